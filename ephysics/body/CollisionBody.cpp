@@ -21,7 +21,8 @@ CollisionBody::CollisionBody(const etk::Transform3D& _transform, CollisionWorld&
   m_proxyCollisionShapes(null),
   m_numberCollisionShapes(0),
   m_contactManifoldsList(null),
-  m_world(_world) {
+  m_world(_world),
+  m_collisionGroup(0) {
 	
 }
 
@@ -33,7 +34,18 @@ CollisionBody::~CollisionBody() {
 }
 
 inline void CollisionBody::setType(BodyType _type) {
+	bool wasStatic = m_type == STATIC;
 	m_type = _type;
+	// The shapes of the static bodies are stored in a separate tree of the broad-phase
+	if (    m_isActive == true
+	     && wasStatic != (m_type == STATIC)) {
+		for (ProxyShape* shape = m_proxyCollisionShapes; shape != null; shape = shape->m_next) {
+			m_world.m_collisionDetection.removeProxyCollisionShape(shape);
+			AABB aabb;
+			shape->getScaledCollisionShape()->computeAABB(aabb, m_transform * shape->m_localToBodyTransform);
+			m_world.m_collisionDetection.addProxyCollisionShape(shape, aabb);
+		}
+	}
 	if (m_type == STATIC) {
 		// Update the broad-phase state of the body
 		updateBroadPhaseState();
@@ -134,7 +146,7 @@ void CollisionBody::updateBroadPhaseState() const {
 
 void CollisionBody::updateProxyShapeInBroadPhase(ProxyShape* _proxyShape, bool _forceReinsert) const {
 	AABB aabb;
-	_proxyShape->getCollisionShape()->computeAABB(aabb, m_transform * _proxyShape->getLocalToBodyTransform());
+	_proxyShape->getScaledCollisionShape()->computeAABB(aabb, m_transform * _proxyShape->getLocalToBodyTransform());
 	m_world.m_collisionDetection.updateProxyCollisionShape(_proxyShape, aabb, vec3(0, 0, 0), _forceReinsert);
 }
 
@@ -149,7 +161,7 @@ void CollisionBody::setIsActive(bool _isActive) {
 	if (_isActive == true) {
 		for (ProxyShape* shape = m_proxyCollisionShapes; shape != null; shape = shape->m_next) {
 			AABB aabb;
-			shape->getCollisionShape()->computeAABB(aabb, m_transform * shape->m_localToBodyTransform);
+			shape->getScaledCollisionShape()->computeAABB(aabb, m_transform * shape->m_localToBodyTransform);
 			m_world.m_collisionDetection.addProxyCollisionShape(shape, aabb);
 		}
 	} else {
@@ -161,6 +173,13 @@ void CollisionBody::setIsActive(bool _isActive) {
 }
 
 
+void CollisionBody::setCollisionGroup(uint32_t _group) {
+	m_collisionGroup = _group;
+	for (ProxyShape* shape = m_proxyCollisionShapes; shape != null; shape = shape->m_next) {
+		m_world.m_collisionDetection.notifyCollisionFilterChanged(shape);
+	}
+}
+
 void CollisionBody::askForBroadPhaseCollisionCheck() const {
 	for (ProxyShape* shape = m_proxyCollisionShapes; shape != null; shape = shape->m_next) {
 		m_world.m_collisionDetection.askForBroadPhaseCollisionCheck(shape);  
@@ -209,10 +228,10 @@ AABB CollisionBody::getAABB() const {
 	if (m_proxyCollisionShapes == null) {
 		return bodyAABB;
 	}
-	m_proxyCollisionShapes->getCollisionShape()->computeAABB(bodyAABB, m_transform * m_proxyCollisionShapes->getLocalToBodyTransform());
+	m_proxyCollisionShapes->getScaledCollisionShape()->computeAABB(bodyAABB, m_transform * m_proxyCollisionShapes->getLocalToBodyTransform());
 	for (ProxyShape* shape = m_proxyCollisionShapes->m_next; shape != null; shape = shape->m_next) {
 		AABB aabb;
-		shape->getCollisionShape()->computeAABB(aabb, m_transform * shape->getLocalToBodyTransform());
+		shape->getScaledCollisionShape()->computeAABB(aabb, m_transform * shape->getLocalToBodyTransform());
 		bodyAABB.mergeWithAABB(aabb);
 	}
 	return bodyAABB;
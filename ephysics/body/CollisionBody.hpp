@@ -37,6 +37,7 @@ namespace ephysics {
 			uint32_t m_numberCollisionShapes; //!< Number of collision shapes
 			ContactManifoldListElement* m_contactManifoldsList; //!< First element of the linked list of contact manifolds involving this body
 			CollisionWorld& m_world; //!< Reference to the world the body belongs to
+			uint32_t m_collisionGroup; //!< Ignore group of the body (the bodies of the same non-zero group never collide)
 			/// Private copy-constructor
 			CollisionBody(const CollisionBody& _body) = delete;
 			/// Private assignment operator
@@ -61,6 +62,13 @@ namespace ephysics {
 			 * @brief Ask the broad-phase to test again the collision shapes of the body for collision (as if the body has moved).
 			 */
 			void askForBroadPhaseCollisionCheck() const;
+			/**
+			 * @brief Translate the world-space data of the body (the broad-phase is translated by the world)
+			 * @param[in] _translation Translation to apply
+			 */
+			virtual void translateWorldSpace(const vec3& _translation) {
+				m_transform.setPosition(m_transform.getPosition() + _translation);
+			}
 			/**
 			 * @brief Reset the m_isAlreadyInIsland variable of the body and contact manifolds.
 			 * This method also returns the number of contact manifolds of the body.
@@ -90,6 +98,19 @@ namespace ephysics {
 			 * @param[in] type The type of the body (STATIC, KINEMATIC, DYNAMIC)
 			 */
 			virtual void setType(BodyType _type);
+			/**
+			 * @brief Return the ignore group of the body
+			 * @return The ignore group (0 if the body is not in a group)
+			 */
+			uint32_t getCollisionGroup() const {
+				return m_collisionGroup;
+			}
+			/**
+			 * @brief Set the ignore group of the body. The bodies of a same non-zero group never
+			 * collide with each other (the parts of a ragdoll for instance).
+			 * @param[in] _group Ignore group of the body (0 to remove the body from its group)
+			 */
+			void setCollisionGroup(uint32_t _group);
 			/**
 			 * @brief Set whether or not the body is active
 			 * @param[in] _isActive True if you want to activate the body
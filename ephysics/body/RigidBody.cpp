@@ -23,7 +23,8 @@ RigidBody::RigidBody(const etk::Transform3D& _transform, CollisionWorld& _world,
   m_isGravityEnabled(true),
   m_linearDamping(0.0f),
   m_angularDamping(float(0.0)),
-  m_jointsList(null) {
+  m_jointsList(null),
+  m_previousTransform(_transform) {
 	// Compute the inverse mass
 	m_massInverse = 1.0f / m_initMass;
 }
@@ -185,6 +186,8 @@ void RigidBody::setIsSleeping(bool _isSleeping) {
 
 void RigidBody::setTransform(const etk::Transform3D& _transform) {
 	m_transform = _transform;
+	// A teleportation is not interpolated by DynamicsWorld::advance()
+	m_previousTransform = _transform;
 	const vec3 oldCenterOfMass = m_centerOfMassWorld;
 	// Compute the new center of mass in world-space coordinates
 	m_centerOfMassWorld = m_transform * m_centerOfMassLocal;
@@ -224,7 +227,7 @@ void RigidBody::recomputeMassInformation() {
 	for (ProxyShape* shape = m_proxyCollisionShapes; shape != null; shape = shape->m_next) {
 		// Get the inertia tensor of the collision shape in its local-space
 		etk::Matrix3x3 inertiaTensor;
-		shape->getCollisionShape()->computeLocalInertiaTensor(inertiaTensor, shape->getMass());
+		shape->getScaledCollisionShape()->computeLocalInertiaTensor(inertiaTensor, shape->getMass());
 		// Convert the collision shape inertia tensor int32_to the local-space of the body
 		const etk::Transform3D& shapeTransform = shape->getLocalToBodyTransform();
 		etk::Matrix3x3 rotationMatrix = shapeTransform.getOrientation().getMatrix();
@@ -258,7 +261,7 @@ void RigidBody::updateBroadPhaseState() const {
 		// Recompute the world-space AABB of the collision shape
 		AABB aabb;
 		EPHY_VERBOSE("         : " << aabb.getMin() << " " << aabb.getMax());
-		shape->getCollisionShape()->computeAABB(aabb, m_transform *shape->getLocalToBodyTransform());
+		shape->getScaledCollisionShape()->computeAABB(aabb, m_transform *shape->getLocalToBodyTransform());
 		EPHY_VERBOSE("         : " << aabb.getMin() << " " << aabb.getMax());
 		// Update the broad-phase state for the proxy collision shape
 		m_world.m_collisionDetection.updateProxyCollisionShape(shape, aabb, displacement);
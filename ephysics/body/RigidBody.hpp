@@ -42,6 +42,7 @@ namespace ephysics {
 			float m_linearDamping; //!< Linear velocity damping factor
 			float m_angularDamping; //!< Angular velocity damping factor
 			JointListElement* m_jointsList; //!< First element of the linked list of joints involving this body
+			etk::Transform3D m_previousTransform; //!< Transform at the start of the last fixed step of DynamicsWorld::advance()
 			/// Private copy-constructor
 			RigidBody(const RigidBody& body);
 			/// Private assignment operator
@@ -58,6 +59,12 @@ namespace ephysics {
 				m_transform.setPosition(m_centerOfMassWorld - m_transform.getOrientation() * m_centerOfMassLocal);
 			}
 			void updateBroadPhaseState() const override;
+			void translateWorldSpace(const vec3& _translation) override {
+				CollisionBody::translateWorldSpace(_translation);
+				m_centerOfMassWorld += _translation;
+				// The interpolation of DynamicsWorld::advance() starts from the previous transform
+				m_previousTransform.setPosition(m_previousTransform.getPosition() + _translation);
+			}
 		public :
 			/**
 			 * @brief Constructor
@@ -128,6 +135,13 @@ namespace ephysics {
 			 * @brief Set the local center of mass of the body (in local-space coordinates)
 			 * @param[in] _centerOfMassLocal The center of mass of the body in local-space coordinates
 			 */
+			/**
+			 * @brief Get the local center of mass of the body (in local-space coordinates)
+			 * @return The center of mass of the body in local-space coordinates
+			 */
+			const vec3& getCenterOfMassLocal() const {
+				return m_centerOfMassLocal;
+			}
 			void setCenterOfMassLocal(const vec3& centerOfMassLocal);
 			/**
 			 * @brief Set the mass of the rigid body
@@ -185,6 +199,13 @@ namespace ephysics {
 			Material& getMaterial() {
 				return m_material;
 			}
+			/**
+			 * @brief get a reference to the material properties of the rigid body
+			 * @return A const reference to the material of the body
+			 */
+			const Material& getMaterial() const {
+				return m_material;
+			}
 			/**
 			 * @brief Set a new material for this rigid body
 			 * @param[in] _material The material you want to set to the body
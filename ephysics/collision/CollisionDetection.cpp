@@ -10,8 +10,12 @@
 #include <ephysics/engine/CollisionWorld.hpp>
 #include <ephysics/body/Body.hpp>
 #include <ephysics/collision/shapes/BoxShape.hpp>
+#include <ephysics/collision/shapes/CompoundShape.hpp>
+#include <ephysics/collision/shapes/TriangleShape.hpp>
 #include <ephysics/body/RigidBody.hpp>
 #include <ephysics/configuration.hpp>
+#include <ephysics/engine/StateBuffer.hpp>
+#include <ephysics/mathematics/simd.hpp>
 
 // We want to use the ReactPhysics3D namespace
 using namespace ephysics;
@@ -21,7 +25,15 @@ using namespace std;
 CollisionDetection::CollisionDetection(CollisionWorld* _world):
   m_world(_world),
   m_broadPhaseAlgorithm(*this),
-  m_isCollisionShapesAdded(false) {
+  m_isCollisionShapesAdded(false),
+  m_isContactPairEventsEnabled(false),
+  m_contactBeginImpulseThreshold(0.0f),
+  m_contactPersistImpulseThreshold(0.0f),
+  m_collisionFilterVersion(0) {
+	// All the layers collide with each other by default
+	for (uint32_t iii=0; iii<NB_COLLISION_LAYERS; ++iii) {
+		m_layerCollisionMatrix[iii] = 0xFFFFFFFFFFFFFFFFULL;
+	}
 	// Set the default collision dispatch configuration
 	setCollisionDispatch(&m_defaultCollisionDispatch);
 	// Fill-in the collision detection matrix with algorithms
@@ -85,11 +97,11 @@ void CollisionDetection::reportCollisionBetweenShapes(CollisionCallback* _callba
 			const ContactManifold* manifold = manifoldSet.getContactManifold(j);
 			// For each contact manifold of the manifold set
 			for (uint32_t i=0; i<manifold->getNbContactPoints(); i++) {
-				ContactPoint* contactPoint = manifold->getContactPoint(i);
+				const ContactPoint* contactPoint = manifold->getContactPoint(i);
 				// Create the contact info object for the contact
 				ContactPointInfo contactInfo(manifold->getShape1(), manifold->getShape2(),
-				                             manifold->getShape1()->getCollisionShape(),
-				                             manifold->getShape2()->getCollisionShape(),
+				                             manifold->getShape1()->getScaledCollisionShape(),
+				                             manifold->getShape2()->getScaledCollisionShape(),
 				                             contactPoint->getNormal(),
 				                             contactPoint->getPenetrationDepth(),
 				                             contactPoint->getLocalPointOnBody1(),
@@ -118,6 +130,12 @@ void CollisionDetection::computeNarrowPhase() {
 	PROFILE("CollisionDetection::computeNarrowPhase()");
 	// Clear the set of overlapping pairs in narrow-phase contact
 	m_contactOverlappingPairs.clear();
+	// Publish the EXIT events of the trigger pairs destroyed since the last step
+	m_triggerEvents.clear();
+	for (auto &it: m_pendingTriggerEvents) {
+		m_triggerEvents.pushBack(it);
+	}
+	m_pendingTriggerEvents.clear();
 	// For each possible collision pair of bodies
 	etk::Map<overlappingpairid, OverlappingPair*>::Iterator it;
 	for (it = m_overlappingPairs.begin(); it != m_overlappingPairs.end(); ) {
@@ -127,11 +145,13 @@ void CollisionDetection::computeNarrowPhase() {
 		assert(shape1->m_broadPhaseID != shape2->m_broadPhaseID);
 		// Check if the collision filtering allows collision between the two shapes and
 		// that the two shapes are still overlapping. Otherwise, we destroy the
-		// overlapping pair
-		if (((shape1->getCollideWithMaskBits() & shape2->getCollisionCategoryBits()) == 0 ||
-			 (shape1->getCollisionCategoryBits() & shape2->getCollideWithMaskBits()) == 0) ||
-			 !m_broadPhaseAlgorithm.testOverlappingShapes(shape1, shape2)) {
+		// overlapping pair (the filters are only checked again when they have changed
+		// since the pair has been created, the broad-phase does not create filtered pairs)
+		if (    (    pair->getCollisionFilterVersion() != m_collisionFilterVersion
+		          && testCollisionFilter(shape1, shape2) == false)
+		     || !m_broadPhaseAlgorithm.testOverlappingShapes(shape1, shape2) ) {
 			// TODO : Remove all the contact manifold of the overlapping pair from the contact manifolds list of the two bodies involved
+			reportDestroyedPairContactEvent(it->second);
 			// Destroy the overlapping pair
 			ETK_DELETE(OverlappingPair, it->second);
 			it->second = null;
@@ -140,6 +160,7 @@ void CollisionDetection::computeNarrowPhase() {
 		} else {
 			++it;
 		}
+		pair->setCollisionFilterVersion(m_collisionFilterVersion);
 		CollisionBody* const body1 = shape1->getBody();
 		CollisionBody* const body2 = shape2->getBody();
 		// Update the contact cache of the overlapping pair
@@ -156,8 +177,8 @@ void CollisionDetection::computeNarrowPhase() {
 			continue;
 		}
 		// Select the narrow phase algorithm to use according to the two collision shapes
-		const CollisionShapeType shape1Type = shape1->getCollisionShape()->getType();
-		const CollisionShapeType shape2Type = shape2->getCollisionShape()->getType();
+		const CollisionShapeType shape1Type = shape1->getScaledCollisionShape()->getType();
+		const CollisionShapeType shape2Type = shape2->getScaledCollisionShape()->getType();
 		NarrowPhaseAlgorithm* narrowPhaseAlgorithm = m_collisionMatrix[shape1Type][shape2Type];
 		// If there is no collision algorithm between those two kinds of shapes
 		if (narrowPhaseAlgorithm == null) {
@@ -166,11 +187,27 @@ void CollisionDetection::computeNarrowPhase() {
 		// Notify the narrow-phase algorithm about the overlapping pair we are going to test
 		narrowPhaseAlgorithm->setCurrentOverlappingPair(pair);
 		// Create the CollisionShapeInfo objects
-		CollisionShapeInfo shape1Info(shape1, shape1->getCollisionShape(), shape1->getLocalToWorldTransform(),
+		CollisionShapeInfo shape1Info(shape1, shape1->getScaledCollisionShape(), shape1->getLocalToWorldTransform(),
 									  pair, shape1->getCachedCollisionData());
-		CollisionShapeInfo shape2Info(shape2, shape2->getCollisionShape(), shape2->getLocalToWorldTransform(),
+		CollisionShapeInfo shape2Info(shape2, shape2->getScaledCollisionShape(), shape2->getLocalToWorldTransform(),
 									  pair, shape2->getCachedCollisionData());
-		
+		// A trigger only reports the changes of its overlapping state: no contact is
+		// created, thus the pair never links the two bodies in an island
+		if (    shape1->isTrigger() == true
+		     || shape2->isTrigger() == true) {
+			pair->clearContactPoints();
+			bool isOverlapping = testTriggerOverlap(narrowPhaseAlgorithm, shape1Info, shape2Info);
+			if (isOverlapping != pair->isTriggerOverlapping()) {
+				pair->setIsTriggerOverlapping(isOverlapping);
+				m_triggerEvents.pushBack(createTriggerEvent(pair, isOverlapping == true ? TriggerEvent::ENTER : TriggerEvent::EXIT));
+			}
+			continue;
+		}
+		// The pair is not a trigger pair anymore
+		if (pair->isTriggerOverlapping() == true) {
+			pair->setIsTriggerOverlapping(false);
+			m_triggerEvents.pushBack(createTriggerEvent(pair, TriggerEvent::EXIT));
+		}
 		// Use the narrow-phase collision detection algorithm to check
 		// if there really is a collision. If a collision occurs, the
 		// notifyContact() callback method will be called.
@@ -216,11 +253,13 @@ void CollisionDetection::computeNarrowPhaseBetweenShapes(CollisionCallback* _cal
 		}
 		// Check if the collision filtering allows collision between the two shapes and
 		// that the two shapes are still overlapping. Otherwise, we destroy the
-		// overlapping pair
-		if (    (    (shape1->getCollideWithMaskBits() & shape2->getCollisionCategoryBits()) == 0
-		          || (shape1->getCollisionCategoryBits() & shape2->getCollideWithMaskBits()) == 0 )
+		// overlapping pair (the filters are only checked again when they have changed
+		// since the pair has been created, the broad-phase does not create filtered pairs)
+		if (    (    pair->getCollisionFilterVersion() != m_collisionFilterVersion
+		          && testCollisionFilter(shape1, shape2) == false)
 		     || !m_broadPhaseAlgorithm.testOverlappingShapes(shape1, shape2) ) {
 			// TODO : Remove all the contact manifold of the overlapping pair from the contact manifolds list of the two bodies involved
+			reportDestroyedPairContactEvent(it->second);
 			// Destroy the overlapping pair
 			ETK_DELETE(OverlappingPair, it->second);
 			it->second = null;
@@ -229,6 +268,7 @@ void CollisionDetection::computeNarrowPhaseBetweenShapes(CollisionCallback* _cal
 		} else {
 			++it;
 		}
+		pair->setCollisionFilterVersion(m_collisionFilterVersion);
 		CollisionBody* const body1 = shape1->getBody();
 		CollisionBody* const body2 = shape2->getBody();
 		// Update the contact cache of the overlapping pair
@@ -245,9 +285,14 @@ void CollisionDetection::computeNarrowPhaseBetweenShapes(CollisionCallback* _cal
 		if (body1->isSleeping() && body2->isSleeping()) {
 			continue;
 		}
+		// A trigger never reports contact points (same rule as the simulation)
+		if (    shape1->isTrigger() == true
+		     || shape2->isTrigger() == true) {
+			continue;
+		}
 		// Select the narrow phase algorithm to use according to the two collision shapes
-		const CollisionShapeType shape1Type = shape1->getCollisionShape()->getType();
-		const CollisionShapeType shape2Type = shape2->getCollisionShape()->getType();
+		const CollisionShapeType shape1Type = shape1->getScaledCollisionShape()->getType();
+		const CollisionShapeType shape2Type = shape2->getScaledCollisionShape()->getType();
 		NarrowPhaseAlgorithm* narrowPhaseAlgorithm = m_collisionMatrix[shape1Type][shape2Type];
 		// If there is no collision algorithm between those two kinds of shapes
 		if (narrowPhaseAlgorithm == null) {
@@ -257,12 +302,12 @@ void CollisionDetection::computeNarrowPhaseBetweenShapes(CollisionCallback* _cal
 		narrowPhaseAlgorithm->setCurrentOverlappingPair(pair);
 		// Create the CollisionShapeInfo objects
 		CollisionShapeInfo shape1Info(shape1,
-		                              shape1->getCollisionShape(),
+		                              shape1->getScaledCollisionShape(),
 		                              shape1->getLocalToWorldTransform(),
 		                              pair,
 		                              shape1->getCachedCollisionData());
 		CollisionShapeInfo shape2Info(shape2,
-		                              shape2->getCollisionShape(),
+		                              shape2->getScaledCollisionShape(),
 		                              shape2->getLocalToWorldTransform(),
 		                              pair,
 		                              shape2->getCachedCollisionData());
@@ -277,25 +322,18 @@ void CollisionDetection::computeNarrowPhaseBetweenShapes(CollisionCallback* _cal
 
 void CollisionDetection::broadPhaseNotifyOverlappingPair(ProxyShape* _shape1, ProxyShape* _shape2) {
 	assert(_shape1->m_broadPhaseID != _shape2->m_broadPhaseID);
-	// If the two proxy collision shapes are from the same body, skip it
-	if (_shape1->getBody()->getID() == _shape2->getBody()->getID()) {
-		return;
-	}
-	// Check if the collision filtering allows collision between the two shapes
-	if (    (_shape1->getCollideWithMaskBits() & _shape2->getCollisionCategoryBits()) == 0
-	     || (_shape1->getCollisionCategoryBits() & _shape2->getCollideWithMaskBits()) == 0) {
-		return;
-	}
+	// Note: the broad-phase only reports the pairs allowed by the collision filters
 	// Compute the overlapping pair ID
 	overlappingpairid pairID = OverlappingPair::computeID(_shape1, _shape2);
 	// Check if the overlapping pair already exists
 	if (m_overlappingPairs.find(pairID) != m_overlappingPairs.end()) return;
 	// Compute the maximum number of contact manifolds for this pair
-	int32_t nbMaxManifolds = CollisionShape::computeNbMaxContactManifolds(_shape1->getCollisionShape()->getType(),
-	                                                                      _shape2->getCollisionShape()->getType());
+	int32_t nbMaxManifolds = CollisionShape::computeNbMaxContactManifolds(_shape1->getScaledCollisionShape()->getType(),
+	                                                                      _shape2->getScaledCollisionShape()->getType());
 	// Create the overlapping pair and add it int32_to the set of overlapping pairs
 	OverlappingPair* newPair = ETK_NEW(OverlappingPair, _shape1, _shape2, nbMaxManifolds);
 	assert(newPair != null);
+	newPair->setCollisionFilterVersion(m_collisionFilterVersion);
 	m_overlappingPairs.set(pairID, newPair);
 	// Wake up the two bodies
 	_shape1->getBody()->setIsSleeping(false);
@@ -309,6 +347,7 @@ void CollisionDetection::removeProxyCollisionShape(ProxyShape* _proxyShape) {
 		if (it->second->getShape1()->m_broadPhaseID == _proxyShape->m_broadPhaseID||
 			it->second->getShape2()->m_broadPhaseID == _proxyShape->m_broadPhaseID) {
 			// TODO : Remove all the contact manifold of the overlapping pair from the contact manifolds list of the two bodies involved
+			reportDestroyedPairContactEvent(it->second);
 			// Destroy the overlapping pair
 			ETK_DELETE(OverlappingPair, it->second);
 			it->second = null;
@@ -338,10 +377,9 @@ void CollisionDetection::notifyContact(OverlappingPair* _overlappingPair, const
 }
 
 void CollisionDetection::createContact(OverlappingPair* _overlappingPair, const ContactPointInfo& _contactInfo) {
-	// Create a new contact
-	ContactPoint* contact = ETK_NEW(ContactPoint, _contactInfo);
 	// Add the contact to the contact manifold set of the corresponding overlapping pair
-	_overlappingPair->addContact(contact);
+	// (the contact point is stored by value in the manifold)
+	_overlappingPair->addContact(_contactInfo);
 	// Add the overlapping pair int32_to the set of pairs in contact during narrow-phase
 	overlappingpairid pairId = OverlappingPair::computeID(_overlappingPair->getShape1(),
 	                                                      _overlappingPair->getShape2());
@@ -362,7 +400,7 @@ void CollisionDetection::addContactManifoldToBody(OverlappingPair* _pair) {
 	assert(_pair != null);
 	CollisionBody* body1 = _pair->getShape1()->getBody();
 	CollisionBody* body2 = _pair->getShape2()->getBody();
-	const ContactManifoldSet& manifoldSet = _pair->getContactManifoldSet();
+	ContactManifoldSet& manifoldSet = _pair->getContactManifoldSet();
 	// For each contact manifold in the set of manifolds in the pair
 	for (int32_t i=0; i<manifoldSet.getNbContactManifolds(); i++) {
 		ContactManifold* contactManifold = manifoldSet.getContactManifold(i);
@@ -376,6 +414,147 @@ void CollisionDetection::addContactManifoldToBody(OverlappingPair* _pair) {
 	}
 }
 
+TriggerEvent CollisionDetection::createTriggerEvent(const OverlappingPair* _pair, TriggerEvent::Type _type) {
+	TriggerEvent event;
+	event.type = _type;
+	event.body1Id = _pair->getShape1()->getBody()->getID();
+	event.body2Id = _pair->getShape2()->getBody()->getID();
+	event.shape1UserData = _pair->getShape1()->getUserData();
+	event.shape2UserData = _pair->getShape2()->getUserData();
+	return event;
+}
+
+bool CollisionDetection::testTriggerOverlap(NarrowPhaseAlgorithm* _narrowPhaseAlgorithm,
+                                            const CollisionShapeInfo& _shape1Info,
+                                            const CollisionShapeInfo& _shape2Info) {
+	// Two convex shapes: boolean GJK test (no EPA, no contact point)
+	if (    _shape1Info.collisionShape->isConvex() == true
+	     && _shape2Info.collisionShape->isConvex() == true) {
+		return m_narrowPhaseGJKAlgorithm.testOverlap(_shape1Info, _shape2Info);
+	}
+	// Convex shape against the triangles of a concave shape: boolean GJK test per triangle
+	const CollisionShapeInfo* convexShapeInfo = &_shape1Info;
+	const CollisionShapeInfo* concaveShapeInfo = &_shape2Info;
+	if (_shape1Info.collisionShape->isConvex() == false) {
+		convexShapeInfo = &_shape2Info;
+		concaveShapeInfo = &_shape1Info;
+	}
+	if (    convexShapeInfo->collisionShape->isConvex() == true
+	     && (    concaveShapeInfo->collisionShape->getType() == CONCAVE_MESH
+	          || concaveShapeInfo->collisionShape->getType() == HEIGHTFIELD)) {
+		const ConcaveShape* concaveShape = static_cast<const ConcaveShape*>(concaveShapeInfo->collisionShape);
+		// Compute the convex shape AABB in the local-space of the concave shape
+		AABB aabb;
+		convexShapeInfo->collisionShape->computeAABB(aabb, concaveShapeInfo->shapeToWorldTransform.getInverse() * convexShapeInfo->shapeToWorldTransform);
+		TestTriggerTriangleOverlapCallback callback(m_narrowPhaseGJKAlgorithm, *convexShapeInfo, *concaveShapeInfo);
+		concaveShape->testAllTriangles(callback, aabb);
+		return callback.isOverlapping();
+	}
+	// Compound shape: run the selected algorithm but only keep the overlapping state
+	TestTriggerOverlapCallback callback;
+	_narrowPhaseAlgorithm->testCollision(_shape1Info, _shape2Info, &callback);
+	return callback.isOverlapping();
+}
+
+void TestTriggerTriangleOverlapCallback::testTriangle(const vec3* _trianglePoints) {
+	// The overlapping state is already known: skip the remaining triangles
+	if (m_isOverlapping == true) {
+		return;
+	}
+	const ConcaveShape* concaveShape = static_cast<const ConcaveShape*>(m_concaveShapeInfo.collisionShape);
+	TriangleShape triangleShape(_trianglePoints[0], _trianglePoints[1], _trianglePoints[2], concaveShape->getTriangleMargin());
+	CollisionShapeInfo triangleShapeInfo(m_concaveShapeInfo.proxyShape,
+	                                     &triangleShape,
+	                                     m_concaveShapeInfo.shapeToWorldTransform,
+	                                     m_concaveShapeInfo.overlappingPair,
+	                                     m_concaveShapeInfo.cachedCollisionData);
+	m_isOverlapping = m_gjkAlgorithm.testOverlap(m_convexShapeInfo, triangleShapeInfo);
+}
+
+void CollisionDetection::reportDestroyedPairContactEvent(OverlappingPair* _pair) {
+	if (_pair->isTriggerOverlapping() == true) {
+		m_pendingTriggerEvents.pushBack(createTriggerEvent(_pair, TriggerEvent::EXIT));
+		_pair->setIsTriggerOverlapping(false);
+	}
+	if (    m_isContactPairEventsEnabled == false
+	     || _pair->isContactReported() == false) {
+		return;
+	}
+	ContactPairEvent event;
+	event.type = ContactPairEvent::END;
+	event.body1Id = _pair->getShape1()->getBody()->getID();
+	event.body2Id = _pair->getShape2()->getBody()->getID();
+	event.shape1UserData = _pair->getShape1()->getUserData();
+	event.shape2UserData = _pair->getShape2()->getUserData();
+	event.nbContactPoints = 0;
+	event.normalImpulse = 0.0f;
+	m_pendingContactPairEvents.pushBack(event);
+	_pair->setIsContactReported(false);
+}
+
+void CollisionDetection::computeContactPairEvents() {
+	PROFILE("CollisionDetection::computeContactPairEvents()");
+	// Publish the END events of the pairs destroyed since the last step
+	m_contactPairEvents.clear();
+	for (auto &it: m_pendingContactPairEvents) {
+		m_contactPairEvents.pushBack(it);
+	}
+	m_pendingContactPairEvents.clear();
+	if (m_isContactPairEventsEnabled == false) {
+		return;
+	}
+	etk::Map<overlappingpairid, OverlappingPair*>::Iterator it;
+	for (it = m_overlappingPairs.begin(); it != m_overlappingPairs.end(); ++it) {
+		OverlappingPair* pair = it->second;
+		// Accumulate the normal impulses stored by the contact solver
+		uint32_t nbContactPoints = 0;
+		float normalImpulse = 0.0f;
+		ContactManifoldSet& manifoldSet = pair->getContactManifoldSet();
+		for (int32_t iii=0; iii<manifoldSet.getNbContactManifolds(); ++iii) {
+			const ContactManifold* manifold = manifoldSet.getContactManifold(iii);
+			for (uint32_t jjj=0; jjj<manifold->getNbContactPoints(); ++jjj) {
+				normalImpulse += manifold->getContactPoint(jjj)->getPenetrationImpulse();
+			}
+			nbContactPoints += manifold->getNbContactPoints();
+		}
+		ContactPairEvent event;
+		event.body1Id = pair->getShape1()->getBody()->getID();
+		event.body2Id = pair->getShape2()->getBody()->getID();
+		event.shape1UserData = pair->getShape1()->getUserData();
+		event.shape2UserData = pair->getShape2()->getUserData();
+		event.nbContactPoints = nbContactPoints;
+		event.normalImpulse = normalImpulse;
+		if (nbContactPoints == 0) {
+			if (pair->isContactReported() == true) {
+				event.type = ContactPairEvent::END;
+				event.normalImpulse = 0.0f;
+				m_contactPairEvents.pushBack(event);
+				pair->setIsContactReported(false);
+			}
+			continue;
+		}
+		if (pair->isContactReported() == false) {
+			// The contact starts only when it is strong enough
+			if (normalImpulse >= m_contactBeginImpulseThreshold) {
+				event.type = ContactPairEvent::BEGIN;
+				m_contactPairEvents.pushBack(event);
+				pair->setIsContactReported(true);
+			}
+			continue;
+		}
+		// Nothing new to report for a contact between two bodies that do not move
+		CollisionBody* body1 = pair->getShape1()->getBody();
+		CollisionBody* body2 = pair->getShape2()->getBody();
+		const bool isBody1Active = !body1->isSleeping() && body1->getType() != STATIC;
+		const bool isBody2Active = !body2->isSleeping() && body2->getType() != STATIC;
+		if (    (isBody1Active || isBody2Active)
+		     && normalImpulse >= m_contactPersistImpulseThreshold) {
+			event.type = ContactPairEvent::PERSIST;
+			m_contactPairEvents.pushBack(event);
+		}
+	}
+}
+
 void CollisionDetection::clearContactPoints() {
 	// For each overlapping pair
 	etk::Map<overlappingpairid, OverlappingPair*>::Iterator it;
@@ -426,6 +605,123 @@ void CollisionDetection::removeNoCollisionPair(CollisionBody* _body1, CollisionB
 	m_noCollisionPairs.erase(m_noCollisionPairs.find(OverlappingPair::computeBodiesIndexPair(_body1, _body2)));
 }
 
+bool CollisionDetection::testCollisionFilter(const ProxyShape* _shape1, const ProxyShape* _shape2) const {
+	const CollisionBody* body1 = _shape1->getBody();
+	const CollisionBody* body2 = _shape2->getBody();
+	// The shapes of a same body never collide
+	if (body1->getID() == body2->getID()) {
+		return false;
+	}
+	// The bodies of a same ignore group never collide
+	if (    body1->getCollisionGroup() != 0
+	     && body1->getCollisionGroup() == body2->getCollisionGroup()) {
+		return false;
+	}
+	if (canLayersCollide(_shape1->getCollisionLayer(), _shape2->getCollisionLayer()) == false) {
+		return false;
+	}
+	return    (_shape1->getCollideWithMaskBits() & _shape2->getCollisionCategoryBits()) != 0
+	       && (_shape1->getCollisionCategoryBits() & _shape2->getCollideWithMaskBits()) != 0;
+}
+
+void CollisionDetection::notifyCollisionFilterChanged(ProxyShape* _shape) {
+	// The existing pairs are checked again during the next narrow-phase
+	m_collisionFilterVersion++;
+	// The new allowed pairs are created during the next broad-phase
+	if (_shape->m_broadPhaseID != -1) {
+		askForBroadPhaseCollisionCheck(_shape);
+	}
+}
+
+void CollisionDetection::setLayersCollision(uint32_t _layer1, uint32_t _layer2, bool _canCollide) {
+	assert(_layer1 < NB_COLLISION_LAYERS);
+	assert(_layer2 < NB_COLLISION_LAYERS);
+	if (_canCollide == true) {
+		m_layerCollisionMatrix[_layer1] |= uint64_t(1) << _layer2;
+		m_layerCollisionMatrix[_layer2] |= uint64_t(1) << _layer1;
+	} else {
+		m_layerCollisionMatrix[_layer1] &= ~(uint64_t(1) << _layer2);
+		m_layerCollisionMatrix[_layer2] &= ~(uint64_t(1) << _layer1);
+	}
+	m_collisionFilterVersion++;
+}
+
+void CollisionDetection::translateWorldSpace(const vec3& _translation) {
+	m_broadPhaseAlgorithm.translate(_translation);
+	etk::Map<overlappingpairid, OverlappingPair*>::Iterator it;
+	for (it = m_overlappingPairs.begin(); it != m_overlappingPairs.end(); ++it) {
+		ContactManifoldSet& manifoldSet = it->second->getContactManifoldSet();
+		for (int32_t iii=0; iii<manifoldSet.getNbContactManifolds(); ++iii) {
+			ContactManifold* manifold = manifoldSet.getContactManifold(iii);
+			for (uint32_t jjj=0; jjj<manifold->getNbContactPoints(); ++jjj) {
+				ContactPoint* point = manifold->getContactPoint(jjj);
+				point->setWorldPointOnBody1(point->getWorldPointOnBody1() + _translation);
+				point->setWorldPointOnBody2(point->getWorldPointOnBody2() + _translation);
+			}
+		}
+	}
+}
+
+void CollisionDetection::saveState(etk::Vector<uint8_t>& _buffer) const {
+	m_broadPhaseAlgorithm.saveState(_buffer);
+	stateBuffer::write(_buffer, int32_t(m_overlappingPairs.size()));
+	etk::Map<overlappingpairid, OverlappingPair*>::Iterator it;
+	for (it = m_overlappingPairs.begin(); it != m_overlappingPairs.end(); ++it) {
+		// The proxy shapes are stored with their pointers (the snapshot is only valid for this world)
+		ProxyShape* shape1 = it->second->getShape1();
+		ProxyShape* shape2 = it->second->getShape2();
+		stateBuffer::write(_buffer, shape1);
+		stateBuffer::write(_buffer, shape2);
+		it->second->saveState(_buffer);
+	}
+}
+
+void CollisionDetection::restoreState(const uint8_t*& _data) {
+	m_broadPhaseAlgorithm.restoreState(_data);
+	int32_t nbPairs = 0;
+	stateBuffer::read(_data, nbPairs);
+	// Rebuild the set of overlapping pairs, reusing the pairs that still exist
+	etk::Map<overlappingpairid, OverlappingPair*> overlappingPairs;
+	for (int32_t iii=0; iii<nbPairs; ++iii) {
+		ProxyShape* shape1 = null;
+		ProxyShape* shape2 = null;
+		stateBuffer::read(_data, shape1);
+		stateBuffer::read(_data, shape2);
+		overlappingpairid pairID = OverlappingPair::computeID(shape1, shape2);
+		OverlappingPair* pair = null;
+		auto it = m_overlappingPairs.find(pairID);
+		if (it != m_overlappingPairs.end()) {
+			pair = it->second;
+			m_overlappingPairs.erase(it);
+			if (pair->getShape1() != shape1) {
+				// Same shapes in the other order: the manifolds can not be restored in this pair
+				ETK_DELETE(OverlappingPair, pair);
+				pair = null;
+			}
+		}
+		if (pair == null) {
+			int32_t nbMaxManifolds = CollisionShape::computeNbMaxContactManifolds(shape1->getScaledCollisionShape()->getType(),
+			                                                                      shape2->getScaledCollisionShape()->getType());
+			pair = ETK_NEW(OverlappingPair, shape1, shape2, nbMaxManifolds);
+		}
+		pair->restoreState(_data);
+		overlappingPairs.set(pairID, pair);
+	}
+	// Destroy the pairs created after the snapshot (without any END/EXIT event)
+	etk::Map<overlappingpairid, OverlappingPair*>::Iterator it;
+	for (it = m_overlappingPairs.begin(); it != m_overlappingPairs.end(); ++it) {
+		ETK_DELETE(OverlappingPair, it->second);
+		it->second = null;
+	}
+	m_overlappingPairs.clear();
+	for (it = overlappingPairs.begin(); it != overlappingPairs.end(); ++it) {
+		m_overlappingPairs.set(it->first, it->second);
+	}
+	m_contactOverlappingPairs.clear();
+	m_pendingContactPairEvents.clear();
+	m_pendingTriggerEvents.clear();
+}
+
 void CollisionDetection::askForBroadPhaseCollisionCheck(ProxyShape* _shape) {
 	m_broadPhaseAlgorithm.addMovedCollisionShape(_shape->m_broadPhaseID);
 }
@@ -434,7 +730,7 @@ void CollisionDetection::updateProxyCollisionShape(ProxyShape* _shape, const AAB
 	m_broadPhaseAlgorithm.updateProxyCollisionShape(_shape, _aabb, _displacement);
 }
 
-void CollisionDetection::raycast(RaycastCallback* _raycastCallback, const Ray& _ray, unsigned short _raycastWithCategoryMaskBits) const {
+void CollisionDetection::raycast(RaycastCallback* _raycastCallback, const Ray& _ray, uint64_t _raycastWithCategoryMaskBits) const {
 	PROFILE("CollisionDetection::raycast()");
 	RaycastTest rayCastTest(_raycastCallback);
 	// Ask the broad-phase algorithm to call the testRaycastAgainstShape()
@@ -442,6 +738,257 @@ void CollisionDetection::raycast(RaycastCallback* _raycastCallback, const Ray& _
 	m_broadPhaseAlgorithm.raycast(_ray, rayCastTest, _raycastWithCategoryMaskBits);
 }
 
+namespace {
+	/**
+	 * @brief Compute the distance between two collision shapes (the compound shapes return the
+	 * smallest distance of their children)
+	 * @param[in] _shape2 Second shape (null to compute the distance to the point _transform2.getPosition())
+	 * @return false if a shape is not supported (concave shape)
+	 */
+	bool computeShapesDistance(const GJKAlgorithm& _gjkAlgorithm,
+	                           const CollisionShape* _shape1,
+	                           const etk::Transform3D& _transform1,
+	                           const CollisionShape* _shape2,
+	                           const etk::Transform3D& _transform2,
+	                           DistanceInfo& _distanceInfo) {
+		const CompoundShape* compoundShape = null;
+		bool isCompoundShape1 = true;
+		if (_shape1->getType() == COMPOUND) {
+			compoundShape = static_cast<const CompoundShape*>(_shape1);
+		} else if (    _shape2 != null
+		            && _shape2->getType() == COMPOUND) {
+			compoundShape = static_cast<const CompoundShape*>(_shape2);
+			isCompoundShape1 = false;
+		}
+		if (compoundShape != null) {
+			bool isComputed = false;
+			DistanceInfo childDistanceInfo;
+			for (size_t iii=0; iii<compoundShape->getNbChildren(); ++iii) {
+				bool isChildComputed = false;
+				if (isCompoundShape1 == true) {
+					isChildComputed = computeShapesDistance(_gjkAlgorithm,
+					                                        compoundShape->getChildShape(iii), _transform1 * compoundShape->getChildTransform(iii),
+					                                        _shape2, _transform2,
+					                                        childDistanceInfo);
+				} else {
+					isChildComputed = computeShapesDistance(_gjkAlgorithm,
+					                                        _shape1, _transform1,
+					                                        compoundShape->getChildShape(iii), _transform2 * compoundShape->getChildTransform(iii),
+					                                        childDistanceInfo);
+				}
+				if (isChildComputed == false) {
+					return false;
+				}
+				if (    isComputed == false
+				     || childDistanceInfo.distance < _distanceInfo.distance) {
+					_distanceInfo = childDistanceInfo;
+				}
+				isComputed = true;
+			}
+			return isComputed;
+		}
+		if (    _shape1->isConvex() == false
+		     || (    _shape2 != null
+		          && _shape2->isConvex() == false)) {
+			return false;
+		}
+		void* cachedCollisionData1 = null;
+		void* cachedCollisionData2 = null;
+		_gjkAlgorithm.computeDistance(static_cast<const ConvexShape*>(_shape1), _transform1, &cachedCollisionData1,
+		                              static_cast<const ConvexShape*>(_shape2), _transform2, &cachedCollisionData2,
+		                              _distanceInfo);
+		free(cachedCollisionData1);
+		free(cachedCollisionData2);
+		return true;
+	}
+	/// Return the distance between two AABBs (0 if they overlap)
+	float computeAABBDistance(const AABB& _aabb1, const AABB& _aabb2) {
+		vec3 gap1 = _aabb2.getMin() - _aabb1.getMax();
+		vec3 gap2 = _aabb1.getMin() - _aabb2.getMax();
+		vec3 gap(etk::max(0.0f, etk::max(gap1.x(), gap2.x())),
+		         etk::max(0.0f, etk::max(gap1.y(), gap2.y())),
+		         etk::max(0.0f, etk::max(gap1.z(), gap2.z())));
+		return gap.length();
+	}
+}
+
+bool CollisionDetection::computeDistance(const ProxyShape* _shape1, const ProxyShape* _shape2, DistanceInfo& _distanceInfo) const {
+	PROFILE("CollisionDetection::computeDistance()");
+	if (computeShapesDistance(m_narrowPhaseGJKAlgorithm,
+	                          _shape1->getScaledCollisionShape(), _shape1->getLocalToWorldTransform(),
+	                          _shape2->getScaledCollisionShape(), _shape2->getLocalToWorldTransform(),
+	                          _distanceInfo) == false) {
+		return false;
+	}
+	_distanceInfo.proxyShape = null;
+	return true;
+}
+
+bool CollisionDetection::findNearest(const ProxyShape* _shape,
+                                     const vec3& _point,
+                                     float _maxDistance,
+                                     DistanceInfo& _distanceInfo,
+                                     uint64_t _categoryMaskBits) const {
+	PROFILE("CollisionDetection::findNearest()");
+	const CollisionShape* queryShape = null;
+	etk::Transform3D queryTransform;
+	AABB queryAABB(_point, _point);
+	if (_shape != null) {
+		queryShape = _shape->getScaledCollisionShape();
+		queryTransform = _shape->getLocalToWorldTransform();
+		queryShape->computeAABB(queryAABB, queryTransform);
+	} else {
+		queryTransform.setPosition(_point);
+	}
+	AABB searchAABB = queryAABB;
+	searchAABB.inflate(_maxDistance, _maxDistance, _maxDistance);
+	// Collect the candidates with the distance to their broad-phase AABB (lower bound of their distance)
+	etk::Vector<etk::Pair<float, ProxyShape*>> candidates;
+	m_broadPhaseAlgorithm.reportAllShapesOverlappingWithAABB(searchAABB, [&](ProxyShape* _candidate, const AABB& _candidateAABB) mutable {
+	                                                         	if (    (_candidate->getCollisionCategoryBits() & _categoryMaskBits) == 0
+	                                                         	     || _candidate->getBody()->isActive() == false) {
+	                                                         		return;
+	                                                         	}
+	                                                         	// The shapes of the queried body are never reported
+	                                                         	if (    _shape != null
+	                                                         	     && _candidate->getBody() == _shape->getBody()) {
+	                                                         		return;
+	                                                         	}
+	                                                         	float lowerBound = computeAABBDistance(queryAABB, _candidateAABB);
+	                                                         	if (lowerBound <= _maxDistance) {
+	                                                         		candidates.pushBack(etk::makePair(lowerBound, _candidate));
+	                                                         	}
+	                                                         });
+	if (candidates.size() == 0) {
+		return false;
+	}
+	// Test the nearest AABBs first to skip the candidates that can not be nearer than the current result
+	candidates.sort(0,
+	                candidates.size()-1,
+	                [](const etk::Pair<float, ProxyShape*>& _candidate1, const etk::Pair<float, ProxyShape*>& _candidate2) {
+	                	return _candidate1.first < _candidate2.first;
+	                });
+	bool isFound = false;
+	DistanceInfo candidateDistanceInfo;
+	for (auto &it: candidates) {
+		if (    isFound == true
+		     && it.first >= _distanceInfo.distance) {
+			break;
+		}
+		if (computeShapesDistance(m_narrowPhaseGJKAlgorithm,
+		                          it.second->getScaledCollisionShape(), it.second->getLocalToWorldTransform(),
+		                          queryShape, queryTransform,
+		                          candidateDistanceInfo) == false) {
+			continue;
+		}
+		if (candidateDistanceInfo.distance > _maxDistance) {
+			continue;
+		}
+		if (    isFound == false
+		     || candidateDistanceInfo.distance < _distanceInfo.distance) {
+			// The distance is computed from the candidate: swap the result to go from the query to the candidate
+			_distanceInfo.distance = candidateDistanceInfo.distance;
+			_distanceInfo.worldPoint1 = candidateDistanceInfo.worldPoint2;
+			_distanceInfo.worldPoint2 = candidateDistanceInfo.worldPoint1;
+			_distanceInfo.worldNormal = -candidateDistanceInfo.worldNormal;
+			_distanceInfo.proxyShape = it.second;
+			isFound = true;
+		}
+	}
+	return isFound;
+}
+
+namespace {
+	const size_t POINTS_GROUP_SIZE = 64; //!< Number of points of a group tested with the same broad-phase query
+	/// Spread the 10 lowest bits of a value to every third bit (Morton code)
+	uint32_t spreadBits(uint32_t _value) {
+		_value = (_value | (_value << 16)) & 0x030000FF;
+		_value = (_value | (_value << 8)) & 0x0300F00F;
+		_value = (_value | (_value << 4)) & 0x030C30C3;
+		_value = (_value | (_value << 2)) & 0x09249249;
+		return _value;
+	}
+	/// Quantize a coordinate on 10 bits
+	uint32_t quantize(float _value, float _min, float _scale) {
+		return uint32_t(etk::min(1023.0f, etk::max(0.0f, (_value - _min) * _scale)));
+	}
+}
+
+void CollisionDetection::testPointsInside(const vec3* _points,
+                                          size_t _nbPoints,
+                                          CollisionBody** _bodies,
+                                          uint64_t _categoryMaskBits) const {
+	PROFILE("CollisionDetection::testPointsInside()");
+	if (_nbPoints == 0) {
+		return;
+	}
+	vec3 minimum = _points[0];
+	vec3 maximum = _points[0];
+	for (size_t iii=0; iii<_nbPoints; ++iii) {
+		_bodies[iii] = null;
+		minimum.setValue(etk::min(minimum.x(), _points[iii].x()), etk::min(minimum.y(), _points[iii].y()), etk::min(minimum.z(), _points[iii].z()));
+		maximum.setValue(etk::max(maximum.x(), _points[iii].x()), etk::max(maximum.y(), _points[iii].y()), etk::max(maximum.z(), _points[iii].z()));
+	}
+	// Sort the points along a Morton curve: the consecutive points are spatially grouped
+	vec3 extent = maximum - minimum;
+	vec3 scale(1023.0f / etk::max(extent.x(), FLT_EPSILON),
+	           1023.0f / etk::max(extent.y(), FLT_EPSILON),
+	           1023.0f / etk::max(extent.z(), FLT_EPSILON));
+	etk::Vector<etk::Pair<uint32_t, uint32_t>> sortedPoints;
+	sortedPoints.reserve(_nbPoints);
+	for (size_t iii=0; iii<_nbPoints; ++iii) {
+		uint32_t code =   spreadBits(quantize(_points[iii].x(), minimum.x(), scale.x()))
+		                | (spreadBits(quantize(_points[iii].y(), minimum.y(), scale.y())) << 1)
+		                | (spreadBits(quantize(_points[iii].z(), minimum.z(), scale.z())) << 2);
+		sortedPoints.pushBack(etk::makePair(code, uint32_t(iii)));
+	}
+	sortedPoints.sort(0,
+	                  sortedPoints.size()-1,
+	                  [](const etk::Pair<uint32_t, uint32_t>& _point1, const etk::Pair<uint32_t, uint32_t>& _point2) {
+	                  	return _point1.first < _point2.first;
+	                  });
+	vec3 localPoints[POINTS_GROUP_SIZE];
+	uint32_t pointIndices[POINTS_GROUP_SIZE];
+	bool isInside[POINTS_GROUP_SIZE];
+	for (size_t groupStart=0; groupStart<_nbPoints; groupStart+=POINTS_GROUP_SIZE) {
+		size_t groupEnd = etk::min(groupStart + POINTS_GROUP_SIZE, _nbPoints);
+		// One broad-phase query for all the points of the group
+		AABB groupAABB(_points[sortedPoints[groupStart].second], _points[sortedPoints[groupStart].second]);
+		for (size_t iii=groupStart+1; iii<groupEnd; ++iii) {
+			const vec3& point = _points[sortedPoints[iii].second];
+			groupAABB.mergeWithAABB(AABB(point, point));
+		}
+		m_broadPhaseAlgorithm.reportAllShapesOverlappingWithAABB(groupAABB, [&](ProxyShape* _shape, const AABB& _shapeAABB) mutable {
+		                                                         	if (    (_shape->getCollisionCategoryBits() & _categoryMaskBits) == 0
+		                                                         	     || _shape->getBody()->isActive() == false) {
+		                                                         		return;
+		                                                         	}
+		                                                         	// Test in one batch the points of the group inside the AABB of the shape and not classified yet
+		                                                         	const simd::Transform worldToLocal(_shape->getLocalToWorldTransform().getInverse());
+		                                                         	size_t nbLocalPoints = 0;
+		                                                         	for (size_t iii=groupStart; iii<groupEnd; ++iii) {
+		                                                         		uint32_t pointIndex = sortedPoints[iii].second;
+		                                                         		if (    _bodies[pointIndex] != null
+		                                                         		     || _shapeAABB.contains(_points[pointIndex]) == false) {
+		                                                         			continue;
+		                                                         		}
+		                                                         		localPoints[nbLocalPoints] = worldToLocal * _points[pointIndex];
+		                                                         		pointIndices[nbLocalPoints] = pointIndex;
+		                                                         		++nbLocalPoints;
+		                                                         	}
+		                                                         	if (nbLocalPoints == 0) {
+		                                                         		return;
+		                                                         	}
+		                                                         	_shape->testLocalPointsInside(localPoints, nbLocalPoints, isInside);
+		                                                         	for (size_t iii=0; iii<nbLocalPoints; ++iii) {
+		                                                         		if (isInside[iii] == true) {
+		                                                         			_bodies[pointIndices[iii]] = _shape->getBody();
+		                                                         		}
+		                                                         	}
+		                                                         });
+	}
+}
+
 bool CollisionDetection::testAABBOverlap(const ProxyShape* _shape1, const ProxyShape* _shape2) const {
 	// If one of the shape's body is not active, we return no overlap
 	if (    !_shape1->getBody()->isActive()
@@ -14,6 +14,8 @@
 #include <ephysics/engine/EventListener.hpp>
 #include <ephysics/collision/narrowphase/DefaultCollisionDispatch.hpp>
 #include <ephysics/constraint/ContactPoint.hpp>
+#include <ephysics/collision/DistanceInfo.hpp>
+#include <ephysics/collision/shapes/ConcaveShape.hpp>
 #include <etk/Vector.hpp>
 #include <etk/Map.hpp>
 #include <etk/Set.hpp>
@@ -38,6 +40,60 @@ namespace ephysics {
 			                           const ContactPointInfo& _contactInfo);
 	};
 	
+	/**
+	 * @brief Narrow-phase callback that only records if a contact has been found
+	 * (used for the trigger shapes that do not need the contact points).
+	 */
+	class TestTriggerOverlapCallback : public NarrowPhaseCallback {
+		private:
+			bool m_isOverlapping; //!< True if a contact has been found
+		public:
+			// Constructor
+			TestTriggerOverlapCallback():
+			  m_isOverlapping(false) {
+				
+			}
+			// Called by a narrow-phase collision algorithm when a new contact has been found
+			virtual void notifyContact(OverlappingPair* /*_overlappingPair*/,
+			                           const ContactPointInfo& /*_contactInfo*/) {
+				m_isOverlapping = true;
+			}
+			/// Return true if a contact has been found
+			bool isOverlapping() const {
+				return m_isOverlapping;
+			}
+	};
+	
+	/**
+	 * @brief Triangle callback that tests the overlap of a convex shape with the triangles of a
+	 * concave shape with the boolean GJK test (used for the trigger shapes: no EPA, no contact
+	 * point). The remaining triangles are skipped once an overlap has been found.
+	 */
+	class TestTriggerTriangleOverlapCallback : public TriangleCallback {
+		private:
+			GJKAlgorithm& m_gjkAlgorithm; //!< GJK algorithm used for the boolean test
+			const CollisionShapeInfo& m_convexShapeInfo; //!< Convex shape tested against the triangles
+			const CollisionShapeInfo& m_concaveShapeInfo; //!< Concave shape that reports its triangles
+			bool m_isOverlapping; //!< True if an overlapping triangle has been found
+		public:
+			// Constructor
+			TestTriggerTriangleOverlapCallback(GJKAlgorithm& _gjkAlgorithm,
+			                                   const CollisionShapeInfo& _convexShapeInfo,
+			                                   const CollisionShapeInfo& _concaveShapeInfo):
+			  m_gjkAlgorithm(_gjkAlgorithm),
+			  m_convexShapeInfo(_convexShapeInfo),
+			  m_concaveShapeInfo(_concaveShapeInfo),
+			  m_isOverlapping(false) {
+				
+			}
+			/// Test the overlap of a triangle of the concave shape with the convex shape
+			void testTriangle(const vec3* _trianglePoints) override;
+			/// Return true if an overlapping triangle has been found
+			bool isOverlapping() const {
+				return m_isOverlapping;
+			}
+	};
+	
 	/**
 	 * @brief It computes the collision detection algorithms. We first
 	 * perform a broad-phase algorithm to know which pairs of bodies can
@@ -57,6 +113,15 @@ namespace ephysics {
 			GJKAlgorithm m_narrowPhaseGJKAlgorithm; //!< Narrow-phase GJK algorithm
 			etk::Set<bodyindexpair> m_noCollisionPairs; //!< Set of pair of bodies that cannot collide between each other
 			bool m_isCollisionShapesAdded; //!< True if some collision shapes have been added previously
+			bool m_isContactPairEventsEnabled; //!< True if the contact pair events are computed
+			float m_contactBeginImpulseThreshold; //!< Minimum normal impulse of a pair to report a BEGIN event
+			float m_contactPersistImpulseThreshold; //!< Minimum normal impulse of a pair to report a PERSIST event
+			etk::Vector<ContactPairEvent> m_contactPairEvents; //!< Contact pair events of the last step
+			etk::Vector<ContactPairEvent> m_pendingContactPairEvents; //!< END events of the pairs destroyed since the last report
+			etk::Vector<TriggerEvent> m_triggerEvents; //!< Trigger events of the last step
+			etk::Vector<TriggerEvent> m_pendingTriggerEvents; //!< EXIT events of the trigger pairs destroyed since the last report
+			uint64_t m_layerCollisionMatrix[NB_COLLISION_LAYERS]; //!< For each layer, bits mask of the layers it can collide with
+			uint32_t m_collisionFilterVersion; //!< Incremented each time a collision filter changes (the existing pairs are checked again)
 			/// Private copy-constructor
 			CollisionDetection(const CollisionDetection& _collisionDetection);
 			/// Private assignment operator
@@ -74,6 +139,16 @@ namespace ephysics {
 			void fillInCollisionMatrix();
 			/// Add all the contact manifold of colliding pairs to their bodies
 			void addAllContactManifoldsToBodies();
+			/// Report the END/EXIT event of an overlapping pair that will be destroyed (if needed)
+			void reportDestroyedPairContactEvent(OverlappingPair* _pair);
+			/// Create a trigger event for an overlapping pair
+			static TriggerEvent createTriggerEvent(const OverlappingPair* _pair, TriggerEvent::Type _type);
+			/// Test if the shapes of a trigger pair overlap (without computing the contact points)
+			bool testTriggerOverlap(NarrowPhaseAlgorithm* _narrowPhaseAlgorithm,
+			                        const CollisionShapeInfo& _shape1Info,
+			                        const CollisionShapeInfo& _shape2Info);
+			/// Compute the contact pair events of the step (after the contact impulses are stored)
+			void computeContactPairEvents();
 		public :
 			/// Constructor
 			CollisionDetection(CollisionWorld* _world);
@@ -93,6 +168,23 @@ namespace ephysics {
 			                               const AABB& _aabb,
 			                               const vec3& _displacement = vec3(0, 0, 0),
 			                               bool _forceReinsert = false);
+			/**
+			 * @brief Test if the collision filters allow a collision between two shapes
+			 * (body, ignore group, layer collision matrix and category/mask bits)
+			 * @param[in] _shape1 First proxy shape
+			 * @param[in] _shape2 Second proxy shape
+			 * @return true if the two shapes can collide
+			 */
+			bool testCollisionFilter(const ProxyShape* _shape1, const ProxyShape* _shape2) const;
+			/// Notify that a collision filter of a shape has changed: the existing pairs are
+			/// checked again and the shape is tested again in the broad-phase
+			void notifyCollisionFilterChanged(ProxyShape* _shape);
+			/// Set whether two collision layers can collide with each other
+			void setLayersCollision(uint32_t _layer1, uint32_t _layer2, bool _canCollide);
+			/// Return true if two collision layers can collide with each other
+			bool canLayersCollide(uint32_t _layer1, uint32_t _layer2) const {
+				return (m_layerCollisionMatrix[_layer1] & (uint64_t(1) << _layer2)) != 0;
+			}
 			/// Add a pair of bodies that cannot collide with each other
 			void addNoCollisionPair(CollisionBody* _body1, CollisionBody* _body2);
 			/// Remove a pair of bodies that cannot collide with each other
@@ -101,8 +193,22 @@ namespace ephysics {
 			/// We simply put the shape in the list of collision shape that have moved in the
 			/// previous frame so that it is tested for collision again in the broad-phase.
 			void askForBroadPhaseCollisionCheck(ProxyShape* _shape);
+			/// Start a bulk insertion of proxy shapes in the broad-phase
+			void beginBulkInsertion() {
+				m_broadPhaseAlgorithm.beginBulkInsertion();
+			}
+			/// End a bulk insertion of proxy shapes (the broad-phase trees are built in one pass)
+			void endBulkInsertion() {
+				m_broadPhaseAlgorithm.endBulkInsertion();
+			}
 			/// Compute the collision detection
 			void computeCollisionDetection();
+			/// Translate the broad-phase AABBs and the world-space points of the cached contacts
+			void translateWorldSpace(const vec3& _translation);
+			/// Save the broad-phase and the overlapping pairs with their contact manifolds (see DynamicsWorld::saveState())
+			void saveState(etk::Vector<uint8_t>& _buffer) const;
+			/// Restore the broad-phase and the overlapping pairs saved with saveState() (no event is reported)
+			void restoreState(const uint8_t*& _data);
 			/// Compute the collision detection
 			void testCollisionBetweenShapes(CollisionCallback* _callback,
 			                                const etk::Set<uint32_t>& _shapes1,
@@ -114,7 +220,20 @@ namespace ephysics {
 			/// Ray casting method
 			void raycast(RaycastCallback* _raycastCallback,
 			             const Ray& _ray,
-			             unsigned short _raycastWithCategoryMaskBits) const;
+			             uint64_t _raycastWithCategoryMaskBits) const;
+			/// Compute the distance between two proxy shapes (see CollisionWorld::computeDistance())
+			bool computeDistance(const ProxyShape* _shape1, const ProxyShape* _shape2, DistanceInfo& _distanceInfo) const;
+			/// Find the proxy shape nearest to a proxy shape or to a point if _shape is null (see CollisionWorld::findNearest())
+			bool findNearest(const ProxyShape* _shape,
+			                 const vec3& _point,
+			                 float _maxDistance,
+			                 DistanceInfo& _distanceInfo,
+			                 uint64_t _categoryMaskBits) const;
+			/// Find the body containing each point of an array (see CollisionWorld::testPointsInside())
+			void testPointsInside(const vec3* _points,
+			                      size_t _nbPoints,
+			                      CollisionBody** _bodies,
+			                      uint64_t _categoryMaskBits) const;
 			/// Test if the AABBs of two bodies overlap
 			bool testAABBOverlap(const CollisionBody* _body1,
 			                     const CollisionBody* _body2) const;
@@ -7,9 +7,23 @@
  * @license MPL v2.0 (see license file)
  */
 #include <ephysics/collision/ContactManifold.hpp>
+#include <ephysics/mathematics/simd.hpp>
 
 using namespace ephysics;
 
+ContactManifold::ContactManifold():
+  m_shape1(null),
+  m_shape2(null),
+  m_normalDirectionId(0),
+  m_nbContactPoints(0),
+  m_frictionImpulse1(0.0),
+  m_frictionImpulse2(0.0),
+  m_frictionTwistImpulse(0.0),
+  m_rollingResistanceImpulse(0, 0, 0),
+  m_isAlreadyInIsland(false) {
+	
+}
+
 ContactManifold::ContactManifold(ProxyShape* _shape1,
                                  ProxyShape* _shape2,
                                  short _normalDirectionId):
@@ -20,6 +34,7 @@ ContactManifold::ContactManifold(ProxyShape* _shape1,
   m_frictionImpulse1(0.0),
   m_frictionImpulse2(0.0),
   m_frictionTwistImpulse(0.0),
+  m_rollingResistanceImpulse(0, 0, 0),
   m_isAlreadyInIsland(false) {
 	
 }
@@ -28,15 +43,28 @@ ContactManifold::~ContactManifold() {
 	clear();
 }
 
-void ContactManifold::addContactPoint(ContactPoint* contact) {
+void ContactManifold::addContactPoint(const ContactPointInfo& _contactInfo, const ContactPoint* _previousContact) {
+	ContactPoint contact(_contactInfo);
+	if (contact.getFeatureId() != 0) {
+		// The same features are already in contact: refresh the geometry and keep the warm starting impulses
+		for (uint32_t iii=0; iii<m_nbContactPoints; ++iii) {
+			if (m_contactPoints[iii].hasSameFeatures(contact) == true) {
+				contact.copyCachedImpulses(m_contactPoints[iii]);
+				m_contactPoints[iii] = contact;
+				return;
+			}
+		}
+		if (_previousContact != null) {
+			contact.copyCachedImpulses(*_previousContact);
+		}
+	}
 	// For contact already in the manifold
 	for (uint32_t i=0; i<m_nbContactPoints; i++) {
 		// Check if the new point point does not correspond to a same contact point
 		// already in the manifold.
-		float distance = (m_contactPoints[i]->getWorldPointOnBody1() - contact->getWorldPointOnBody1()).length2();
+		float distance = (m_contactPoints[i].getWorldPointOnBody1() - contact.getWorldPointOnBody1()).length2();
 		if (distance <= PERSISTENT_CONTACT_DIST_THRESHOLD*PERSISTENT_CONTACT_DIST_THRESHOLD) {
-			// Delete the new contact
-			ETK_DELETE(ContactPoint, contact);
+			// Drop the new contact
 			assert(m_nbContactPoints > 0);
 			return;
 		}
@@ -44,7 +72,7 @@ void ContactManifold::addContactPoint(ContactPoint* contact) {
 	// If the contact manifold is full
 	if (m_nbContactPoints == MAX_CONTACT_POINTS_IN_MANIFOLD) {
 		int32_t indexMaxPenetration = getIndexOfDeepestPenetration(contact);
-		int32_t indexToRemove = getIndexToRemove(indexMaxPenetration, contact->getLocalPointOnBody1());
+		int32_t indexToRemove = getIndexToRemove(indexMaxPenetration, contact.getLocalPointOnBody1());
 		removeContactPoint(indexToRemove);
 	}
 	// Add the new contact point in the manifold
@@ -56,59 +84,77 @@ void ContactManifold::addContactPoint(ContactPoint* contact) {
 void ContactManifold::removeContactPoint(uint32_t index) {
 	assert(index < m_nbContactPoints);
 	assert(m_nbContactPoints > 0);
-	// Call the destructor explicitly and tell the memory allocator that
-	// the corresponding memory block is now free
-	ETK_DELETE(ContactPoint, m_contactPoints[index]);
-	m_contactPoints[index] = null;
-	// If we don't remove the last index
+	// If we don't remove the last index, move the last contact in the free slot
 	if (index < m_nbContactPoints - 1) {
 		m_contactPoints[index] = m_contactPoints[m_nbContactPoints - 1];
 	}
 	m_nbContactPoints--;
 }
 
-void ContactManifold::update(const etk::Transform3D& transform1, const etk::Transform3D& transform2) {
+void ContactManifold::update(const etk::Transform3D& transform1,
+                             const etk::Transform3D& transform2,
+                             ContactPoint* _removedContactPoints,
+                             uint32_t& _nbRemovedContactPoints) {
 	if (m_nbContactPoints == 0) {
 		return;
 	}
-	// Update the world coordinates and penetration depth of the contact points in the manifold
+	// Update the world coordinates and penetration depth of the contact points in the manifold (the
+	// local points are gathered to be transformed at once)
+	vec3 pointsOnBody1[MAX_CONTACT_POINTS_IN_MANIFOLD];
+	vec3 pointsOnBody2[MAX_CONTACT_POINTS_IN_MANIFOLD];
 	for (uint32_t i=0; i<m_nbContactPoints; i++) {
-		m_contactPoints[i]->setWorldPointOnBody1(transform1 * m_contactPoints[i]->getLocalPointOnBody1());
-		m_contactPoints[i]->setWorldPointOnBody2(transform2 * m_contactPoints[i]->getLocalPointOnBody2());
-		m_contactPoints[i]->setPenetrationDepth((m_contactPoints[i]->getWorldPointOnBody1() - m_contactPoints[i]->getWorldPointOnBody2()).dot(m_contactPoints[i]->getNormal()));
+		pointsOnBody1[i] = m_contactPoints[i].getLocalPointOnBody1();
+		pointsOnBody2[i] = m_contactPoints[i].getLocalPointOnBody2();
+	}
+	simd::transformPoints(simd::Transform(transform1), pointsOnBody1, pointsOnBody1, m_nbContactPoints);
+	simd::transformPoints(simd::Transform(transform2), pointsOnBody2, pointsOnBody2, m_nbContactPoints);
+	for (uint32_t i=0; i<m_nbContactPoints; i++) {
+		m_contactPoints[i].setWorldPointOnBody1(pointsOnBody1[i]);
+		m_contactPoints[i].setWorldPointOnBody2(pointsOnBody2[i]);
+		m_contactPoints[i].setPenetrationDepth((m_contactPoints[i].getWorldPointOnBody1() - m_contactPoints[i].getWorldPointOnBody2()).dot(m_contactPoints[i].getNormal()));
 	}
 	const float squarePersistentContactThreshold = PERSISTENT_CONTACT_DIST_THRESHOLD * PERSISTENT_CONTACT_DIST_THRESHOLD;
 	// Remove the contact points that don't represent very well the contact manifold
 	for (int32_t i=static_cast<int32_t>(m_nbContactPoints)-1; i>=0; i--) {
 		assert(i < static_cast<int32_t>(m_nbContactPoints));
 		// Compute the distance between contact points in the normal direction
-		float distanceNormal = -m_contactPoints[i]->getPenetrationDepth();
+		float distanceNormal = -m_contactPoints[i].getPenetrationDepth();
 		// If the contacts points are too far from each other in the normal direction
 		if (distanceNormal > squarePersistentContactThreshold) {
-			removeContactPoint(i);
+			removeDriftedContactPoint(i, _removedContactPoints, _nbRemovedContactPoints);
 		} else {
 			// Compute the distance of the two contact points in the plane
 			// orthogonal to the contact normal
-			vec3 projOfPoint1 = m_contactPoints[i]->getWorldPointOnBody1() + m_contactPoints[i]->getNormal() * distanceNormal;
-			vec3 projDifference = m_contactPoints[i]->getWorldPointOnBody2() - projOfPoint1;
+			vec3 projOfPoint1 = m_contactPoints[i].getWorldPointOnBody1() + m_contactPoints[i].getNormal() * distanceNormal;
+			vec3 projDifference = m_contactPoints[i].getWorldPointOnBody2() - projOfPoint1;
 			// If the orthogonal distance is larger than the valid distance
 			// threshold, we remove the contact
 			if (projDifference.length2() > squarePersistentContactThreshold) {
-				removeContactPoint(i);
+				removeDriftedContactPoint(i, _removedContactPoints, _nbRemovedContactPoints);
 			}
 		}
 	}
 }
 
-int32_t ContactManifold::getIndexOfDeepestPenetration(ContactPoint* newContact) const {
+void ContactManifold::removeDriftedContactPoint(uint32_t _index, ContactPoint* _removedContactPoints, uint32_t& _nbRemovedContactPoints) {
+	// Keep the contact between known features: the narrow-phase can report them again at their new position
+	if (    _removedContactPoints != null
+	     && m_contactPoints[_index].getFeatureId() != 0) {
+		_removedContactPoints[_nbRemovedContactPoints] = m_contactPoints[_index];
+		_nbRemovedContactPoints++;
+	}
+	removeContactPoint(_index);
+}
+
+int32_t ContactManifold::getIndexOfDeepestPenetration(const ContactPoint& newContact) const {
 	assert(m_nbContactPoints == MAX_CONTACT_POINTS_IN_MANIFOLD);
 	int32_t indexMaxPenetrationDepth = -1;
-	float maxPenetrationDepth = newContact->getPenetrationDepth();
+	float maxPenetrationDepth = newContact.getPenetrationDepth();
 	// For each contact in the cache
 	for (uint32_t i=0; i<m_nbContactPoints; i++) {
 		// If the current contact has a larger penetration depth
-		if (m_contactPoints[i]->getPenetrationDepth() > maxPenetrationDepth) {
-			maxPenetrationDepth = m_contactPoints[i]->getPenetrationDepth();
+		if (m_contactPoints[i].getPenetrationDepth() > maxPenetrationDepth) {
+			maxPenetrationDepth = m_contactPoints[i].getPenetrationDepth();
 			indexMaxPenetrationDepth = i;
 		}
 	}
@@ -124,29 +170,29 @@ int32_t ContactManifold::getIndexToRemove(int32_t indexMaxPenetration, const vec
 	float area3 = 0.0f; // Area with contact 0,1,2 and newPoint
 	if (indexMaxPenetration != 0) {
 		// Compute the area
-		vec3 vector1 = newPoint - m_contactPoints[1]->getLocalPointOnBody1();
-		vec3 vector2 = m_contactPoints[3]->getLocalPointOnBody1() - m_contactPoints[2]->getLocalPointOnBody1();
+		vec3 vector1 = newPoint - m_contactPoints[1].getLocalPointOnBody1();
+		vec3 vector2 = m_contactPoints[3].getLocalPointOnBody1() - m_contactPoints[2].getLocalPointOnBody1();
 		vec3 crossProduct = vector1.cross(vector2);
 		area0 = crossProduct.length2();
 	}
 	if (indexMaxPenetration != 1) {
 		// Compute the area
-		vec3 vector1 = newPoint - m_contactPoints[0]->getLocalPointOnBody1();
-		vec3 vector2 = m_contactPoints[3]->getLocalPointOnBody1() - m_contactPoints[2]->getLocalPointOnBody1();
+		vec3 vector1 = newPoint - m_contactPoints[0].getLocalPointOnBody1();
+		vec3 vector2 = m_contactPoints[3].getLocalPointOnBody1() - m_contactPoints[2].getLocalPointOnBody1();
 		vec3 crossProduct = vector1.cross(vector2);
 		area1 = crossProduct.length2();
 	}
 	if (indexMaxPenetration != 2) {
 		// Compute the area
-		vec3 vector1 = newPoint - m_contactPoints[0]->getLocalPointOnBody1();
-		vec3 vector2 = m_contactPoints[3]->getLocalPointOnBody1() - m_contactPoints[1]->getLocalPointOnBody1();
+		vec3 vector1 = newPoint - m_contactPoints[0].getLocalPointOnBody1();
+		vec3 vector2 = m_contactPoints[3].getLocalPointOnBody1() - m_contactPoints[1].getLocalPointOnBody1();
 		vec3 crossProduct = vector1.cross(vector2);
 		area2 = crossProduct.length2();
 	}
 	if (indexMaxPenetration != 3) {
 		// Compute the area
-		vec3 vector1 = newPoint - m_contactPoints[0]->getLocalPointOnBody1();
-		vec3 vector2 = m_contactPoints[2]->getLocalPointOnBody1() - m_contactPoints[1]->getLocalPointOnBody1();
+		vec3 vector1 = newPoint - m_contactPoints[0].getLocalPointOnBody1();
+		vec3 vector2 = m_contactPoints[2].getLocalPointOnBody1() - m_contactPoints[1].getLocalPointOnBody1();
 		vec3 crossProduct = vector1.cross(vector2);
 		area3 = crossProduct.length2();
 	}
@@ -182,13 +228,6 @@ int32_t ContactManifold::getMaxArea(float area0, float area1, float area2, float
 
 // Clear the contact manifold
 void ContactManifold::clear() {
-	for (uint32_t iii=0; iii<m_nbContactPoints; ++iii) {
-		
-		// Call the destructor explicitly and tell the memory allocator that
-		// the corresponding memory block is now free
-		ETK_DELETE(ContactPoint, m_contactPoints[iii]);
-		m_contactPoints[iii] = null;
-	}
 	m_nbContactPoints = 0;
 }
 
@@ -272,15 +311,26 @@ void ContactManifold::setFrictionTwistImpulse(float frictionTwistImpulse) {
 	m_frictionTwistImpulse = frictionTwistImpulse;
 }
 
+// Return the accumulated rolling resistance impulse
+const vec3& ContactManifold::getRollingResistanceImpulse() const {
+	return m_rollingResistanceImpulse;
+}
+
 // Set the accumulated rolling resistance impulse
 void ContactManifold::setRollingResistanceImpulse(const vec3& rollingResistanceImpulse) {
 	m_rollingResistanceImpulse = rollingResistanceImpulse;
 }
 
 // Return a contact point of the manifold
-ContactPoint* ContactManifold::getContactPoint(uint32_t index) const {
+ContactPoint* ContactManifold::getContactPoint(uint32_t index) {
+	assert(index < m_nbContactPoints);
+	return &m_contactPoints[index];
+}
+
+// Return a contact point of the manifold
+const ContactPoint* ContactManifold::getContactPoint(uint32_t index) const {
 	assert(index < m_nbContactPoints);
-	return m_contactPoints[index];
+	return &m_contactPoints[index];
 }
 
 // Return true if the contact manifold has already been added int32_to an island
@@ -292,7 +342,7 @@ bool ContactManifold::isAlreadyInIsland() const {
 vec3 ContactManifold::getAverageContactNormal() const {
 	vec3 averageNormal;
 	for (uint32_t i=0; i<m_nbContactPoints; i++) {
-		averageNormal += m_contactPoints[i]->getNormal();
+		averageNormal += m_contactPoints[i].getNormal();
 	}
 	return averageNormal.safeNormalized();
 }
@@ -301,7 +351,7 @@ vec3 ContactManifold::getAverageContactNormal() const {
 float ContactManifold::getLargestContactDepth() const {
 	float largestDepth = 0.0f;
 	for (uint32_t i=0; i<m_nbContactPoints; i++) {
-		float depth = m_contactPoints[i]->getPenetrationDepth();
+		float depth = m_contactPoints[i].getPenetrationDepth();
 		if (depth > largestDepth) {
 			largestDepth = depth;
 		}
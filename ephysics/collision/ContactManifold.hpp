@@ -50,20 +50,22 @@ namespace ephysics {
 	 */
 	class ContactManifold {
 		public:
+			/// Constructor of an empty manifold (manifolds are stored by value in the ContactManifoldSet)
+			ContactManifold();
 			/// Constructor
 			ContactManifold(ProxyShape* _shape1,
 			                ProxyShape* _shape2,
 			                int16_t _normalDirectionId);
 			/// Destructor
 			~ContactManifold();
-			/// DELETE copy-constructor
-			ContactManifold(const ContactManifold& _contactManifold) = delete;
-			/// DELETE assignment operator
-			ContactManifold& operator=(const ContactManifold& _contactManifold) = delete;
+			/// Copy-constructor
+			ContactManifold(const ContactManifold& _contactManifold) = default;
+			/// Assignment operator
+			ContactManifold& operator=(const ContactManifold& _contactManifold) = default;
 		private:
 			ProxyShape* m_shape1; //!< Pointer to the first proxy shape of the contact
 			ProxyShape* m_shape2; //!< Pointer to the second proxy shape of the contact
-			ContactPoint* m_contactPoints[MAX_CONTACT_POINTS_IN_MANIFOLD]; //!< Contact points in the manifold
+			ContactPoint m_contactPoints[MAX_CONTACT_POINTS_IN_MANIFOLD]; //!< Contact points in the manifold (stored inline)
 			int16_t m_normalDirectionId; //!< Normal direction Id (Unique Id representing the normal direction)
 			uint32_t m_nbContactPoints; //!< Number of contacts in the cache
 			vec3 m_frictionVector1; //!< First friction vector of the contact manifold
@@ -81,7 +83,7 @@ namespace ephysics {
 			 * This corresponding contact will be kept in the cache. The method returns -1 is
 			 * the new contact is the deepest.
 			 */
-			int32_t getIndexOfDeepestPenetration(ContactPoint* _newContact) const;
+			int32_t getIndexOfDeepestPenetration(const ContactPoint& _newContact) const;
 			/**
 			 * @brief Return the index that will be removed.
 			 * The index of the contact point with the larger penetration
@@ -97,6 +99,8 @@ namespace ephysics {
 			int32_t getIndexToRemove(int32_t _indexMaxPenetration, const vec3& _newPoint) const;
 			/// Remove a contact point from the manifold
 			void removeContactPoint(uint32_t _index);
+			/// Remove a contact point that does not represent the contact anymore (it is appended to _removedContactPoints if it has a feature ID)
+			void removeDriftedContactPoint(uint32_t _index, ContactPoint* _removedContactPoints, uint32_t& _nbRemovedContactPoints);
 			/// Return true if the contact manifold has already been added int32_to an island
 			bool isAlreadyInIsland() const;
 		public:
@@ -110,8 +114,15 @@ namespace ephysics {
 			CollisionBody* getBody2() const;
 			/// Return the normal direction Id
 			int16_t getNormalDirectionId() const;
-			/// Add a contact point to the manifold
-			void addContactPoint(ContactPoint* _contact);
+			/**
+			 * @brief Add a contact point to the manifold.
+			 *
+			 * A contact with a feature ID replaces the contact of the same features already in the manifold
+			 * (new geometry, same cached impulses) even if it has moved beyond the persistent threshold.
+			 * @param[in] _contactInfo Contact computed by the narrow-phase
+			 * @param[in] _previousContact Contact of the same features removed by the last update (its cached impulses are kept), or null
+			 */
+			void addContactPoint(const ContactPointInfo& _contactInfo, const ContactPoint* _previousContact = null);
 			/**
 			 * @brief Update the contact manifold.
 			 * 
@@ -120,9 +131,15 @@ namespace ephysics {
 			 * with a negative penetration depth (meaning that the bodies are not penetrating anymore) and also
 			 * the contacts with a too large distance between the contact points in the plane orthogonal to the
 			 * contact normal.
+			 * @param[in] _transform1 Local to world transform of the first shape
+			 * @param[in] _transform2 Local to world transform of the second shape
+			 * @param[out] _removedContactPoints Removed contact points with a feature ID are appended here (null to ignore them)
+			 * @param[in,out] _nbRemovedContactPoints Number of contact points in _removedContactPoints
 			 */
 			void update(const etk::Transform3D& _transform1,
-			            const etk::Transform3D& _transform2);
+			            const etk::Transform3D& _transform2,
+			            ContactPoint* _removedContactPoints,
+			            uint32_t& _nbRemovedContactPoints);
 			/// Clear the contact manifold
 			void clear();
 			/// Return the number of contact points in the manifold
@@ -147,10 +164,14 @@ namespace ephysics {
 			float getFrictionTwistImpulse() const;
 			/// Set the friction twist accumulated impulse
 			void setFrictionTwistImpulse(float _frictionTwistImpulse);
+			/// Return the accumulated rolling resistance impulse
+			const vec3& getRollingResistanceImpulse() const;
 			/// Set the accumulated rolling resistance impulse
 			void setRollingResistanceImpulse(const vec3& _rollingResistanceImpulse);
 			/// Return a contact point of the manifold
-			ContactPoint* getContactPoint(uint32_t _index) const;
+			ContactPoint* getContactPoint(uint32_t _index);
+			/// Return a contact point of the manifold
+			const ContactPoint* getContactPoint(uint32_t _index) const;
 			/// Return the normalized averaged normal vector
 			vec3 getAverageContactNormal() const;
 			/// Return the largest depth of all the contact points
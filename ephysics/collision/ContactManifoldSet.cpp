@@ -7,6 +7,7 @@
  * @license MPL v2.0 (see license file)
  */
 #include <ephysics/collision/ContactManifoldSet.hpp>
+#include <ephysics/engine/StateBuffer.hpp>
 
 using namespace ephysics;
 
@@ -16,7 +17,8 @@ ContactManifoldSet::ContactManifoldSet(ProxyShape* _shape1,
   m_nbMaxManifolds(_nbMaxManifolds),
   m_nbManifolds(0),
   m_shape1(_shape1),
-  m_shape2(_shape2) {
+  m_shape2(_shape2),
+  m_nbRemovedContactPoints(0) {
 	assert(_nbMaxManifolds >= 1);
 }
 
@@ -24,16 +26,18 @@ ContactManifoldSet::~ContactManifoldSet() {
 	clear();
 }
 
-void ContactManifoldSet::addContactPoint(ContactPoint* contact) {
+void ContactManifoldSet::addContactPoint(const ContactPointInfo& _contactInfo) {
 	// Compute an Id corresponding to the normal direction (using a cubemap)
-	int16_t normalDirectionId = computeCubemapNormalId(contact->getNormal());
+	int16_t normalDirectionId = computeCubemapNormalId(_contactInfo.normal);
+	// Contact of the same features that has drifted during the last update (its impulses are kept)
+	const ContactPoint* previousContact = findRemovedContactPoint(_contactInfo);
 	// If there is no contact manifold yet
 	if (m_nbManifolds == 0) {
 		createManifold(normalDirectionId);
-		m_manifolds[0]->addContactPoint(contact);
-		assert(m_manifolds[m_nbManifolds-1]->getNbContactPoints() > 0);
+		m_manifolds[0].addContactPoint(_contactInfo, previousContact);
+		assert(m_manifolds[m_nbManifolds-1].getNbContactPoints() > 0);
 		for (int32_t i=0; i<m_nbManifolds; i++) {
-			assert(m_manifolds[i]->getNbContactPoints() > 0);
+			assert(m_manifolds[i].getNbContactPoints() > 0);
 		}
 		return;
 	}
@@ -45,17 +49,17 @@ void ContactManifoldSet::addContactPoint(ContactPoint* contact) {
 	// If a similar manifold has been found
 	if (similarManifoldIndex != -1) {
 		// Add the contact point to that similar manifold
-		m_manifolds[similarManifoldIndex]->addContactPoint(contact);
-		assert(m_manifolds[similarManifoldIndex]->getNbContactPoints() > 0);
+		m_manifolds[similarManifoldIndex].addContactPoint(_contactInfo, previousContact);
+		assert(m_manifolds[similarManifoldIndex].getNbContactPoints() > 0);
 		return;
 	}
 	// If the maximum number of manifold has not been reached yet
 	if (m_nbManifolds < m_nbMaxManifolds) {
 		// Create a new manifold for the contact point
 		createManifold(normalDirectionId);
-		m_manifolds[m_nbManifolds-1]->addContactPoint(contact);
+		m_manifolds[m_nbManifolds-1].addContactPoint(_contactInfo, previousContact);
 		for (int32_t i=0; i<m_nbManifolds; i++) {
-			assert(m_manifolds[i]->getNbContactPoints() > 0);
+			assert(m_manifolds[i].getNbContactPoints() > 0);
 		}
 		return;
 	}
@@ -63,10 +67,10 @@ void ContactManifoldSet::addContactPoint(ContactPoint* contact) {
 	// manifolds condidates. We need to remove one. We choose to keep the manifolds
 	// with the largest contact depth among their points
 	int32_t smallestDepthIndex = -1;
-	float minDepth = contact->getPenetrationDepth();
+	float minDepth = _contactInfo.penetrationDepth;
 	assert(m_nbManifolds == m_nbMaxManifolds);
 	for (int32_t i=0; i<m_nbManifolds; i++) {
-		float depth = m_manifolds[i]->getLargestContactDepth();
+		float depth = m_manifolds[i].getLargestContactDepth();
 		if (depth < minDepth) {
 			minDepth = depth;
 			smallestDepthIndex = i;
@@ -75,9 +79,7 @@ void ContactManifoldSet::addContactPoint(ContactPoint* contact) {
 	// If we do not want to keep to new manifold (not created yet) with the
 	// new contact point
 	if (smallestDepthIndex == -1) {
-		// Delete the new contact
-		ETK_DELETE(ContactPoint, contact);
-		contact = null;
+		// Drop the new contact
 		return;
 	}
 	assert(smallestDepthIndex >= 0 && smallestDepthIndex < m_nbManifolds);
@@ -85,18 +87,33 @@ void ContactManifoldSet::addContactPoint(ContactPoint* contact) {
 	// the new contact point)
 	removeManifold(smallestDepthIndex);
 	createManifold(normalDirectionId);
-	m_manifolds[m_nbManifolds-1]->addContactPoint(contact);
-	assert(m_manifolds[m_nbManifolds-1]->getNbContactPoints() > 0);
+	m_manifolds[m_nbManifolds-1].addContactPoint(_contactInfo, previousContact);
+	assert(m_manifolds[m_nbManifolds-1].getNbContactPoints() > 0);
 	for (int32_t i=0; i<m_nbManifolds; i++) {
-		assert(m_manifolds[i]->getNbContactPoints() > 0);
+		assert(m_manifolds[i].getNbContactPoints() > 0);
 	}
 	return;
 }
 
+const ContactPoint* ContactManifoldSet::findRemovedContactPoint(const ContactPointInfo& _contactInfo) const {
+	if (_contactInfo.featureId == 0) {
+		return null;
+	}
+	for (uint32_t iii=0; iii<m_nbRemovedContactPoints; ++iii) {
+		const ContactPoint& contact = m_removedContactPoints[iii];
+		if (    contact.getFeatureId() == _contactInfo.featureId
+		     && contact.getChildIndex1() == _contactInfo.childIndex1
+		     && contact.getChildIndex2() == _contactInfo.childIndex2) {
+			return &contact;
+		}
+	}
+	return null;
+}
+
 int32_t ContactManifoldSet::selectManifoldWithSimilarNormal(int16_t normalDirectionId) const {
 	// Return the Id of the manifold with the same normal direction id (if exists)
 	for (int32_t i=0; i<m_nbManifolds; i++) {
-		if (normalDirectionId == m_manifolds[i]->getNormalDirectionId()) {
+		if (normalDirectionId == m_manifolds[i].getNormalDirectionId()) {
 			return i;
 		}
 	}
@@ -135,12 +152,16 @@ int16_t ContactManifoldSet::computeCubemapNormalId(const vec3& normal) const {
 }
 
 void ContactManifoldSet::update() {
+	// The removed contacts are only kept until the next narrow-phase
+	m_nbRemovedContactPoints = 0;
 	for (int32_t i=m_nbManifolds-1; i>=0; i--) {
 		// Update the contact manifold
-		m_manifolds[i]->update(m_shape1->getBody()->getTransform() * m_shape1->getLocalToBodyTransform(),
-							  m_shape2->getBody()->getTransform() * m_shape2->getLocalToBodyTransform());
+		m_manifolds[i].update(m_shape1->getBody()->getTransform() * m_shape1->getLocalToBodyTransform(),
+		                      m_shape2->getBody()->getTransform() * m_shape2->getLocalToBodyTransform(),
+		                      m_removedContactPoints,
+		                      m_nbRemovedContactPoints);
 		// Remove the contact manifold if has no contact points anymore
-		if (m_manifolds[i]->getNbContactPoints() == 0) {
+		if (m_manifolds[i].getNbContactPoints() == 0) {
 			removeManifold(i);
 		}
 	}
@@ -150,21 +171,20 @@ void ContactManifoldSet::clear() {
 	for (int32_t i=m_nbManifolds-1; i>=0; i--) {
 		removeManifold(i);
 	}
+	m_nbRemovedContactPoints = 0;
 	assert(m_nbManifolds == 0);
 }
 
 void ContactManifoldSet::createManifold(int16_t normalDirectionId) {
 	assert(m_nbManifolds < m_nbMaxManifolds);
-	m_manifolds[m_nbManifolds] = ETK_NEW(ContactManifold, m_shape1, m_shape2, normalDirectionId);
+	m_manifolds[m_nbManifolds] = ContactManifold(m_shape1, m_shape2, normalDirectionId);
 	m_nbManifolds++;
 }
 
 void ContactManifoldSet::removeManifold(int32_t index) {
 	assert(m_nbManifolds > 0);
 	assert(index >= 0 && index < m_nbManifolds);
-	// Delete the new contact
-	ETK_DELETE(ContactManifold, m_manifolds[index]);
-	m_manifolds[index] = null;
+	// Keep the manifolds packed at the beginning of the array
 	for (int32_t i=index; (i+1) < m_nbManifolds; i++) {
 		m_manifolds[i] = m_manifolds[i+1];
 	}
@@ -183,15 +203,33 @@ int32_t ContactManifoldSet::getNbContactManifolds() const {
 	return m_nbManifolds;
 }
 
-ContactManifold* ContactManifoldSet::getContactManifold(int32_t index) const {
+ContactManifold* ContactManifoldSet::getContactManifold(int32_t index) {
+	assert(index >= 0 && index < m_nbManifolds);
+	return &m_manifolds[index];
+}
+
+const ContactManifold* ContactManifoldSet::getContactManifold(int32_t index) const {
 	assert(index >= 0 && index < m_nbManifolds);
-	return m_manifolds[index];
+	return &m_manifolds[index];
 }
 
 int32_t ContactManifoldSet::getTotalNbContactPoints() const {
 	int32_t nbPoints = 0;
 	for (int32_t i=0; i<m_nbManifolds; i++) {
-		nbPoints += m_manifolds[i]->getNbContactPoints();
+		nbPoints += m_manifolds[i].getNbContactPoints();
 	}
 	return nbPoints;
 }
+
+void ContactManifoldSet::saveState(etk::Vector<uint8_t>& _buffer) const {
+	// The manifolds and their contact points are stored inline: copy their raw bytes
+	stateBuffer::write(_buffer, m_nbManifolds);
+	stateBuffer::write(_buffer, m_manifolds, m_nbManifolds * sizeof(ContactManifold));
+}
+
+void ContactManifoldSet::restoreState(const uint8_t*& _data) {
+	stateBuffer::read(_data, m_nbManifolds);
+	assert(m_nbManifolds >= 0 && m_nbManifolds <= m_nbMaxManifolds);
+	stateBuffer::read(_data, m_manifolds, m_nbManifolds * sizeof(ContactManifold));
+	m_nbRemovedContactPoints = 0;
+}
@@ -25,7 +25,9 @@ namespace ephysics {
 			int32_t m_nbManifolds; //!< Current number of contact manifolds in the set
 			ProxyShape* m_shape1; //!< Pointer to the first proxy shape of the contact
 			ProxyShape* m_shape2; //!< Pointer to the second proxy shape of the contact
-			ContactManifold* m_manifolds[MAX_MANIFOLDS_IN_CONTACT_MANIFOLD_SET]; //!< Contact manifolds of the set
+			ContactManifold m_manifolds[MAX_MANIFOLDS_IN_CONTACT_MANIFOLD_SET]; //!< Contact manifolds of the set (stored contiguously)
+			ContactPoint m_removedContactPoints[MAX_MANIFOLDS_IN_CONTACT_MANIFOLD_SET * MAX_CONTACT_POINTS_IN_MANIFOLD]; //!< Contact points with a feature ID removed by the last update (warm starting of the same features)
+			uint32_t m_nbRemovedContactPoints; //!< Number of contact points in m_removedContactPoints
 			/// Create a new contact manifold and add it to the set
 			void createManifold(short _normalDirectionId);
 			/// Remove a contact manifold from the set
@@ -36,6 +38,8 @@ namespace ephysics {
 			// Each face of the cube is divided int32_to 4x4 buckets. This method maps the
 			// normal vector int32_to of the of the bucket and returns a unique Id for the bucket
 			int16_t computeCubemapNormalId(const vec3& _normal) const;
+			/// Return the contact point of the same features removed by the last update (null if none)
+			const ContactPoint* findRemovedContactPoint(const ContactPointInfo& _contactInfo) const;
 		public:
 			/// Constructor
 			ContactManifoldSet(ProxyShape* _shape1,
@@ -48,7 +52,7 @@ namespace ephysics {
 			/// Return the second proxy shape
 			ProxyShape* getShape2() const;
 			/// Add a contact point to the manifold set
-			void addContactPoint(ContactPoint* _contact);
+			void addContactPoint(const ContactPointInfo& _contactInfo);
 			/// Update the contact manifolds
 			void update();
 			/// Clear the contact manifold set
@@ -56,9 +60,15 @@ namespace ephysics {
 			/// Return the number of manifolds in the set
 			int32_t getNbContactManifolds() const;
 			/// Return a given contact manifold
-			ContactManifold* getContactManifold(int32_t _index) const;
+			ContactManifold* getContactManifold(int32_t _index);
+			/// Return a given contact manifold
+			const ContactManifold* getContactManifold(int32_t _index) const;
 			/// Return the total number of contact points in the set of manifolds
 			int32_t getTotalNbContactPoints() const;
+			/// Save the contact manifolds of the set (see DynamicsWorld::saveState())
+			void saveState(etk::Vector<uint8_t>& _buffer) const;
+			/// Restore the contact manifolds saved with saveState()
+			void restoreState(const uint8_t*& _data);
 	};
 
 }
@@ -0,0 +1,32 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/math/Vector3D.hpp>
+
+namespace ephysics {
+	class ProxyShape;
+	/**
+	 * @brief It contains the result of a distance query (closest points between two shapes or
+	 * between a point and a shape). The distance is computed between the shapes enlarged with
+	 * their collision margins (the shapes used for the collision detection).
+	 * When the two shapes overlap, the distance is 0 and the witness points are only an
+	 * approximation (no penetration depth is computed).
+	 */
+	struct DistanceInfo {
+		float distance; //!< Distance between the two shapes (0 if they overlap)
+		vec3 worldPoint1; //!< Closest point of the first shape (the query point for a point query) in world-space coordinates
+		vec3 worldPoint2; //!< Closest point of the second shape (the nearest shape for findNearest()) in world-space coordinates
+		vec3 worldNormal; //!< Unit vector from worldPoint1 to worldPoint2 in world-space coordinates
+		ProxyShape* proxyShape; //!< Nearest proxy shape (only set by findNearest())
+		/// Constructor
+		DistanceInfo() :
+		  distance(0.0f),
+		  proxyShape(null) {
+
+		}
+	};
+}
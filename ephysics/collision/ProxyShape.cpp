@@ -7,6 +7,9 @@
  * @license MPL v2.0 (see license file)
  */
 #include <ephysics/collision/ProxyShape.hpp>
+#include <ephysics/engine/CollisionWorld.hpp>
+#include <ephysics/collision/shapes/ScaledShape.hpp>
+#include <ephysics/debug.hpp>
 
 using namespace ephysics;
 
@@ -18,10 +21,12 @@ using namespace ephysics;
  * @param mass Mass of the collision shape (in kilograms)
  */
 ProxyShape::ProxyShape(CollisionBody* body, CollisionShape* shape, const etk::Transform3D& transform, float mass)
-		   :m_body(body), m_collisionShape(shape), m_localToBodyTransform(transform), m_mass(mass),
+		   :m_body(body), m_collisionShape(shape), m_localScaling(1.0f, 1.0f, 1.0f), m_scaledCollisionShape(null),
+			m_localToBodyTransform(transform), m_mass(mass),
 			m_next(NULL), m_broadPhaseID(-1), m_cachedCollisionData(NULL), m_userData(NULL),
-			m_collisionCategoryBits(0x0001), m_collideWithMaskBits(0xFFFF) {
-
+			m_collisionCategoryBits(0x0001), m_collideWithMaskBits(0xFFFFFFFFFFFFFFFFULL),
+			m_collisionLayer(0), m_isTrigger(false) {
+	m_collisionShape->prepareQueries();
 }
 
 // Destructor
@@ -30,6 +35,9 @@ ProxyShape::~ProxyShape() {
 	if (m_cachedCollisionData != NULL) {
 		free(m_cachedCollisionData);
 	}
+	if (m_scaledCollisionShape != null) {
+		ETK_DELETE(CollisionShape, m_scaledCollisionShape);
+	}
 }
 
 // Return true if a point is inside the collision shape
@@ -40,7 +48,11 @@ ProxyShape::~ProxyShape() {
 bool ProxyShape::testPointInside(const vec3& worldPoint) {
 	const etk::Transform3D localToWorld = m_body->getTransform() * m_localToBodyTransform;
 	const vec3 localPoint = localToWorld.getInverse() * worldPoint;
-	return m_collisionShape->testPointInside(localPoint, this);
+	return getScaledCollisionShape()->testPointInside(localPoint, this);
+}
+
+void ProxyShape::testLocalPointsInside(const vec3* _localPoints, size_t _nbPoints, bool* _isInside) {
+	getScaledCollisionShape()->testPointsInside(_localPoints, _nbPoints, _isInside, this);
 }
 
 // Raycast method with feedback information
@@ -62,7 +74,7 @@ bool ProxyShape::raycast(const Ray& ray, RaycastInfo& raycastInfo) {
 				 worldToLocalTransform * ray.point2,
 				 ray.maxFraction);
 
-	bool isHit = m_collisionShape->raycast(rayLocal, raycastInfo, this);
+	bool isHit = getScaledCollisionShape()->raycast(rayLocal, raycastInfo, this);
 	if (isHit == true) {
 		// Convert the raycast info int32_to world-space
 		raycastInfo.worldPoint = localToWorldTransform * raycastInfo.worldPoint;
@@ -85,6 +97,13 @@ const CollisionShape* ProxyShape::getCollisionShape() const {
 	return m_collisionShape;
 }
 
+const CollisionShape* ProxyShape::getScaledCollisionShape() const {
+	if (m_scaledCollisionShape != null) {
+		return m_scaledCollisionShape;
+	}
+	return m_collisionShape;
+}
+
 // Return the parent body
 /**
  * @return Pointer to the parent body
@@ -166,7 +185,7 @@ const ProxyShape* ProxyShape::getNext() const {
 /**
  * @return The collision category bits mask of the proxy shape
  */
-unsigned short ProxyShape::getCollisionCategoryBits() const {
+uint64_t ProxyShape::getCollisionCategoryBits() const {
 	return m_collisionCategoryBits;
 }
 
@@ -174,15 +193,16 @@ unsigned short ProxyShape::getCollisionCategoryBits() const {
 /**
  * @param collisionCategoryBits The collision category bits mask of the proxy shape
  */
-void ProxyShape::setCollisionCategoryBits(unsigned short collisionCategoryBits) {
+void ProxyShape::setCollisionCategoryBits(uint64_t collisionCategoryBits) {
 	m_collisionCategoryBits = collisionCategoryBits;
+	m_body->m_world.m_collisionDetection.notifyCollisionFilterChanged(this);
 }
 
 // Return the collision bits mask
 /**
  * @return The bits mask that specifies with which collision category this shape will collide
  */
-unsigned short ProxyShape::getCollideWithMaskBits() const {
+uint64_t ProxyShape::getCollideWithMaskBits() const {
 	return m_collideWithMaskBits;
 }
 
@@ -190,8 +210,38 @@ unsigned short ProxyShape::getCollideWithMaskBits() const {
 /**
  * @param collideWithMaskBits The bits mask that specifies with which collision category this shape will collide
  */
-void ProxyShape::setCollideWithMaskBits(unsigned short collideWithMaskBits) {
+void ProxyShape::setCollideWithMaskBits(uint64_t collideWithMaskBits) {
 	m_collideWithMaskBits = collideWithMaskBits;
+	m_body->m_world.m_collisionDetection.notifyCollisionFilterChanged(this);
+}
+
+// Return the collision layer of the shape
+uint32_t ProxyShape::getCollisionLayer() const {
+	return m_collisionLayer;
+}
+
+// Set the collision layer of the shape
+void ProxyShape::setCollisionLayer(uint32_t _layer) {
+	assert(_layer < NB_COLLISION_LAYERS);
+	m_collisionLayer = _layer;
+	m_body->m_world.m_collisionDetection.notifyCollisionFilterChanged(this);
+}
+
+// Return true if the shape is a trigger
+bool ProxyShape::isTrigger() const {
+	return m_isTrigger;
+}
+
+// Set whether the shape is a trigger
+void ProxyShape::setIsTrigger(bool _isTrigger) {
+	if (m_isTrigger == _isTrigger) {
+		return;
+	}
+	m_isTrigger = _isTrigger;
+	// Test again the overlapping pairs of this shape at the next step
+	if (m_broadPhaseID != -1) {
+		m_body->updateProxyShapeInBroadPhase(this, true);
+	}
 }
 
 // Return the local scaling vector of the collision shape
@@ -199,7 +249,7 @@ void ProxyShape::setCollideWithMaskBits(unsigned short collideWithMaskBits) {
  * @return The local scaling vector
  */
 vec3 ProxyShape::getLocalScaling() const {
-	return m_collisionShape->getScaling();
+	return m_localScaling;
 }
 
 // Set the local scaling vector of the collision shape
@@ -207,10 +257,23 @@ vec3 ProxyShape::getLocalScaling() const {
  * @param scaling The new local scaling vector
  */
 void ProxyShape::setLocalScaling(const vec3& scaling) {
-
-	// Set the local scaling of the collision shape
-	m_collisionShape->setLocalScaling(scaling);
-
+	if (m_collisionShape->getType() == COMPOUND) {
+		EPHY_ERROR("A compound shape can not be scaled: scale its child shapes before adding them");
+		return;
+	}
+	m_localScaling = scaling;
+	// Replace the scaled view of the shared collision shape (the shared shape is never modified)
+	if (m_scaledCollisionShape != null) {
+		ETK_DELETE(CollisionShape, m_scaledCollisionShape);
+		m_scaledCollisionShape = null;
+	}
+	if (scaling != vec3(1.0f, 1.0f, 1.0f)) {
+		if (m_collisionShape->isConvex() == true) {
+			m_scaledCollisionShape = ETK_NEW(ScaledConvexShape, static_cast<const ConvexShape*>(m_collisionShape), scaling);
+		} else {
+			m_scaledCollisionShape = ETK_NEW(ScaledConcaveShape, static_cast<const ConcaveShape*>(m_collisionShape), scaling);
+		}
+	}
 	m_body->setIsSleeping(false);
 
 	// Notify the body that the proxy shape has to be updated in the broad-phase
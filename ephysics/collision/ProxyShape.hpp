@@ -24,28 +24,32 @@ namespace  ephysics {
 	class ProxyShape {
 		protected:
 			CollisionBody* m_body; //!< Pointer to the parent body
-			CollisionShape* m_collisionShape; //!< Internal collision shape
+			CollisionShape* m_collisionShape; //!< Internal collision shape (can be shared by many proxy shapes)
+			vec3 m_localScaling; //!< Scaling of the collision shape for this proxy shape only
+			CollisionShape* m_scaledCollisionShape; //!< View of the shared collision shape with the local scaling (null when the proxy is not scaled)
 			etk::Transform3D m_localToBodyTransform; //!< Local-space to parent body-space transform (does not change over time)
 			float m_mass; //!< Mass (in kilogramms) of the corresponding collision shape
 			ProxyShape* m_next; //!< Pointer to the next proxy shape of the body (linked list)
-			int32_t m_broadPhaseID; //!< Broad-phase ID (node ID in the dynamic AABB tree)
+			int32_t m_broadPhaseID; //!< Broad-phase ID (node ID in the AABB tree of the broad-phase, see BroadPhaseAlgorithm)
 			void* m_cachedCollisionData; //!< Cached collision data
 			void* m_userData; //!< Pointer to user data
 			/**
 			 * @brief Bits used to define the collision category of this shape.
 			 * You can set a single bit to one to define a category value for this
-			 * shape. This value is one (0x0001) by default. This variable can be used
+			 * shape (64 categories). This value is one (0x0001) by default. This variable can be used
 			 * together with the m_collideWithMaskBits variable so that given
 			 * categories of shapes collide with each other and do not collide with
 			 * other categories.
 			 */
-			unsigned short m_collisionCategoryBits;
+			uint64_t m_collisionCategoryBits;
 			/**
 			 * @brief Bits mask used to state which collision categories this shape can
-			 * collide with. This value is 0xFFFF by default. It means that this
+			 * collide with. All the bits are set by default. It means that this
 			 * proxy shape will collide with every collision categories by default.
 			 */
-			unsigned short m_collideWithMaskBits;
+			uint64_t m_collideWithMaskBits;
+			uint32_t m_collisionLayer; //!< Collision layer of the shape (checked with the layer collision matrix of the world)
+			bool m_isTrigger; //!< True if the shape is a trigger (overlap detection only, no contact)
 			/// Private copy-constructor
 			ProxyShape(const ProxyShape&) = delete;
 			/// Private assignment operator
@@ -63,6 +67,9 @@ namespace  ephysics {
 			/// Return the collision shape
 			const CollisionShape* getCollisionShape() const;
 	
+			/// Return the collision shape with the local scaling of the proxy applied (the shared collision shape if the proxy is not scaled)
+			const CollisionShape* getScaledCollisionShape() const;
+	
 			/// Return the parent body
 			CollisionBody* getBody() const;
 	
@@ -86,21 +93,49 @@ namespace  ephysics {
 	
 			/// Return true if a point is inside the collision shape
 			bool testPointInside(const vec3& _worldPoint);
+			/**
+			 * @brief Test a batch of points given in the local-space of the proxy shape (see getLocalToWorldTransform())
+			 * @param[in] _localPoints Points to test
+			 * @param[in] _nbPoints Number of points
+			 * @param[out] _isInside True for each point inside the collision shape
+			 */
+			void testLocalPointsInside(const vec3* _localPoints, size_t _nbPoints, bool* _isInside);
 	
 			/// Raycast method with feedback information
 			bool raycast(const Ray& _ray, RaycastInfo& _raycastInfo);
 	
 			/// Return the collision bits mask
-			unsigned short getCollideWithMaskBits() const;
+			uint64_t getCollideWithMaskBits() const;
 	
 			/// Set the collision bits mask
-			void setCollideWithMaskBits(unsigned short _collideWithMaskBits);
+			void setCollideWithMaskBits(uint64_t _collideWithMaskBits);
 	
 			/// Return the collision category bits
-			unsigned short getCollisionCategoryBits() const;
+			uint64_t getCollisionCategoryBits() const;
 	
 			/// Set the collision category bits
-			void setCollisionCategoryBits(unsigned short _collisionCategoryBits);
+			void setCollisionCategoryBits(uint64_t _collisionCategoryBits);
+	
+			/// Return the collision layer of the shape
+			uint32_t getCollisionLayer() const;
+			/**
+			 * @brief Set the collision layer of the shape. Two shapes collide only if their
+			 * layers can collide in the layer collision matrix of the world (all the
+			 * layers collide with each other by default).
+			 * @param[in] _layer Layer of the shape (in [0, NB_COLLISION_LAYERS[, 0 by default)
+			 */
+			void setCollisionLayer(uint32_t _layer);
+	
+			/// Return true if the shape is a trigger
+			bool isTrigger() const;
+			/**
+			 * @brief Set whether the shape is a trigger (sensor).
+			 * A trigger only detects whether it overlaps other shapes (boolean GJK test, no
+			 * penetration depth). It never creates contact points, never links bodies in
+			 * an island and reports ENTER/EXIT trigger events instead of contacts.
+			 * @param[in] _isTrigger True if the shape must be a trigger
+			 */
+			void setIsTrigger(bool _isTrigger);
 	
 			/// Return the next proxy shape in the linked list of proxy shapes
 			ProxyShape* getNext();
@@ -111,10 +146,15 @@ namespace  ephysics {
 			/// Return the pointer to the cached collision data
 			void** getCachedCollisionData();
 	
-			/// Return the local scaling vector of the collision shape
+			/// Return the local scaling vector of the proxy shape
 			vec3 getLocalScaling() const;
-	
-			/// Set the local scaling vector of the collision shape
+			/**
+			 * @brief Set the local scaling of the proxy shape. The collision shape is not modified:
+			 * the scaling is applied on the fly (support points, bounds, raycast and triangles of
+			 * the shared BVH), so one collision shape can be shared by many differently scaled
+			 * proxy shapes. A compound shape can not be scaled.
+			 * @param[in] _scaling Non-uniform scaling (all the components must be strictly positive)
+			 */
 			virtual void setLocalScaling(const vec3& _scaling);
 	
 			friend class OverlappingPair;
@@ -30,12 +30,14 @@ namespace ephysics {
 			float hitFraction; //!< Fraction distance of the hit point between point1 and point2 of the ray. The hit point "p" is such that p = point1 + hitFraction * (point2 - point1)
 			int32_t meshSubpart; //!< Mesh subpart index that has been hit (only used for triangles mesh and -1 otherwise)
 			int32_t triangleIndex; //!< Hit triangle index (only used for triangles mesh and -1 otherwise)
+			int32_t childIndex; //!< Hit child index (only used for compound shape and -1 otherwise)
 			CollisionBody* body; //!< Pointer to the hit collision body
 			ProxyShape* proxyShape; //!< Pointer to the hit proxy collision shape
 			/// Constructor
 			RaycastInfo() :
 			  meshSubpart(-1),
 			  triangleIndex(-1),
+			  childIndex(-1),
 			  body(null),
 			  proxyShape(null) {
 				
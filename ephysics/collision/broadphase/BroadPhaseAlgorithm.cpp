@@ -9,11 +9,20 @@
 #include <ephysics/collision/broadphase/BroadPhaseAlgorithm.hpp>
 #include <ephysics/collision/CollisionDetection.hpp>
 #include <ephysics/engine/Profiler.hpp>
+#include <ephysics/engine/StateBuffer.hpp>
+#include <ephysics/mathematics/mathematics.hpp>
 
 using namespace ephysics;
 
+const int32_t BroadPhaseAlgorithm::STATIC_TREE_ID_FLAG = 0x40000000;
+const int32_t BroadPhaseAlgorithm::STATIC_TREE_MIN_REBUILD_CHANGES = 32;
+
 BroadPhaseAlgorithm::BroadPhaseAlgorithm(CollisionDetection& _collisionDetection):
   m_dynamicAABBTree(DYNAMIC_TREE_AABB_GAP),
+  m_staticAABBTree(0.0f),
+  m_nbStaticShapes(0),
+  m_nbStaticTreeChanges(0),
+  m_isBulkInsertion(false),
   m_collisionDetection(_collisionDetection) {
 	m_movedShapes.reserve(8);
 	m_potentialPairs.reserve(8);
@@ -72,10 +81,20 @@ void BroadPhaseAlgorithm::removeMovedCollisionShape(int32_t _broadPhaseID) {
 }
 
 void BroadPhaseAlgorithm::addProxyCollisionShape(ProxyShape* _proxyShape, const AABB& _aabb) {
-	// Add the collision shape int32_to the dynamic AABB tree and get its broad-phase ID
-	int32_t nodeId = m_dynamicAABBTree.addObject(_aabb, _proxyShape);
-	// Set the broad-phase ID of the proxy shape
-	_proxyShape->m_broadPhaseID = nodeId;
+	if (m_isBulkInsertion == true) {
+		// The shape is added in its tree by endBulkInsertion() (its broad-phase ID stays -1 until then)
+		m_bulkShapes.pushBack(_proxyShape);
+		return;
+	}
+	// Add the collision shape int32_to the AABB tree of its body type and set its broad-phase ID
+	if (_proxyShape->getBody()->getType() == STATIC) {
+		int32_t nodeId = m_staticAABBTree.addObject(_aabb, _proxyShape);
+		_proxyShape->m_broadPhaseID = nodeId | STATIC_TREE_ID_FLAG;
+		m_nbStaticShapes++;
+		m_nbStaticTreeChanges++;
+	} else {
+		_proxyShape->m_broadPhaseID = m_dynamicAABBTree.addObject(_aabb, _proxyShape);
+	}
 	// Add the collision shape int32_to the array of bodies that have moved (or have been created)
 	// during the last simulation step
 	addMovedCollisionShape(_proxyShape->m_broadPhaseID);
@@ -83,11 +102,28 @@ void BroadPhaseAlgorithm::addProxyCollisionShape(ProxyShape* _proxyShape, const
 
 void BroadPhaseAlgorithm::removeProxyCollisionShape(ProxyShape* _proxyShape) {
 	int32_t broadPhaseID = _proxyShape->m_broadPhaseID;
-	// Remove the collision shape from the dynamic AABB tree
-	m_dynamicAABBTree.removeObject(broadPhaseID);
+	if (broadPhaseID == -1) {
+		// Shape added during the current bulk insertion: it is not in a tree yet
+		auto it = m_bulkShapes.begin();
+		while (it != m_bulkShapes.end()) {
+			if (*it == _proxyShape) {
+				it = m_bulkShapes.erase(it);
+			} else {
+				++it;
+			}
+		}
+		return;
+	}
+	// Remove the collision shape from its AABB tree
+	getTree(broadPhaseID).removeObject(getTreeNodeID(broadPhaseID));
+	if (isStaticTreeID(broadPhaseID) == true) {
+		m_nbStaticShapes--;
+		m_nbStaticTreeChanges++;
+	}
 	// Remove the collision shape int32_to the array of shapes that have moved (or have been created)
 	// during the last simulation step
 	removeMovedCollisionShape(broadPhaseID);
+	_proxyShape->m_broadPhaseID = -1;
 }
 
 void BroadPhaseAlgorithm::updateProxyCollisionShape(ProxyShape* _proxyShape,
@@ -95,9 +131,18 @@ void BroadPhaseAlgorithm::updateProxyCollisionShape(ProxyShape* _proxyShape,
                                                     const vec3& _displacement,
                                                     bool _forceReinsert) {
 	int32_t broadPhaseID = _proxyShape->m_broadPhaseID;
+	if (    m_isBulkInsertion == true
+	     && broadPhaseID == -1) {
+		// The AABB of the shape is computed at the end of the bulk insertion
+		return;
+	}
 	assert(broadPhaseID >= 0);
-	// Update the dynamic AABB tree according to the movement of the collision shape
-	bool hasBeenReInserted = m_dynamicAABBTree.updateObject(broadPhaseID, _aabb, _displacement, _forceReinsert);
+	// Update the AABB tree according to the movement of the collision shape
+	bool hasBeenReInserted = getTree(broadPhaseID).updateObject(getTreeNodeID(broadPhaseID), _aabb, _displacement, _forceReinsert);
+	if (    hasBeenReInserted == true
+	     && isStaticTreeID(broadPhaseID) == true) {
+		m_nbStaticTreeChanges++;
+	}
 	// If the collision shape has moved out of its fat AABB (and therefore has been reinserted
 	// int32_to the tree).
 	if (hasBeenReInserted) {
@@ -107,8 +152,101 @@ void BroadPhaseAlgorithm::updateProxyCollisionShape(ProxyShape* _proxyShape,
 	}
 }
 
+void BroadPhaseAlgorithm::beginBulkInsertion() {
+	assert(m_isBulkInsertion == false);
+	m_isBulkInsertion = true;
+	m_bulkShapes.clear();
+}
+
+void BroadPhaseAlgorithm::endBulkInsertion() {
+	PROFILE("BroadPhaseAlgorithm::endBulkInsertion()");
+	assert(m_isBulkInsertion == true);
+	m_isBulkInsertion = false;
+	// Allocate all the nodes at once
+	int32_t nbStaticShapes = 0;
+	for (auto &it: m_bulkShapes) {
+		if (it->getBody()->getType() == STATIC) {
+			nbStaticShapes++;
+		}
+	}
+	m_staticAABBTree.reserve(nbStaticShapes);
+	m_dynamicAABBTree.reserve(m_bulkShapes.size() - nbStaticShapes);
+	m_movedShapes.reserve(m_movedShapes.size() + m_bulkShapes.size());
+	// Add the leaves without building the hierarchy of the trees
+	for (auto &it: m_bulkShapes) {
+		AABB aabb;
+		it->getScaledCollisionShape()->computeAABB(aabb, it->getBody()->getTransform() * it->getLocalToBodyTransform());
+		if (it->getBody()->getType() == STATIC) {
+			it->m_broadPhaseID = m_staticAABBTree.addObjectWithoutInsertion(aabb, it) | STATIC_TREE_ID_FLAG;
+			m_nbStaticShapes++;
+		} else {
+			it->m_broadPhaseID = m_dynamicAABBTree.addObjectWithoutInsertion(aabb, it);
+		}
+		addMovedCollisionShape(it->m_broadPhaseID);
+	}
+	m_bulkShapes.clear();
+	// Build the two trees in one pass (top-down median split)
+	m_dynamicAABBTree.rebuild();
+	m_staticAABBTree.rebuild();
+	m_nbStaticTreeChanges = 0;
+}
+
+void BroadPhaseAlgorithm::reportPotentialPairs(int32_t _broadPhaseID, const AABB& _aabb, const DynamicAABBTree& _tree, int32_t _treeIDFlag) {
+	const ProxyShape* shape = static_cast<const ProxyShape*>(getTree(_broadPhaseID).getNodeDataPointer(getTreeNodeID(_broadPhaseID)));
+	// Ask the AABB tree to report all collision shapes that overlap with this AABB
+	_tree.reportAllShapesOverlappingWithAABB(_aabb, [&](int32_t _nodeId) mutable {
+	                                         	int32_t otherBroadPhaseID = _nodeId | _treeIDFlag;
+	                                         	// If both the nodes are the same, we do not create store the overlapping pair
+	                                         	if (_broadPhaseID == otherBroadPhaseID) {
+	                                         		return;
+	                                         	}
+	                                         	// Filter the pair before it is stored (the filtered pairs never reach the narrow-phase)
+	                                         	const ProxyShape* otherShape = static_cast<const ProxyShape*>(_tree.getNodeDataPointer(_nodeId));
+	                                         	if (m_collisionDetection.testCollisionFilter(shape, otherShape) == false) {
+	                                         		return;
+	                                         	}
+	                                         	// Add the new potential pair int32_to the array of potential overlapping pairs
+	                                         	m_potentialPairs.pushBack(getPairKey(_broadPhaseID, otherBroadPhaseID));
+	                                         });
+}
+
+void BroadPhaseAlgorithm::saveState(etk::Vector<uint8_t>& _buffer) const {
+	m_dynamicAABBTree.saveState(_buffer);
+	m_staticAABBTree.saveState(_buffer);
+	stateBuffer::write(_buffer, m_nbStaticShapes);
+	stateBuffer::write(_buffer, m_nbStaticTreeChanges);
+	int32_t nbMovedShapes = m_movedShapes.size();
+	stateBuffer::write(_buffer, nbMovedShapes);
+	if (nbMovedShapes != 0) {
+		stateBuffer::write(_buffer, m_movedShapes.dataPointer(), nbMovedShapes * sizeof(int32_t));
+	}
+}
+
+void BroadPhaseAlgorithm::restoreState(const uint8_t*& _data) {
+	m_dynamicAABBTree.restoreState(_data);
+	m_staticAABBTree.restoreState(_data);
+	stateBuffer::read(_data, m_nbStaticShapes);
+	stateBuffer::read(_data, m_nbStaticTreeChanges);
+	int32_t nbMovedShapes;
+	stateBuffer::read(_data, nbMovedShapes);
+	m_movedShapes.resize(nbMovedShapes);
+	if (nbMovedShapes != 0) {
+		stateBuffer::read(_data, m_movedShapes.dataPointer(), nbMovedShapes * sizeof(int32_t));
+	}
+}
+
 void BroadPhaseAlgorithm::computeOverlappingPairs() {
 	m_potentialPairs.clear();
+	// The static tree is updated incrementally: it is only rebuilt in bulk when a large batch
+	// of shapes has been added, removed or reinserted since the last step (level streaming)
+	if (m_nbStaticTreeChanges >= etk::max(STATIC_TREE_MIN_REBUILD_CHANGES, m_nbStaticShapes / 4)) {
+		m_staticAABBTree.rebuild();
+	}
+	m_nbStaticTreeChanges = 0;
+	// The query layouts are built before the queries of the step when shapes have been added or removed
+	// (the moved shapes are refitted in the layout of the dynamic tree by updateObject())
+	m_staticAABBTree.updateQueryLayout();
+	m_dynamicAABBTree.updateQueryLayout();
 	// For all collision shapes that have moved (or have been created) during the
 	// last simulation step
 	for (auto &it: m_movedShapes) {
@@ -117,63 +255,43 @@ void BroadPhaseAlgorithm::computeOverlappingPairs() {
 			continue;
 		}
 		// Get the AABB of the shape
-		const AABB& shapeAABB = m_dynamicAABBTree.getFatAABB(it);
-		// Ask the dynamic AABB tree to report all collision shapes that overlap with
-		// this AABB. The method BroadPhase::notifiyOverlappingPair() will be called
-		// by the dynamic AABB tree for each potential overlapping pair.
-		m_dynamicAABBTree.reportAllShapesOverlappingWithAABB(shapeAABB, [&](int32_t _nodeId) mutable {
-		                                                                	// If both the nodes are the same, we do not create store the overlapping pair
-		                                                                	if (it == _nodeId) {
-		                                                                		return;
-		                                                                	}
-		                                                                	// Add the new potential pair int32_to the array of potential overlapping pairs
-		                                                                	m_potentialPairs.pushBack(etk::makePair(etk::min(it, _nodeId), etk::max(it, _nodeId) ));
-		                                                                });
+		const AABB& shapeAABB = getTree(it).getFatAABB(getTreeNodeID(it));
+		// A moved shape is always tested against the dynamic tree, a static shape is never
+		// tested against the static tree (no static-vs-static pair)
+		reportPotentialPairs(it, shapeAABB, m_dynamicAABBTree, 0);
+		if (isStaticTreeID(it) == false) {
+			reportPotentialPairs(it, shapeAABB, m_staticAABBTree, STATIC_TREE_ID_FLAG);
+		}
 	}
 	// Reset the array of collision shapes that have move (or have been created) during the last simulation step
 	m_movedShapes.clear();
-	// Sort the array of potential overlapping pairs in order to remove duplicate pairs
-	m_potentialPairs.sort(0,
-	                      m_potentialPairs.size()-1,
-	                      [](const etk::Pair<int32_t,int32_t>& _pair1, const etk::Pair<int32_t,int32_t>& _pair2) {
-	                      	if (_pair1.first < _pair2.first) {
-	                      		return true;
-	                      	}
-	                      	if (_pair1.first == _pair2.first) {
-	                      		return _pair1.second < _pair2.second;
-	                      	}
-	                      	return false;
-	                      });
+	// Sort the array of potential overlapping pairs in order to remove duplicate pairs (radix
+	// sort of the pair keys: same order as sorting the pairs by first then second ID)
+	m_potentialPairsBuffer.resize(m_potentialPairs.size());
+	radixSort(m_potentialPairs.dataPointer(), m_potentialPairsBuffer.dataPointer(), m_potentialPairs.size());
 	// Check all the potential overlapping pairs avoiding duplicates to report unique
 	// overlapping pairs
-	uint32_t iii=0;
-	while (iii < m_potentialPairs.size()) {
-		// Get a potential overlapping pair
-		const etk::Pair<int32_t,int32_t>& pair = (m_potentialPairs[iii]);
-		++iii;
+	for (size_t iii=0; iii<m_potentialPairs.size(); ++iii) {
+		uint64_t key = m_potentialPairs[iii];
+		// Skip the duplicate overlapping pairs
+		if (    iii > 0
+		     && key == m_potentialPairs[iii-1]) {
+			continue;
+		}
+		int32_t broadPhaseID1 = int32_t(key >> 32);
+		int32_t broadPhaseID2 = int32_t(key & 0xFFFFFFFF);
 		// Get the two collision shapes of the pair
-		ProxyShape* shape1 = static_cast<ProxyShape*>(m_dynamicAABBTree.getNodeDataPointer(pair.first));
-		ProxyShape* shape2 = static_cast<ProxyShape*>(m_dynamicAABBTree.getNodeDataPointer(pair.second));
+		ProxyShape* shape1 = static_cast<ProxyShape*>(getTree(broadPhaseID1).getNodeDataPointer(getTreeNodeID(broadPhaseID1)));
+		ProxyShape* shape2 = static_cast<ProxyShape*>(getTree(broadPhaseID2).getNodeDataPointer(getTreeNodeID(broadPhaseID2)));
 		// Notify the collision detection about the overlapping pair
 		m_collisionDetection.broadPhaseNotifyOverlappingPair(shape1, shape2);
-		// Skip the duplicate overlapping pairs
-		while (iii < m_potentialPairs.size()) {
-			// Get the next pair
-			const etk::Pair<int32_t,int32_t>& nextPair = m_potentialPairs[iii];
-			// If the next pair is different from the previous one, we stop skipping pairs
-			if (    nextPair.first != pair.first
-			     || nextPair.second != pair.second) {
-				break;
-			}
-			++iii;
-		}
 	}
 }
 
 float BroadPhaseRaycastCallback::operator()(int32_t _nodeId, const Ray& _ray) {
 	float hitFraction = float(-1.0);
 	// Get the proxy shape from the node
-	ProxyShape* proxyShape = static_cast<ProxyShape*>(m_dynamicAABBTree.getNodeDataPointer(_nodeId));
+	ProxyShape* proxyShape = static_cast<ProxyShape*>(m_dynamicAABBTree->getNodeDataPointer(_nodeId));
 	// Check if the raycast filtering mask allows raycast against this shape
 	if ((m_raycastWithCategoryMaskBits & proxyShape->getCollisionCategoryBits()) != 0) {
 		// Ask the collision detection to perform a ray cast test against
@@ -181,23 +299,37 @@ float BroadPhaseRaycastCallback::operator()(int32_t _nodeId, const Ray& _ray) {
 		// with the shape in the broad-phase
 		hitFraction = m_raycastTest.raycastAgainstShape(proxyShape, _ray);
 	}
+	if (    hitFraction >= 0.0f
+	     && hitFraction < m_maxFraction) {
+		m_maxFraction = hitFraction;
+	}
 	return hitFraction;
 }
 
 bool BroadPhaseAlgorithm::testOverlappingShapes(const ProxyShape* _shape1,
                                                 const ProxyShape* _shape2) const {
 	// Get the two AABBs of the collision shapes
-	const AABB& aabb1 = m_dynamicAABBTree.getFatAABB(_shape1->m_broadPhaseID);
-	const AABB& aabb2 = m_dynamicAABBTree.getFatAABB(_shape2->m_broadPhaseID);
+	const AABB& aabb1 = getTree(_shape1->m_broadPhaseID).getFatAABB(getTreeNodeID(_shape1->m_broadPhaseID));
+	const AABB& aabb2 = getTree(_shape2->m_broadPhaseID).getFatAABB(getTreeNodeID(_shape2->m_broadPhaseID));
 	// Check if the two AABBs are overlapping
 	return aabb1.testCollision(aabb2);
 }
 
 void BroadPhaseAlgorithm::raycast(const Ray& _ray,
                                   RaycastTest& _raycastTest,
-                                  unsigned short _raycastWithCategoryMaskBits) const {
+                                  uint64_t _raycastWithCategoryMaskBits) const {
 	PROFILE("BroadPhaseAlgorithm::raycast()");
-	BroadPhaseRaycastCallback broadPhaseRaycastCallback(m_dynamicAABBTree, _raycastWithCategoryMaskBits, _raycastTest);
-	m_dynamicAABBTree.raycast(_ray, broadPhaseRaycastCallback);
+	BroadPhaseRaycastCallback broadPhaseRaycastCallback(_raycastWithCategoryMaskBits, _raycastTest, _ray.maxFraction);
+	auto callback = [&](int32_t _nodeId, const Ray& _rayTemp) mutable {
+	                	return broadPhaseRaycastCallback(_nodeId, _rayTemp);
+	                };
+	broadPhaseRaycastCallback.setTree(&m_staticAABBTree);
+	m_staticAABBTree.raycast(_ray, callback);
+	// The dynamic tree is raycasted with the ray clipped by the hits in the static tree
+	if (broadPhaseRaycastCallback.getMaxFraction() == 0.0f) {
+		return;
+	}
+	broadPhaseRaycastCallback.setTree(&m_dynamicAABBTree);
+	m_dynamicAABBTree.raycast(Ray(_ray.point1, _ray.point2, broadPhaseRaycastCallback.getMaxFraction()), callback);
 }
 
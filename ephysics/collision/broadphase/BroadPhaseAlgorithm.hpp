@@ -26,19 +26,29 @@ namespace ephysics {
 	 */
 	class BroadPhaseRaycastCallback {
 		private :
-			const DynamicAABBTree& m_dynamicAABBTree;
-			unsigned short m_raycastWithCategoryMaskBits;
+			const DynamicAABBTree* m_dynamicAABBTree; //!< Tree currently raycasted
+			uint64_t m_raycastWithCategoryMaskBits;
 			RaycastTest& m_raycastTest;
+			float m_maxFraction; //!< Smallest hit fraction returned by the user (to clip the ray in the next tree)
 		public:
 			// Constructor
-			BroadPhaseRaycastCallback(const DynamicAABBTree& _dynamicAABBTree,
-			                          unsigned short _raycastWithCategoryMaskBits,
-			                          RaycastTest& _raycastTest):
-			  m_dynamicAABBTree(_dynamicAABBTree),
+			BroadPhaseRaycastCallback(uint64_t _raycastWithCategoryMaskBits,
+			                          RaycastTest& _raycastTest,
+			                          float _maxFraction):
+			  m_dynamicAABBTree(null),
 			  m_raycastWithCategoryMaskBits(_raycastWithCategoryMaskBits),
-			  m_raycastTest(_raycastTest) {
+			  m_raycastTest(_raycastTest),
+			  m_maxFraction(_maxFraction) {
 				
 			}
+			/// Set the tree to raycast
+			void setTree(const DynamicAABBTree* _dynamicAABBTree) {
+				m_dynamicAABBTree = _dynamicAABBTree;
+			}
+			/// Return the smallest hit fraction returned by the user (0 if the raycast has to stop)
+			float getMaxFraction() const {
+				return m_maxFraction;
+			}
 			// Called for a broad-phase shape that has to be tested for raycast
 			float operator()(int32_t _nodeId, const Ray& _ray);
 	};
@@ -47,19 +57,55 @@ namespace ephysics {
 	 * @brief It represents the broad-phase collision detection. The
 	 * goal of the broad-phase collision detection is to compute the pairs of proxy shapes
 	 * that have their AABBs overlapping. Only those pairs of bodies will be tested
-	 * later for collision during the narrow-phase collision detection. A dynamic AABB
-	 * tree data structure is used for fast broad-phase collision detection.
+	 * later for collision during the narrow-phase collision detection. Two dynamic AABB
+	 * trees are used for fast broad-phase collision detection: one for the shapes of the
+	 * static bodies (tight AABBs, updated incrementally and rebuilt only after a bulk
+	 * insertion or a large batch of changes in one step) and one for the
+	 * shapes of the dynamic and kinematic bodies. The moved shapes of the dynamic tree are
+	 * tested against both trees, the static shapes only against the dynamic tree (no
+	 * static-vs-static pair is ever generated).
 	 */
 	class BroadPhaseAlgorithm {
 		protected :
-			DynamicAABBTree m_dynamicAABBTree; //!< Dynamic AABB tree
+			static const int32_t STATIC_TREE_ID_FLAG; //!< Flag set in the broad-phase ID of the shapes stored in the static tree
+			static const int32_t STATIC_TREE_MIN_REBUILD_CHANGES; //!< Minimum number of changes of the static tree in one step that triggers a rebuild
+			DynamicAABBTree m_dynamicAABBTree; //!< Dynamic AABB tree (shapes of the dynamic and kinematic bodies)
+			DynamicAABBTree m_staticAABBTree; //!< Dynamic AABB tree of the shapes of the static bodies
+			int32_t m_nbStaticShapes; //!< Number of shapes stored in the static tree
+			int32_t m_nbStaticTreeChanges; //!< Number of incremental insertions/removals in the static tree since the last computeOverlappingPairs()
+			bool m_isBulkInsertion; //!< True between beginBulkInsertion() and endBulkInsertion()
+			etk::Vector<ProxyShape*> m_bulkShapes; //!< Shapes added during the bulk insertion (inserted in the trees by endBulkInsertion())
 			etk::Vector<int32_t> m_movedShapes; //!< Array with the broad-phase IDs of all collision shapes that have moved (or have been created) during the last simulation step. Those are the shapes that need to be tested for overlapping in the next simulation step.
-			etk::Vector<etk::Pair<int32_t,int32_t>> m_potentialPairs; //!< Temporary array of potential overlapping pairs (with potential duplicates)
+			etk::Vector<uint64_t> m_potentialPairs; //!< Temporary array of potential overlapping pairs (with potential duplicates), see getPairKey()
+			etk::Vector<uint64_t> m_potentialPairsBuffer; //!< Temporary array used to sort the potential pairs
 			CollisionDetection& m_collisionDetection; //!< Reference to the collision detection object
 			/// Private copy-constructor
 			BroadPhaseAlgorithm(const BroadPhaseAlgorithm& _obj);
 			/// Private assignment operator
 			BroadPhaseAlgorithm& operator=(const BroadPhaseAlgorithm& _obj);
+			/// Return true if a broad-phase ID references a node of the static tree
+			static bool isStaticTreeID(int32_t _broadPhaseID) {
+				return (_broadPhaseID & STATIC_TREE_ID_FLAG) != 0;
+			}
+			/// Return the tree node ID of a broad-phase ID
+			static int32_t getTreeNodeID(int32_t _broadPhaseID) {
+				return _broadPhaseID & ~STATIC_TREE_ID_FLAG;
+			}
+			/// Return the tree that stores a broad-phase ID
+			const DynamicAABBTree& getTree(int32_t _broadPhaseID) const {
+				return isStaticTreeID(_broadPhaseID) == true ? m_staticAABBTree : m_dynamicAABBTree;
+			}
+			/// Return the tree that stores a broad-phase ID
+			DynamicAABBTree& getTree(int32_t _broadPhaseID) {
+				return isStaticTreeID(_broadPhaseID) == true ? m_staticAABBTree : m_dynamicAABBTree;
+			}
+			/// Pack a pair of broad-phase IDs in a key (the smallest ID in the high bits: the keys are sorted as the pairs)
+			static uint64_t getPairKey(int32_t _broadPhaseID1, int32_t _broadPhaseID2) {
+				return   (uint64_t(uint32_t(etk::min(_broadPhaseID1, _broadPhaseID2))) << 32)
+				       | uint64_t(uint32_t(etk::max(_broadPhaseID1, _broadPhaseID2)));
+			}
+			/// Report in the potential pairs all the shapes of a tree overlapping a moved shape
+			void reportPotentialPairs(int32_t _broadPhaseID, const AABB& _aabb, const DynamicAABBTree& _tree, int32_t _treeIDFlag);
 		public :
 			/// Constructor
 			BroadPhaseAlgorithm(CollisionDetection& _collisionDetection);
@@ -80,14 +126,46 @@ namespace ephysics {
 			/// Remove a collision shape from the array of shapes that have moved in the last simulation
 			/// step and that need to be tested again for broad-phase overlapping.
 			void removeMovedCollisionShape(int32_t _broadPhaseID);
+			/**
+			 * @brief Start a bulk insertion: the added shapes are only stored (no tree insertion,
+			 * no rebalancing) until endBulkInsertion(). Their AABB is computed when the bulk ends.
+			 */
+			void beginBulkInsertion();
+			/// End a bulk insertion: add all the stored shapes in the trees and build the trees in one pass
+			void endBulkInsertion();
 			/// Compute all the overlapping pairs of collision shapes
 			void computeOverlappingPairs();
+			/// Translate all the AABBs of the broad-phase (no reinsertion, no new pair)
+			void translate(const vec3& _translation) {
+				m_dynamicAABBTree.translate(_translation);
+				m_staticAABBTree.translate(_translation);
+			}
+			/// Save the two trees and the moved shapes (see DynamicsWorld::saveState())
+			void saveState(etk::Vector<uint8_t>& _buffer) const;
+			/// Restore the two trees and the moved shapes saved with saveState()
+			void restoreState(const uint8_t*& _data);
 			/// Return true if the two broad-phase collision shapes are overlapping
 			bool testOverlappingShapes(const ProxyShape* _shape1, const ProxyShape* _shape2) const;
+			/**
+			 * @brief Report all the proxy shapes of both trees whose AABB overlaps an AABB
+			 * @param[in] _aabb AABB to test (world-space)
+			 * @param[in] _visitor Called with each overlapping shape and its broad-phase AABB: void(ProxyShape* _shape, const AABB& _shapeAABB)
+			 */
+			template<class VISITOR>
+			void reportAllShapesOverlappingWithAABB(const AABB& _aabb, VISITOR&& _visitor) const {
+				m_staticAABBTree.reportAllShapesOverlappingWithAABB(_aabb, [&](int32_t _nodeId) {
+				                                                    	_visitor(static_cast<ProxyShape*>(m_staticAABBTree.getNodeDataPointer(_nodeId)),
+				                                                    	         m_staticAABBTree.getFatAABB(_nodeId));
+				                                                    });
+				m_dynamicAABBTree.reportAllShapesOverlappingWithAABB(_aabb, [&](int32_t _nodeId) {
+				                                                     	_visitor(static_cast<ProxyShape*>(m_dynamicAABBTree.getNodeDataPointer(_nodeId)),
+				                                                     	         m_dynamicAABBTree.getFatAABB(_nodeId));
+				                                                     });
+			}
 			/// Ray casting method
 			void raycast(const Ray& _ray,
 			             RaycastTest& _raycastTest,
-			             unsigned short _raycastWithCategoryMaskBits) const;
+			             uint64_t _raycastWithCategoryMaskBits) const;
 	};
 
 }
@@ -8,8 +8,8 @@
  */
 #include <ephysics/collision/broadphase/DynamicAABBTree.hpp>
 #include <ephysics/collision/broadphase/BroadPhaseAlgorithm.hpp>
-#include <ephysics/memory/Stack.hpp>
 #include <ephysics/engine/Profiler.hpp>
+#include <ephysics/engine/StateBuffer.hpp>
 #include <ephysics/debug.hpp>
 
 using namespace ephysics;
@@ -28,6 +28,8 @@ DynamicAABBTree::~DynamicAABBTree() {
 // Initialize the tree
 void DynamicAABBTree::init() {
 	m_rootNodeID = TreeNode::NULL_TREE_NODE;
+	m_isQueryLayoutValid = false;
+	m_nbQueryLayoutRefits = 0;
 	m_numberNodes = 0;
 	m_numberAllocatedNodes = 8;
 	// Allocate memory for the nodes of the tree
@@ -94,7 +96,7 @@ void DynamicAABBTree::releaseNode(int32_t _nodeID) {
 }
 
 // Internally add an object int32_to the tree
-int32_t DynamicAABBTree::addObjectInternal(const AABB& aabb) {
+int32_t DynamicAABBTree::addObjectInternal(const AABB& aabb, bool _insertInTree) {
 	// Get the next available node (or allocate new ones if necessary)
 	int32_t _nodeID = allocateNode();
 	// Create the fat aabb to use in the tree
@@ -103,14 +105,253 @@ int32_t DynamicAABBTree::addObjectInternal(const AABB& aabb) {
 	m_nodes[_nodeID].aabb.setMax(aabb.getMax() + gap);
 	// Set the height of the node in the tree
 	m_nodes[_nodeID].height = 0;
-	// Insert the new leaf node in the tree
-	insertLeafNode(_nodeID);
+	// Insert the new leaf node in the tree (the bulk loading builds the hierarchy later with rebuild())
+	if (_insertInTree == true) {
+		insertLeafNode(_nodeID);
+	}
 	assert(m_nodes[_nodeID].isLeaf());
 	assert(_nodeID >= 0);
 	// Return the Id of the node
 	return _nodeID;
 }
 
+void DynamicAABBTree::rebuild() {
+	PROFILE("DynamicAABBTree::rebuild()");
+	// Keep the leaves and release all the int32_ternal nodes
+	etk::Vector<int32_t> leaves;
+	leaves.reserve(m_numberNodes / 2 + 1);
+	for (int32_t iii=0; iii<m_numberAllocatedNodes; ++iii) {
+		if (m_nodes[iii].height < 0) {
+			continue;
+		}
+		if (m_nodes[iii].isLeaf() == true) {
+			leaves.pushBack(iii);
+		} else {
+			releaseNode(iii);
+		}
+	}
+	if (leaves.size() == 0) {
+		m_rootNodeID = TreeNode::NULL_TREE_NODE;
+	} else {
+		m_rootNodeID = buildSubTree(leaves, 0, leaves.size());
+		m_nodes[m_rootNodeID].parentID = TreeNode::NULL_TREE_NODE;
+	}
+	buildQueryLayout();
+}
+
+void DynamicAABBTree::translate(const vec3& _translation) {
+	for (int32_t iii=0; iii<m_numberAllocatedNodes; ++iii) {
+		if (m_nodes[iii].height < 0) {
+			continue;
+		}
+		m_nodes[iii].aabb.setMin(m_nodes[iii].aabb.getMin() + _translation);
+		m_nodes[iii].aabb.setMax(m_nodes[iii].aabb.getMax() + _translation);
+	}
+	// The hierarchy does not change: translate the query layout instead of building it again
+	if (m_isQueryLayoutValid == false) {
+		return;
+	}
+	for (size_t iii=0; iii<m_queryNodes.size(); ++iii) {
+		QueryNode& queryNode = m_queryNodes[iii];
+		for (int32_t jjj=0; jjj<4; ++jjj) {
+			if (((queryNode.childrenMask >> jjj) & 0x1) == 0) {
+				continue;
+			}
+			queryNode.minX[jjj] += _translation.x();
+			queryNode.minY[jjj] += _translation.y();
+			queryNode.minZ[jjj] += _translation.z();
+			queryNode.maxX[jjj] += _translation.x();
+			queryNode.maxY[jjj] += _translation.y();
+			queryNode.maxZ[jjj] += _translation.z();
+		}
+	}
+}
+
+void DynamicAABBTree::saveState(etk::Vector<uint8_t>& _buffer) const {
+	stateBuffer::write(_buffer, m_rootNodeID);
+	stateBuffer::write(_buffer, m_freeNodeID);
+	stateBuffer::write(_buffer, m_numberAllocatedNodes);
+	stateBuffer::write(_buffer, m_numberNodes);
+	stateBuffer::write(_buffer, m_nodes, m_numberAllocatedNodes * sizeof(TreeNode));
+}
+
+void DynamicAABBTree::restoreState(const uint8_t*& _data) {
+	int32_t numberAllocatedNodes;
+	stateBuffer::read(_data, m_rootNodeID);
+	stateBuffer::read(_data, m_freeNodeID);
+	stateBuffer::read(_data, numberAllocatedNodes);
+	stateBuffer::read(_data, m_numberNodes);
+	// Only reallocate when the tree has grown (or shrunk) since the state has been saved
+	if (numberAllocatedNodes != m_numberAllocatedNodes) {
+		free(m_nodes);
+		m_numberAllocatedNodes = numberAllocatedNodes;
+		m_nodes = (TreeNode*) malloc(m_numberAllocatedNodes * sizeof(TreeNode));
+		assert(m_nodes);
+	}
+	stateBuffer::read(_data, m_nodes, m_numberAllocatedNodes * sizeof(TreeNode));
+	buildQueryLayout();
+}
+
+void DynamicAABBTree::buildQueryLayout() {
+	PROFILE("DynamicAABBTree::buildQueryLayout()");
+	m_queryNodes.clear();
+	m_queryNodeParents.clear();
+	m_queryLeafSlots.resize(m_numberAllocatedNodes);
+	if (m_rootNodeID != TreeNode::NULL_TREE_NODE) {
+		buildQueryNode(m_rootNodeID);
+	}
+	m_nbQueryLayoutRefits = 0;
+	m_isQueryLayoutValid = true;
+}
+
+int32_t DynamicAABBTree::buildQueryNode(int32_t _nodeID) {
+	// Collapse the highest levels of the sub-tree: replace the child with the largest AABB by its
+	// two children until there are four children (the root of a single leaf tree has one child)
+	int32_t children[4];
+	int32_t nbChildren = 0;
+	if (m_nodes[_nodeID].isLeaf() == true) {
+		children[nbChildren++] = _nodeID;
+	} else {
+		children[nbChildren++] = m_nodes[_nodeID].children[0];
+		children[nbChildren++] = m_nodes[_nodeID].children[1];
+	}
+	while (nbChildren < 4) {
+		int32_t expandedChild = -1;
+		float expandedVolume = -1.0f;
+		for (int32_t iii=0; iii<nbChildren; ++iii) {
+			const TreeNode& node = m_nodes[children[iii]];
+			if (    node.isLeaf() == false
+			     && node.aabb.getVolume() > expandedVolume) {
+				expandedChild = iii;
+				expandedVolume = node.aabb.getVolume();
+			}
+		}
+		if (expandedChild == -1) {
+			break;
+		}
+		int32_t nodeID = children[expandedChild];
+		children[expandedChild] = m_nodes[nodeID].children[0];
+		children[nbChildren++] = m_nodes[nodeID].children[1];
+	}
+	// The children query nodes are appended after their parent (depth first order): the node is
+	// filled after the recursion because the vector can be reallocated
+	int32_t queryNodeID = m_queryNodes.size();
+	m_queryNodes.pushBack(QueryNode());
+	m_queryNodeParents.pushBack(-1);
+	QueryNode queryNode;
+	queryNode.childrenMask = (1 << nbChildren) - 1;
+	for (int32_t iii=0; iii<4; ++iii) {
+		if (iii >= nbChildren) {
+			setQueryNodeChild(queryNode, iii, TreeNode::NULL_TREE_NODE, TreeNode::NULL_TREE_NODE);
+		} else if (m_nodes[children[iii]].isLeaf() == true) {
+			setQueryNodeChild(queryNode, iii, children[iii], children[iii]);
+			m_queryLeafSlots[children[iii]] = 4 * queryNodeID + iii;
+		} else {
+			int32_t childQueryNodeID = buildQueryNode(children[iii]);
+			setQueryNodeChild(queryNode, iii, children[iii], childQueryNodeID);
+			m_queryNodeParents[childQueryNodeID] = 4 * queryNodeID + iii;
+		}
+	}
+	m_queryNodes[queryNodeID] = queryNode;
+	return queryNodeID;
+}
+
+void DynamicAABBTree::refitQueryLeaf(int32_t _nodeID) {
+	int32_t slot = m_queryLeafSlots[_nodeID];
+	AABB aabb = m_nodes[_nodeID].aabb;
+	while (slot != -1) {
+		QueryNode& queryNode = m_queryNodes[slot / 4];
+		const int32_t index = slot % 4;
+		queryNode.minX[index] = aabb.getMin().x();
+		queryNode.minY[index] = aabb.getMin().y();
+		queryNode.minZ[index] = aabb.getMin().z();
+		queryNode.maxX[index] = aabb.getMax().x();
+		queryNode.maxY[index] = aabb.getMax().y();
+		queryNode.maxZ[index] = aabb.getMax().z();
+		// The AABB of the query node in its parent is the union of the AABBs of its children
+		bool isFirstChild = true;
+		for (int32_t iii=0; iii<4; ++iii) {
+			if (((queryNode.childrenMask >> iii) & 0x1) == 0) {
+				continue;
+			}
+			const AABB childAABB(vec3(queryNode.minX[iii], queryNode.minY[iii], queryNode.minZ[iii]),
+			                     vec3(queryNode.maxX[iii], queryNode.maxY[iii], queryNode.maxZ[iii]));
+			if (isFirstChild == true) {
+				aabb = childAABB;
+				isFirstChild = false;
+			} else {
+				aabb.mergeWithAABB(childAABB);
+			}
+		}
+		slot = m_queryNodeParents[slot / 4];
+	}
+	m_nbQueryLayoutRefits++;
+}
+
+void DynamicAABBTree::setQueryNodeChild(QueryNode& _queryNode, int32_t _index, int32_t _nodeID, int32_t _reference) const {
+	if (_nodeID == TreeNode::NULL_TREE_NODE) {
+		_queryNode.minX[_index] = 0.0f;
+		_queryNode.minY[_index] = 0.0f;
+		_queryNode.minZ[_index] = 0.0f;
+		_queryNode.maxX[_index] = 0.0f;
+		_queryNode.maxY[_index] = 0.0f;
+		_queryNode.maxZ[_index] = 0.0f;
+		_queryNode.children[_index] = TreeNode::NULL_TREE_NODE;
+		return;
+	}
+	const TreeNode& node = m_nodes[_nodeID];
+	_queryNode.minX[_index] = node.aabb.getMin().x();
+	_queryNode.minY[_index] = node.aabb.getMin().y();
+	_queryNode.minZ[_index] = node.aabb.getMin().z();
+	_queryNode.maxX[_index] = node.aabb.getMax().x();
+	_queryNode.maxY[_index] = node.aabb.getMax().y();
+	_queryNode.maxZ[_index] = node.aabb.getMax().z();
+	if (node.isLeaf() == true) {
+		_queryNode.children[_index] = QueryNode::encodeLeaf(_nodeID);
+	} else {
+		_queryNode.children[_index] = _reference;
+	}
+}
+
+int32_t DynamicAABBTree::buildSubTree(etk::Vector<int32_t>& _leaves, int32_t _start, int32_t _stop) {
+	if (_stop - _start == 1) {
+		return _leaves[_start];
+	}
+	// Split along the largest axis of the bounds of the leaf centers
+	vec3 center = m_nodes[_leaves[_start]].aabb.getCenter();
+	AABB centerBounds(center, center);
+	for (int32_t iii=_start+1; iii<_stop; ++iii) {
+		center = m_nodes[_leaves[iii]].aabb.getCenter();
+		centerBounds.mergeWithAABB(AABB(center, center));
+	}
+	const vec3 extent = centerBounds.getExtent();
+	int32_t axis = 0;
+	if (extent.y() > extent.x()) {
+		axis = 1;
+	}
+	if (extent.z() > extent[axis]) {
+		axis = 2;
+	}
+	const TreeNode* nodes = m_nodes;
+	_leaves.sort(_start,
+	             _stop-1,
+	             [&](const int32_t& _leaf1, const int32_t& _leaf2) {
+	             	return nodes[_leaf1].aabb.getCenter()[axis] < nodes[_leaf2].aabb.getCenter()[axis];
+	             });
+	int32_t middle = (_start + _stop) / 2;
+	int32_t leftChild = buildSubTree(_leaves, _start, middle);
+	int32_t rightChild = buildSubTree(_leaves, middle, _stop);
+	// Create the parent node (the released int32_ternal nodes are reused: no reallocation)
+	int32_t nodeID = allocateNode();
+	m_nodes[nodeID].children[0] = leftChild;
+	m_nodes[nodeID].children[1] = rightChild;
+	m_nodes[nodeID].aabb.mergeTwoAABBs(m_nodes[leftChild].aabb, m_nodes[rightChild].aabb);
+	m_nodes[nodeID].height = etk::max(m_nodes[leftChild].height, m_nodes[rightChild].height) + 1;
+	m_nodes[leftChild].parentID = nodeID;
+	m_nodes[rightChild].parentID = nodeID;
+	return nodeID;
+}
+
 // Remove an object from the tree
 void DynamicAABBTree::removeObject(int32_t _nodeID) {
 	assert(_nodeID >= 0 && _nodeID < m_numberAllocatedNodes);
@@ -140,7 +381,9 @@ bool DynamicAABBTree::updateObject(int32_t _nodeID, const AABB& _newAABB, const
 	     && m_nodes[_nodeID].aabb.contains(_newAABB)) {
 		return false;
 	}
-	// If the new AABB is outside the fat AABB, we remove the corresponding node
+	// If the new AABB is outside the fat AABB, we remove the corresponding node (the leaf keeps its
+	// place in the query layout: only its AABB changes)
+	const bool isQueryLayoutValid = m_isQueryLayoutValid;
 	removeLeafNode(_nodeID);
 	// Compute the fat AABB by inflating the AABB with a constant gap
 	m_nodes[_nodeID].aabb = _newAABB;
@@ -171,6 +414,10 @@ bool DynamicAABBTree::updateObject(int32_t _nodeID, const AABB& _newAABB, const
 	assert(m_nodes[_nodeID].aabb.contains(_newAABB));
 	// Reinsert the node int32_to the tree
 	insertLeafNode(_nodeID);
+	if (isQueryLayoutValid == true) {
+		refitQueryLeaf(_nodeID);
+		m_isQueryLayoutValid = true;
+	}
 	return true;
 }
 
@@ -178,6 +425,7 @@ bool DynamicAABBTree::updateObject(int32_t _nodeID, const AABB& _newAABB, const
 // in the dynamic tree is described in the book "Introduction to Game Physics
 // with Box2D" by Ian Parberry.
 void DynamicAABBTree::insertLeafNode(int32_t _nodeID) {
+	m_isQueryLayoutValid = false;
 	// If the tree is empty
 	if (m_rootNodeID == TreeNode::NULL_TREE_NODE) {
 		m_rootNodeID = _nodeID;
@@ -285,6 +533,7 @@ void DynamicAABBTree::insertLeafNode(int32_t _nodeID) {
 
 // Remove a leaf node from the tree
 void DynamicAABBTree::removeLeafNode(int32_t _nodeID) {
+	m_isQueryLayoutValid = false;
 	assert(_nodeID >= 0 && _nodeID < m_numberAllocatedNodes);
 	assert(m_nodes[_nodeID].isLeaf());
 	// If we are removing the root node (root node is a leaf in this case)
@@ -469,99 +718,6 @@ int32_t DynamicAABBTree::balanceSubTreeAtNode(int32_t _nodeID) {
 	return _nodeID;
 }
 
-/// Report all shapes overlapping with the AABB given in parameter.
-void DynamicAABBTree::reportAllShapesOverlappingWithAABB(const AABB& _aabb, etk::Function<void(int32_t nodeId)> _callback) const {
-	if (_callback == null) {
-		EPHY_ERROR("call with null callback");
-		return;
-	}
-	// Create a stack with the nodes to visit
-	Stack<int32_t, 64> stack;
-	stack.push(m_rootNodeID);
-	// While there are still nodes to visit
-	while(stack.getNbElements() > 0) {
-		// Get the next node ID to visit
-		int32_t nodeIDToVisit = stack.pop();
-		// Skip it if it is a null node
-		if (nodeIDToVisit == TreeNode::NULL_TREE_NODE) {
-			continue;
-		}
-		// Get the corresponding node
-		const TreeNode* nodeToVisit = m_nodes + nodeIDToVisit;
-		// If the AABB in parameter overlaps with the AABB of the node to visit
-		if (_aabb.testCollision(nodeToVisit->aabb)) {
-			// If the node is a leaf
-			if (nodeToVisit->isLeaf()) {
-				// Notify the broad-phase about a new potential overlapping pair
-				_callback(nodeIDToVisit);
-			} else {
-				// If the node is not a leaf
-				// We need to visit its children
-				stack.push(nodeToVisit->children[0]);
-				stack.push(nodeToVisit->children[1]);
-			}
-		}
-	}
-}
-
-// Ray casting method
-void DynamicAABBTree::raycast(const ephysics::Ray& _ray, etk::Function<float(int32_t _nodeId, const ephysics::Ray& _ray)> _callback) const {
-	PROFILE("DynamicAABBTree::raycast()");
-	if (_callback == null) {
-		EPHY_ERROR("call with null callback");
-		return;
-	}
-	float maxFraction = _ray.maxFraction;
-	Stack<int32_t, 128> stack;
-	stack.push(m_rootNodeID);
-	// Walk through the tree from the root looking for proxy shapes
-	// that overlap with the ray AABB
-	while (stack.getNbElements() > 0) {
-		// Get the next node in the stack
-		int32_t nodeID = stack.pop();
-		// If it is a null node, skip it
-		if (nodeID == TreeNode::NULL_TREE_NODE) {
-			continue;
-		}
-		// Get the corresponding node
-		const TreeNode* node = m_nodes + nodeID;
-		Ray rayTemp(_ray.point1, _ray.point2, maxFraction);
-		// Test if the ray int32_tersects with the current node AABB
-		if (node->aabb.testRayIntersect(rayTemp) == false) {
-			continue;
-		}
-		// If the node is a leaf of the tree
-		if (node->isLeaf()) {
-			// Call the callback that will raycast again the broad-phase shape
-			float hitFraction = _callback(nodeID, rayTemp);
-			// If the user returned a hitFraction of zero, it means that
-			// the raycasting should stop here
-			if (hitFraction == 0.0f) {
-				return;
-			}
-			// If the user returned a positive fraction
-			if (hitFraction > 0.0f) {
-				// We update the maxFraction value and the ray
-				// AABB using the new maximum fraction
-				if (hitFraction < maxFraction) {
-					maxFraction = hitFraction;
-				}
-			}
-			// If the user returned a negative fraction, we continue
-			// the raycasting as if the proxy shape did not exist
-		} else {  // If the node has children
-			// Push its children in the stack of nodes to explore
-			stack.push(node->children[0]);
-			stack.push(node->children[1]);
-		}
-	}
-}
-
-// Return true if the node is a leaf of the tree
-bool TreeNode::isLeaf() const {
-	return (height == 0);
-}
-
 // Return the fat AABB corresponding to a given node ID
 const AABB& DynamicAABBTree::getFatAABB(int32_t nodeID) const {
 	assert(nodeID >= 0 && nodeID < m_numberAllocatedNodes);
@@ -604,6 +760,37 @@ int32_t DynamicAABBTree::addObject(const AABB& aabb, void* data) {
 	return nodeId;
 }
 
+int32_t DynamicAABBTree::addObjectWithoutInsertion(const AABB& _aabb, void* _data) {
+	int32_t nodeId = addObjectInternal(_aabb, false);
+	m_nodes[nodeId].children[0] = TreeNode::NULL_TREE_NODE;
+	m_nodes[nodeId].children[1] = TreeNode::NULL_TREE_NODE;
+	m_nodes[nodeId].dataPointer = _data;
+	return nodeId;
+}
+
+void DynamicAABBTree::reserve(int32_t _nbObjects) {
+	// A tree with N leaves has N-1 internal nodes
+	int32_t nbNeededNodes = m_numberNodes + 2 * _nbObjects;
+	if (nbNeededNodes <= m_numberAllocatedNodes) {
+		return;
+	}
+	int32_t oldNumberAllocatedNodes = m_numberAllocatedNodes;
+	m_numberAllocatedNodes = nbNeededNodes;
+	TreeNode* oldNodes = m_nodes;
+	m_nodes = (TreeNode*) malloc(m_numberAllocatedNodes * sizeof(TreeNode));
+	assert(m_nodes);
+	memcpy(m_nodes, oldNodes, oldNumberAllocatedNodes * sizeof(TreeNode));
+	free(oldNodes);
+	// Add the new nodes in front of the list of free nodes
+	for (int32_t iii=oldNumberAllocatedNodes; iii<m_numberAllocatedNodes - 1; ++iii) {
+		m_nodes[iii].nextNodeID = iii + 1;
+		m_nodes[iii].height = -1;
+	}
+	m_nodes[m_numberAllocatedNodes - 1].nextNodeID = m_freeNodeID;
+	m_nodes[m_numberAllocatedNodes - 1].height = -1;
+	m_freeNodeID = oldNumberAllocatedNodes;
+}
+
 
 #ifdef DEBUG
 
@@ -12,6 +12,10 @@
 #include <ephysics/collision/shapes/AABB.hpp>
 #include <ephysics/body/CollisionBody.hpp>
 #include <etk/Function.hpp>
+#include <etk/Vector.hpp>
+#include <ephysics/debug.hpp>
+#include <ephysics/engine/Profiler.hpp>
+#include <ephysics/mathematics/simd.hpp>
 
 namespace ephysics {
 	// TODO: to replace this, create a Tree<T> template (multiple child) or TreeRedBlack<T>
@@ -41,7 +45,107 @@ namespace ephysics {
 		int16_t height; //!< Height of the node in the tree
 		AABB aabb; //!< Fat axis aligned bounding box (AABB) corresponding to the node
 		/// Return true if the node is a leaf of the tree
-		bool isLeaf() const;
+		bool isLeaf() const {
+			return (height == 0);
+		}
+	};
+	/**
+	 * @brief Node of the query layout of the tree (BVH4): the AABBs of the (up to) four children
+	 * are stored in the parent (structure of arrays) to be tested at once with SIMD instructions.
+	 * The children are the internal nodes of the query layout or the leaves of the tree.
+	 */
+	struct QueryNode {
+		float minX[4]; //!< Minimum x coordinate of the AABB of each child
+		float minY[4]; //!< Minimum y coordinate of the AABB of each child
+		float minZ[4]; //!< Minimum z coordinate of the AABB of each child
+		float maxX[4]; //!< Maximum x coordinate of the AABB of each child
+		float maxY[4]; //!< Maximum y coordinate of the AABB of each child
+		float maxZ[4]; //!< Maximum z coordinate of the AABB of each child
+		int32_t children[4]; //!< Index of the child query node (>= 0) or encoded ID of the leaf of the tree (see encodeLeaf())
+		int32_t childrenMask; //!< Bit N is set when the child N exists
+		/// Encode a leaf node ID of the tree in a child reference
+		static int32_t encodeLeaf(int32_t _nodeID) {
+			return -2 - _nodeID;
+		}
+		/// Decode the leaf node ID of the tree of a child reference
+		static int32_t decodeLeaf(int32_t _child) {
+			return -2 - _child;
+		}
+		/// Return true if the child reference is a leaf of the tree
+		static bool isLeaf(int32_t _child) {
+			return _child < 0;
+		}
+		/**
+		 * @brief Test the four children AABBs against an AABB
+		 * @param[in] _aabb AABB to test
+		 * @return Mask of the children that overlap the AABB (bit N for the child N)
+		 */
+		int32_t testCollision(const AABB& _aabb) const {
+			int32_t mask = childrenMask;
+			mask &= simd::Float4::lessEqualMask(simd::Float4::load(minX), simd::Float4::splat(_aabb.getMax().x()));
+			mask &= simd::Float4::lessEqualMask(simd::Float4::load(minY), simd::Float4::splat(_aabb.getMax().y()));
+			mask &= simd::Float4::lessEqualMask(simd::Float4::load(minZ), simd::Float4::splat(_aabb.getMax().z()));
+			mask &= simd::Float4::lessEqualMask(simd::Float4::splat(_aabb.getMin().x()), simd::Float4::load(maxX));
+			mask &= simd::Float4::lessEqualMask(simd::Float4::splat(_aabb.getMin().y()), simd::Float4::load(maxY));
+			mask &= simd::Float4::lessEqualMask(simd::Float4::splat(_aabb.getMin().z()), simd::Float4::load(maxZ));
+			return mask;
+		}
+	};
+	/**
+	 * @brief Ray prepared for the slab test against the four children AABBs of a query node (the
+	 * inverse of the direction is computed once per ray).
+	 */
+	class TreeRayTest {
+		private:
+			simd::Float4 m_origin[3]; //!< Coordinates of the first point of the ray
+			simd::Float4 m_inverseDirection[3]; //!< Inverse of each component of point2 - point1
+			bool m_isParallel[3]; //!< True when the ray is parallel to the slabs of an axis (null direction component)
+			/// Clip the [_tMin, _tMax] intervals of the ray with the slabs of an axis and return the mask of the children the ray can hit
+			int32_t clipSlabs(int32_t _axis, const float* _min, const float* _max, simd::Float4& _tMin, simd::Float4& _tMax) const {
+				const simd::Float4 min = simd::Float4::load(_min);
+				const simd::Float4 max = simd::Float4::load(_max);
+				// A parallel ray hits the slab if its origin is between the two planes
+				if (m_isParallel[_axis] == true) {
+					return   simd::Float4::lessEqualMask(min, m_origin[_axis])
+					       & simd::Float4::lessEqualMask(m_origin[_axis], max);
+				}
+				const simd::Float4 t1 = (min - m_origin[_axis]) * m_inverseDirection[_axis];
+				const simd::Float4 t2 = (max - m_origin[_axis]) * m_inverseDirection[_axis];
+				_tMin = simd::Float4::max(_tMin, simd::Float4::min(t1, t2));
+				_tMax = simd::Float4::min(_tMax, simd::Float4::max(t1, t2));
+				return 0xF;
+			}
+		public:
+			/// Constructor
+			TreeRayTest(const Ray& _ray) {
+				const vec3 direction = _ray.point2 - _ray.point1;
+				m_origin[0] = simd::Float4::splat(_ray.point1.x());
+				m_origin[1] = simd::Float4::splat(_ray.point1.y());
+				m_origin[2] = simd::Float4::splat(_ray.point1.z());
+				m_isParallel[0] = direction.x() == 0.0f;
+				m_isParallel[1] = direction.y() == 0.0f;
+				m_isParallel[2] = direction.z() == 0.0f;
+				m_inverseDirection[0] = simd::Float4::splat(m_isParallel[0] == true ? 0.0f : 1.0f / direction.x());
+				m_inverseDirection[1] = simd::Float4::splat(m_isParallel[1] == true ? 0.0f : 1.0f / direction.y());
+				m_inverseDirection[2] = simd::Float4::splat(m_isParallel[2] == true ? 0.0f : 1.0f / direction.z());
+			}
+			/**
+			 * @brief Compute the fraction where the ray enters the four children AABBs of a query node
+			 * @param[in] _node Node to test
+			 * @param[in] _maxFraction Maximum fraction of the ray
+			 * @param[out] _entry Entry fraction of the ray in each child AABB (0 if the first point is inside)
+			 * @return Mask of the children hit before _maxFraction (bit N for the child N)
+			 */
+			int32_t computeEntry(const QueryNode& _node, float _maxFraction, float* _entry) const {
+				simd::Float4 tMin = simd::Float4::splat(0.0f);
+				simd::Float4 tMax = simd::Float4::splat(_maxFraction);
+				int32_t mask = _node.childrenMask;
+				mask &= clipSlabs(0, _node.minX, _node.maxX, tMin, tMax);
+				mask &= clipSlabs(1, _node.minY, _node.maxY, tMin, tMax);
+				mask &= clipSlabs(2, _node.minZ, _node.maxZ, tMin, tMax);
+				tMin.store(_entry);
+				return mask & simd::Float4::lessEqualMask(tMin, tMax);
+			}
 	};
 	
 	/**
@@ -52,8 +156,21 @@ namespace ephysics {
 	 * "Introduction to Game Physics with Box2D" by Ian Parberry.
 	 */
 	class DynamicAABBTree {
+		public:
+			static const int32_t MAX_TRAVERSAL_DEPTH = 256; //!< Maximum height of the tree for the traversals
+			static const int32_t TRAVERSAL_STACK_SIZE = 3 * MAX_TRAVERSAL_DEPTH + 1; //!< Size of the fixed stack of the traversals (a query node pushes at most 4 children)
 		private:
-			TreeNode* m_nodes; //!< Pointer to the memory location of the nodes of the tree
+			/// Element of the traversal stack of the raycast
+			struct RaycastItem {
+				int32_t child; //!< Query node or leaf to visit (child reference of a query node)
+				float entry; //!< Fraction where the ray enters the AABB of the child
+			};
+			TreeNode* m_nodes; //!< Pointer to the memory location of the nodes of the tree (used to update the tree, user data of the leaves)
+			etk::Vector<QueryNode> m_queryNodes; //!< Query layout of the tree (root is the first node), built by updateQueryLayout()
+			etk::Vector<int32_t> m_queryNodeParents; //!< Child slot (4 * index of the query node + index of the child) of each query node in its parent (-1 for the root)
+			etk::Vector<int32_t> m_queryLeafSlots; //!< Child slot of each leaf of the tree in the query layout (indexed by the node ID of the leaf)
+			int32_t m_nbQueryLayoutRefits; //!< Number of leaves refitted in the query layout since it has been built
+			bool m_isQueryLayoutValid; //!< False when the tree has been modified since the query layout has been built (the queries traverse the hierarchy of the tree)
 			int32_t m_rootNodeID; //!< ID of the root node of the tree
 			int32_t m_freeNodeID; //!< ID of the first node of the list of free (allocated) nodes in the tree that we can use
 			int32_t m_numberAllocatedNodes; //!< Number of allocated nodes in the tree
@@ -72,9 +189,52 @@ namespace ephysics {
 			/// Compute the height of a given node in the tree
 			int32_t computeHeight(int32_t _nodeID);
 			/// Internally add an object int32_to the tree
-			int32_t addObjectInternal(const AABB& _aabb);
+			int32_t addObjectInternal(const AABB& _aabb, bool _insertInTree = true);
+			/// Build (top-down) the sub-tree of the leaves in the range [_start, _stop[ and return its root node
+			int32_t buildSubTree(etk::Vector<int32_t>& _leaves, int32_t _start, int32_t _stop);
 			/// Initialize the tree
 			void init();
+			/// Build the query layout from the hierarchy of the tree
+			void buildQueryLayout();
+			/// Build (depth first) the query node that contains the (up to) four highest descendants of a node of the tree and return its index
+			int32_t buildQueryNode(int32_t _nodeID);
+			/**
+			 * @brief Update the AABB of a moved leaf in the query layout and the AABBs of the ancestors of its query node. The
+			 * groups of the leaves do not change: the layout is built again by updateQueryLayout() when a lot of leaves have been refitted.
+			 * @param[in] _nodeID Node ID of the leaf (it has to be in the tree when the query layout has been built)
+			 */
+			void refitQueryLeaf(int32_t _nodeID);
+			/// Set the AABB and the reference of a child of a query node from a node of the tree (empty child if the node is null, _reference is the child reference of an internal node)
+			void setQueryNodeChild(QueryNode& _queryNode, int32_t _index, int32_t _nodeID, int32_t _reference) const;
+			/**
+			 * @brief Return the node of the query layout referenced by a child, or a query node filled with the (up to) two
+			 * children of the node of the tree when the query layout is not up to date (the child is then a node ID of the tree)
+			 * @param[in] _child Child reference of an internal node (index of the query node or node ID of the tree)
+			 * @param[out] _hierarchyNode Storage of the query node filled from the hierarchy of the tree
+			 * @return The query node to test
+			 */
+			const QueryNode& getQueryNode(int32_t _child, QueryNode& _hierarchyNode) const {
+				if (m_isQueryLayoutValid == true) {
+					return m_queryNodes[_child];
+				}
+				const TreeNode& node = m_nodes[_child];
+				if (node.isLeaf() == true) {
+					setQueryNodeChild(_hierarchyNode, 0, _child, _child);
+					setQueryNodeChild(_hierarchyNode, 1, TreeNode::NULL_TREE_NODE, TreeNode::NULL_TREE_NODE);
+					_hierarchyNode.childrenMask = 0x1;
+				} else {
+					setQueryNodeChild(_hierarchyNode, 0, node.children[0], node.children[0]);
+					setQueryNodeChild(_hierarchyNode, 1, node.children[1], node.children[1]);
+					_hierarchyNode.childrenMask = 0x3;
+				}
+				setQueryNodeChild(_hierarchyNode, 2, TreeNode::NULL_TREE_NODE, TreeNode::NULL_TREE_NODE);
+				setQueryNodeChild(_hierarchyNode, 3, TreeNode::NULL_TREE_NODE, TreeNode::NULL_TREE_NODE);
+				return _hierarchyNode;
+			}
+			/// Return the child reference of the root of the tree for the traversals
+			int32_t getQueryRoot() const {
+				return m_isQueryLayoutValid == true ? 0 : m_rootNodeID;
+			}
 			#ifndef NDEBUG
 				/// Check if the tree structure is valid (for debugging purpose)
 				void check() const;
@@ -90,6 +250,19 @@ namespace ephysics {
 			int32_t addObject(const AABB& _aabb, int32_t _data1, int32_t _data2);
 			/// Add an object int32_to the tree (where node data is a pointer)
 			int32_t addObject(const AABB& _aabb, void* _data);
+			/**
+			 * @brief Add an object without inserting it in the hierarchy of the tree (bulk loading).
+			 * rebuild() must be called before the next query or update of the tree.
+			 * @param[in] _aabb AABB of the object
+			 * @param[in] _data Data of the node (pointer)
+			 * @return ID of the leaf node of the object
+			 */
+			int32_t addObjectWithoutInsertion(const AABB& _aabb, void* _data);
+			/**
+			 * @brief Allocate the nodes needed by a number of new objects at once (bulk loading)
+			 * @param[in] _nbObjects Number of objects that will be added
+			 */
+			void reserve(int32_t _nbObjects);
 			/// Remove an object from the tree
 			void removeObject(int32_t _nodeID);
 			/// Update the dynamic tree after an object has moved.
@@ -100,16 +273,151 @@ namespace ephysics {
 			int32_t* getNodeDataInt(int32_t _nodeID) const;
 			/// Return the data pointer of a given leaf node of the tree
 			void* getNodeDataPointer(int32_t _nodeID) const;
-			/// Report all shapes overlapping with the AABB given in parameter.
-			void reportAllShapesOverlappingWithAABB(const AABB& _aabb, etk::Function<void(int32_t _nodeId)> _callback) const;
-			/// Ray casting method
-			void raycast(const Ray& _ray, etk::Function<float(int32_t _nodeId, const ephysics::Ray& _ray)> _callback) const;
+			/**
+			 * @brief Build the query layout if objects have been added to or removed from the tree since it has been
+			 * built (the moved objects are refitted by updateObject()), or if the refitted leaves are as many as the
+			 * leaves of the tree (the groups of the layout do not follow the moved objects). It has to be called after
+			 * a batch of modifications: the queries only read the tree (they can be executed from several threads at
+			 * once) and traverse the hierarchy of the tree (two children per node) when the query layout is not up to date.
+			 */
+			void updateQueryLayout() {
+				if (    m_isQueryLayoutValid == false
+				     || m_nbQueryLayoutRefits > m_numberNodes / 2) {
+					buildQueryLayout();
+				}
+			}
+			/// Return true if the query layout is up to date (see updateQueryLayout())
+			bool isQueryLayoutValid() const {
+				return m_isQueryLayoutValid;
+			}
+			/**
+			 * @brief Report all shapes overlapping with the AABB given in parameter. The visitor is a
+			 * template parameter (inlined in the traversal) and the traversal uses a fixed stack
+			 * (no allocation). Each visited query node tests its four children at once.
+			 * @param[in] _aabb AABB to test
+			 * @param[in] _visitor Called with the node ID of each overlapping leaf: void(int32_t _nodeId)
+			 */
+			template<class VISITOR>
+			void reportAllShapesOverlappingWithAABB(const AABB& _aabb, VISITOR&& _visitor) const {
+				if (m_rootNodeID == TreeNode::NULL_TREE_NODE) {
+					return;
+				}
+				// A query node has a lower depth than the matching node of the tree and pushes at most 4 children
+				EPHY_ASSERT(m_nodes[m_rootNodeID].height < MAX_TRAVERSAL_DEPTH, "The tree is too high for the traversal stack");
+				QueryNode hierarchyNode;
+				int32_t stack[TRAVERSAL_STACK_SIZE];
+				int32_t nbElements = 0;
+				stack[nbElements++] = getQueryRoot();
+				while (nbElements > 0) {
+					const QueryNode& node = getQueryNode(stack[--nbElements], hierarchyNode);
+					int32_t mask = node.testCollision(_aabb);
+					for (int32_t iii=0; mask != 0; ++iii, mask >>= 1) {
+						if ((mask & 1) == 0) {
+							continue;
+						}
+						if (QueryNode::isLeaf(node.children[iii]) == true) {
+							_visitor(QueryNode::decodeLeaf(node.children[iii]));
+						} else {
+							stack[nbElements++] = node.children[iii];
+						}
+					}
+				}
+			}
+			/**
+			 * @brief Ray casting method. The children of a node are visited in the order of the
+			 * fraction where the ray enters their AABB (nearest first) and the nodes entered after
+			 * the closest hit returned by the visitor are skipped.
+			 * @param[in] _ray Ray to cast
+			 * @param[in] _visitor Called with the node ID of each leaf hit and the ray clipped with the current closest hit:
+			 *                     float(int32_t _nodeId, const Ray& _ray). It returns the hit fraction (0 to stop the raycast,
+			 *                     a negative value to ignore the leaf)
+			 */
+			template<class VISITOR>
+			void raycast(const Ray& _ray, VISITOR&& _visitor) const {
+				PROFILE("DynamicAABBTree::raycast()");
+				if (m_rootNodeID == TreeNode::NULL_TREE_NODE) {
+					return;
+				}
+				EPHY_ASSERT(m_nodes[m_rootNodeID].height < MAX_TRAVERSAL_DEPTH, "The tree is too high for the traversal stack");
+				QueryNode hierarchyNode;
+				float maxFraction = _ray.maxFraction;
+				const TreeRayTest rayTest(_ray);
+				RaycastItem stack[TRAVERSAL_STACK_SIZE];
+				int32_t nbElements = 0;
+				stack[nbElements].child = getQueryRoot();
+				stack[nbElements].entry = 0.0f;
+				++nbElements;
+				while (nbElements > 0) {
+					const RaycastItem item = stack[--nbElements];
+					// The closest hit may have been found after the child has been pushed
+					if (item.entry > maxFraction) {
+						continue;
+					}
+					if (QueryNode::isLeaf(item.child) == true) {
+						float hitFraction = _visitor(QueryNode::decodeLeaf(item.child), Ray(_ray.point1, _ray.point2, maxFraction));
+						// A null fraction stops the raycast
+						if (hitFraction == 0.0f) {
+							return;
+						}
+						// A negative fraction ignores the leaf
+						if (    hitFraction > 0.0f
+						     && hitFraction < maxFraction) {
+							maxFraction = hitFraction;
+						}
+						continue;
+					}
+					const QueryNode& node = getQueryNode(item.child, hierarchyNode);
+					float entry[4];
+					int32_t mask = rayTest.computeEntry(node, maxFraction, entry);
+					// Sort the children hit by decreasing entry: the nearest child is pushed last to be visited first
+					RaycastItem children[4];
+					int32_t nbChildren = 0;
+					for (int32_t iii=0; mask != 0; ++iii, mask >>= 1) {
+						if ((mask & 1) == 0) {
+							continue;
+						}
+						int32_t jjj = nbChildren++;
+						while (    jjj > 0
+						        && children[jjj-1].entry < entry[iii]) {
+							children[jjj] = children[jjj-1];
+							--jjj;
+						}
+						children[jjj].child = node.children[iii];
+						children[jjj].entry = entry[iii];
+					}
+					for (int32_t iii=0; iii<nbChildren; ++iii) {
+						stack[nbElements++] = children[iii];
+					}
+				}
+			}
 			/// Compute the height of the tree
 			int32_t computeHeight();
 			/// Return the root AABB of the tree
 			AABB getRootAABB() const;
 			/// Clear all the nodes and reset the tree
 			void reset();
+			/**
+			 * @brief Rebuild all the int32_ternal nodes of the tree with a top-down median split of the
+			 * leaves. This is faster to query than the incremental insertion when a lot of objects
+			 * are added at once (static level geometry, mesh triangles). The leaf IDs do not change.
+			 * The query layout is built at the end.
+			 */
+			void rebuild();
+			/**
+			 * @brief Translate all the nodes of the tree (the structure of the tree does not change)
+			 * @param[in] _translation Translation to apply
+			 */
+			void translate(const vec3& _translation);
+			/**
+			 * @brief Save the nodes of the tree (raw copy: the node IDs are kept by a restore)
+			 * @param[in,out] _buffer Buffer where the state is appended
+			 */
+			void saveState(etk::Vector<uint8_t>& _buffer) const;
+			/**
+			 * @brief Restore the nodes of the tree saved with saveState()
+			 * @param[in,out] _data Reading cursor in the state buffer
+			 */
+			void restoreState(const uint8_t*& _data);
 	};
 
 
@@ -0,0 +1,73 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#include <ephysics/collision/narrowphase/CompoundVsShapeAlgorithm.hpp>
+#include <ephysics/collision/CollisionDetection.hpp>
+#include <ephysics/engine/Profiler.hpp>
+
+using namespace ephysics;
+
+CompoundVsShapeAlgorithm::CompoundVsShapeAlgorithm() {
+	
+}
+
+void CompoundVsShapeAlgorithm::testCollision(const CollisionShapeInfo& _shape1Info,
+                                             const CollisionShapeInfo& _shape2Info,
+                                             NarrowPhaseCallback* _callback) {
+	PROFILE("CompoundVsShapeAlgorithm::testCollision()");
+	const CollisionShapeInfo* compoundInfo = &_shape1Info;
+	const CollisionShapeInfo* otherInfo = &_shape2Info;
+	bool isCompoundFirst = true;
+	if (_shape1Info.collisionShape->getType() != COMPOUND) {
+		compoundInfo = &_shape2Info;
+		otherInfo = &_shape1Info;
+		isCompoundFirst = false;
+	}
+	const CompoundShape* compoundShape = static_cast<const CompoundShape*>(compoundInfo->collisionShape);
+	const CollisionShape* otherShape = otherInfo->collisionShape;
+	// Compute the AABB of the other shape in the local-space of the compound shape
+	AABB aabb;
+	otherShape->computeAABB(aabb, compoundInfo->shapeToWorldTransform.getInverse() * otherInfo->shapeToWorldTransform);
+	// Test the other shape against each child overlapping its AABB
+	compoundShape->testAllChildren(aabb, [&](int32_t _childIndex) {
+	                               	const CollisionShape* childShape = compoundShape->getChildShape(_childIndex);
+	                               	NarrowPhaseAlgorithm* algo = m_collisionDetection->getCollisionAlgorithm(childShape->getType(), otherShape->getType());
+	                               	// If there is no collision algorithm between those two kinds of shapes
+	                               	if (algo == null) {
+	                               		return;
+	                               	}
+	                               	algo->setCurrentOverlappingPair(compoundInfo->overlappingPair);
+	                               	// The cached collision data of the proxy belongs to the compound: each child test uses its own
+	                               	void* childCachedCollisionData = null;
+	                               	CollisionShapeInfo childInfo(compoundInfo->proxyShape,
+	                               	                             childShape,
+	                               	                             compoundInfo->shapeToWorldTransform * compoundShape->getChildTransform(_childIndex),
+	                               	                             compoundInfo->overlappingPair,
+	                               	                             &childCachedCollisionData);
+	                               	CompoundChildNarrowPhaseCallback childCallback(_callback, compoundShape, _childIndex, isCompoundFirst);
+	                               	if (isCompoundFirst == true) {
+	                               		algo->testCollision(childInfo, *otherInfo, &childCallback);
+	                               	} else {
+	                               		algo->testCollision(*otherInfo, childInfo, &childCallback);
+	                               	}
+	                               	free(childCachedCollisionData);
+	                               });
+}
+
+void CompoundChildNarrowPhaseCallback::notifyContact(OverlappingPair* _overlappingPair,
+                                                     const ContactPointInfo& _contactInfo) {
+	ContactPointInfo contactInfo(_contactInfo);
+	const etk::Transform3D& childTransform = m_compoundShape->getChildTransform(m_childIndex);
+	if (m_isCompoundFirst == true) {
+		contactInfo.collisionShape1 = m_compoundShape;
+		contactInfo.localPoint1 = childTransform * _contactInfo.localPoint1;
+		contactInfo.childIndex1 = m_childIndex;
+	} else {
+		contactInfo.collisionShape2 = m_compoundShape;
+		contactInfo.localPoint2 = childTransform * _contactInfo.localPoint2;
+		contactInfo.childIndex2 = m_childIndex;
+	}
+	m_narrowPhaseCallback->notifyContact(_overlappingPair, contactInfo);
+}
@@ -0,0 +1,54 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <ephysics/collision/narrowphase/NarrowPhaseAlgorithm.hpp>
+#include <ephysics/collision/shapes/CompoundShape.hpp>
+
+namespace ephysics {
+	/**
+	 * @brief Narrow-phase callback used for the children of a compound shape. It converts
+	 * the contact points from the child local-space to the compound local-space and
+	 * stores the index of the child before forwarding the contact.
+	 */
+	class CompoundChildNarrowPhaseCallback : public NarrowPhaseCallback {
+		private:
+			NarrowPhaseCallback* m_narrowPhaseCallback; //!< Callback of the compound shape
+			const CompoundShape* m_compoundShape; //!< Compound shape
+			int32_t m_childIndex; //!< Index of the child tested
+			bool m_isCompoundFirst; //!< True if the compound is the first shape of the contact
+		public:
+			/// Constructor
+			CompoundChildNarrowPhaseCallback(NarrowPhaseCallback* _narrowPhaseCallback,
+			                                 const CompoundShape* _compoundShape,
+			                                 int32_t _childIndex,
+			                                 bool _isCompoundFirst):
+			  m_narrowPhaseCallback(_narrowPhaseCallback),
+			  m_compoundShape(_compoundShape),
+			  m_childIndex(_childIndex),
+			  m_isCompoundFirst(_isCompoundFirst) {
+				
+			}
+			virtual void notifyContact(OverlappingPair* _overlappingPair, const ContactPointInfo& _contactInfo);
+	};
+
+	/**
+	 * @brief This class is used to compute the narrow-phase collision detection
+	 * between a compound shape and any other shape. The AABB of the other shape is
+	 * used to descend the local tree of the compound and each overlapping child is
+	 * tested with the collision algorithm of its own type (a compound against a
+	 * compound is handled by the recursion through the collision dispatch).
+	 */
+	class CompoundVsShapeAlgorithm : public NarrowPhaseAlgorithm {
+		public :
+			/// Constructor
+			CompoundVsShapeAlgorithm();
+			/// Compute a contact info if the two bounding volume collide
+			virtual void testCollision(const CollisionShapeInfo& _shape1Info,
+			                           const CollisionShapeInfo& _shape2Info,
+			                           NarrowPhaseCallback* _narrowPhaseCallback);
+	};
+}
@@ -21,23 +21,17 @@ ConcaveVsConvexAlgorithm::ConcaveVsConvexAlgorithm() {
 void ConcaveVsConvexAlgorithm::testCollision(const CollisionShapeInfo& _shape1Info,
                                              const CollisionShapeInfo& _shape2Info,
                                              NarrowPhaseCallback* _callback) {
-	ProxyShape* convexProxyShape;
-	ProxyShape* concaveProxyShape;
-	const ConvexShape* convexShape;
-	const ConcaveShape* concaveShape;
-	// Collision shape 1 is convex, collision shape 2 is concave
-	if (_shape1Info.collisionShape->isConvex()) {
-		convexProxyShape = _shape1Info.proxyShape;
-		convexShape = static_cast<const ConvexShape*>(_shape1Info.collisionShape);
-		concaveProxyShape = _shape2Info.proxyShape;
-		concaveShape = static_cast<const ConcaveShape*>(_shape2Info.collisionShape);
-	} else {
-		// Collision shape 2 is convex, collision shape 1 is concave
-		convexProxyShape = _shape2Info.proxyShape;
-		convexShape = static_cast<const ConvexShape*>(_shape2Info.collisionShape);
-		concaveProxyShape = _shape1Info.proxyShape;
-		concaveShape = static_cast<const ConcaveShape*>(_shape1Info.collisionShape);
+	const CollisionShapeInfo* convexShapeInfo = &_shape1Info;
+	const CollisionShapeInfo* concaveShapeInfo = &_shape2Info;
+	// Collision shape 2 is convex, collision shape 1 is concave
+	if (_shape1Info.collisionShape->isConvex() == false) {
+		convexShapeInfo = &_shape2Info;
+		concaveShapeInfo = &_shape1Info;
 	}
+	ProxyShape* convexProxyShape = convexShapeInfo->proxyShape;
+	ProxyShape* concaveProxyShape = concaveShapeInfo->proxyShape;
+	const ConvexShape* convexShape = static_cast<const ConvexShape*>(convexShapeInfo->collisionShape);
+	const ConcaveShape* concaveShape = static_cast<const ConcaveShape*>(concaveShapeInfo->collisionShape);
 	// Set the parameters of the callback object
 	ConvexVsTriangleCallback convexVsTriangleCallback;
 	convexVsTriangleCallback.setCollisionDetection(m_collisionDetection);
@@ -45,9 +39,10 @@ void ConcaveVsConvexAlgorithm::testCollision(const CollisionShapeInfo& _shape1In
 	convexVsTriangleCallback.setConcaveShape(concaveShape);
 	convexVsTriangleCallback.setProxyShapes(convexProxyShape, concaveProxyShape);
 	convexVsTriangleCallback.setOverlappingPair(_shape1Info.overlappingPair);
-	// Compute the convex shape AABB in the local-space of the convex shape
+	convexVsTriangleCallback.setShapesInfo(*convexShapeInfo, *concaveShapeInfo);
+	// Compute the convex shape AABB in the local-space of the concave shape
 	AABB aabb;
-	convexShape->computeAABB(aabb, convexProxyShape->getLocalToWorldTransform());
+	convexShape->computeAABB(aabb, concaveShapeInfo->shapeToWorldTransform.getInverse() * convexShapeInfo->shapeToWorldTransform);
 	// If smooth mesh collision is enabled for the concave mesh
 	if (concaveShape->getIsSmoothMeshCollisionEnabled()) {
 		etk::Vector<SmoothMeshContactInfo> contactPoints;
@@ -56,7 +51,11 @@ void ConcaveVsConvexAlgorithm::testCollision(const CollisionShapeInfo& _shape1In
 		// Call the convex vs triangle callback for each triangle of the concave shape
 		concaveShape->testAllTriangles(convexVsTriangleCallback, aabb);
 		// Run the smooth mesh collision algorithm
-		processSmoothMeshCollision(_shape1Info.overlappingPair, contactPoints, _callback);
+		processSmoothMeshCollision(_shape1Info.overlappingPair,
+		                           contactPoints,
+		                           convexShapeInfo->shapeToWorldTransform,
+		                           concaveShapeInfo->shapeToWorldTransform,
+		                           _callback);
 	} else {
 		convexVsTriangleCallback.setNarrowPhaseCallback(_callback);
 		// Call the convex vs triangle callback for each triangle of the concave shape
@@ -79,12 +78,12 @@ void ConvexVsTriangleCallback::testTriangle(const vec3* _trianglePoints) {
 	// Create the CollisionShapeInfo objects
 	CollisionShapeInfo shapeConvexInfo(m_convexProxyShape,
 	                                   m_convexShape,
-	                                   m_convexProxyShape->getLocalToWorldTransform(),
+	                                   m_convexShapeToWorld,
 	                                   m_overlappingPair,
-	                                   m_convexProxyShape->getCachedCollisionData());
+	                                   m_convexCachedCollisionData);
 	CollisionShapeInfo shapeConcaveInfo(m_concaveProxyShape,
 	                                    &triangleShape,
-	                                    m_concaveProxyShape->getLocalToWorldTransform(),
+	                                    m_concaveShapeToWorld,
 	                                    m_overlappingPair,
 	                                    m_concaveProxyShape->getCachedCollisionData());
 	// Use the collision algorithm to test collision between the triangle and the other convex shape
@@ -93,6 +92,8 @@ void ConvexVsTriangleCallback::testTriangle(const vec3* _trianglePoints) {
 
 void ConcaveVsConvexAlgorithm::processSmoothMeshCollision(OverlappingPair* _overlappingPair,
                                                           etk::Vector<SmoothMeshContactInfo> _contactPoints,
+                                                          const etk::Transform3D& _convexShapeToWorld,
+                                                          const etk::Transform3D& _concaveShapeToWorld,
                                                           NarrowPhaseCallback* _callback) {
 	// Set with the triangle vertices already processed to void further contacts with same triangle
 	etk::Vector<etk::Pair<int32_t, vec3>> processTriangleVertices;
@@ -147,22 +148,13 @@ void ConcaveVsConvexAlgorithm::processSmoothMeshCollision(OverlappingPair* _over
 		} else {
 			// If it is a face contact
 			ContactPointInfo newContactInfo(info.contactInfo);
-			ProxyShape* firstShape;
-			ProxyShape* secondShape;
-			if (info.isFirstShapeTriangle) {
-				firstShape = _overlappingPair->getShape1();
-				secondShape = _overlappingPair->getShape2();
-			} else {
-				firstShape = _overlappingPair->getShape2();
-				secondShape = _overlappingPair->getShape1();
-			}
 			// We use the triangle normal as the contact normal
 			vec3 a = info.triangleVertices[1] - info.triangleVertices[0];
 			vec3 b = info.triangleVertices[2] - info.triangleVertices[0];
 			vec3 localNormal = a.cross(b);
-			newContactInfo.normal = firstShape->getLocalToWorldTransform().getOrientation() * localNormal;
+			newContactInfo.normal = _concaveShapeToWorld.getOrientation() * localNormal;
 			vec3 firstLocalPoint = info.isFirstShapeTriangle ? info.contactInfo.localPoint1 : info.contactInfo.localPoint2;
-			vec3 firstWorldPoint = firstShape->getLocalToWorldTransform() * firstLocalPoint;
+			vec3 firstWorldPoint = _concaveShapeToWorld * firstLocalPoint;
 			newContactInfo.normal.normalize();
 			if (newContactInfo.normal.dot(info.contactInfo.normal) < 0) {
 				newContactInfo.normal = -newContactInfo.normal;
@@ -170,7 +162,7 @@ void ConcaveVsConvexAlgorithm::processSmoothMeshCollision(OverlappingPair* _over
 			// We recompute the contact point on the second body with the new normal as described in
 			// the Smooth Mesh Contacts with GJK of the Game Physics Pearls book (from Gino van Den Bergen and
 			// Dirk Gregorius) to avoid adding torque
-			etk::Transform3D worldToLocalSecondPoint = secondShape->getLocalToWorldTransform().getInverse();
+			etk::Transform3D worldToLocalSecondPoint = _convexShapeToWorld.getInverse();
 			if (info.isFirstShapeTriangle) {
 				vec3 newSecondWorldPoint = firstWorldPoint + newContactInfo.normal;
 				newContactInfo.localPoint2 = worldToLocalSecondPoint * newSecondWorldPoint;
@@ -28,6 +28,9 @@ namespace ephysics {
 			ProxyShape* m_convexProxyShape; //!< Proxy shape of the convex collision shape
 			ProxyShape* m_concaveProxyShape; //!< Proxy shape of the concave collision shape
 			OverlappingPair* m_overlappingPair; //!< Broadphase overlapping pair
+			etk::Transform3D m_convexShapeToWorld; //!< Convex shape local-space to world-space transform
+			etk::Transform3D m_concaveShapeToWorld; //!< Concave shape local-space to world-space transform
+			void** m_convexCachedCollisionData; //!< Cached collision data of the convex shape
 			static bool contactsDepthCompare(const ContactPointInfo& _contact1,
 			                                 const ContactPointInfo& _contact2);
 		public:
@@ -56,6 +59,12 @@ namespace ephysics {
 				m_convexProxyShape = _convexProxyShape;
 				m_concaveProxyShape = _concaveProxyShape;
 			}
+			/// Set the shape to world transforms and the convex cached data (they differ from the proxy ones for a compound child)
+			void setShapesInfo(const CollisionShapeInfo& _convexShapeInfo, const CollisionShapeInfo& _concaveShapeInfo) {
+				m_convexShapeToWorld = _convexShapeInfo.shapeToWorldTransform;
+				m_concaveShapeToWorld = _concaveShapeInfo.shapeToWorldTransform;
+				m_convexCachedCollisionData = _convexShapeInfo.cachedCollisionData;
+			}
 			/// Test collision between a triangle and the convex mesh shape
 			virtual void testTriangle(const vec3* _trianglePoints);
 	};
@@ -127,6 +136,8 @@ namespace ephysics {
 			/// Process the concave triangle mesh collision using the smooth mesh collision algorithm
 			void processSmoothMeshCollision(OverlappingPair* _overlappingPair,
 			                                etk::Vector<SmoothMeshContactInfo> _contactPoints,
+			                                const etk::Transform3D& _convexShapeToWorld,
+			                                const etk::Transform3D& _concaveShapeToWorld,
 			                                NarrowPhaseCallback* _narrowPhaseCallback);
 			/// Add a triangle vertex int32_to the set of processed triangles
 			void addProcessedVertex(etk::Vector<etk::Pair<int32_t, vec3>>& _processTriangleVertices, const vec3& _vertex) {
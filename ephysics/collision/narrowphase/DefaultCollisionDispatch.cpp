@@ -23,12 +23,17 @@ void DefaultCollisionDispatch::init(CollisionDetection* _collisionDetection) {
 	m_sphereVsSphereAlgorithm.init(_collisionDetection);
 	m_GJKAlgorithm.init(_collisionDetection);
 	m_concaveVsConvexAlgorithm.init(_collisionDetection);
+	m_compoundVsShapeAlgorithm.init(_collisionDetection);
 }
 
 
 NarrowPhaseAlgorithm* DefaultCollisionDispatch::selectAlgorithm(int32_t _type1, int32_t _type2) {
 	CollisionShapeType shape1Type = static_cast<CollisionShapeType>(_type1);
 	CollisionShapeType shape2Type = static_cast<CollisionShapeType>(_type2);
+	// Compound vs any shape algorithm (the children are dispatched again)
+	if (shape1Type == COMPOUND || shape2Type == COMPOUND) {
+		return &m_compoundVsShapeAlgorithm;
+	}
 	// Sphere vs Sphere algorithm
 	if (shape1Type == SPHERE && shape2Type == SPHERE) {
 		return &m_sphereVsSphereAlgorithm;
@@ -10,6 +10,7 @@
 
 #include <ephysics/collision/narrowphase/CollisionDispatch.hpp>
 #include <ephysics/collision/narrowphase/ConcaveVsConvexAlgorithm.hpp>
+#include <ephysics/collision/narrowphase/CompoundVsShapeAlgorithm.hpp>
 #include <ephysics/collision/narrowphase/SphereVsSphereAlgorithm.hpp>
 #include <ephysics/collision/narrowphase/GJK/GJKAlgorithm.hpp>
 
@@ -23,6 +24,7 @@ namespace ephysics {
 		protected:
 			SphereVsSphereAlgorithm m_sphereVsSphereAlgorithm; //!< Sphere vs Sphere collision algorithm
 			ConcaveVsConvexAlgorithm m_concaveVsConvexAlgorithm; //!< Concave vs Convex collision algorithm
+			CompoundVsShapeAlgorithm m_compoundVsShapeAlgorithm; //!< Compound vs any shape collision algorithm
 			GJKAlgorithm m_GJKAlgorithm; //!< GJK Algorithm
 		public:
 			/**
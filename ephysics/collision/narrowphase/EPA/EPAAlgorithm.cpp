@@ -10,6 +10,7 @@
 #include <ephysics/engine/Profiler.hpp>
 #include <ephysics/collision/narrowphase/GJK/GJKAlgorithm.hpp>
 #include <ephysics/collision/narrowphase/EPA/TrianglesStore.hpp>
+#include <ephysics/mathematics/simd.hpp>
 
 using namespace ephysics;
 
@@ -74,6 +75,9 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& _simpl
 	// Matrix that transform a direction from local
 	// space of body 1 int32_to local space of body 2
 	etk::Quaternion rotateToBody2 = _transform2.getOrientation().getInverse() * _transform1.getOrientation();
+	// Transforms of the support points converted once to the fused SIMD form
+	const simd::Transform body2Tobody1Simd(body2Tobody1);
+	const simd::Transform rotateToBody2Simd(rotateToBody2.getMatrix(), vec3(0.0f, 0.0f, 0.0f));
 	// Get the simplex computed previously by the GJK algorithm
 	uint32_t nbVertices = _simplex.getSimplex(suppPointsA, suppPointsB, points);
 	// Compute the tolerance
@@ -112,18 +116,18 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& _simpl
 			vec3 v3 = rotationQuat * v2;
 			// Compute the support point in the direction of v1
 			suppPointsA[2] = shape1->getLocalSupportPointWithMargin(v1, shape1CachedCollisionData);
-			suppPointsB[2] = body2Tobody1 *
-					   shape2->getLocalSupportPointWithMargin(rotateToBody2 * (-v1), shape2CachedCollisionData);
+			suppPointsB[2] = body2Tobody1Simd *
+					   shape2->getLocalSupportPointWithMargin(rotateToBody2Simd.rotate(-v1), shape2CachedCollisionData);
 			points[2] = suppPointsA[2] - suppPointsB[2];
 			// Compute the support point in the direction of v2
 			suppPointsA[3] = shape1->getLocalSupportPointWithMargin(v2, shape1CachedCollisionData);
-			suppPointsB[3] = body2Tobody1 *
-					 shape2->getLocalSupportPointWithMargin(rotateToBody2 * (-v2), shape2CachedCollisionData);
+			suppPointsB[3] = body2Tobody1Simd *
+					 shape2->getLocalSupportPointWithMargin(rotateToBody2Simd.rotate(-v2), shape2CachedCollisionData);
 			points[3] = suppPointsA[3] - suppPointsB[3];
 			// Compute the support point in the direction of v3
 			suppPointsA[4] = shape1->getLocalSupportPointWithMargin(v3, shape1CachedCollisionData);
-			suppPointsB[4] = body2Tobody1 *
-							shape2->getLocalSupportPointWithMargin(rotateToBody2 * (-v3), shape2CachedCollisionData);
+			suppPointsB[4] = body2Tobody1Simd *
+							shape2->getLocalSupportPointWithMargin(rotateToBody2Simd.rotate(-v3), shape2CachedCollisionData);
 			points[4] = suppPointsA[4] - suppPointsB[4];
 			// Now we have an hexahedron (two tetrahedron glued together). We can simply keep the
 			// tetrahedron that contains the origin in order that the initial polytope of the
@@ -208,12 +212,12 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& _simpl
 			vec3 n = v1.cross(v2);
 			// Compute the two new vertices to obtain a hexahedron
 			suppPointsA[3] = shape1->getLocalSupportPointWithMargin(n, shape1CachedCollisionData);
-			suppPointsB[3] = body2Tobody1 *
-					 shape2->getLocalSupportPointWithMargin(rotateToBody2 * (-n), shape2CachedCollisionData);
+			suppPointsB[3] = body2Tobody1Simd *
+					 shape2->getLocalSupportPointWithMargin(rotateToBody2Simd.rotate(-n), shape2CachedCollisionData);
 			points[3] = suppPointsA[3] - suppPointsB[3];
 			suppPointsA[4] = shape1->getLocalSupportPointWithMargin(-n, shape1CachedCollisionData);
-			suppPointsB[4] = body2Tobody1 *
-					 shape2->getLocalSupportPointWithMargin(rotateToBody2 * n, shape2CachedCollisionData);
+			suppPointsB[4] = body2Tobody1Simd *
+					 shape2->getLocalSupportPointWithMargin(rotateToBody2Simd.rotate(n), shape2CachedCollisionData);
 			points[4] = suppPointsA[4] - suppPointsB[4];
 			TriangleEPA* face0 = null;
 			TriangleEPA* face1 = null;
@@ -294,7 +298,7 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& _simpl
 			// Compute the support point of the Minkowski
 			// difference (A-B) in the closest point direction
 			suppPointsA[nbVertices] = shape1->getLocalSupportPointWithMargin(triangle->getClosestPoint(), shape1CachedCollisionData);
-			suppPointsB[nbVertices] = body2Tobody1 * shape2->getLocalSupportPointWithMargin(rotateToBody2 * (-triangle->getClosestPoint()), shape2CachedCollisionData);
+			suppPointsB[nbVertices] = body2Tobody1Simd * shape2->getLocalSupportPointWithMargin(rotateToBody2Simd.rotate(-triangle->getClosestPoint()), shape2CachedCollisionData);
 			points[nbVertices] = suppPointsA[nbVertices] - suppPointsB[nbVertices];
 			int32_t indexNewVertex = nbVertices;
 			nbVertices++;
@@ -349,5 +353,6 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& _simpl
 	}
 	// Create the contact info object
 	ContactPointInfo contactInfo(_shape1Info.proxyShape, _shape2Info.proxyShape, _shape1Info.collisionShape, _shape2Info.collisionShape, normal, penetrationDepth, pALocal, pBLocal);
+	contactInfo.featureId = ConvexShape::computeContactFeatureId(shape1, pALocal, shape2, pBLocal);
 	narrowPhaseCallback->notifyContact(_shape1Info.overlappingPair, contactInfo);
 }
@@ -11,6 +11,7 @@
 #include <ephysics/constraint/ContactPoint.hpp>
 #include <ephysics/configuration.hpp>
 #include <ephysics/engine/Profiler.hpp>
+#include <ephysics/mathematics/simd.hpp>
 
 using namespace ephysics;
 
@@ -49,6 +50,9 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
 	// space of body 1 int32_to local space of body 2
 	etk::Matrix3x3 rotateToBody2 = transform2.getOrientation().getMatrix().getTranspose() *
 							  transform1.getOrientation().getMatrix();
+	// Transforms of the support points converted once to the fused SIMD form
+	const simd::Transform body2Tobody1Simd(body2Tobody1);
+	const simd::Transform rotateToBody2Simd(rotateToBody2, vec3(0.0f, 0.0f, 0.0f));
 	// Initialize the margin (sum of margins of both objects)
 	float margin = shape1->getMargin() + shape2->getMargin();
 	float marginSquare = margin * margin;
@@ -62,7 +66,7 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
 	do {
 		// Compute the support points for original objects (without margins) A and B
 		suppA = shape1->getLocalSupportPointWithoutMargin(-v, shape1CachedCollisionData);
-		suppB = body2Tobody1 * shape2->getLocalSupportPointWithoutMargin(rotateToBody2 * v, shape2CachedCollisionData);
+		suppB = body2Tobody1Simd * shape2->getLocalSupportPointWithoutMargin(rotateToBody2Simd.rotate(v), shape2CachedCollisionData);
 		// Compute the support point for the Minkowski difference A-B
 		w = suppA - suppB;
 		vDotw = v.dot(w);
@@ -91,6 +95,7 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
 			// Create the contact info object
 			ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
 										 shape2Info.collisionShape, normal, penetrationDepth, pA, pB);
+			contactInfo.featureId = ConvexShape::computeContactFeatureId(shape1, pA, shape2, pB);
 			narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
 			// There is an int32_tersection, therefore we return
 			return;
@@ -117,6 +122,7 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
 			// Create the contact info object
 			ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
 										 shape2Info.collisionShape, normal, penetrationDepth, pA, pB);
+			contactInfo.featureId = ConvexShape::computeContactFeatureId(shape1, pA, shape2, pB);
 			narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
 			// There is an int32_tersection, therefore we return
 			return;
@@ -142,6 +148,7 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
 			// Create the contact info object
 			ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
 										 shape2Info.collisionShape, normal, penetrationDepth, pA, pB);
+			contactInfo.featureId = ConvexShape::computeContactFeatureId(shape1, pA, shape2, pB);
 			narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
 			// There is an int32_tersection, therefore we return
 			return;
@@ -173,6 +180,7 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
 			// Create the contact info object
 			ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
 										 shape2Info.collisionShape, normal, penetrationDepth, pA, pB);
+			contactInfo.featureId = ConvexShape::computeContactFeatureId(shape1, pA, shape2, pB);
 			narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
 			// There is an int32_tersection, therefore we return
 			return;
@@ -187,6 +195,65 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
 													 transform2, narrowPhaseCallback, v);
 }
 
+bool GJKAlgorithm::testOverlap(const CollisionShapeInfo& _shape1Info,
+                               const CollisionShapeInfo& _shape2Info) {
+	PROFILE("GJKAlgorithm::testOverlap()");
+	assert(_shape1Info.collisionShape->isConvex());
+	assert(_shape2Info.collisionShape->isConvex());
+	const ConvexShape* shape1 = static_cast<const ConvexShape*>(_shape1Info.collisionShape);
+	const ConvexShape* shape2 = static_cast<const ConvexShape*>(_shape2Info.collisionShape);
+	void** shape1CachedCollisionData = _shape1Info.cachedCollisionData;
+	void** shape2CachedCollisionData = _shape2Info.cachedCollisionData;
+	OverlappingPair* overlappingPair = _shape1Info.overlappingPair;
+	const etk::Transform3D transform1 = _shape1Info.shapeToWorldTransform;
+	const etk::Transform3D transform2 = _shape2Info.shapeToWorldTransform;
+	// The GJK algorithm is done in local space of body 1
+	etk::Transform3D body2Tobody1 = transform1.getInverse() * transform2;
+	etk::Matrix3x3 rotateToBody2 = transform2.getOrientation().getMatrix().getTranspose() *
+	                               transform1.getOrientation().getMatrix();
+	// Transforms of the support points converted once to the fused SIMD form
+	const simd::Transform body2Tobody1Simd(body2Tobody1);
+	const simd::Transform rotateToBody2Simd(rotateToBody2, vec3(0.0f, 0.0f, 0.0f));
+	float margin = shape1->getMargin() + shape2->getMargin();
+	float marginSquare = margin * margin;
+	assert(margin > 0.0);
+	Simplex simplex;
+	vec3 v = overlappingPair->getCachedSeparatingAxis();
+	float distSquare = FLT_MAX;
+	float prevDistSquare;
+	do {
+		vec3 suppA = shape1->getLocalSupportPointWithoutMargin(-v, shape1CachedCollisionData);
+		vec3 suppB = body2Tobody1Simd * shape2->getLocalSupportPointWithoutMargin(rotateToBody2Simd.rotate(v), shape2CachedCollisionData);
+		vec3 w = suppA - suppB;
+		float vDotw = v.dot(w);
+		// The enlarged objects are separated
+		if (vDotw > 0.0 && vDotw * vDotw > distSquare * marginSquare) {
+			overlappingPair->setCachedSeparatingAxis(v);
+			return false;
+		}
+		// The closest distance between the original objects is found: the enlarged
+		// objects overlap if this distance is smaller than the margin
+		if (    simplex.isPointInSimplex(w)
+		     || distSquare - vDotw <= distSquare * REL_ERROR_SQUARE) {
+			return distSquare < marginSquare;
+		}
+		simplex.addPoint(w, suppA, suppB);
+		if (    simplex.isAffinelyDependent()
+		     || !simplex.computeClosestPoint(v)) {
+			return distSquare < marginSquare;
+		}
+		prevDistSquare = distSquare;
+		distSquare = v.length2();
+		if (prevDistSquare - distSquare <= FLT_EPSILON * prevDistSquare) {
+			simplex.backupClosestPointInSimplex(v);
+			return v.length2() < marginSquare;
+		}
+	} while(!simplex.isFull() && distSquare > FLT_EPSILON *
+	                             simplex.getMaxLengthSquareOfAPoint());
+	// The original objects (without margins) intersect
+	return true;
+}
+
 void GJKAlgorithm::computePenetrationDepthForEnlargedObjects(const CollisionShapeInfo& shape1Info,
 															 const etk::Transform3D& transform1,
 															 const CollisionShapeInfo& shape2Info,
@@ -213,10 +280,13 @@ void GJKAlgorithm::computePenetrationDepthForEnlargedObjects(const CollisionShap
 	// Matrix that transform a direction from local space of body 1 int32_to local space of body 2
 	etk::Matrix3x3 rotateToBody2 = transform2.getOrientation().getMatrix().getTranspose() *
 							  transform1.getOrientation().getMatrix();
+	// Transforms of the support points converted once to the fused SIMD form
+	const simd::Transform body2ToBody1Simd(body2ToBody1);
+	const simd::Transform rotateToBody2Simd(rotateToBody2, vec3(0.0f, 0.0f, 0.0f));
 	do {
 		// Compute the support points for the enlarged object A and B
 		suppA = shape1->getLocalSupportPointWithMargin(-v, shape1CachedCollisionData);
-		suppB = body2ToBody1 * shape2->getLocalSupportPointWithMargin(rotateToBody2 * v, shape2CachedCollisionData);
+		suppB = body2ToBody1Simd * shape2->getLocalSupportPointWithMargin(rotateToBody2Simd.rotate(v), shape2CachedCollisionData);
 		// Compute the support point for the Minkowski difference A-B
 		w = suppA - suppB;
 		vDotw = v.dot(w);
@@ -249,15 +319,113 @@ void GJKAlgorithm::computePenetrationDepthForEnlargedObjects(const CollisionShap
 															v, narrowPhaseCallback);
 }
 
+bool GJKAlgorithm::computeDistance(const ConvexShape* _shape1,
+                                   const etk::Transform3D& _transform1,
+                                   void** _cachedCollisionData1,
+                                   const ConvexShape* _shape2,
+                                   const etk::Transform3D& _transform2,
+                                   void** _cachedCollisionData2,
+                                   DistanceInfo& _distanceInfo) const {
+	PROFILE("GJKAlgorithm::computeDistance()");
+	vec3 suppA; // Support point of object A
+	vec3 suppB; // Support point of object B
+	vec3 pA; // Closest point of object A
+	vec3 pB; // Closest point of object B
+	float prevDistSquare;
+	// The GJK algorithm is done in local space of body 1
+	etk::Transform3D body2Tobody1 = _transform1.getInverse() * _transform2;
+	etk::Matrix3x3 rotateToBody2 = _transform2.getOrientation().getMatrix().getTranspose() *
+	                               _transform1.getOrientation().getMatrix();
+	// Transforms of the support points converted once to the fused SIMD form
+	const simd::Transform body2Tobody1Simd(body2Tobody1);
+	const simd::Transform rotateToBody2Simd(rotateToBody2, vec3(0.0f, 0.0f, 0.0f));
+	float margin1 = _shape1->getMargin();
+	float margin2 = 0.0f;
+	if (_shape2 != null) {
+		margin2 = _shape2->getMargin();
+	}
+	Simplex simplex;
+	// Start with the direction between the two origins (no separating axis cache for the queries)
+	vec3 v = -body2Tobody1.getPosition();
+	if (v.length2() < FLT_EPSILON) {
+		v = vec3(1.0f, 0.0f, 0.0f);
+	}
+	float distSquare = FLT_MAX;
+	bool isSeparated = false;
+	do {
+		// Compute the support points for original objects (without margins) A and B
+		suppA = _shape1->getLocalSupportPointWithoutMargin(-v, _cachedCollisionData1);
+		if (_shape2 != null) {
+			suppB = body2Tobody1Simd * _shape2->getLocalSupportPointWithoutMargin(rotateToBody2Simd.rotate(v), _cachedCollisionData2);
+		} else {
+			suppB = body2Tobody1.getPosition();
+		}
+		vec3 w = suppA - suppB;
+		float vDotw = v.dot(w);
+		// If the closest point can not be improved anymore
+		if (    simplex.isPointInSimplex(w) == true
+		     || distSquare - vDotw <= distSquare * REL_ERROR_SQUARE) {
+			isSeparated = true;
+			break;
+		}
+		simplex.addPoint(w, suppA, suppB);
+		if (simplex.isAffinelyDependent() == true) {
+			isSeparated = true;
+			break;
+		}
+		if (simplex.computeClosestPoint(v) == false) {
+			isSeparated = true;
+			break;
+		}
+		prevDistSquare = distSquare;
+		distSquare = v.length2();
+		// If the distance to the closest point doesn't improve a lot
+		if (prevDistSquare - distSquare <= FLT_EPSILON * prevDistSquare) {
+			simplex.backupClosestPointInSimplex(v);
+			distSquare = v.length2();
+			isSeparated = true;
+			break;
+		}
+	} while(    simplex.isFull() == false
+	         && distSquare > FLT_EPSILON * simplex.getMaxLengthSquareOfAPoint());
+	float dist = 0.0f;
+	if (isSeparated == true) {
+		dist = sqrt(distSquare);
+	}
+	if (dist <= margin1 + margin2) {
+		// The shapes overlap: only report the origins of the shapes as approximated witness points
+		_distanceInfo.distance = 0.0f;
+		_distanceInfo.worldPoint1 = _transform1.getPosition();
+		_distanceInfo.worldPoint2 = _transform2.getPosition();
+		_distanceInfo.worldNormal = (_distanceInfo.worldPoint2 - _distanceInfo.worldPoint1).safeNormalized();
+		return false;
+	}
+	// Compute the closest points of the shapes without margin and project them on the margins
+	simplex.computeClosestPointsOfAandB(pA, pB);
+	pA = pA - (margin1 / dist) * v;
+	pB = pB + (margin2 / dist) * v;
+	_distanceInfo.distance = dist - margin1 - margin2;
+	_distanceInfo.worldPoint1 = _transform1 * pA;
+	_distanceInfo.worldPoint2 = _transform1 * pB;
+	_distanceInfo.worldNormal = _transform1.getOrientation() * (-v.safeNormalized());
+	return true;
+}
+
 bool GJKAlgorithm::testPointInside(const vec3& localPoint, ProxyShape* proxyShape) {
+	assert(proxyShape->getCollisionShape()->isConvex());
+	return testPointInside(localPoint,
+	                       static_cast<const ConvexShape*>(proxyShape->getCollisionShape()),
+	                       proxyShape->getCachedCollisionData());
+}
+
+bool GJKAlgorithm::testPointInside(const vec3& _localPoint, const ConvexShape* _shape, void** _cachedCollisionData) {
 	vec3 suppA;			 // Support point of object A
 	vec3 w;				 // Support point of Minkowski difference A-B
 	float prevDistSquare;
-	assert(proxyShape->getCollisionShape()->isConvex());
-	const ConvexShape* shape = static_cast<const ConvexShape*>(proxyShape->getCollisionShape());
-	void** shapeCachedCollisionData = proxyShape->getCachedCollisionData();
+	const ConvexShape* shape = _shape;
+	void** shapeCachedCollisionData = _cachedCollisionData;
 	// Support point of object B (object B is a single point)
-	const vec3 suppB(localPoint);
+	const vec3 suppB(_localPoint);
 	// Create a simplex set
 	Simplex simplex;
 	// Initial supporting direction
@@ -295,8 +463,20 @@ bool GJKAlgorithm::testPointInside(const vec3& localPoint, ProxyShape* proxyShap
 
 bool GJKAlgorithm::raycast(const Ray& ray, ProxyShape* proxyShape, RaycastInfo& raycastInfo) {
 	assert(proxyShape->getCollisionShape()->isConvex());
-	const ConvexShape* shape = static_cast<const ConvexShape*>(proxyShape->getCollisionShape());
-	void** shapeCachedCollisionData = proxyShape->getCachedCollisionData();
+	return raycast(ray,
+	               proxyShape,
+	               static_cast<const ConvexShape*>(proxyShape->getCollisionShape()),
+	               proxyShape->getCachedCollisionData(),
+	               raycastInfo);
+}
+
+bool GJKAlgorithm::raycast(const Ray& ray,
+                           ProxyShape* proxyShape,
+                           const ConvexShape* _shape,
+                           void** _cachedCollisionData,
+                           RaycastInfo& raycastInfo) {
+	const ConvexShape* shape = _shape;
+	void** shapeCachedCollisionData = _cachedCollisionData;
 	vec3 suppA;	  // Current lower bound point on the ray (starting at ray's origin)
 	vec3 suppB;	  // Support point on the collision shape
 	const float machineEpsilonSquare = FLT_EPSILON * FLT_EPSILON;
@@ -12,6 +12,7 @@
 #include <ephysics/constraint/ContactPoint.hpp>
 #include <ephysics/collision/shapes/ConvexShape.hpp>
 #include <ephysics/collision/narrowphase/EPA/EPAAlgorithm.hpp>
+#include <ephysics/collision/DistanceInfo.hpp>
 
 namespace ephysics {
 	const float REL_ERROR = float(1.0e-3);
@@ -72,12 +73,51 @@ namespace ephysics {
 			virtual void testCollision(const CollisionShapeInfo& shape1Info,
 			                           const CollisionShapeInfo& shape2Info,
 			                           NarrowPhaseCallback* narrowPhaseCallback);
+			/**
+			 * @brief Boolean overlap test between two convex shapes (enlarged with their margins).
+			 * Run the GJK loop only: no contact point and no penetration depth are computed and the
+			 * EPA algorithm is never used. The separating axis of the overlapping pair is cached.
+			 * @param[in] _shape1Info Information of the first shape
+			 * @param[in] _shape2Info Information of the second shape
+			 * @return true if the two shapes overlap
+			 */
+			bool testOverlap(const CollisionShapeInfo& _shape1Info,
+			                 const CollisionShapeInfo& _shape2Info);
+			/**
+			 * @brief Compute the distance and the closest points between two convex shapes (enlarged
+			 * with their margins) or between a convex shape and a point. The GJK loop runs on the
+			 * shapes without margin, without EPA and without the overlapping pair cache: it can be
+			 * called outside of the collision detection (queries).
+			 * @param[in] _shape1 First convex shape
+			 * @param[in] _transform1 Local-space to world-space transform of the first shape
+			 * @param[in] _cachedCollisionData1 Cached collision data of the first shape
+			 * @param[in] _shape2 Second convex shape (null to compute the distance to the point _transform2.getPosition())
+			 * @param[in] _transform2 Local-space to world-space transform of the second shape
+			 * @param[in] _cachedCollisionData2 Cached collision data of the second shape
+			 * @param[out] _distanceInfo Distance, closest points (first shape then second shape) and normal
+			 * @return true if the shapes are separated, false if they overlap (distance 0)
+			 */
+			bool computeDistance(const ConvexShape* _shape1,
+			                     const etk::Transform3D& _transform1,
+			                     void** _cachedCollisionData1,
+			                     const ConvexShape* _shape2,
+			                     const etk::Transform3D& _transform2,
+			                     void** _cachedCollisionData2,
+			                     DistanceInfo& _distanceInfo) const;
 			/// Use the GJK Algorithm to find if a point is inside a convex collision shape
 			bool testPointInside(const vec3& localPoint, ProxyShape* proxyShape);
+			/// Use the GJK Algorithm to find if a point is inside a convex collision shape that is not directly owned by the proxy (child of a compound)
+			bool testPointInside(const vec3& _localPoint, const ConvexShape* _shape, void** _cachedCollisionData);
 			/// Ray casting algorithm agains a convex collision shape using the GJK Algorithm
 			/// This method implements the GJK ray casting algorithm described by Gino Van Den Bergen in
 			/// "Ray Casting against General Convex Objects with Application to Continuous Collision Detection".
 			bool raycast(const Ray& ray, ProxyShape* proxyShape, RaycastInfo& raycastInfo);
+			/// Ray casting against a convex collision shape that is not directly owned by the proxy (child of a compound)
+			bool raycast(const Ray& _ray,
+			             ProxyShape* _proxyShape,
+			             const ConvexShape* _shape,
+			             void** _cachedCollisionData,
+			             RaycastInfo& _raycastInfo);
 	};
 }
 
@@ -151,22 +151,6 @@ void AABB::inflate(float _dx, float _dy, float _dz) {
 	m_minCoordinates -= vec3(_dx, _dy, _dz);
 }
 
-bool AABB::testCollision(const AABB& _aabb) const {
-	if (    m_maxCoordinates.x() < _aabb.m_minCoordinates.x()
-	     || _aabb.m_maxCoordinates.x() < m_minCoordinates.x()) {
-		return false;
-	}
-	if (    m_maxCoordinates.y() < _aabb.m_minCoordinates.y()
-	     || _aabb.m_maxCoordinates.y() < m_minCoordinates.y()) {
-		return false;
-	}
-	if (    m_maxCoordinates.z() < _aabb.m_minCoordinates.z()
-	     || _aabb.m_maxCoordinates.z() < m_minCoordinates.z()) {
-		return false;
-	}
-	return true;
-}
-
 float AABB::getVolume() const {
 	const vec3 diff = m_maxCoordinates - m_minCoordinates;
 	return (diff.x() * diff.y() * diff.z());
@@ -91,7 +91,21 @@ namespace ephysics {
 			 * @return true Collision detected
 			 * @return false Not collide
 			 */
-			bool testCollision(const AABB& _aabb) const;
+			bool testCollision(const AABB& _aabb) const {
+				if (    m_maxCoordinates.x() < _aabb.m_minCoordinates.x()
+				     || _aabb.m_maxCoordinates.x() < m_minCoordinates.x()) {
+					return false;
+				}
+				if (    m_maxCoordinates.y() < _aabb.m_minCoordinates.y()
+				     || _aabb.m_maxCoordinates.y() < m_minCoordinates.y()) {
+					return false;
+				}
+				if (    m_maxCoordinates.z() < _aabb.m_minCoordinates.z()
+				     || _aabb.m_maxCoordinates.z() < m_minCoordinates.z()) {
+					return false;
+				}
+				return true;
+			}
 			/**
 			 * @brief Get the volume of the AABB
 			 * @return The 3D volume.
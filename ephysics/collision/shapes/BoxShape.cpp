@@ -33,6 +33,19 @@ void BoxShape::computeLocalInertiaTensor(etk::Matrix3x3& _tensor, float _mass) c
 	                 0.0, 0.0, factor * (xSquare + ySquare));
 }
 
+void BoxShape::testPointsInside(const vec3* _localPoints, size_t _nbPoints, bool* _isInside, ProxyShape* _proxyShape) const {
+	// Same test as testPointInside() without branch (the loop can be vectorized)
+	const float extentX = m_extent[0];
+	const float extentY = m_extent[1];
+	const float extentZ = m_extent[2];
+	for (size_t iii=0; iii<_nbPoints; ++iii) {
+		const vec3& point = _localPoints[iii];
+		_isInside[iii] =   (point.x() < extentX) & (point.x() > -extentX)
+		                 & (point.y() < extentY) & (point.y() > -extentY)
+		                 & (point.z() < extentZ) & (point.z() > -extentZ);
+	}
+}
+
 bool BoxShape::raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const {
 	vec3 rayDirection = _ray.point2 - _ray.point1;
 	float tMin = FLT_MIN;
@@ -122,6 +135,22 @@ vec3 BoxShape::getLocalSupportPointWithoutMargin(const vec3& _direction,
 	            _direction.z() < 0.0 ? -m_extent.z() : m_extent.z());
 }
 
+uint32_t BoxShape::getLocalFeatureId(const vec3& _localPoint) const {
+	// 2 bits by axis: the point is on the positive face (1), on the negative face (2) or between them (0).
+	// A vertex has the 3 axis set, an edge 2 and a face 1 (0 is a point inside the box).
+	uint32_t featureId = 0;
+	for (int32_t iii=0; iii<3; ++iii) {
+		// The contact points are on the surface with margin, a vertex contact point can be at the margin distance of the face
+		float limit = m_extent[iii] - m_margin - 0.01f * m_extent[iii];
+		if (_localPoint[iii] >= limit) {
+			featureId |= 1 << (2 * iii);
+		} else if (_localPoint[iii] <= -limit) {
+			featureId |= 2 << (2 * iii);
+		}
+	}
+	return featureId;
+}
+
 bool BoxShape::testPointInside(const vec3& _localPoint, ProxyShape* _proxyShape) const {
 	return (    _localPoint.x() < m_extent[0]
 	         && _localPoint.x() > -m_extent[0]
@@ -50,7 +50,9 @@ class BoxShape : public ConvexShape {
 	protected:
 		vec3 m_extent; //!< Extent sizes of the box in the x, y and z direction
 		vec3 getLocalSupportPointWithoutMargin(const vec3& _direction, void** _cachedCollisionData) const override;
+		uint32_t getLocalFeatureId(const vec3& _localPoint) const override;
 		bool testPointInside(const vec3& _localPoint, ProxyShape* _proxyShape) const override;
+		void testPointsInside(const vec3* _localPoints, size_t _nbPoints, bool* _isInside, ProxyShape* _proxyShape) const override;
 		bool raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const override;
 		size_t getSizeInBytes() const override;
 };
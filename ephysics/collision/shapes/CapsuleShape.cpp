@@ -50,6 +50,17 @@ bool CapsuleShape::testPointInside(const vec3& _localPoint, ProxyShape* _proxySh
 			(xSquare + zSquare + diffYCenterSphere2 * diffYCenterSphere2) < squareRadius;
 }
 
+void CapsuleShape::testPointsInside(const vec3* _localPoints, size_t _nbPoints, bool* _isInside, ProxyShape* _proxyShape) const {
+	// A point is inside the capsule if its distance to the segment between the two sphere centers is smaller than the radius
+	const float squareRadius = m_margin * m_margin;
+	for (size_t iii=0; iii<_nbPoints; ++iii) {
+		const vec3& point = _localPoints[iii];
+		const float clampedY = etk::min(m_halfHeight, etk::max(-m_halfHeight, point.y()));
+		const float diffY = point.y() - clampedY;
+		_isInside[iii] = (point.x() * point.x() + point.z() * point.z() + diffY * diffY < squareRadius);
+	}
+}
+
 bool CapsuleShape::raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const {
 	const vec3 n = _ray.point2 - _ray.point1;
 	const float epsilon = float(0.01);
@@ -51,6 +51,7 @@ namespace ephysics {
 			float m_halfHeight; //!< Half height of the capsule (height = distance between the centers of the two spheres)
 			vec3 getLocalSupportPointWithoutMargin(const vec3& _direction, void** _cachedCollisionData) const override;
 			bool testPointInside(const vec3& _localPoint, ProxyShape* _proxyShape) const override;
+			void testPointsInside(const vec3* _localPoints, size_t _nbPoints, bool* _isInside, ProxyShape* _proxyShape) const override;
 			bool raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const override;
 			/**
 			 * @brief Raycasting method between a ray one of the two spheres end cap of the capsule
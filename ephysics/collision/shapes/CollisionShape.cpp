@@ -19,6 +19,12 @@ CollisionShape::CollisionShape(CollisionShapeType type) :
 	
 }
 
+void CollisionShape::testPointsInside(const vec3* _localPoints, size_t _nbPoints, bool* _isInside, ProxyShape* _proxyShape) const {
+	for (size_t iii=0; iii<_nbPoints; ++iii) {
+		_isInside[iii] = testPointInside(_localPoints[iii], _proxyShape);
+	}
+}
+
 void CollisionShape::computeAABB(AABB& _aabb, const etk::Transform3D& _transform) const {
 	PROFILE("CollisionShape::computeAABB()");
 	// Get the local bounds in x,y and z direction
@@ -17,8 +17,8 @@
 
 namespace ephysics {
 enum CollisionShapeType {TRIANGLE, BOX, SPHERE, CONE, CYLINDER,
-						 CAPSULE, CONVEX_MESH, CONCAVE_MESH, HEIGHTFIELD};
-const int32_t NB_COLLISION_SHAPE_TYPES = 9;
+						 CAPSULE, CONVEX_MESH, CONCAVE_MESH, HEIGHTFIELD, COMPOUND};
+const int32_t NB_COLLISION_SHAPE_TYPES = 10;
 
 class ProxyShape;
 class CollisionBody;
@@ -79,6 +79,11 @@ class CollisionShape {
 		 * @param[in] _transform etk::Transform3D used to compute the AABB of the collision shape
 		 */
 		virtual void computeAABB(AABB& _aabb, const etk::Transform3D& _transform) const;
+		/**
+		 * @brief Build the acceleration structures of the queries of the shape (called when the shape is
+		 * added to a body: the queries of the collision detection only read the shape)
+		 */
+		virtual void prepareQueries() {}
 		/**
 		 * @brief Check if the shape is convex
 		 * @param[in] _shapeType shape type
@@ -87,7 +92,8 @@ class CollisionShape {
 		 */
 		static bool isConvex(CollisionShapeType _shapeType) {
 			return    _shapeType != CONCAVE_MESH
-			       && _shapeType != HEIGHTFIELD;
+			       && _shapeType != HEIGHTFIELD
+			       && _shapeType != COMPOUND;
 		}
 		/**
 		 * @brief Get the maximum number of contact
@@ -97,11 +103,22 @@ class CollisionShape {
 		                                            CollisionShapeType _shapeType2);
 		friend class ProxyShape;
 		friend class CollisionWorld;
+		friend class CompoundShape;
+		friend class ScaledConvexShape;
+		friend class ScaledConcaveShape;
 	protected :
 		CollisionShapeType m_type; //!< Type of the collision shape
 		vec3 m_scaling; //!< Scaling vector of the collision shape
 		/// Return true if a point is inside the collision shape
 		virtual bool testPointInside(const vec3& worldPoint, ProxyShape* proxyShape) const = 0;
+		/**
+		 * @brief Test a batch of points (the primitive shapes implement it without virtual call per point)
+		 * @param[in] _localPoints Points to test in the local-space of the shape
+		 * @param[in] _nbPoints Number of points
+		 * @param[out] _isInside True for each point inside the shape
+		 * @param[in] _proxyShape Proxy shape of the collision shape
+		 */
+		virtual void testPointsInside(const vec3* _localPoints, size_t _nbPoints, bool* _isInside, ProxyShape* _proxyShape) const;
 		/// Raycast method with feedback information
 		virtual bool raycast(const Ray& ray, RaycastInfo& raycastInfo, ProxyShape* proxyShape) const = 0;
 		/// Return the number of bytes used by the collision shape
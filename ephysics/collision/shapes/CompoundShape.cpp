@@ -0,0 +1,107 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#include <ephysics/collision/shapes/CompoundShape.hpp>
+#include <ephysics/collision/ProxyShape.hpp>
+#include <ephysics/engine/Profiler.hpp>
+#include <ephysics/debug.hpp>
+
+using namespace ephysics;
+
+CompoundShape::CompoundShape():
+  CollisionShape(COMPOUND) {
+
+}
+
+int32_t CompoundShape::addChild(CollisionShape* _shape, const etk::Transform3D& _transform, void* _userData) {
+	EPHY_ASSERT(_shape != null, "Input check error");
+	int32_t childIndex = m_children.size();
+	m_children.pushBack(Child(_shape, _transform, _userData));
+	// Add the AABB of the child (in the compound local-space) in the local tree
+	AABB aabb;
+	_shape->computeAABB(aabb, _transform);
+	m_dynamicAABBTree.addObject(aabb, childIndex, 0);
+	return childIndex;
+}
+
+void CompoundShape::getLocalBounds(vec3& _min, vec3& _max) const {
+	if (m_children.size() == 0) {
+		_min = vec3(0, 0, 0);
+		_max = vec3(0, 0, 0);
+		return;
+	}
+	// The tree has no extra gap: its root AABB is the union of the children AABB
+	AABB treeAABB = m_dynamicAABBTree.getRootAABB();
+	_min = treeAABB.getMin();
+	_max = treeAABB.getMax();
+}
+
+void CompoundShape::setLocalScaling(const vec3& /*_scaling*/) {
+	// A non uniform scaling of a rotated child can not be represented by the child shape
+	EPHY_ERROR("A compound shape can not be scaled: scale its child shapes before adding them");
+}
+
+void CompoundShape::computeLocalInertiaTensor(etk::Matrix3x3& _tensor, float _mass) const {
+	// Inertia tensor of the bounding box of the children
+	// Note that this is only an approximation of the distribution of the mass in the children.
+	vec3 minBounds;
+	vec3 maxBounds;
+	getLocalBounds(minBounds, maxBounds);
+	float factor = (1.0f / float(3.0)) * _mass;
+	vec3 realExtent = 0.5f * (maxBounds - minBounds);
+	float xSquare = realExtent.x() * realExtent.x();
+	float ySquare = realExtent.y() * realExtent.y();
+	float zSquare = realExtent.z() * realExtent.z();
+	_tensor.setValue(factor * (ySquare + zSquare), 0.0, 0.0,
+	                 0.0, factor * (xSquare + zSquare), 0.0,
+	                 0.0, 0.0, factor * (xSquare + ySquare));
+}
+
+bool CompoundShape::testPointInside(const vec3& _localPoint, ProxyShape* _proxyShape) const {
+	bool isInside = false;
+	testAllChildren(AABB(_localPoint, _localPoint), [&](int32_t _childIndex) {
+	                	if (isInside == true) {
+	                		return;
+	                	}
+	                	const Child& child = m_children[_childIndex];
+	                	isInside = child.shape->testPointInside(child.transform.getInverse() * _localPoint, _proxyShape);
+	                });
+	return isInside;
+}
+
+bool CompoundShape::raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const {
+	PROFILE("CompoundShape::raycast()");
+	bool isHit = false;
+	// Ask the local tree to report the children hit by the ray (nearest first). The ray
+	// of the traversal is clipped with the closest hit found so far.
+	m_dynamicAABBTree.raycast(_ray, [&](int32_t _nodeId, const Ray& _treeRay) {
+	                          	int32_t childIndex = m_dynamicAABBTree.getNodeDataInt(_nodeId)[0];
+	                          	const Child& child = m_children[childIndex];
+	                          	// Convert the ray in the local-space of the child (the hit fraction is unchanged)
+	                          	const etk::Transform3D compoundToChild = child.transform.getInverse();
+	                          	Ray childRay(compoundToChild * _treeRay.point1,
+	                          	             compoundToChild * _treeRay.point2,
+	                          	             _treeRay.maxFraction);
+	                          	RaycastInfo childInfo;
+	                          	if (child.shape->raycast(childRay, childInfo, _proxyShape) == false) {
+	                          		return -1.0f;
+	                          	}
+	                          	_raycastInfo.body = childInfo.body;
+	                          	_raycastInfo.proxyShape = childInfo.proxyShape;
+	                          	_raycastInfo.hitFraction = childInfo.hitFraction;
+	                          	_raycastInfo.worldPoint = child.transform * childInfo.worldPoint;
+	                          	_raycastInfo.worldNormal = child.transform.getOrientation() * childInfo.worldNormal;
+	                          	_raycastInfo.meshSubpart = childInfo.meshSubpart;
+	                          	_raycastInfo.triangleIndex = childInfo.triangleIndex;
+	                          	_raycastInfo.childIndex = childIndex;
+	                          	isHit = true;
+	                          	return childInfo.hitFraction;
+	                          });
+	return isHit;
+}
+
+size_t CompoundShape::getSizeInBytes() const {
+	return sizeof(CompoundShape);
+}
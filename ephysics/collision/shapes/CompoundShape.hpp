@@ -0,0 +1,105 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/Function.hpp>
+#include <ephysics/collision/shapes/CollisionShape.hpp>
+#include <ephysics/collision/broadphase/DynamicAABBTree.hpp>
+
+namespace ephysics {
+	/**
+	 * @brief Represents a collision shape made of several child shapes placed with a local
+	 * transform. A body with many parts uses a single compound proxy shape (only one
+	 * entry in the broad-phase) and the children are selected during the narrow-phase
+	 * with a local dynamic AABB tree.
+	 * The child shapes are not owned by the compound shape (as for the proxy shapes, the
+	 * user has to keep them alive) and all the children have to be added before the
+	 * compound shape is attached to a body.
+	 */
+	class CompoundShape : public CollisionShape {
+		public:
+			/**
+			 * @brief Child of the compound shape
+			 */
+			class Child {
+				public:
+					CollisionShape* shape; //!< Collision shape of the child
+					etk::Transform3D transform; //!< Transform from the child local-space to the compound local-space
+					void* userData; //!< User data of the child (reported by the contacts and the raycasts with the child index)
+					/// Constructor
+					Child(CollisionShape* _shape, const etk::Transform3D& _transform, void* _userData):
+					  shape(_shape),
+					  transform(_transform),
+					  userData(_userData) {
+
+					}
+					Child():
+					  shape(null),
+					  userData(null) {
+						// TODO: add it for etk::Vector
+					}
+			};
+		protected:
+			etk::Vector<Child> m_children; //!< List of the child shapes
+			DynamicAABBTree m_dynamicAABBTree; //!< Local AABB tree of the children (node data is the child index)
+		public:
+			/// Constructor
+			CompoundShape();
+			/// DELETE copy-constructor
+			CompoundShape(const CompoundShape& _shape) = delete;
+			/// DELETE assignment operator
+			CompoundShape& operator=(const CompoundShape& _shape) = delete;
+			/**
+			 * @brief Add a child shape in the compound
+			 * @param[in] _shape Collision shape of the child (not owned by the compound)
+			 * @param[in] _transform Transform from the child local-space to the compound local-space
+			 * @param[in] _userData User data of the child
+			 * @return Index of the child (reported in ContactPoint::getChildIndex1/2() and RaycastInfo::childIndex)
+			 */
+			int32_t addChild(CollisionShape* _shape, const etk::Transform3D& _transform, void* _userData = null);
+			/// Return the number of children
+			size_t getNbChildren() const {
+				return m_children.size();
+			}
+			/// Return the collision shape of a child
+			const CollisionShape* getChildShape(int32_t _childIndex) const {
+				return m_children[_childIndex].shape;
+			}
+			/// Return the transform from the child local-space to the compound local-space
+			const etk::Transform3D& getChildTransform(int32_t _childIndex) const {
+				return m_children[_childIndex].transform;
+			}
+			/// Return the user data of a child
+			void* getChildUserData(int32_t _childIndex) const {
+				return m_children[_childIndex].userData;
+			}
+			/**
+			 * @brief Report all the children overlapping an AABB
+			 * @param[in] _localAABB AABB in the local-space of the compound shape
+			 * @param[in] _visitor Called with the index of each overlapping child: void(int32_t _childIndex)
+			 */
+			template<class VISITOR>
+			void testAllChildren(const AABB& _localAABB, VISITOR&& _visitor) const {
+				m_dynamicAABBTree.reportAllShapesOverlappingWithAABB(_localAABB, [&](int32_t _nodeId) {
+				                                                     	_visitor(m_dynamicAABBTree.getNodeDataInt(_nodeId)[0]);
+				                                                     });
+			}
+			bool isConvex() const override {
+				return false;
+			}
+			void getLocalBounds(vec3& _min, vec3& _max) const override;
+			void setLocalScaling(const vec3& _scaling) override;
+			void computeLocalInertiaTensor(etk::Matrix3x3& _tensor, float _mass) const override;
+			/// Build the query layout of the tree of the children once they have been added
+			void prepareQueries() override {
+				m_dynamicAABBTree.updateQueryLayout();
+			}
+		protected:
+			bool testPointInside(const vec3& _localPoint, ProxyShape* _proxyShape) const override;
+			bool raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const override;
+			size_t getSizeInBytes() const override;
+	};
+}
@@ -7,6 +7,7 @@
  * @license MPL v2.0 (see license file)
  */
 #include <ephysics/collision/shapes/ConcaveMeshShape.hpp>
+#include <ephysics/collision/ProxyShape.hpp>
 #include <ephysics/debug.hpp>
 
 using namespace ephysics;
@@ -19,7 +20,6 @@ ConcaveMeshShape::ConcaveMeshShape(TriangleMesh* _triangleMesh):
 }
 
 void ConcaveMeshShape::initBVHTree() {
-	// TODO : Try to randomly add the triangles into the tree to obtain a better tree
 	// For each sub-part of the mesh
 	for (uint32_t subPart=0; subPart<m_triangleMesh->getNbSubparts(); subPart++) {
 		// Get the triangle vertex array of the current sub-part
@@ -38,6 +38,8 @@ void ConcaveMeshShape::initBVHTree() {
 			m_dynamicAABBTree.addObject(aabb, subPart, iii);
 		}
 	}
+	// All the triangles are known: build the tree in bulk (better than the incremental insertion)
+	m_dynamicAABBTree.rebuild();
 }
 
 void ConcaveMeshShape::getTriangleVerticesWithIndexPointer(int32_t _subPart, int32_t _triangleIndex, vec3* _outTriangleVertices) const {
@@ -71,50 +73,131 @@ bool ConcaveMeshShape::raycast(const Ray& _ray, RaycastInfo& _raycastInfo, Proxy
 	PROFILE("ConcaveMeshShape::raycast()");
 	// Create the callback object that will compute ray casting against triangles
 	ConcaveMeshRaycastCallback raycastCallback(m_dynamicAABBTree, *this, _proxyShape, _raycastInfo, _ray);
-	// Ask the Dynamic AABB Tree to report all AABB nodes that are hit by the ray.
-	// The raycastCallback object will then compute ray casting against the triangles
-	// in the hit AABBs.
-	m_dynamicAABBTree.raycast(_ray, [&](int32_t _nodeId, const ephysics::Ray& _ray) mutable { return raycastCallback(_nodeId, _ray);});
+	// Ask the Dynamic AABB Tree to report the AABB nodes hit by the ray (nearest first).
+	// The raycastCallback object tests the triangles of those nodes and returns the
+	// closest hit fraction to clip the ray during the traversal.
+	m_dynamicAABBTree.raycast(_ray, [&](int32_t _nodeId, const ephysics::Ray&) mutable { return raycastCallback(_nodeId);});
+	// Test the triangles remaining in the last (partial) batch
 	raycastCallback.raycastTriangles();
 	return raycastCallback.getIsHit();
 }
 
-float ConcaveMeshRaycastCallback::operator()(int32_t _nodeId, const Ray& _ray) {
-	// Add the id of the hit AABB node int32_to
-	m_hitAABBNodes.pushBack(_nodeId);
-	return _ray.maxFraction;
+float ConcaveMeshRaycastCallback::operator()(int32_t _nodeId) {
+	// Get the node data (triangle index and mesh subpart index)
+	int32_t* data = m_dynamicAABBTree.getNodeDataInt(_nodeId);
+	// Add the triangle vertices of this node in the current batch
+	m_concaveMeshShape.getTriangleVerticesWithIndexPointer(data[0], data[1], m_batchVertices[m_batchSize]);
+	m_batchData[m_batchSize][0] = data[0];
+	m_batchData[m_batchSize][1] = data[1];
+	m_batchSize++;
+	if (m_batchSize == RAYCAST_TRIANGLE_BATCH_SIZE) {
+		raycastTriangles();
+	}
+	// Clip the ray of the tree traversal with the closest hit found so far
+	if (m_isHit == true) {
+		return m_smallestHitFraction;
+	}
+	return -1.0f;
 }
 
 void ConcaveMeshRaycastCallback::raycastTriangles() {
-	etk::Vector<int32_t>::Iterator it;
-	float smallestHitFraction = m_ray.maxFraction;
-	for (it = m_hitAABBNodes.begin(); it != m_hitAABBNodes.end(); ++it) {
-		// Get the node data (triangle index and mesh subpart index)
-		int32_t* data = m_dynamicAABBTree.getNodeDataInt(*it);
-		// Get the triangle vertices for this node from the concave mesh shape
-		vec3 trianglePoints[3];
-		m_concaveMeshShape.getTriangleVerticesWithIndexPointer(data[0], data[1], trianglePoints);
-		// Create a triangle collision shape
-		float margin = m_concaveMeshShape.getTriangleMargin();
-		TriangleShape triangleShape(trianglePoints[0], trianglePoints[1], trianglePoints[2], margin);
-		triangleShape.setRaycastTestType(m_concaveMeshShape.getRaycastTestType());
-		// Ray casting test against the collision shape
-		RaycastInfo raycastInfo;
-		bool isTriangleHit = triangleShape.raycast(m_ray, raycastInfo, m_proxyShape);
-		// If the ray hit the collision shape
-		if (isTriangleHit && raycastInfo.hitFraction <= smallestHitFraction) {
-			assert(raycastInfo.hitFraction >= 0.0f);
-			m_raycastInfo.body = raycastInfo.body;
-			m_raycastInfo.proxyShape = raycastInfo.proxyShape;
-			m_raycastInfo.hitFraction = raycastInfo.hitFraction;
-			m_raycastInfo.worldPoint = raycastInfo.worldPoint;
-			m_raycastInfo.worldNormal = raycastInfo.worldNormal;
-			m_raycastInfo.meshSubpart = data[0];
-			m_raycastInfo.triangleIndex = data[1];
-			smallestHitFraction = raycastInfo.hitFraction;
-			m_isHit = true;
+	if (m_batchSize == 0) {
+		return;
+	}
+	const int32_t batchSize = RAYCAST_TRIANGLE_BATCH_SIZE;
+	const TriangleRaycastSide raycastSide = m_concaveMeshShape.getRaycastTestType();
+	// Gather the batch in a structure of arrays so that the compiler can vectorize
+	// the Moller-Trumbore test below (unused lanes get a degenerated triangle).
+	float v0x[batchSize], v0y[batchSize], v0z[batchSize];
+	float e1x[batchSize], e1y[batchSize], e1z[batchSize];
+	float e2x[batchSize], e2y[batchSize], e2z[batchSize];
+	for (int32_t iii=0; iii<batchSize; ++iii) {
+		if (iii < m_batchSize) {
+			const vec3* vertices = m_batchVertices[iii];
+			v0x[iii] = vertices[0].x();
+			v0y[iii] = vertices[0].y();
+			v0z[iii] = vertices[0].z();
+			e1x[iii] = vertices[1].x() - vertices[0].x();
+			e1y[iii] = vertices[1].y() - vertices[0].y();
+			e1z[iii] = vertices[1].z() - vertices[0].z();
+			e2x[iii] = vertices[2].x() - vertices[0].x();
+			e2y[iii] = vertices[2].y() - vertices[0].y();
+			e2z[iii] = vertices[2].z() - vertices[0].z();
+		} else {
+			v0x[iii] = v0y[iii] = v0z[iii] = 0.0f;
+			e1x[iii] = e1y[iii] = e1z[iii] = 0.0f;
+			e2x[iii] = e2y[iii] = e2z[iii] = 0.0f;
+		}
+	}
+	const float dx = m_rayDirection.x();
+	const float dy = m_rayDirection.y();
+	const float dz = m_rayDirection.z();
+	// The determinant is positive when the ray hits the front face of the triangle
+	// (same convention as TriangleShape::raycast()).
+	const float frontSign = raycastSide == BACK ? -1.0f : 1.0f;
+	const bool bothSides = raycastSide == FRONT_AND_BACK;
+	// The determinant is compared to the product of the lengths of the two edges and of the
+	// ray (|det| <= |e1|.|e2|.|d|): the test does not depend on the scale of the mesh
+	const float rayLength = m_rayDirection.length();
+	const float relativeEpsilon = 1.0e-6f;
+	float hitFraction[batchSize];
+	for (int32_t iii=0; iii<batchSize; ++iii) {
+		// p = d x e2
+		const float px = dy * e2z[iii] - dz * e2y[iii];
+		const float py = dz * e2x[iii] - dx * e2z[iii];
+		const float pz = dx * e2y[iii] - dy * e2x[iii];
+		const float det = e1x[iii] * px + e1y[iii] * py + e1z[iii] * pz;
+		const float signedDet = bothSides ? etk::abs(det) : det * frontSign;
+		const float e1Length2 = e1x[iii] * e1x[iii] + e1y[iii] * e1y[iii] + e1z[iii] * e1z[iii];
+		const float e2Length2 = e2x[iii] * e2x[iii] + e2y[iii] * e2y[iii] + e2z[iii] * e2z[iii];
+		// Parallel ray and degenerated triangles (and unused lanes) are rejected
+		const bool isNotParallel = signedDet > relativeEpsilon * etk::sqrt(e1Length2 * e2Length2) * rayLength;
+		const float invDet = isNotParallel ? 1.0f / det : 0.0f;
+		// s = origin - v0
+		const float sx = m_ray.point1.x() - v0x[iii];
+		const float sy = m_ray.point1.y() - v0y[iii];
+		const float sz = m_ray.point1.z() - v0z[iii];
+		const float u = (sx * px + sy * py + sz * pz) * invDet;
+		// q = s x e1
+		const float qx = sy * e1z[iii] - sz * e1y[iii];
+		const float qy = sz * e1x[iii] - sx * e1z[iii];
+		const float qz = sx * e1y[iii] - sy * e1x[iii];
+		const float v = (dx * qx + dy * qy + dz * qz) * invDet;
+		const float t = (e2x[iii] * qx + e2y[iii] * qy + e2z[iii] * qz) * invDet;
+		const bool isValid =    isNotParallel
+		                     && u >= 0.0f
+		                     && v >= 0.0f
+		                     && u + v <= 1.0f
+		                     && t >= 0.0f
+		                     && t <= m_smallestHitFraction;
+		hitFraction[iii] = isValid ? t : -1.0f;
+	}
+	// Keep the closest hit of the batch
+	int32_t closestId = -1;
+	for (int32_t iii=0; iii<m_batchSize; ++iii) {
+		if (    hitFraction[iii] >= 0.0f
+		     && hitFraction[iii] <= m_smallestHitFraction) {
+			m_smallestHitFraction = hitFraction[iii];
+			closestId = iii;
 		}
 	}
+	m_batchSize = 0;
+	if (closestId < 0) {
+		return;
+	}
+	const vec3* vertices = m_batchVertices[closestId];
+	vec3 localHitNormal = (vertices[1] - vertices[0]).cross(vertices[2] - vertices[0]);
+	if (localHitNormal.dot(m_rayDirection) > 0.0f) {
+		localHitNormal = -localHitNormal;
+	}
+	m_raycastInfo.body = m_proxyShape->getBody();
+	m_raycastInfo.proxyShape = m_proxyShape;
+	m_raycastInfo.hitFraction = m_smallestHitFraction;
+	m_raycastInfo.worldPoint = m_ray.point1 + m_smallestHitFraction * m_rayDirection;
+	m_raycastInfo.worldNormal = localHitNormal;
+	m_raycastInfo.meshSubpart = m_batchData[closestId][0];
+	m_raycastInfo.triangleIndex = m_batchData[closestId][1];
+	m_isHit = true;
 }
 
 size_t ConcaveMeshShape::getSizeInBytes() const {
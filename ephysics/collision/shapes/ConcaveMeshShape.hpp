@@ -16,15 +16,27 @@
 
 namespace ephysics {
 	class ConcaveMeshShape;
+	/**
+	 * @brief Raycast the triangles of a concave mesh while the dynamic AABB tree is
+	 * traversed (nearest nodes first). The leaves are tested by batches of
+	 * RAYCAST_TRIANGLE_BATCH_SIZE triangles and every hit clips the ray, so that the
+	 * tree stops exploring nodes that are farther than the closest hit found so far.
+	 */
 	class ConcaveMeshRaycastCallback {
+		public:
+			static const int32_t RAYCAST_TRIANGLE_BATCH_SIZE = 4; //!< Number of triangles tested together
 		private:
-			etk::Vector<int32_t> m_hitAABBNodes;
 			const DynamicAABBTree& m_dynamicAABBTree;
 			const ConcaveMeshShape& m_concaveMeshShape;
 			ProxyShape* m_proxyShape;
 			RaycastInfo& m_raycastInfo;
 			const Ray& m_ray;
+			vec3 m_rayDirection; //!< Non normalized direction of the ray (point2 - point1)
+			float m_smallestHitFraction; //!< Hit fraction of the closest triangle found so far
 			bool m_isHit;
+			vec3 m_batchVertices[RAYCAST_TRIANGLE_BATCH_SIZE][3]; //!< Vertices of the triangles waiting to be tested
+			int32_t m_batchData[RAYCAST_TRIANGLE_BATCH_SIZE][2]; //!< Mesh sub-part and triangle index of the triangles waiting to be tested
+			int32_t m_batchSize; //!< Number of triangles waiting to be tested
 		public:
 			// Constructor
 			ConcaveMeshRaycastCallback(const DynamicAABBTree& _dynamicAABBTree,
@@ -37,12 +49,19 @@ namespace ephysics {
 			  m_proxyShape(_proxyShape),
 			  m_raycastInfo(_raycastInfo),
 			  m_ray(_ray),
-			  m_isHit(false) {
+			  m_rayDirection(_ray.point2 - _ray.point1),
+			  m_smallestHitFraction(_ray.maxFraction),
+			  m_isHit(false),
+			  m_batchSize(0) {
 				
 			}
-			/// Collect all the AABB nodes that are hit by the ray in the Dynamic AABB Tree
-			float operator()(int32_t _nodeId, const ephysics::Ray& _ray);
-			/// Raycast all collision shapes that have been collected
+			/**
+			 * @brief Add the triangle of a hit AABB node to the current batch (and test the batch when it is full)
+			 * @param[in] _nodeId ID of the leaf node hit by the ray
+			 * @return The smallest hit fraction found so far (to clip the ray) or -1 if there is no hit yet
+			 */
+			float operator()(int32_t _nodeId);
+			/// Raycast the triangles that are still waiting in the batch
 			void raycastTriangles();
 			/// Return true if a raycast hit has been found
 			bool getIsHit() const {
@@ -165,7 +165,15 @@ void ConvexMeshShape::recalculateBounds() {
 }
 
 bool ConvexMeshShape::raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const {
-	return _proxyShape->m_body->m_world.m_collisionDetection.m_narrowPhaseGJKAlgorithm.raycast(_ray, _proxyShape, _raycastInfo);
+	GJKAlgorithm& gjk = _proxyShape->m_body->m_world.m_collisionDetection.m_narrowPhaseGJKAlgorithm;
+	if (_proxyShape->getCollisionShape() != this) {
+		// Child of a compound shape: the proxy cached data belongs to the compound
+		void* cachedCollisionData = null;
+		bool isHit = gjk.raycast(_ray, _proxyShape, this, &cachedCollisionData, _raycastInfo);
+		free(cachedCollisionData);
+		return isHit;
+	}
+	return gjk.raycast(_ray, _proxyShape, _raycastInfo);
 }
 
 void ConvexMeshShape::setLocalScaling(const vec3& _scaling) {
@@ -244,5 +252,13 @@ void ConvexMeshShape::setIsEdgesInformationUsed(bool _isEdgesUsed) {
 bool ConvexMeshShape::testPointInside(const vec3& _localPoint,
                                       ProxyShape* _proxyShape) const {
 	// Use the GJK algorithm to test if the point is inside the convex mesh
-	return _proxyShape->m_body->m_world.m_collisionDetection.m_narrowPhaseGJKAlgorithm.testPointInside(_localPoint, _proxyShape);
+	GJKAlgorithm& gjk = _proxyShape->m_body->m_world.m_collisionDetection.m_narrowPhaseGJKAlgorithm;
+	if (_proxyShape->getCollisionShape() != this) {
+		// Child of a compound shape: the proxy cached data belongs to the compound
+		void* cachedCollisionData = null;
+		bool isInside = gjk.testPointInside(_localPoint, this, &cachedCollisionData);
+		free(cachedCollisionData);
+		return isInside;
+	}
+	return gjk.testPointInside(_localPoint, _proxyShape);
 }
\ No newline at end of file
@@ -83,6 +83,18 @@ namespace ephysics {
 		public:
 			void getLocalBounds(vec3& _min, vec3& _max) const override;
 			void computeLocalInertiaTensor(etk::Matrix3x3& _tensor, float _mass) const override;
+			/// Return the number of vertices of the mesh
+			uint32_t getNbVertices() const {
+				return m_numberVertices;
+			}
+			/// Return a vertex of the mesh (without the local scaling of the shape)
+			const vec3& getVertex(uint32_t _index) const {
+				return m_vertices[_index];
+			}
+			/// Return the adjacency list of the edges of the mesh (see addEdge())
+			const etk::Map<uint32_t, etk::Set<uint32_t> >& getEdgesAdjacencyList() const {
+				return m_edgesAdjacencyList;
+			}
 			/**
 			 * @brief Add a vertex int32_to the convex mesh
 			 * @param vertex Vertex to be added
@@ -31,3 +31,20 @@ vec3 ephysics::ConvexShape::getLocalSupportPointWithMargin(const vec3& _directio
 	}
 	return supportPoint;
 }
+
+uint32_t ephysics::ConvexShape::getLocalFeatureId(const vec3& /*_localPoint*/) const {
+	return 0;
+}
+
+uint32_t ephysics::ConvexShape::computeContactFeatureId(const ephysics::ConvexShape* _shape1,
+                                                        const vec3& _localPoint1,
+                                                        const ephysics::ConvexShape* _shape2,
+                                                        const vec3& _localPoint2) {
+	uint32_t featureId1 = _shape1->getLocalFeatureId(_localPoint1);
+	uint32_t featureId2 = _shape2->getLocalFeatureId(_localPoint2);
+	if (    featureId1 == 0
+	     || featureId2 == 0) {
+		return 0;
+	}
+	return (featureId1 << 16) | (featureId2 & 0xFFFF);
+}
@@ -26,6 +26,25 @@ class ConvexShape: public CollisionShape {
 		/// Return a local support point in a given direction without the object margin
 		virtual vec3 getLocalSupportPointWithoutMargin(const vec3& _direction, void** _cachedCollisionData) const=0;
 		bool testPointInside(const vec3& _worldPoint, ProxyShape* _proxyShape) const override = 0;
+		/**
+		 * @brief Return the ID of the feature (vertex, edge or face) of the shape nearest to a contact point.
+		 * The ID does not change while the contact slides on the same feature (warm starting of the contacts).
+		 * @param[in] _localPoint Contact point on the shape (with margin) in local-space coordinates
+		 * @return Feature ID (0 if unknown: curved shapes)
+		 */
+		virtual uint32_t getLocalFeatureId(const vec3& _localPoint) const;
+		/**
+		 * @brief Compute the feature ID of a contact between two convex shapes
+		 * @param[in] _shape1 First shape
+		 * @param[in] _localPoint1 Contact point on the first shape in its local-space coordinates
+		 * @param[in] _shape2 Second shape
+		 * @param[in] _localPoint2 Contact point on the second shape in its local-space coordinates
+		 * @return ID of the pair of features (0 if one of the features is unknown)
+		 */
+		static uint32_t computeContactFeatureId(const ConvexShape* _shape1,
+		                                        const vec3& _localPoint1,
+		                                        const ConvexShape* _shape2,
+		                                        const vec3& _localPoint2);
 	public:
 		/// Constructor
 		ConvexShape(CollisionShapeType _type, float _margin);
@@ -44,6 +63,7 @@ class ConvexShape: public CollisionShape {
 		}
 		friend class GJKAlgorithm;
 		friend class EPAAlgorithm;
+		friend class ScaledConvexShape;
 };
 
 }
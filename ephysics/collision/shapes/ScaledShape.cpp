@@ -0,0 +1,163 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#include <ephysics/collision/shapes/ScaledShape.hpp>
+#include <ephysics/debug.hpp>
+
+using namespace ephysics;
+
+namespace {
+	/**
+	 * @brief Compute the inertia tensor of a shape scaled with a diagonal matrix S from the
+	 * inertia tensor of the unscaled shape (same mass): the second moment C = tr(I)/2 - I
+	 * becomes S.C.S and the inertia tensor is I' = tr(C') - C'.
+	 */
+	void scaleInertiaTensor(etk::Matrix3x3& _tensor, const vec3& _scaling) {
+		vec3 row0 = _tensor.getRow(0);
+		vec3 row1 = _tensor.getRow(1);
+		vec3 row2 = _tensor.getRow(2);
+		float halfTrace = 0.5f * (row0.x() + row1.y() + row2.z());
+		float secondMomentX = (halfTrace - row0.x()) * _scaling.x() * _scaling.x();
+		float secondMomentY = (halfTrace - row1.y()) * _scaling.y() * _scaling.y();
+		float secondMomentZ = (halfTrace - row2.z()) * _scaling.z() * _scaling.z();
+		float trace = secondMomentX + secondMomentY + secondMomentZ;
+		_tensor.setValue(trace - secondMomentX, row0.y() * _scaling.x() * _scaling.y(), row0.z() * _scaling.x() * _scaling.z(),
+		                 row1.x() * _scaling.y() * _scaling.x(), trace - secondMomentY, row1.z() * _scaling.y() * _scaling.z(),
+		                 row2.x() * _scaling.z() * _scaling.x(), row2.y() * _scaling.z() * _scaling.y(), trace - secondMomentZ);
+	}
+	/**
+	 * @brief Scale the triangles reported by a shared concave shape before forwarding them
+	 */
+	class ScaledTriangleCallback : public TriangleCallback {
+		private:
+			TriangleCallback& m_callback;
+			const vec3& m_scaling;
+		public:
+			ScaledTriangleCallback(TriangleCallback& _callback, const vec3& _scaling):
+			  m_callback(_callback),
+			  m_scaling(_scaling) {
+
+			}
+			void testTriangle(const vec3* _trianglePoints) override {
+				vec3 trianglePoints[3];
+				trianglePoints[0] = _trianglePoints[0] * m_scaling;
+				trianglePoints[1] = _trianglePoints[1] * m_scaling;
+				trianglePoints[2] = _trianglePoints[2] * m_scaling;
+				m_callback.testTriangle(trianglePoints);
+			}
+	};
+}
+
+ScaledConvexShape::ScaledConvexShape(const ConvexShape* _shape, const vec3& _scaling):
+  ConvexShape(CONVEX_MESH, _shape->getMargin() * etk::min(_scaling.x(), etk::min(_scaling.y(), _scaling.z()))),
+  m_shape(_shape),
+  m_proxyScaling(_scaling),
+  m_proxyInverseScaling(1.0f / _scaling.x(), 1.0f / _scaling.y(), 1.0f / _scaling.z()) {
+	EPHY_ASSERT(_scaling.x() > 0.0f && _scaling.y() > 0.0f && _scaling.z() > 0.0f, "The scaling must be strictly positive");
+}
+
+void ScaledConvexShape::getLocalBounds(vec3& _min, vec3& _max) const {
+	// The scaled shape is exactly the shared shape (with its margin) scaled
+	m_shape->getLocalBounds(_min, _max);
+	_min = _min * m_proxyScaling;
+	_max = _max * m_proxyScaling;
+}
+
+void ScaledConvexShape::computeLocalInertiaTensor(etk::Matrix3x3& _tensor, float _mass) const {
+	m_shape->computeLocalInertiaTensor(_tensor, _mass);
+	scaleInertiaTensor(_tensor, m_proxyScaling);
+}
+
+vec3 ScaledConvexShape::getLocalSupportPointWithMargin(const vec3& _direction, void** _cachedCollisionData) const {
+	// Support point of S.A in direction d is S * support_A(S.d) (S is diagonal)
+	return m_shape->getLocalSupportPointWithMargin(_direction * m_proxyScaling, _cachedCollisionData) * m_proxyScaling;
+}
+
+vec3 ScaledConvexShape::getLocalSupportPointWithoutMargin(const vec3& _direction, void** _cachedCollisionData) const {
+	// The margin of the scaled shape is the smallest scaled margin: remove it from the exact support point
+	// (exact for a uniform scaling, a slightly rounded core otherwise)
+	vec3 supportPoint = getLocalSupportPointWithMargin(_direction, _cachedCollisionData);
+	if (m_margin != 0.0f) {
+		vec3 unitVec(0.0, -1.0, 0.0);
+		if (_direction.length2() > FLT_EPSILON * FLT_EPSILON) {
+			unitVec = _direction.safeNormalized();
+		}
+		supportPoint -= unitVec * m_margin;
+	}
+	return supportPoint;
+}
+
+uint32_t ScaledConvexShape::getLocalFeatureId(const vec3& _localPoint) const {
+	// The features of the scaled shape are the ones of the shared shape
+	return m_shape->getLocalFeatureId(_localPoint * m_proxyInverseScaling);
+}
+
+bool ScaledConvexShape::testPointInside(const vec3& _localPoint, ProxyShape* _proxyShape) const {
+	return m_shape->testPointInside(_localPoint * m_proxyInverseScaling, _proxyShape);
+}
+
+bool ScaledConvexShape::raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const {
+	// Raycast the shared shape with the ray in its unscaled local-space (the hit fraction is not changed by the scaling)
+	Ray unscaledRay(_ray.point1 * m_proxyInverseScaling, _ray.point2 * m_proxyInverseScaling, _ray.maxFraction);
+	if (m_shape->raycast(unscaledRay, _raycastInfo, _proxyShape) == false) {
+		return false;
+	}
+	_raycastInfo.worldPoint = _raycastInfo.worldPoint * m_proxyScaling;
+	// The normal is transformed with the inverse transpose of the scaling (it is normalized by the proxy shape)
+	_raycastInfo.worldNormal = _raycastInfo.worldNormal * m_proxyInverseScaling;
+	return true;
+}
+
+size_t ScaledConvexShape::getSizeInBytes() const {
+	return sizeof(ScaledConvexShape);
+}
+
+ScaledConcaveShape::ScaledConcaveShape(const ConcaveShape* _shape, const vec3& _scaling):
+  ConcaveShape(_shape->getType()),
+  m_shape(_shape),
+  m_proxyScaling(_scaling),
+  m_proxyInverseScaling(1.0f / _scaling.x(), 1.0f / _scaling.y(), 1.0f / _scaling.z()) {
+	EPHY_ASSERT(_scaling.x() > 0.0f && _scaling.y() > 0.0f && _scaling.z() > 0.0f, "The scaling must be strictly positive");
+	m_isSmoothMeshCollisionEnabled = _shape->getIsSmoothMeshCollisionEnabled();
+	m_triangleMargin = _shape->getTriangleMargin();
+	m_raycastTestType = _shape->getRaycastTestType();
+}
+
+void ScaledConcaveShape::getLocalBounds(vec3& _min, vec3& _max) const {
+	m_shape->getLocalBounds(_min, _max);
+	_min = _min * m_proxyScaling;
+	_max = _max * m_proxyScaling;
+	// The triangle margin is not scaled
+	_min -= vec3(m_triangleMargin, m_triangleMargin, m_triangleMargin);
+	_max += vec3(m_triangleMargin, m_triangleMargin, m_triangleMargin);
+}
+
+void ScaledConcaveShape::computeLocalInertiaTensor(etk::Matrix3x3& _tensor, float _mass) const {
+	m_shape->computeLocalInertiaTensor(_tensor, _mass);
+	scaleInertiaTensor(_tensor, m_proxyScaling);
+}
+
+void ScaledConcaveShape::testAllTriangles(TriangleCallback& _callback, const AABB& _localAABB) const {
+	// Query the shared BVH with the AABB in the unscaled local-space
+	AABB unscaledAABB(_localAABB.getMin() * m_proxyInverseScaling, _localAABB.getMax() * m_proxyInverseScaling);
+	ScaledTriangleCallback scaledCallback(_callback, m_proxyScaling);
+	m_shape->testAllTriangles(scaledCallback, unscaledAABB);
+}
+
+bool ScaledConcaveShape::raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const {
+	// Raycast the shared shape with the ray in its unscaled local-space (the hit fraction is not changed by the scaling)
+	Ray unscaledRay(_ray.point1 * m_proxyInverseScaling, _ray.point2 * m_proxyInverseScaling, _ray.maxFraction);
+	if (m_shape->raycast(unscaledRay, _raycastInfo, _proxyShape) == false) {
+		return false;
+	}
+	_raycastInfo.worldPoint = _raycastInfo.worldPoint * m_proxyScaling;
+	// The normal is transformed with the inverse transpose of the scaling (it is normalized by the proxy shape)
+	_raycastInfo.worldNormal = _raycastInfo.worldNormal * m_proxyInverseScaling;
+	return true;
+}
+
+size_t ScaledConcaveShape::getSizeInBytes() const {
+	return sizeof(ScaledConcaveShape);
+}
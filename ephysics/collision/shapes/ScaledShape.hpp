@@ -0,0 +1,74 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <ephysics/collision/shapes/ConvexShape.hpp>
+#include <ephysics/collision/shapes/ConcaveShape.hpp>
+
+namespace ephysics {
+	/**
+	 * @brief Light view of a shared convex shape with the non-uniform scaling of a proxy
+	 * shape. The support function, the bounds and the raycast apply the scaling on the
+	 * fly so that the shared shape (and its data) is never modified nor copied.
+	 * The shape is reported as a CONVEX_MESH: its collisions are always computed with GJK/EPA.
+	 */
+	class ScaledConvexShape : public ConvexShape {
+		protected:
+			const ConvexShape* m_shape; //!< Shared (unscaled) convex shape
+			vec3 m_proxyScaling; //!< Scaling of the proxy shape
+			vec3 m_proxyInverseScaling; //!< Inverse of the scaling of the proxy shape
+		public:
+			/**
+			 * @brief Constructor
+			 * @param[in] _shape Shared convex shape (not owned)
+			 * @param[in] _scaling Scaling of the proxy shape (all the components must be strictly positive)
+			 */
+			ScaledConvexShape(const ConvexShape* _shape, const vec3& _scaling);
+			/// Return the shared (unscaled) convex shape
+			const ConvexShape* getShape() const {
+				return m_shape;
+			}
+			void getLocalBounds(vec3& _min, vec3& _max) const override;
+			void computeLocalInertiaTensor(etk::Matrix3x3& _tensor, float _mass) const override;
+		protected:
+			vec3 getLocalSupportPointWithMargin(const vec3& _direction, void** _cachedCollisionData) const override;
+			vec3 getLocalSupportPointWithoutMargin(const vec3& _direction, void** _cachedCollisionData) const override;
+			uint32_t getLocalFeatureId(const vec3& _localPoint) const override;
+			bool testPointInside(const vec3& _localPoint, ProxyShape* _proxyShape) const override;
+			bool raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const override;
+			size_t getSizeInBytes() const override;
+	};
+
+	/**
+	 * @brief Light view of a shared concave shape with the non-uniform scaling of a proxy
+	 * shape. The triangles reported by the shared shape (and its BVH) are scaled on the fly.
+	 * The smooth mesh collision, the triangle margin and the raycast side are copied from the
+	 * shared shape when the view is created.
+	 */
+	class ScaledConcaveShape : public ConcaveShape {
+		protected:
+			const ConcaveShape* m_shape; //!< Shared (unscaled) concave shape
+			vec3 m_proxyScaling; //!< Scaling of the proxy shape
+			vec3 m_proxyInverseScaling; //!< Inverse of the scaling of the proxy shape
+		public:
+			/**
+			 * @brief Constructor
+			 * @param[in] _shape Shared concave shape (not owned)
+			 * @param[in] _scaling Scaling of the proxy shape (all the components must be strictly positive)
+			 */
+			ScaledConcaveShape(const ConcaveShape* _shape, const vec3& _scaling);
+			/// Return the shared (unscaled) concave shape
+			const ConcaveShape* getShape() const {
+				return m_shape;
+			}
+			void getLocalBounds(vec3& _min, vec3& _max) const override;
+			void computeLocalInertiaTensor(etk::Matrix3x3& _tensor, float _mass) const override;
+			void testAllTriangles(TriangleCallback& _callback, const AABB& _localAABB) const override;
+		protected:
+			bool raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const override;
+			size_t getSizeInBytes() const override;
+	};
+}
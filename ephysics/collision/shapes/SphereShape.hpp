@@ -31,6 +31,12 @@ namespace ephysics {
 			bool testPointInside(const vec3& _localPoint, ProxyShape* _proxyShape) const override {
 				return (_localPoint.length2() < m_margin * m_margin);
 			}
+			void testPointsInside(const vec3* _localPoints, size_t _nbPoints, bool* _isInside, ProxyShape* _proxyShape) const override {
+				const float squareRadius = m_margin * m_margin;
+				for (size_t iii=0; iii<_nbPoints; ++iii) {
+					_isInside[iii] = (_localPoints[iii].length2() < squareRadius);
+				}
+			}
 			bool raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const override;
 			size_t getSizeInBytes() const override {
 				return sizeof(SphereShape);
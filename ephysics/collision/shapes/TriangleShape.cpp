@@ -142,6 +142,24 @@ void TriangleShape::computeAABB(AABB& _aabb, const etk::Transform3D& _transform)
 	_aabb.setMax(vec3(xAxis.getMax(), yAxis.getMax(), zAxis.getMax()));
 }
 
+uint32_t TriangleShape::getLocalFeatureId(const vec3& _localPoint) const {
+	// One bit by vertex with a non null barycentric coordinate of the projected point: a vertex
+	// has 1 bit set, an edge 2 and the face 3 (0 for a degenerated triangle)
+	float u, v, w;
+	computeBarycentricCoordinatesInTriangle(m_points[0], m_points[1], m_points[2], _localPoint, u, v, w);
+	uint32_t featureId = 0;
+	if (u > 0.001f) {
+		featureId |= 1;
+	}
+	if (v > 0.001f) {
+		featureId |= 2;
+	}
+	if (w > 0.001f) {
+		featureId |= 4;
+	}
+	return featureId;
+}
+
 bool TriangleShape::testPointInside(const vec3& _localPoint, ProxyShape* _proxyShape) const {
 	return false;
 }
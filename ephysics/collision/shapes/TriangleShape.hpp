@@ -34,6 +34,7 @@ namespace ephysics {
 			/// Private assignment operator
 			TriangleShape& operator=(const TriangleShape& _shape);
 			vec3 getLocalSupportPointWithoutMargin(const vec3& _direction, void** _cachedCollisionData) const override;
+			uint32_t getLocalFeatureId(const vec3& _localPoint) const override;
 			bool testPointInside(const vec3& _localPoint, ProxyShape* _proxyShape) const override;
 			bool raycast(const Ray& _ray, RaycastInfo& _raycastInfo, ProxyShape* _proxyShape) const override;
 			size_t getSizeInBytes() const override;
@@ -95,5 +95,15 @@ namespace ephysics {
 	/// Maximum number of contact manifolds in an overlapping pair that involves at
 	/// least one concave collision shape.
 	const int32_t NB_MAX_CONTACT_MANIFOLDS_CONCAVE_SHAPE = 3;
+	
+	/// Number of collision layers of the layer collision matrix of the world
+	const uint32_t NB_COLLISION_LAYERS = 64;
+	
+	/// Time step (in seconds) of the fixed steps of DynamicsWorld::advance()
+	const float DEFAULT_FIXED_TIME_STEP = 1.0f / 60.0f;
+	
+	/// Maximum number of fixed steps executed by one call of DynamicsWorld::advance() (the
+	/// remaining time is dropped to avoid the "spiral of death" when a step is slower than real time)
+	const uint32_t DEFAULT_MAX_NB_SUB_STEPS = 5;
 
 }
@@ -8,6 +8,7 @@
  */
 // Libraries
 #include <ephysics/constraint/BallAndSocketJoint.hpp>
+#include <ephysics/engine/StateBuffer.hpp>
 #include <ephysics/engine/ConstraintSolver.hpp>
 
 using namespace ephysics;
@@ -38,8 +39,8 @@ void BallAndSocketJoint::initBeforeSolve(const ConstraintSolverData& constraintS
 	const etk::Quaternion& orientationBody2 = m_body2->getTransform().getOrientation();
 
 	// Get the inertia tensor of bodies
-	m_i1 = m_body1->getInertiaTensorInverseWorld();
-	m_i2 = m_body2->getInertiaTensorInverseWorld();
+	m_i1 = constraintSolverData.inverseInertiaTensors[m_indexBody1];
+	m_i2 = constraintSolverData.inverseInertiaTensors[m_indexBody2];
 
 	// Compute the vector from body center to the anchor point in world-space
 	m_r1World = orientationBody1 * m_localAnchorPointBody1;
@@ -210,3 +211,20 @@ void BallAndSocketJoint::solvePositionConstraint(const ConstraintSolverData& con
 	q2.normalize();
 }
 
+void BallAndSocketJoint::saveState(etk::Vector<uint8_t>& _buffer) const {
+	stateBuffer::write(_buffer, m_impulse);
+}
+
+void BallAndSocketJoint::restoreState(const uint8_t*& _data) {
+	stateBuffer::read(_data, m_impulse);
+}
+
+void BallAndSocketJoint::saveConfiguration(etk::Vector<uint8_t>& _buffer) const {
+	stateBuffer::write(_buffer, m_localAnchorPointBody1);
+	stateBuffer::write(_buffer, m_localAnchorPointBody2);
+}
+
+void BallAndSocketJoint::restoreConfiguration(const uint8_t*& _data) {
+	stateBuffer::read(_data, m_localAnchorPointBody1);
+	stateBuffer::read(_data, m_localAnchorPointBody2);
+}
@@ -61,6 +61,10 @@ namespace ephysics {
 			void warmstart(const ConstraintSolverData& _constraintSolverData) override;
 			void solveVelocityConstraint(const ConstraintSolverData& _constraintSolverData) override;
 			void solvePositionConstraint(const ConstraintSolverData& _constraintSolverData) override;
+			void saveState(etk::Vector<uint8_t>& _buffer) const override;
+			void restoreState(const uint8_t*& _data) override;
+			void saveConfiguration(etk::Vector<uint8_t>& _buffer) const override;
+			void restoreConfiguration(const uint8_t*& _data) override;
 		public:
 			/// Constructor
 			BallAndSocketJoint(const BallAndSocketJointInfo& _jointInfo);
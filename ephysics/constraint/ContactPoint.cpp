@@ -12,6 +12,27 @@
 using namespace ephysics;
 using namespace std;
 
+ContactPoint::ContactPoint():
+  m_body1(null),
+  m_body2(null),
+  m_normal(0, 0, 0),
+  m_penetrationDepth(0.0f),
+  m_localPointOnBody1(0, 0, 0),
+  m_localPointOnBody2(0, 0, 0),
+  m_worldPointOnBody1(0, 0, 0),
+  m_worldPointOnBody2(0, 0, 0),
+  m_childIndex1(-1),
+  m_childIndex2(-1),
+  m_featureId(0),
+  m_isRestingContact(false),
+  m_penetrationImpulse(0.0f),
+  m_frictionImpulse1(0.0f),
+  m_frictionImpulse2(0.0f),
+  m_rollingResistanceImpulse(0, 0, 0) {
+	m_frictionVectors[0] = vec3(0, 0, 0);
+	m_frictionVectors[1] = vec3(0, 0, 0);
+}
+
 // Constructor
 ContactPoint::ContactPoint(const ContactPointInfo& _contactInfo):
   m_body1(_contactInfo.shape1->getBody()),
@@ -26,7 +47,14 @@ ContactPoint::ContactPoint(const ContactPointInfo& _contactInfo):
   m_worldPointOnBody2(_contactInfo.shape2->getBody()->getTransform() *
                       _contactInfo.shape2->getLocalToBodyTransform() *
                       _contactInfo.localPoint2),
-  m_isRestingContact(false) {
+  m_childIndex1(_contactInfo.childIndex1),
+  m_childIndex2(_contactInfo.childIndex2),
+  m_featureId(_contactInfo.featureId),
+  m_isRestingContact(false),
+  m_penetrationImpulse(0.0f),
+  m_frictionImpulse1(0.0f),
+  m_frictionImpulse2(0.0f),
+  m_rollingResistanceImpulse(0, 0, 0) {
 
 	m_frictionVectors[0] = vec3(0, 0, 0);
 	m_frictionVectors[1] = vec3(0, 0, 0);
@@ -80,6 +108,35 @@ vec3 ContactPoint::getWorldPointOnBody2() const {
 	return m_worldPointOnBody2;
 }
 
+int32_t ContactPoint::getChildIndex1() const {
+	return m_childIndex1;
+}
+
+int32_t ContactPoint::getChildIndex2() const {
+	return m_childIndex2;
+}
+
+uint32_t ContactPoint::getFeatureId() const {
+	return m_featureId;
+}
+
+bool ContactPoint::hasSameFeatures(const ContactPoint& _contact) const {
+	return    m_featureId != 0
+	       && m_featureId == _contact.m_featureId
+	       && m_childIndex1 == _contact.m_childIndex1
+	       && m_childIndex2 == _contact.m_childIndex2;
+}
+
+void ContactPoint::copyCachedImpulses(const ContactPoint& _contact) {
+	m_isRestingContact = _contact.m_isRestingContact;
+	m_frictionVectors[0] = _contact.m_frictionVectors[0];
+	m_frictionVectors[1] = _contact.m_frictionVectors[1];
+	m_penetrationImpulse = _contact.m_penetrationImpulse;
+	m_frictionImpulse1 = _contact.m_frictionImpulse1;
+	m_frictionImpulse2 = _contact.m_frictionImpulse2;
+	m_rollingResistanceImpulse = _contact.m_rollingResistanceImpulse;
+}
+
 // Return the cached penetration impulse
 float ContactPoint::getPenetrationImpulse() const {
 	return m_penetrationImpulse;
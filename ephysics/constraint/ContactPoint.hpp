@@ -32,6 +32,9 @@ namespace ephysics {
 			float penetrationDepth; //!< Penetration depth of the contact
 			vec3 localPoint1; //!< Contact point of body 1 in local space of body 1
 			vec3 localPoint2; //!< Contact point of body 2 in local space of body 2
+			int32_t childIndex1; //!< Child index in the compound shape of body 1 (-1 if the shape 1 is not a compound)
+			int32_t childIndex2; //!< Child index in the compound shape of body 2 (-1 if the shape 2 is not a compound)
+			uint32_t featureId; //!< ID of the pair of features (vertex, edge or face) of the two shapes in contact (0 if unknown)
 			ContactPointInfo(ProxyShape* _proxyShape1,
 			                 ProxyShape* _proxyShape2,
 			                 const CollisionShape* _collShape1,
@@ -47,14 +50,20 @@ namespace ephysics {
 			  normal(_normal),
 			  penetrationDepth(_penetrationDepth),
 			  localPoint1(_localPoint1),
-			  localPoint2(_localPoint2) {
+			  localPoint2(_localPoint2),
+			  childIndex1(-1),
+			  childIndex2(-1),
+			  featureId(0) {
 				
 			}
 			ContactPointInfo():
 			  shape1(null),
 			  shape2(null),
 			  collisionShape1(null),
-			  collisionShape2(null) {
+			  collisionShape2(null),
+			  childIndex1(-1),
+			  childIndex2(-1),
+			  featureId(0) {
 				// TODO: add it for etk::Vector
 			}
 	};
@@ -67,25 +76,30 @@ namespace ephysics {
 		private :
 			CollisionBody* m_body1; //!< First rigid body of the contact
 			CollisionBody* m_body2; //!< Second rigid body of the contact
-			const vec3 m_normal; //!< Normalized normal vector of the contact (from body1 toward body2) in world space
+			vec3 m_normal; //!< Normalized normal vector of the contact (from body1 toward body2) in world space
 			float m_penetrationDepth; //!< Penetration depth
-			const vec3 m_localPointOnBody1; //!< Contact point on body 1 in local space of body 1
-			const vec3 m_localPointOnBody2; //!< Contact point on body 2 in local space of body 2
+			vec3 m_localPointOnBody1; //!< Contact point on body 1 in local space of body 1
+			vec3 m_localPointOnBody2; //!< Contact point on body 2 in local space of body 2
 			vec3 m_worldPointOnBody1; //!< Contact point on body 1 in world space
 			vec3 m_worldPointOnBody2; //!< Contact point on body 2 in world space
+			int32_t m_childIndex1; //!< Child index in the compound shape of body 1 (-1 if none)
+			int32_t m_childIndex2; //!< Child index in the compound shape of body 2 (-1 if none)
+			uint32_t m_featureId; //!< ID of the pair of features of the shapes in contact (0 if unknown)
 			bool m_isRestingContact; //!< True if the contact is a resting contact (exists for more than one time step)
 			vec3 m_frictionVectors[2]; //!< Two orthogonal vectors that span the tangential friction plane
 			float m_penetrationImpulse; //!< Cached penetration impulse
 			float m_frictionImpulse1; //!< Cached first friction impulse
 			float m_frictionImpulse2; //!< Cached second friction impulse
 			vec3 m_rollingResistanceImpulse; //!< Cached rolling resistance impulse
-			/// Private copy-constructor
-			ContactPoint(const ContactPoint& contact) = delete;
-			/// Private assignment operator
-			ContactPoint& operator=(const ContactPoint& contact) = delete;
 		public :
+			/// Constructor of an empty contact (contact points are stored by value in the manifolds)
+			ContactPoint();
 			/// Constructor
 			ContactPoint(const ContactPointInfo& contactInfo);
+			/// Copy-constructor
+			ContactPoint(const ContactPoint& _contact) = default;
+			/// Assignment operator
+			ContactPoint& operator=(const ContactPoint& _contact) = default;
 			/// Destructor
 			~ContactPoint();
 			/// Return the reference to the body 1
@@ -104,6 +118,16 @@ namespace ephysics {
 			vec3 getWorldPointOnBody1() const;
 			/// Return the contact world point on body 2
 			vec3 getWorldPointOnBody2() const;
+			/// Return the child index of the compound shape of body 1 (-1 if the shape is not a compound)
+			int32_t getChildIndex1() const;
+			/// Return the child index of the compound shape of body 2 (-1 if the shape is not a compound)
+			int32_t getChildIndex2() const;
+			/// Return the ID of the pair of features (vertex, edge or face) of the shapes in contact (0 if unknown)
+			uint32_t getFeatureId() const;
+			/// Return true if the two contacts are between the same known features of the same child shapes
+			bool hasSameFeatures(const ContactPoint& _contact) const;
+			/// Take the cached impulses, friction vectors and resting state of a previous contact of the same features (warm starting)
+			void copyCachedImpulses(const ContactPoint& _contact);
 			/// Return the cached penetration impulse
 			float getPenetrationImpulse() const;
 			/// Return the cached first friction impulse
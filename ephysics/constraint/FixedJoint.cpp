@@ -7,6 +7,7 @@
  * @license MPL v2.0 (see license file)
  */
 #include <ephysics/constraint/FixedJoint.hpp>
+#include <ephysics/engine/StateBuffer.hpp>
 #include <ephysics/engine/ConstraintSolver.hpp>
 
 using namespace ephysics;
@@ -50,8 +51,8 @@ void FixedJoint::initBeforeSolve(const ConstraintSolverData& constraintSolverDat
 	const etk::Quaternion& orientationBody2 = m_body2->getTransform().getOrientation();
 
 	// Get the inertia tensor of bodies
-	m_i1 = m_body1->getInertiaTensorInverseWorld();
-	m_i2 = m_body2->getInertiaTensorInverseWorld();
+	m_i1 = constraintSolverData.inverseInertiaTensors[m_indexBody1];
+	m_i2 = constraintSolverData.inverseInertiaTensors[m_indexBody2];
 
 	// Compute the vector from body center to the anchor point in world-space
 	m_r1World = orientationBody1 * m_localAnchorPointBody1;
@@ -309,3 +310,24 @@ void FixedJoint::solvePositionConstraint(const ConstraintSolverData& constraintS
 	q2.normalize();
 }
 
+void FixedJoint::saveState(etk::Vector<uint8_t>& _buffer) const {
+	stateBuffer::write(_buffer, m_impulseTranslation);
+	stateBuffer::write(_buffer, m_impulseRotation);
+}
+
+void FixedJoint::restoreState(const uint8_t*& _data) {
+	stateBuffer::read(_data, m_impulseTranslation);
+	stateBuffer::read(_data, m_impulseRotation);
+}
+
+void FixedJoint::saveConfiguration(etk::Vector<uint8_t>& _buffer) const {
+	stateBuffer::write(_buffer, m_localAnchorPointBody1);
+	stateBuffer::write(_buffer, m_localAnchorPointBody2);
+	stateBuffer::write(_buffer, m_initOrientationDifferenceInv);
+}
+
+void FixedJoint::restoreConfiguration(const uint8_t*& _data) {
+	stateBuffer::read(_data, m_localAnchorPointBody1);
+	stateBuffer::read(_data, m_localAnchorPointBody2);
+	stateBuffer::read(_data, m_initOrientationDifferenceInv);
+}
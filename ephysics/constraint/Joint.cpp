@@ -64,6 +64,10 @@ bool Joint::isCollisionEnabled() const {
 	return m_isCollisionEnabled;
 }
 
+JointsPositionCorrectionTechnique Joint::getPositionCorrectionTechnique() const {
+	return m_positionCorrectionTechnique;
+}
+
 // Return true if the joint has already been added int32_to an island
 bool Joint::isAlreadyInIsland() const {
 	return m_isAlreadyInIsland;
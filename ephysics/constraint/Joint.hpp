@@ -101,6 +101,14 @@ namespace ephysics {
 			virtual void solveVelocityConstraint(const ConstraintSolverData& _constraintSolverData) = 0;
 			/// Solve the position constraint
 			virtual void solvePositionConstraint(const ConstraintSolverData& _constraintSolverData) = 0;
+			/// Save the accumulated impulses of the joint (see DynamicsWorld::saveState())
+			virtual void saveState(etk::Vector<uint8_t>& _buffer) const = 0;
+			/// Restore the accumulated impulses saved with saveState()
+			virtual void restoreState(const uint8_t*& _data) = 0;
+			/// Save the configuration of the joint in its bodies local-space (anchors, axes, limits, motor; see WorldSerializer)
+			virtual void saveConfiguration(etk::Vector<uint8_t>& _buffer) const = 0;
+			/// Restore the configuration saved with saveConfiguration()
+			virtual void restoreConfiguration(const uint8_t*& _data) = 0;
 		public :
 			/// Constructor
 			Joint(const JointInfo& _jointInfo);
@@ -116,9 +124,12 @@ namespace ephysics {
 			JointType getType() const;
 			/// Return true if the collision between the two bodies of the joint is enabled
 			bool isCollisionEnabled() const;
+			/// Return the position correction technique of the joint
+			JointsPositionCorrectionTechnique getPositionCorrectionTechnique() const;
 			friend class DynamicsWorld;
 			friend class Island;
 			friend class ConstraintSolver;
+			friend class WorldSerializer;
 	};
 
 }
@@ -7,6 +7,7 @@
  * @license MPL v2.0 (see license file)
  */
 #include <ephysics/constraint/SliderJoint.hpp>
+#include <ephysics/engine/StateBuffer.hpp>
 
 using namespace ephysics;
 
@@ -64,8 +65,8 @@ void SliderJoint::initBeforeSolve(const ConstraintSolverData& constraintSolverDa
 	const etk::Quaternion& orientationBody2 = m_body2->getTransform().getOrientation();
 
 	// Get the inertia tensor of bodies
-	m_i1 = m_body1->getInertiaTensorInverseWorld();
-	m_i2 = m_body2->getInertiaTensorInverseWorld();
+	m_i1 = constraintSolverData.inverseInertiaTensors[m_indexBody1];
+	m_i2 = constraintSolverData.inverseInertiaTensors[m_indexBody2];
 
 	// Vector from body center to the anchor point
 	m_R1 = orientationBody1 * m_localAnchorPointBody1;
@@ -838,3 +839,44 @@ size_t SliderJoint::getSizeInBytes() const {
 	return sizeof(SliderJoint);
 }
 
+void SliderJoint::saveState(etk::Vector<uint8_t>& _buffer) const {
+	stateBuffer::write(_buffer, m_impulseTranslation);
+	stateBuffer::write(_buffer, m_impulseRotation);
+	stateBuffer::write(_buffer, m_impulseLowerLimit);
+	stateBuffer::write(_buffer, m_impulseUpperLimit);
+	stateBuffer::write(_buffer, m_impulseMotor);
+}
+
+void SliderJoint::restoreState(const uint8_t*& _data) {
+	stateBuffer::read(_data, m_impulseTranslation);
+	stateBuffer::read(_data, m_impulseRotation);
+	stateBuffer::read(_data, m_impulseLowerLimit);
+	stateBuffer::read(_data, m_impulseUpperLimit);
+	stateBuffer::read(_data, m_impulseMotor);
+}
+
+void SliderJoint::saveConfiguration(etk::Vector<uint8_t>& _buffer) const {
+	stateBuffer::write(_buffer, m_localAnchorPointBody1);
+	stateBuffer::write(_buffer, m_localAnchorPointBody2);
+	stateBuffer::write(_buffer, m_sliderAxisBody1);
+	stateBuffer::write(_buffer, m_initOrientationDifferenceInv);
+	stateBuffer::write(_buffer, m_isLimitEnabled);
+	stateBuffer::write(_buffer, m_isMotorEnabled);
+	stateBuffer::write(_buffer, m_lowerLimit);
+	stateBuffer::write(_buffer, m_upperLimit);
+	stateBuffer::write(_buffer, m_motorSpeed);
+	stateBuffer::write(_buffer, m_maxMotorForce);
+}
+
+void SliderJoint::restoreConfiguration(const uint8_t*& _data) {
+	stateBuffer::read(_data, m_localAnchorPointBody1);
+	stateBuffer::read(_data, m_localAnchorPointBody2);
+	stateBuffer::read(_data, m_sliderAxisBody1);
+	stateBuffer::read(_data, m_initOrientationDifferenceInv);
+	stateBuffer::read(_data, m_isLimitEnabled);
+	stateBuffer::read(_data, m_isMotorEnabled);
+	stateBuffer::read(_data, m_lowerLimit);
+	stateBuffer::read(_data, m_upperLimit);
+	stateBuffer::read(_data, m_motorSpeed);
+	stateBuffer::read(_data, m_maxMotorForce);
+}
@@ -0,0 +1,319 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#include <ephysics/engine/BodyCommandQueue.hpp>
+#include <ephysics/engine/DynamicsWorld.hpp>
+#include <ephysics/constraint/BallAndSocketJoint.hpp>
+#include <ephysics/constraint/SliderJoint.hpp>
+#include <ephysics/constraint/HingeJoint.hpp>
+#include <ephysics/constraint/FixedJoint.hpp>
+#include <ephysics/engine/Profiler.hpp>
+#include <ephysics/debug.hpp>
+
+using namespace ephysics;
+
+namespace {
+	/// Copy the information of a joint with its real type (null for an unknown type)
+	JointInfo* copyJointInfo(const JointInfo& _jointInfo) {
+		switch (_jointInfo.type) {
+			case BALLSOCKETJOINT:
+				return ETK_NEW(BallAndSocketJointInfo, static_cast<const BallAndSocketJointInfo&>(_jointInfo));
+			case SLIDERJOINT:
+				return ETK_NEW(SliderJointInfo, static_cast<const SliderJointInfo&>(_jointInfo));
+			case HINGEJOINT:
+				return ETK_NEW(HingeJointInfo, static_cast<const HingeJointInfo&>(_jointInfo));
+			case FIXEDJOINT:
+				return ETK_NEW(FixedJointInfo, static_cast<const FixedJointInfo&>(_jointInfo));
+			default:
+				return null;
+		}
+	}
+}
+
+BodyCommand::BodyCommand(Type _type):
+  type(_type),
+  body(null),
+  joint(null),
+  jointInfo(null),
+  transform(etk::Transform3D::identity()),
+  vector(0,0,0),
+  point(0,0,0),
+  next(null) {
+	
+}
+
+BodyCommand::~BodyCommand() {
+	if (jointInfo != null) {
+		ETK_DELETE(JointInfo, jointInfo);
+		jointInfo = null;
+	}
+}
+
+BodyCommandQueue::BodyCommandQueue():
+  m_head(null),
+  m_pendingFirst(null),
+  m_pendingLast(null),
+  m_batchFirst(null),
+  m_batchLast(null) {
+	
+}
+
+BodyCommandQueue::~BodyCommandQueue() {
+	clear();
+}
+
+void BodyCommandQueue::push(BodyCommand* _command) {
+	BodyCommand* head = m_head.load(std::memory_order_relaxed);
+	do {
+		_command->next = head;
+	} while (m_head.compare_exchange_weak(head, _command, std::memory_order_release, std::memory_order_relaxed) == false);
+}
+
+void BodyCommandQueue::takeCommands() {
+	BodyCommand* command = m_head.exchange(null, std::memory_order_acquire);
+	if (command == null) {
+		return;
+	}
+	// Reverse the list to get the recording order
+	BodyCommand* first = null;
+	BodyCommand* last = command;
+	while (command != null) {
+		BodyCommand* next = command->next;
+		command->next = first;
+		first = command;
+		command = next;
+	}
+	if (m_pendingLast == null) {
+		m_pendingFirst = first;
+	} else {
+		m_pendingLast->next = first;
+	}
+	m_pendingLast = last;
+}
+
+bool BodyCommandQueue::isCommandOf(const BodyCommand* _command, const RigidBody* _body, const Joint* _joint) {
+	if (_body != null) {
+		if (_command->body == _body) {
+			return true;
+		}
+		// A joint can not be created on a destroyed body
+		if (    _command->jointInfo != null
+		     && (    _command->jointInfo->body1 == _body
+		          || _command->jointInfo->body2 == _body)) {
+			return true;
+		}
+	}
+	return    _joint != null
+	       && _command->joint == _joint;
+}
+
+void BodyCommandQueue::removeCommands(BodyCommand*& _first, BodyCommand*& _last, const RigidBody* _body, const Joint* _joint) {
+	BodyCommand* previous = null;
+	BodyCommand* command = _first;
+	while (command != null) {
+		BodyCommand* next = command->next;
+		if (isCommandOf(command, _body, _joint) == true) {
+			if (previous == null) {
+				_first = next;
+			} else {
+				previous->next = next;
+			}
+			if (_last == command) {
+				_last = previous;
+			}
+			ETK_DELETE(BodyCommand, command);
+		} else {
+			previous = command;
+		}
+		command = next;
+	}
+}
+
+void BodyCommandQueue::removeCommands(const RigidBody* _body, const Joint* _joint) {
+	// The commands recorded after the batch can reference the destroyed body or joint too
+	takeCommands();
+	removeCommands(m_batchFirst, m_batchLast, _body, _joint);
+	removeCommands(m_pendingFirst, m_pendingLast, _body, _joint);
+}
+
+void BodyCommandQueue::deleteCommands(BodyCommand*& _first, BodyCommand*& _last) {
+	while (_first != null) {
+		BodyCommand* command = _first;
+		_first = command->next;
+		ETK_DELETE(BodyCommand, command);
+	}
+	_last = null;
+}
+
+void BodyCommandQueue::createRigidBody(const etk::Transform3D& _transform, etk::Function<void(RigidBody* _body)> _setup) {
+	BodyCommand* command = ETK_NEW(BodyCommand, BodyCommand::CREATE_RIGID_BODY);
+	command->transform = _transform;
+	command->setup = _setup;
+	push(command);
+}
+
+void BodyCommandQueue::destroyRigidBody(RigidBody* _body) {
+	BodyCommand* command = ETK_NEW(BodyCommand, BodyCommand::DESTROY_RIGID_BODY);
+	command->body = _body;
+	push(command);
+}
+
+void BodyCommandQueue::createJoint(const JointInfo& _jointInfo) {
+	// An unknown joint type is rejected when it is recorded (the applied commands always have a joint information)
+	JointInfo* jointInfo = copyJointInfo(_jointInfo);
+	if (jointInfo == null) {
+		EPHY_ERROR("Can not record the creation of a joint of unknown type " << int32_t(_jointInfo.type));
+		return;
+	}
+	BodyCommand* command = ETK_NEW(BodyCommand, BodyCommand::CREATE_JOINT);
+	command->jointInfo = jointInfo;
+	push(command);
+}
+
+void BodyCommandQueue::destroyJoint(Joint* _joint) {
+	BodyCommand* command = ETK_NEW(BodyCommand, BodyCommand::DESTROY_JOINT);
+	command->joint = _joint;
+	push(command);
+}
+
+void BodyCommandQueue::setTransform(RigidBody* _body, const etk::Transform3D& _transform) {
+	BodyCommand* command = ETK_NEW(BodyCommand, BodyCommand::SET_TRANSFORM);
+	command->body = _body;
+	command->transform = _transform;
+	push(command);
+}
+
+void BodyCommandQueue::setLinearVelocity(RigidBody* _body, const vec3& _linearVelocity) {
+	BodyCommand* command = ETK_NEW(BodyCommand, BodyCommand::SET_LINEAR_VELOCITY);
+	command->body = _body;
+	command->vector = _linearVelocity;
+	push(command);
+}
+
+void BodyCommandQueue::setAngularVelocity(RigidBody* _body, const vec3& _angularVelocity) {
+	BodyCommand* command = ETK_NEW(BodyCommand, BodyCommand::SET_ANGULAR_VELOCITY);
+	command->body = _body;
+	command->vector = _angularVelocity;
+	push(command);
+}
+
+void BodyCommandQueue::applyForce(RigidBody* _body, const vec3& _force, const vec3& _point) {
+	BodyCommand* command = ETK_NEW(BodyCommand, BodyCommand::APPLY_FORCE);
+	command->body = _body;
+	command->vector = _force;
+	command->point = _point;
+	push(command);
+}
+
+void BodyCommandQueue::applyForceToCenterOfMass(RigidBody* _body, const vec3& _force) {
+	BodyCommand* command = ETK_NEW(BodyCommand, BodyCommand::APPLY_FORCE_TO_CENTER_OF_MASS);
+	command->body = _body;
+	command->vector = _force;
+	push(command);
+}
+
+void BodyCommandQueue::applyTorque(RigidBody* _body, const vec3& _torque) {
+	BodyCommand* command = ETK_NEW(BodyCommand, BodyCommand::APPLY_TORQUE);
+	command->body = _body;
+	command->vector = _torque;
+	push(command);
+}
+
+void BodyCommandQueue::removeBody(const RigidBody* _body) {
+	removeCommands(_body, null);
+}
+
+void BodyCommandQueue::removeJoint(const Joint* _joint) {
+	removeCommands(null, _joint);
+}
+
+void BodyCommandQueue::clear() {
+	takeCommands();
+	deleteCommands(m_batchFirst, m_batchLast);
+	deleteCommands(m_pendingFirst, m_pendingLast);
+}
+
+void BodyCommandQueue::takeBatch() {
+	takeCommands();
+	if (m_pendingFirst == null) {
+		return;
+	}
+	if (m_batchLast == null) {
+		m_batchFirst = m_pendingFirst;
+	} else {
+		m_batchLast->next = m_pendingFirst;
+	}
+	m_batchLast = m_pendingLast;
+	m_pendingFirst = null;
+	m_pendingLast = null;
+}
+
+void BodyCommandQueue::apply(DynamicsWorld& _world) {
+	PROFILE("BodyCommandQueue::apply()");
+	if (m_batchFirst == null) {
+		return;
+	}
+	// The bodies created by the batch are inserted in the broad-phase trees in one pass
+	bool isBulkInsertion = false;
+	for (BodyCommand* command = m_batchFirst; command != null; command = command->next) {
+		if (command->type == BodyCommand::CREATE_RIGID_BODY) {
+			isBulkInsertion = true;
+			break;
+		}
+	}
+	if (isBulkInsertion == true) {
+		_world.beginBulkInsertion();
+	}
+	// The commands are removed from the batch before they are applied: a destruction
+	// removes the following commands of the destroyed body or joint from the batch
+	while (m_batchFirst != null) {
+		BodyCommand* command = m_batchFirst;
+		m_batchFirst = command->next;
+		if (m_batchFirst == null) {
+			m_batchLast = null;
+		}
+		switch (command->type) {
+			case BodyCommand::CREATE_RIGID_BODY:
+				{
+					RigidBody* body = _world.createRigidBody(command->transform);
+					if (command->setup != null) {
+						command->setup(body);
+					}
+				}
+				break;
+			case BodyCommand::DESTROY_RIGID_BODY:
+				_world.destroyRigidBody(command->body);
+				break;
+			case BodyCommand::CREATE_JOINT:
+				_world.createJoint(*command->jointInfo);
+				break;
+			case BodyCommand::DESTROY_JOINT:
+				_world.destroyJoint(command->joint);
+				break;
+			case BodyCommand::SET_TRANSFORM:
+				command->body->setTransform(command->transform);
+				break;
+			case BodyCommand::SET_LINEAR_VELOCITY:
+				command->body->setLinearVelocity(command->vector);
+				break;
+			case BodyCommand::SET_ANGULAR_VELOCITY:
+				command->body->setAngularVelocity(command->vector);
+				break;
+			case BodyCommand::APPLY_FORCE:
+				command->body->applyForce(command->vector, command->point);
+				break;
+			case BodyCommand::APPLY_FORCE_TO_CENTER_OF_MASS:
+				command->body->applyForceToCenterOfMass(command->vector);
+				break;
+			case BodyCommand::APPLY_TORQUE:
+				command->body->applyTorque(command->vector);
+				break;
+		}
+		ETK_DELETE(BodyCommand, command);
+	}
+	if (isBulkInsertion == true) {
+		_world.endBulkInsertion();
+	}
+}
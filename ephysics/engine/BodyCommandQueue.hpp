@@ -0,0 +1,141 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/Function.hpp>
+#include <etk/math/Transform3D.hpp>
+#include <etk/math/Vector3D.hpp>
+#include <atomic>
+
+namespace ephysics {
+	class DynamicsWorld;
+	class RigidBody;
+	class Joint;
+	struct JointInfo;
+	/**
+	 * @brief Operation on the world recorded in a BodyCommandQueue
+	 */
+	class BodyCommand {
+		public:
+			/// Type of the operation
+			enum Type {
+				CREATE_RIGID_BODY, //!< DynamicsWorld::createRigidBody(transform) then setup(body)
+				DESTROY_RIGID_BODY, //!< DynamicsWorld::destroyRigidBody(body)
+				CREATE_JOINT, //!< DynamicsWorld::createJoint(*jointInfo)
+				DESTROY_JOINT, //!< DynamicsWorld::destroyJoint(joint)
+				SET_TRANSFORM, //!< RigidBody::setTransform(transform)
+				SET_LINEAR_VELOCITY, //!< RigidBody::setLinearVelocity(vector)
+				SET_ANGULAR_VELOCITY, //!< RigidBody::setAngularVelocity(vector)
+				APPLY_FORCE, //!< RigidBody::applyForce(vector, point)
+				APPLY_FORCE_TO_CENTER_OF_MASS, //!< RigidBody::applyForceToCenterOfMass(vector)
+				APPLY_TORQUE //!< RigidBody::applyTorque(vector)
+			};
+			Type type; //!< Type of the operation
+			RigidBody* body; //!< Modified or destroyed body
+			Joint* joint; //!< Destroyed joint
+			JointInfo* jointInfo; //!< Copy of the information of the created joint (owned)
+			etk::Function<void(RigidBody* _body)> setup; //!< Setup of the created body
+			etk::Transform3D transform; //!< Transform of the body (SET_TRANSFORM, CREATE_RIGID_BODY)
+			vec3 vector; //!< Velocity, force or torque
+			vec3 point; //!< Point of application of the force in world-space (APPLY_FORCE)
+			BodyCommand* next; //!< Next command of the list
+			/// Constructor
+			BodyCommand(Type _type);
+			/// Destructor
+			~BodyCommand();
+			/// DELETE copy-constructor
+			BodyCommand(const BodyCommand& _obj) = delete;
+			/// DELETE assignment operator
+			BodyCommand& operator=(const BodyCommand& _obj) = delete;
+	};
+	/**
+	 * @brief Queue of operations on the bodies and the joints of a world. The operations can be
+	 * recorded from any thread without lock (even while the world is stepped on its update
+	 * thread) and are applied in a batch, in the recording order, at the start of the next step.
+	 * The batch of a step is taken by DynamicsWorld::update() or DynamicsWorld::beginUpdate() on
+	 * the calling thread: the commands recorded while a step is running are applied by the next
+	 * one. The bodies created in a batch are inserted in the broad-phase with a bulk insertion.
+	 * The recording is a lock-free multi-producer stack: the world takes the whole stack with one
+	 * atomic exchange and reverses it. takeBatch() and clear() are only called by the thread that
+	 * owns the world while no step is running. apply() is called by the step (on the update thread
+	 * for DynamicsWorld::beginUpdate()) and the destructions it applies call removeBody() and
+	 * removeJoint() from the step too: the thread that owns the world does not use the queue (nor
+	 * destroy bodies or joints) until the step is finished.
+	 */
+	class BodyCommandQueue {
+		protected:
+			std::atomic<BodyCommand*> m_head; //!< Last recorded command (the list is in the reverse order of the recording)
+			BodyCommand* m_pendingFirst; //!< First command taken from the recording stack and not in a batch yet (recording order)
+			BodyCommand* m_pendingLast; //!< Last command taken from the recording stack and not in a batch yet
+			BodyCommand* m_batchFirst; //!< First command of the batch applied by the next apply() (recording order)
+			BodyCommand* m_batchLast; //!< Last command of the batch applied by the next apply()
+			/// Record a command (any thread)
+			void push(BodyCommand* _command);
+			/// Move the recorded commands at the end of the pending commands (world thread)
+			void takeCommands();
+			/// Return true if a command uses a body (modified, destroyed or linked by a created joint) or a joint
+			static bool isCommandOf(const BodyCommand* _command, const RigidBody* _body, const Joint* _joint);
+			/// Delete the commands of a list that match a body or a joint
+			static void removeCommands(BodyCommand*& _first, BodyCommand*& _last, const RigidBody* _body, const Joint* _joint);
+			/// Delete the batch and pending commands that match a body or a joint (world thread)
+			void removeCommands(const RigidBody* _body, const Joint* _joint);
+			/// Delete the commands of a list
+			static void deleteCommands(BodyCommand*& _first, BodyCommand*& _last);
+		public:
+			/// Constructor
+			BodyCommandQueue();
+			/// Destructor (delete the commands not applied)
+			~BodyCommandQueue();
+			/// DELETE copy-constructor
+			BodyCommandQueue(const BodyCommandQueue& _obj) = delete;
+			/// DELETE assignment operator
+			BodyCommandQueue& operator=(const BodyCommandQueue& _obj) = delete;
+			/**
+			 * @brief Record the creation of a rigid body
+			 * @param[in] _transform Transform of the body (center of the body in world-space)
+			 * @param[in] _setup Called with the new body when the command is applied (on the thread that
+			 * updates the world): add the collision shapes, set the type, the mass, the user data... The
+			 * world can be modified directly in the setup (for example to create the joints of the body)
+			 * but the broad-phase is not built before the end of the batch (no query).
+			 */
+			void createRigidBody(const etk::Transform3D& _transform, etk::Function<void(RigidBody* _body)> _setup);
+			/// Record the destruction of a rigid body (the following commands of the body and the following creations of its joints are dropped)
+			void destroyRigidBody(RigidBody* _body);
+			/// Record the creation of a joint (the information is copied, a joint of unknown type is rejected)
+			void createJoint(const JointInfo& _jointInfo);
+			/// Record the destruction of a joint
+			void destroyJoint(Joint* _joint);
+			/// Record a new transform of a body
+			void setTransform(RigidBody* _body, const etk::Transform3D& _transform);
+			/// Record a new linear velocity of a body
+			void setLinearVelocity(RigidBody* _body, const vec3& _linearVelocity);
+			/// Record a new angular velocity of a body
+			void setAngularVelocity(RigidBody* _body, const vec3& _angularVelocity);
+			/// Record a force applied on a body at a given point (in world-space)
+			void applyForce(RigidBody* _body, const vec3& _force, const vec3& _point);
+			/// Record a force applied on the center of mass of a body
+			void applyForceToCenterOfMass(RigidBody* _body, const vec3& _force);
+			/// Record a torque applied on a body
+			void applyTorque(RigidBody* _body, const vec3& _torque);
+			/// Remove the commands of a body and the creations of its joints (when the body is destroyed)
+			void removeBody(const RigidBody* _body);
+			/// Remove the commands of a joint (when the joint is destroyed)
+			void removeJoint(const Joint* _joint);
+			/// Remove all the recorded commands
+			void clear();
+			/**
+			 * @brief Take all the commands recorded until now as the batch of the next apply(). The
+			 * commands recorded after this call are applied by the next batch.
+			 */
+			void takeBatch();
+			/**
+			 * @brief Apply the batch taken by takeBatch() on the world and clear it. New commands can be
+			 * recorded while it is applied (they are not part of the batch).
+			 * @param[in,out] _world World of the bodies
+			 */
+			void apply(DynamicsWorld& _world);
+	};
+}
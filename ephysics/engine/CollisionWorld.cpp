@@ -72,6 +72,29 @@ void CollisionWorld::resetContactManifoldListsOfBodies() {
 	}
 }
 
+void CollisionWorld::shiftOrigin(const vec3& _newOrigin) {
+	PROFILE("CollisionWorld::shiftOrigin()");
+	const vec3 translation = -_newOrigin;
+	for (etk::Set<CollisionBody*>::Iterator it = m_bodies.begin(); it != m_bodies.end(); ++it) {
+		(*it)->translateWorldSpace(translation);
+	}
+	m_collisionDetection.translateWorldSpace(translation);
+}
+
+void CollisionWorld::setLayersCollision(uint32_t _layer1, uint32_t _layer2, bool _canCollide) {
+	m_collisionDetection.setLayersCollision(_layer1, _layer2, _canCollide);
+	if (_canCollide == false) {
+		// The existing pairs are removed during the next narrow-phase
+		return;
+	}
+	// Test again all the shapes in the broad-phase to create the new allowed pairs
+	for (etk::Set<CollisionBody*>::Iterator it = m_bodies.begin(); it != m_bodies.end(); ++it) {
+		if ((*it)->isActive() == true) {
+			(*it)->askForBroadPhaseCollisionCheck();
+		}
+	}
+}
+
 bool CollisionWorld::testAABBOverlap(const CollisionBody* _body1, const CollisionBody* _body2) const {
 	// If one of the body is not active, we return no overlap
 	if (    !_body1->isActive()
@@ -13,6 +13,7 @@
 #include <ephysics/engine/Profiler.hpp>
 #include <ephysics/body/CollisionBody.hpp>
 #include <ephysics/collision/RaycastInfo.hpp>
+#include <ephysics/collision/DistanceInfo.hpp>
 #include <ephysics/engine/OverlappingPair.hpp>
 #include <ephysics/collision/CollisionDetection.hpp>
 #include <ephysics/constraint/Joint.hpp>
@@ -89,9 +90,108 @@ namespace ephysics {
 			 */
 			void raycast(const Ray& _ray,
 			             RaycastCallback* _raycastCallback,
-			             unsigned short _raycastWithCategoryMaskBits = 0xFFFF) const {
+			             uint64_t _raycastWithCategoryMaskBits = 0xFFFFFFFFFFFFFFFFULL) const {
 				m_collisionDetection.raycast(_raycastCallback, _ray, _raycastWithCategoryMaskBits);
 			}
+			/**
+			 * @brief Compute the distance and the closest points between two proxy shapes (GJK on
+			 * the convex shapes, the compound shapes return the nearest child). The result does not
+			 * depend on the broad-phase: it can be called for any pair of shapes.
+			 * @param[in] _shape1 First proxy shape
+			 * @param[in] _shape2 Second proxy shape
+			 * @param[out] _distanceInfo Distance, closest points and normal from the first shape to the second one
+			 * @return false if the distance can not be computed (concave mesh or height field shape)
+			 */
+			bool computeDistance(const ProxyShape* _shape1, const ProxyShape* _shape2, DistanceInfo& _distanceInfo) const {
+				return m_collisionDetection.computeDistance(_shape1, _shape2, _distanceInfo);
+			}
+			/**
+			 * @brief Find the proxy shape nearest to a point. Only the shapes whose broad-phase AABB
+			 * is closer than the maximum distance are tested, nearest AABB first. The concave shapes
+			 * are not supported and are ignored.
+			 * @param[in] _point Query point in world-space
+			 * @param[in] _maxDistance Maximum distance of the search
+			 * @param[out] _distanceInfo Nearest shape, distance, closest points (the query point then the nearest shape) and normal
+			 * @param[in] _categoryMaskBits Bits mask corresponding to the category of the shapes to search
+			 * @return true if a shape has been found within the maximum distance
+			 */
+			bool findNearest(const vec3& _point,
+			                 float _maxDistance,
+			                 DistanceInfo& _distanceInfo,
+			                 uint64_t _categoryMaskBits = 0xFFFFFFFFFFFFFFFFULL) const {
+				return m_collisionDetection.findNearest(null, _point, _maxDistance, _distanceInfo, _categoryMaskBits);
+			}
+			/**
+			 * @brief Find the proxy shape nearest to a proxy shape (the shapes of its own body are ignored)
+			 * @param[in] _shape Query proxy shape
+			 * @param[in] _maxDistance Maximum distance of the search
+			 * @param[out] _distanceInfo Nearest shape, distance, closest points (the query shape then the nearest shape) and normal
+			 * @param[in] _categoryMaskBits Bits mask corresponding to the category of the shapes to search
+			 * @return true if a shape has been found within the maximum distance
+			 */
+			bool findNearest(const ProxyShape* _shape,
+			                 float _maxDistance,
+			                 DistanceInfo& _distanceInfo,
+			                 uint64_t _categoryMaskBits = 0xFFFFFFFFFFFFFFFFULL) const {
+				return m_collisionDetection.findNearest(_shape, vec3(0.0f, 0.0f, 0.0f), _maxDistance, _distanceInfo, _categoryMaskBits);
+			}
+			/**
+			 * @brief Find the body containing each point of an array (particles classification).
+			 * The points are sorted along a Morton curve and tested by groups of spatially close
+			 * points: the broad-phase is queried once per group and each overlapping shape tests
+			 * all the points of the group in one batch (analytic tests without virtual call per
+			 * point for the box, sphere and capsule shapes).
+			 * @param[in] _points Points to test in world-space
+			 * @param[in] _nbPoints Number of points
+			 * @param[out] _bodies For each point, a body containing it (null if the point is outside of all the bodies)
+			 * @param[in] _categoryMaskBits Bits mask corresponding to the category of the shapes to test
+			 */
+			void testPointsInside(const vec3* _points,
+			                      size_t _nbPoints,
+			                      CollisionBody** _bodies,
+			                      uint64_t _categoryMaskBits = 0xFFFFFFFFFFFFFFFFULL) const {
+				m_collisionDetection.testPointsInside(_points, _nbPoints, _bodies, _categoryMaskBits);
+			}
+			/**
+			 * @brief Move the origin of the world to reduce the floating point error of the
+			 * positions far from the origin (large worlds). All the world-space data is translated
+			 * by -_newOrigin in one pass: body transforms, broad-phase AABBs (the trees keep their
+			 * structure) and world points of the cached contacts. The joints only store body-space
+			 * anchors and do not need to be updated.
+			 * @param[in] _newOrigin Position of the new origin in the current world-space
+			 */
+			virtual void shiftOrigin(const vec3& _newOrigin);
+			/**
+			 * @brief Set whether the shapes of two collision layers can collide with each other
+			 * (all the layers collide with each other by default). The filtered pairs are never
+			 * created in the broad-phase.
+			 * @param[in] _layer1 First layer (in [0, NB_COLLISION_LAYERS[)
+			 * @param[in] _layer2 Second layer (in [0, NB_COLLISION_LAYERS[)
+			 * @param[in] _canCollide True if the two layers can collide
+			 */
+			void setLayersCollision(uint32_t _layer1, uint32_t _layer2, bool _canCollide);
+			/**
+			 * @brief Return true if the shapes of two collision layers can collide with each other
+			 * @param[in] _layer1 First layer
+			 * @param[in] _layer2 Second layer
+			 * @return true if the two layers can collide
+			 */
+			bool canLayersCollide(uint32_t _layer1, uint32_t _layer2) const {
+				return m_collisionDetection.canLayersCollide(_layer1, _layer2);
+			}
+			/**
+			 * @brief Start a bulk insertion of bodies (level loading). The collision shapes added
+			 * to the bodies are not inserted in the broad-phase trees one by one (no rebalancing):
+			 * they are all inserted by endBulkInsertion() that builds the trees in one pass.
+			 * The world can not be updated or queried before endBulkInsertion().
+			 */
+			void beginBulkInsertion() {
+				m_collisionDetection.beginBulkInsertion();
+			}
+			/// End a bulk insertion started with beginBulkInsertion()
+			void endBulkInsertion() {
+				m_collisionDetection.endBulkInsertion();
+			}
 			/**
 			 * @brief Test if the AABBs of two bodies overlap
 			 * @param _body1 Pointer to the first body to test
@@ -150,6 +250,7 @@ namespace ephysics {
 			friend class CollisionBody;
 			friend class RigidBody;
 			friend class ConvexMeshShape;
+			friend class ProxyShape;
 	};
 	
 	/**
@@ -75,4 +75,9 @@ void ConstraintSolver::setConstrainedPositionsArrays(vec3* _constrainedPositions
 	assert(_constrainedOrientations != null);
 	m_constraintSolverData.positions = _constrainedPositions;
 	m_constraintSolverData.orientations = _constrainedOrientations;
+}
+
+void ConstraintSolver::setInverseInertiaTensorsArray(const etk::Matrix3x3* _inverseInertiaTensors) {
+	assert(_inverseInertiaTensors != null);
+	m_constraintSolverData.inverseInertiaTensors = _inverseInertiaTensors;
 }
\ No newline at end of file
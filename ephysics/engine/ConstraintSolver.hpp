@@ -26,6 +26,7 @@ namespace ephysics {
 			vec3* angularVelocities; //!< Array with the bodies angular velocities
 			vec3* positions; //!< Reference to the bodies positions
 			etk::Quaternion* orientations; //!< Reference to the bodies orientations
+			const etk::Matrix3x3* inverseInertiaTensors; //!< Array with the bodies world inverse inertia tensors (at the beginning of the step)
 			const etk::Map<RigidBody*, uint32_t>& mapBodyToConstrainedVelocityIndex; //!< Reference to the map that associates rigid body to their index in the constrained velocities array
 			bool isWarmStartingActive; //!< True if warm starting of the solver is active
 			/// Constructor
@@ -34,6 +35,7 @@ namespace ephysics {
 			  angularVelocities(null),
 			  positions(null),
 			  orientations(null),
+			  inverseInertiaTensors(null),
 			  mapBodyToConstrainedVelocityIndex(refMapBodyToConstrainedVelocityIndex) {
 				
 			}
@@ -136,6 +138,8 @@ namespace ephysics {
 			/// Set the constrained positions/orientations arrays
 			void setConstrainedPositionsArrays(vec3* _constrainedPositions,
 			                                   etk::Quaternion* _constrainedOrientations);
+			/// Set the array of the world inverse inertia tensors of the bodies (indexed like the velocities)
+			void setInverseInertiaTensorsArray(const etk::Matrix3x3* _inverseInertiaTensors);
 	};
 
 }
@@ -22,6 +22,7 @@ ContactSolver::ContactSolver(const etk::Map<RigidBody*, uint32_t>& _mapBodyToVel
   m_splitAngularVelocities(null),
   m_linearVelocities(null),
   m_angularVelocities(null),
+  m_inverseInertiaTensors(null),
   m_mapBodyToConstrainedVelocityIndex(_mapBodyToVelocityIndex),
   m_isWarmStartingActive(true),
   m_isSplitImpulseActive(true),
@@ -38,12 +39,30 @@ void ContactSolver::initializeForIsland(float _dt, Island* _island) {
 	assert(m_splitAngularVelocities != null);
 	// Set the current time step
 	m_timeStep = _dt;
-	m_contactConstraints.resize(_island->getNbContactManifolds());
-	// For each contact manifold of the island
+	uint32_t nbManifolds = _island->getNbContactManifolds();
 	ContactManifold** contactManifolds = _island->getContactManifold();
-	for (uint32_t iii=0; iii<m_contactConstraints.size(); ++iii) {
+	// The contact points of all the manifolds are stored contiguously
+	uint32_t nbContactPoints = 0;
+	for (uint32_t iii=0; iii<nbManifolds; ++iii) {
+		nbContactPoints += contactManifolds[iii]->getNbContactPoints();
+	}
+	m_contactConstraints.resize(nbManifolds);
+	m_contactConstraintsCold.resize(nbManifolds);
+	m_contactConstraintsRolling.resize(nbManifolds);
+	m_contactPoints.resize(nbContactPoints);
+	m_contactPointsCold.resize(nbContactPoints);
+	if (m_isSolveFrictionAtContactManifoldCenterActive == true) {
+		m_contactConstraintsFriction.resize(nbManifolds);
+	} else {
+		m_contactPointsFriction.resize(nbContactPoints);
+	}
+	uint32_t firstContact = 0;
+	// For each contact manifold of the island
+	for (uint32_t iii=0; iii<nbManifolds; ++iii) {
 		ContactManifold* externalManifold = contactManifolds[iii];
-		ContactManifoldSolver& int32_ternalManifold = m_contactConstraints[iii];
+		ContactManifoldSolver& manifold = m_contactConstraints[iii];
+		ContactManifoldSolverCold& manifoldCold = m_contactConstraintsCold[iii];
+		ContactManifoldRollingSolver& rolling = m_contactConstraintsRolling[iii];
 		assert(externalManifold->getNbContactPoints() > 0);
 		// Get the two bodies of the contact
 		RigidBody* body1 = static_cast<RigidBody*>(externalManifold->getContactPoint(0)->getBody1());
@@ -53,198 +72,242 @@ void ContactSolver::initializeForIsland(float _dt, Island* _island) {
 		// Get the position of the two bodies
 		const vec3& x1 = body1->m_centerOfMassWorld;
 		const vec3& x2 = body2->m_centerOfMassWorld;
-		// Initialize the int32_ternal contact manifold structure using the external
-		// contact manifold
-		int32_ternalManifold.indexBody1 = m_mapBodyToConstrainedVelocityIndex.find(body1)->second;
-		int32_ternalManifold.indexBody2 = m_mapBodyToConstrainedVelocityIndex.find(body2)->second;
-		int32_ternalManifold.inverseInertiaTensorBody1 = body1->getInertiaTensorInverseWorld();
-		int32_ternalManifold.inverseInertiaTensorBody2 = body2->getInertiaTensorInverseWorld();
-		int32_ternalManifold.massInverseBody1 = body1->m_massInverse;
-		int32_ternalManifold.massInverseBody2 = body2->m_massInverse;
-		int32_ternalManifold.nbContacts = externalManifold->getNbContactPoints();
-		int32_ternalManifold.restitutionFactor = computeMixedRestitutionFactor(body1, body2);
-		int32_ternalManifold.frictionCoefficient = computeMixedFrictionCoefficient(body1, body2);
-		int32_ternalManifold.rollingResistanceFactor = computeMixedRollingResistance(body1, body2);
-		int32_ternalManifold.externalContactManifold = externalManifold;
-		int32_ternalManifold.isBody1DynamicType = body1->getType() == DYNAMIC;
-		int32_ternalManifold.isBody2DynamicType = body2->getType() == DYNAMIC;
-		// If we solve the friction constraints at the center of the contact manifold
-		if (m_isSolveFrictionAtContactManifoldCenterActive) {
-			int32_ternalManifold.frictionPointBody1 = vec3(0.0f,0.0f,0.0f);
-			int32_ternalManifold.frictionPointBody2 = vec3(0.0f,0.0f,0.0f);
+		// Initialize the internal contact manifold structure using the external contact manifold
+		manifold.indexBody1 = m_mapBodyToConstrainedVelocityIndex.find(body1)->second;
+		manifold.indexBody2 = m_mapBodyToConstrainedVelocityIndex.find(body2)->second;
+		manifold.isBody1DynamicType = body1->getType() == DYNAMIC;
+		manifold.isBody2DynamicType = body2->getType() == DYNAMIC;
+		// The velocity of a non dynamic body is not changed by the impulses (null inverse mass and inertia)
+		manifold.massInverseBody1 = 0.0f;
+		manifold.massInverseBody2 = 0.0f;
+		rolling.inverseInertiaTensorBody1.setZero();
+		rolling.inverseInertiaTensorBody2.setZero();
+		if (manifold.isBody1DynamicType == true) {
+			manifold.massInverseBody1 = body1->m_massInverse;
+			rolling.inverseInertiaTensorBody1 = m_inverseInertiaTensors[manifold.indexBody1];
+		}
+		if (manifold.isBody2DynamicType == true) {
+			manifold.massInverseBody2 = body2->m_massInverse;
+			rolling.inverseInertiaTensorBody2 = m_inverseInertiaTensors[manifold.indexBody2];
 		}
+		manifold.firstContact = firstContact;
+		manifold.nbContacts = externalManifold->getNbContactPoints();
+		manifold.frictionCoefficient = computeMixedFrictionCoefficient(body1, body2);
+		manifold.rollingResistanceFactor = computeMixedRollingResistance(body1, body2);
+		manifoldCold.externalContactManifold = externalManifold;
+		manifoldCold.restitutionFactor = computeMixedRestitutionFactor(body1, body2);
+		vec3 frictionPointBody1(0.0f, 0.0f, 0.0f);
+		vec3 frictionPointBody2(0.0f, 0.0f, 0.0f);
 		// For each  contact point of the contact manifold
-		for (uint32_t ccc=0; ccc<externalManifold->getNbContactPoints(); ++ccc) {
-			ContactPointSolver& contactPoint = int32_ternalManifold.contacts[ccc];
+		for (uint32_t ccc=0; ccc<manifold.nbContacts; ++ccc) {
+			ContactPointSolver& contactPoint = m_contactPoints[firstContact + ccc];
+			ContactPointSolverCold& contactPointCold = m_contactPointsCold[firstContact + ccc];
 			// Get a contact point
 			ContactPoint* externalContact = externalManifold->getContactPoint(ccc);
 			// Get the contact point on the two bodies
 			vec3 p1 = externalContact->getWorldPointOnBody1();
 			vec3 p2 = externalContact->getWorldPointOnBody2();
-			contactPoint.externalContact = externalContact;
-			contactPoint.normal = externalContact->getNormal();
-			contactPoint.r1 = p1 - x1;
-			contactPoint.r2 = p2 - x2;
-			contactPoint.penetrationDepth = externalContact->getPenetrationDepth();
-			contactPoint.isRestingContact = externalContact->getIsRestingContact();
+			contactPointCold.externalContact = externalContact;
+			contactPointCold.r1 = p1 - x1;
+			contactPointCold.r2 = p2 - x2;
+			contactPointCold.penetrationDepth = externalContact->getPenetrationDepth();
+			contactPointCold.isRestingContact = externalContact->getIsRestingContact();
 			externalContact->setIsRestingContact(true);
-			contactPoint.oldFrictionVector1 = externalContact->getFrictionVector1();
-			contactPoint.oldFrictionvec2 = externalContact->getFrictionvec2();
-			contactPoint.penetrationImpulse = 0.0;
-			contactPoint.friction1Impulse = 0.0;
-			contactPoint.friction2Impulse = 0.0;
-			contactPoint.rollingResistanceImpulse = vec3(0.0f,0.0f,0.0f);
+			contactPointCold.oldFrictionVector1 = externalContact->getFrictionVector1();
+			contactPointCold.oldFrictionvec2 = externalContact->getFrictionvec2();
+			contactPoint.normal = externalContact->getNormal();
+			contactPoint.penetrationImpulse = 0.0f;
+			contactPoint.penetrationSplitImpulse = 0.0f;
 			// If we solve the friction constraints at the center of the contact manifold
-			if (m_isSolveFrictionAtContactManifoldCenterActive) {
-				int32_ternalManifold.frictionPointBody1 += p1;
-				int32_ternalManifold.frictionPointBody2 += p2;
+			if (m_isSolveFrictionAtContactManifoldCenterActive == true) {
+				frictionPointBody1 += p1;
+				frictionPointBody2 += p2;
+			} else {
+				ContactPointFrictionSolver& friction = m_contactPointsFriction[firstContact + ccc];
+				friction.friction1Impulse = 0.0f;
+				friction.friction2Impulse = 0.0f;
+				friction.rollingResistanceImpulse = vec3(0.0f, 0.0f, 0.0f);
 			}
 		}
 		// If we solve the friction constraints at the center of the contact manifold
-		if (m_isSolveFrictionAtContactManifoldCenterActive) {
-			int32_ternalManifold.frictionPointBody1 /=static_cast<float>(int32_ternalManifold.nbContacts);
-			int32_ternalManifold.frictionPointBody2 /=static_cast<float>(int32_ternalManifold.nbContacts);
-			int32_ternalManifold.r1Friction = int32_ternalManifold.frictionPointBody1 - x1;
-			int32_ternalManifold.r2Friction = int32_ternalManifold.frictionPointBody2 - x2;
-			int32_ternalManifold.oldFrictionVector1 = externalManifold->getFrictionVector1();
-			int32_ternalManifold.oldFrictionvec2 = externalManifold->getFrictionvec2();
+		if (m_isSolveFrictionAtContactManifoldCenterActive == true) {
+			ContactManifoldFrictionSolver& friction = m_contactConstraintsFriction[iii];
+			frictionPointBody1 /= static_cast<float>(manifold.nbContacts);
+			frictionPointBody2 /= static_cast<float>(manifold.nbContacts);
+			manifoldCold.r1Friction = frictionPointBody1 - x1;
+			manifoldCold.r2Friction = frictionPointBody2 - x2;
+			manifoldCold.oldFrictionVector1 = externalManifold->getFrictionVector1();
+			manifoldCold.oldFrictionvec2 = externalManifold->getFrictionvec2();
 			// If warm starting is active
-			if (m_isWarmStartingActive) {
+			if (m_isWarmStartingActive == true) {
 				// Initialize the accumulated impulses with the previous step accumulated impulses
-				int32_ternalManifold.friction1Impulse = externalManifold->getFrictionImpulse1();
-				int32_ternalManifold.friction2Impulse = externalManifold->getFrictionImpulse2();
-				int32_ternalManifold.frictionTwistImpulse = externalManifold->getFrictionTwistImpulse();
+				friction.friction1Impulse = externalManifold->getFrictionImpulse1();
+				friction.friction2Impulse = externalManifold->getFrictionImpulse2();
+				friction.frictionTwistImpulse = externalManifold->getFrictionTwistImpulse();
+				friction.rollingResistanceImpulse = externalManifold->getRollingResistanceImpulse();
 			} else {
 				// Initialize the accumulated impulses to zero
-				int32_ternalManifold.friction1Impulse = 0.0;
-				int32_ternalManifold.friction2Impulse = 0.0;
-				int32_ternalManifold.frictionTwistImpulse = 0.0;
-				int32_ternalManifold.rollingResistanceImpulse = vec3(0, 0, 0);
+				friction.friction1Impulse = 0.0f;
+				friction.friction2Impulse = 0.0f;
+				friction.frictionTwistImpulse = 0.0f;
+				friction.rollingResistanceImpulse = vec3(0.0f, 0.0f, 0.0f);
 			}
 		}
+		firstContact += manifold.nbContacts;
 	}
 	// Fill-in all the matrices needed to solve the LCP problem
 	initializeContactConstraints();
 }
 
 void ContactSolver::initializeContactConstraints() {
+	// The position correction bias does not change during the step
+	const float beta = m_isSplitImpulseActive ? BETA_SPLIT_IMPULSE : BETA;
 	// For each contact constraint
 	for (uint32_t c=0; c<m_contactConstraints.size(); c++) {
 		ContactManifoldSolver& manifold = m_contactConstraints[c];
+		ContactManifoldSolverCold& manifoldCold = m_contactConstraintsCold[c];
+		ContactManifoldRollingSolver& rolling = m_contactConstraintsRolling[c];
 		// Get the inertia tensors of both bodies
-		etk::Matrix3x3& I1 = manifold.inverseInertiaTensorBody1;
-		etk::Matrix3x3& I2 = manifold.inverseInertiaTensorBody2;
-		// If we solve the friction constraints at the center of the contact manifold
-		if (m_isSolveFrictionAtContactManifoldCenterActive) {
-			manifold.normal = vec3(0.0, 0.0, 0.0);
-		}
+		const etk::Matrix3x3& I1 = rolling.inverseInertiaTensorBody1;
+		const etk::Matrix3x3& I2 = rolling.inverseInertiaTensorBody2;
 		// Get the velocities of the bodies
-		const vec3& v1 = m_linearVelocities[manifold.indexBody1];
-		const vec3& w1 = m_angularVelocities[manifold.indexBody1];
-		const vec3& v2 = m_linearVelocities[manifold.indexBody2];
-		const vec3& w2 = m_angularVelocities[manifold.indexBody2];
+		ManifoldVelocities velocities;
+		gatherVelocities(manifold, m_linearVelocities, m_angularVelocities, velocities);
+		vec3 manifoldNormal(0.0f, 0.0f, 0.0f);
 		// For each contact point constraint
 		for (uint32_t i=0; i<manifold.nbContacts; i++) {
-			ContactPointSolver& contactPoint = manifold.contacts[i];
-			ContactPoint* externalContact = contactPoint.externalContact;
+			uint32_t index = manifold.firstContact + i;
+			ContactPointSolver& contactPoint = m_contactPoints[index];
+			const ContactPointSolverCold& contactPointCold = m_contactPointsCold[index];
+			ContactPoint* externalContact = contactPointCold.externalContact;
+			const vec3& r1 = contactPointCold.r1;
+			const vec3& r2 = contactPointCold.r2;
 			// Compute the velocity difference
-			vec3 deltaV = v2 + w2.cross(contactPoint.r2) - v1 - w1.cross(contactPoint.r1);
-			contactPoint.r1CrossN = contactPoint.r1.cross(contactPoint.normal);
-			contactPoint.r2CrossN = contactPoint.r2.cross(contactPoint.normal);
+			vec3 deltaV = velocities.linear2 + velocities.angular2.cross(r2) - velocities.linear1 - velocities.angular1.cross(r1);
+			// Precompute the Jacobian of the penetration constraint
+			contactPoint.r1CrossN = r1.cross(contactPoint.normal);
+			contactPoint.r2CrossN = r2.cross(contactPoint.normal);
+			contactPoint.inertia1R1CrossN = I1 * contactPoint.r1CrossN;
+			contactPoint.inertia2R2CrossN = I2 * contactPoint.r2CrossN;
 			// Compute the inverse mass matrix K for the penetration constraint
 			float massPenetration =   manifold.massInverseBody1
 			                        + manifold.massInverseBody2
-			                        + ((I1 * contactPoint.r1CrossN).cross(contactPoint.r1)).dot(contactPoint.normal)
-			                        + ((I2 * contactPoint.r2CrossN).cross(contactPoint.r2)).dot(contactPoint.normal);
-			if (massPenetration > 0.0) {
+			                        + (contactPoint.inertia1R1CrossN.cross(r1)).dot(contactPoint.normal)
+			                        + (contactPoint.inertia2R2CrossN.cross(r2)).dot(contactPoint.normal);
+			contactPoint.inversePenetrationMass = 0.0f;
+			if (massPenetration > 0.0f) {
 				contactPoint.inversePenetrationMass = 1.0f / massPenetration;
 			}
 			// If we do not solve the friction constraints at the center of the contact manifold
-			if (!m_isSolveFrictionAtContactManifoldCenterActive) {
+			if (m_isSolveFrictionAtContactManifoldCenterActive == false) {
+				ContactPointFrictionSolver& friction = m_contactPointsFriction[index];
 				// Compute the friction vectors
-				computeFrictionVectors(deltaV, contactPoint);
-				contactPoint.r1CrossT1 = contactPoint.r1.cross(contactPoint.frictionVector1);
-				contactPoint.r1CrossT2 = contactPoint.r1.cross(contactPoint.frictionvec2);
-				contactPoint.r2CrossT1 = contactPoint.r2.cross(contactPoint.frictionVector1);
-				contactPoint.r2CrossT2 = contactPoint.r2.cross(contactPoint.frictionvec2);
+				computeFrictionVectors(deltaV, contactPoint.normal, friction.frictionVector1, friction.frictionvec2);
+				friction.r1CrossT1 = r1.cross(friction.frictionVector1);
+				friction.r1CrossT2 = r1.cross(friction.frictionvec2);
+				friction.r2CrossT1 = r2.cross(friction.frictionVector1);
+				friction.r2CrossT2 = r2.cross(friction.frictionvec2);
+				friction.inertia1R1CrossT1 = I1 * friction.r1CrossT1;
+				friction.inertia1R1CrossT2 = I1 * friction.r1CrossT2;
+				friction.inertia2R2CrossT1 = I2 * friction.r2CrossT1;
+				friction.inertia2R2CrossT2 = I2 * friction.r2CrossT2;
 				// Compute the inverse mass matrix K for the friction
 				// constraints at each contact point
 				float friction1Mass =   manifold.massInverseBody1
 				                      + manifold.massInverseBody2
-				                      + ((I1 * contactPoint.r1CrossT1).cross(contactPoint.r1)).dot(contactPoint.frictionVector1)
-				                      + ((I2 * contactPoint.r2CrossT1).cross(contactPoint.r2)).dot(contactPoint.frictionVector1);
+				                      + (friction.inertia1R1CrossT1.cross(r1)).dot(friction.frictionVector1)
+				                      + (friction.inertia2R2CrossT1.cross(r2)).dot(friction.frictionVector1);
 				float friction2Mass =   manifold.massInverseBody1
 				                      + manifold.massInverseBody2
-				                      + ((I1 * contactPoint.r1CrossT2).cross(contactPoint.r1)).dot(contactPoint.frictionvec2)
-				                      + ((I2 * contactPoint.r2CrossT2).cross(contactPoint.r2)).dot(contactPoint.frictionvec2);
-				if (friction1Mass > 0.0) {
-					contactPoint.inverseFriction1Mass = 1.0f / friction1Mass;
+				                      + (friction.inertia1R1CrossT2.cross(r1)).dot(friction.frictionvec2)
+				                      + (friction.inertia2R2CrossT2.cross(r2)).dot(friction.frictionvec2);
+				friction.inverseFriction1Mass = 0.0f;
+				friction.inverseFriction2Mass = 0.0f;
+				if (friction1Mass > 0.0f) {
+					friction.inverseFriction1Mass = 1.0f / friction1Mass;
+				}
+				if (friction2Mass > 0.0f) {
+					friction.inverseFriction2Mass = 1.0f / friction2Mass;
 				}
-				if (friction2Mass > 0.0) {
-					contactPoint.inverseFriction2Mass = 1.0f / friction2Mass;
+				// If the warm starting of the contact solver is active
+				if (m_isWarmStartingActive == true) {
+					// Get the cached accumulated impulses from the previous step
+					friction.friction1Impulse = externalContact->getFrictionImpulse1();
+					friction.friction2Impulse = externalContact->getFrictionImpulse2();
+					friction.rollingResistanceImpulse = externalContact->getRollingResistanceImpulse();
 				}
 			}
 			// Compute the restitution velocity bias "b". We compute this here instead
 			// of inside the solve() method because we need to use the velocity difference
 			// at the beginning of the contact. Note that if it is a resting contact (normal
 			// velocity bellow a given threshold), we do not add a restitution velocity bias
-			contactPoint.restitutionBias = 0.0;
+			contactPoint.restitutionBias = 0.0f;
 			float deltaVDotN = deltaV.dot(contactPoint.normal);
 			if (deltaVDotN < -RESTITUTION_VELOCITY_THRESHOLD) {
-				contactPoint.restitutionBias = manifold.restitutionFactor * deltaVDotN;
+				contactPoint.restitutionBias = manifoldCold.restitutionFactor * deltaVDotN;
+			}
+			// Compute the position correction bias of the penetration depth
+			contactPoint.penetrationBias = 0.0f;
+			if (contactPointCold.penetrationDepth > SLOP) {
+				contactPoint.penetrationBias = -(beta / m_timeStep) * (contactPointCold.penetrationDepth - SLOP);
 			}
 			// If the warm starting of the contact solver is active
-			if (m_isWarmStartingActive) {
-				// Get the cached accumulated impulses from the previous step
+			if (m_isWarmStartingActive == true) {
+				// Get the cached accumulated impulse from the previous step
 				contactPoint.penetrationImpulse = externalContact->getPenetrationImpulse();
-				contactPoint.friction1Impulse = externalContact->getFrictionImpulse1();
-				contactPoint.friction2Impulse = externalContact->getFrictionImpulse2();
-				contactPoint.rollingResistanceImpulse = externalContact->getRollingResistanceImpulse();
-			}
-			// Initialize the split impulses to zero
-			contactPoint.penetrationSplitImpulse = 0.0;
-			// If we solve the friction constraints at the center of the contact manifold
-			if (m_isSolveFrictionAtContactManifoldCenterActive) {
-				manifold.normal += contactPoint.normal;
 			}
+			manifoldNormal += contactPoint.normal;
 		}
 		// Compute the inverse K matrix for the rolling resistance constraint
-		manifold.inverseRollingResistance.setZero();
+		rolling.inverseRollingResistance.setZero();
 		if (manifold.rollingResistanceFactor > 0 && (manifold.isBody1DynamicType || manifold.isBody2DynamicType)) {
-			manifold.inverseRollingResistance = manifold.inverseInertiaTensorBody1 + manifold.inverseInertiaTensorBody2;
-			manifold.inverseRollingResistance = manifold.inverseRollingResistance.getInverse();
+			rolling.inverseRollingResistance = I1 + I2;
+			rolling.inverseRollingResistance = rolling.inverseRollingResistance.getInverse();
 		}
 		// If we solve the friction constraints at the center of the contact manifold
-		if (m_isSolveFrictionAtContactManifoldCenterActive) {
-			manifold.normal.normalize();
-			vec3 deltaVFrictionPoint =   v2 + w2.cross(manifold.r2Friction)
-			                           - v1 - w1.cross(manifold.r1Friction);
+		if (m_isSolveFrictionAtContactManifoldCenterActive == true) {
+			ContactManifoldFrictionSolver& friction = m_contactConstraintsFriction[c];
+			const vec3& r1Friction = manifoldCold.r1Friction;
+			const vec3& r2Friction = manifoldCold.r2Friction;
+			friction.normal = manifoldNormal;
+			friction.normal.normalize();
+			vec3 deltaVFrictionPoint =   velocities.linear2 + velocities.angular2.cross(r2Friction)
+			                           - velocities.linear1 - velocities.angular1.cross(r1Friction);
 			// Compute the friction vectors
-			computeFrictionVectors(deltaVFrictionPoint, manifold);
+			computeFrictionVectors(deltaVFrictionPoint, friction.normal, friction.frictionVector1, friction.frictionvec2);
 			// Compute the inverse mass matrix K for the friction constraints at the center of
 			// the contact manifold
-			manifold.r1CrossT1 = manifold.r1Friction.cross(manifold.frictionVector1);
-			manifold.r1CrossT2 = manifold.r1Friction.cross(manifold.frictionvec2);
-			manifold.r2CrossT1 = manifold.r2Friction.cross(manifold.frictionVector1);
-			manifold.r2CrossT2 = manifold.r2Friction.cross(manifold.frictionvec2);
+			friction.r1CrossT1 = r1Friction.cross(friction.frictionVector1);
+			friction.r1CrossT2 = r1Friction.cross(friction.frictionvec2);
+			friction.r2CrossT1 = r2Friction.cross(friction.frictionVector1);
+			friction.r2CrossT2 = r2Friction.cross(friction.frictionvec2);
+			friction.inertia1R1CrossT1 = I1 * friction.r1CrossT1;
+			friction.inertia1R1CrossT2 = I1 * friction.r1CrossT2;
+			friction.inertia2R2CrossT1 = I2 * friction.r2CrossT1;
+			friction.inertia2R2CrossT2 = I2 * friction.r2CrossT2;
+			friction.inertia1Normal = I1 * friction.normal;
+			friction.inertia2Normal = I2 * friction.normal;
 			float friction1Mass =   manifold.massInverseBody1
 			                      + manifold.massInverseBody2
-			                      + ((I1 * manifold.r1CrossT1).cross(manifold.r1Friction)).dot(manifold.frictionVector1)
-			                      + ((I2 * manifold.r2CrossT1).cross(manifold.r2Friction)).dot(manifold.frictionVector1);
+			                      + (friction.inertia1R1CrossT1.cross(r1Friction)).dot(friction.frictionVector1)
+			                      + (friction.inertia2R2CrossT1.cross(r2Friction)).dot(friction.frictionVector1);
 			float friction2Mass =   manifold.massInverseBody1
 			                      + manifold.massInverseBody2
-			                      + ((I1 * manifold.r1CrossT2).cross(manifold.r1Friction)).dot(manifold.frictionvec2)
-			                      + ((I2 * manifold.r2CrossT2).cross(manifold.r2Friction)).dot(manifold.frictionvec2);
-			float frictionTwistMass =   manifold.normal.dot(manifold.inverseInertiaTensorBody1 * manifold.normal)
-			                          + manifold.normal.dot(manifold.inverseInertiaTensorBody2 * manifold.normal);
-			if (friction1Mass > 0.0) {
-				manifold.inverseFriction1Mass = 1.0f/friction1Mass;
+			                      + (friction.inertia1R1CrossT2.cross(r1Friction)).dot(friction.frictionvec2)
+			                      + (friction.inertia2R2CrossT2.cross(r2Friction)).dot(friction.frictionvec2);
+			float frictionTwistMass =   friction.normal.dot(friction.inertia1Normal)
+			                          + friction.normal.dot(friction.inertia2Normal);
+			friction.inverseFriction1Mass = 0.0f;
+			friction.inverseFriction2Mass = 0.0f;
+			friction.inverseTwistFrictionMass = 0.0f;
+			if (friction1Mass > 0.0f) {
+				friction.inverseFriction1Mass = 1.0f / friction1Mass;
 			}
-			if (friction2Mass > 0.0) {
-				manifold.inverseFriction2Mass = 1.0f/friction2Mass;
+			if (friction2Mass > 0.0f) {
+				friction.inverseFriction2Mass = 1.0f / friction2Mass;
 			}
-			if (frictionTwistMass > 0.0) {
-				manifold.inverseTwistFrictionMass = 1.0f / frictionTwistMass;
+			if (frictionTwistMass > 0.0f) {
+				friction.inverseTwistFrictionMass = 1.0f / frictionTwistMass;
 			}
 		}
 	}
@@ -252,397 +315,325 @@ void ContactSolver::initializeContactConstraints() {
 
 void ContactSolver::warmStart() {
 	// Check that warm starting is active
-	if (!m_isWarmStartingActive) {
+	if (m_isWarmStartingActive == false) {
 		return;
 	}
 	// For each constraint
 	for (uint32_t ccc=0; ccc<m_contactConstraints.size(); ++ccc) {
-		ContactManifoldSolver& contactManifold = m_contactConstraints[ccc];
+		const ContactManifoldSolver& manifold = m_contactConstraints[ccc];
+		const ContactManifoldSolverCold& manifoldCold = m_contactConstraintsCold[ccc];
+		const ContactManifoldRollingSolver& rolling = m_contactConstraintsRolling[ccc];
+		ManifoldVelocities velocities;
+		gatherVelocities(manifold, m_linearVelocities, m_angularVelocities, velocities);
 		bool atLeastOneRestingContactPoint = false;
-		for (uint32_t iii=0; iii<contactManifold.nbContacts; ++iii) {
-			ContactPointSolver& contactPoint = contactManifold.contacts[iii];
+		for (uint32_t iii=0; iii<manifold.nbContacts; ++iii) {
+			uint32_t index = manifold.firstContact + iii;
+			ContactPointSolver& contactPoint = m_contactPoints[index];
+			const ContactPointSolverCold& contactPointCold = m_contactPointsCold[index];
 			// If it is not a new contact (this contact was already existing at last time step)
-			if (contactPoint.isRestingContact) {
+			if (contactPointCold.isRestingContact == true) {
 				atLeastOneRestingContactPoint = true;
 				// --------- Penetration --------- //
-				// Compute the impulse P = J^T * lambda
-				const Impulse impulsePenetration = computePenetrationImpulse(contactPoint.penetrationImpulse, contactPoint);
-				// Apply the impulse to the bodies of the constraint
-				applyImpulse(impulsePenetration, contactManifold);
+				applyImpulse(contactPoint.penetrationImpulse, contactPoint.normal, contactPoint.inertia1R1CrossN, contactPoint.inertia2R2CrossN, manifold, velocities);
 				// If we do not solve the friction constraints at the center of the contact manifold
-				if (!m_isSolveFrictionAtContactManifoldCenterActive) {
-					// Project the old friction impulses (with old friction vectors) int32_to
+				if (m_isSolveFrictionAtContactManifoldCenterActive == false) {
+					ContactPointFrictionSolver& friction = m_contactPointsFriction[index];
+					// Project the old friction impulses (with old friction vectors) into
 					// the new friction vectors to get the new friction impulses
-					vec3 oldFrictionImpulse = contactPoint.friction1Impulse *
-					                          contactPoint.oldFrictionVector1 +
-					                          contactPoint.friction2Impulse *
-					                          contactPoint.oldFrictionvec2;
-					contactPoint.friction1Impulse = oldFrictionImpulse.dot(contactPoint.frictionVector1);
-					contactPoint.friction2Impulse = oldFrictionImpulse.dot(contactPoint.frictionvec2);
+					vec3 oldFrictionImpulse =   friction.friction1Impulse * contactPointCold.oldFrictionVector1
+					                          + friction.friction2Impulse * contactPointCold.oldFrictionvec2;
+					friction.friction1Impulse = oldFrictionImpulse.dot(friction.frictionVector1);
+					friction.friction2Impulse = oldFrictionImpulse.dot(friction.frictionvec2);
 					// --------- Friction 1 --------- //
-					// Compute the impulse P = J^T * lambda
-					const Impulse impulseFriction1 = computeFriction1Impulse(contactPoint.friction1Impulse, contactPoint);
-					// Apply the impulses to the bodies of the constraint
-					applyImpulse(impulseFriction1, contactManifold);
+					applyImpulse(friction.friction1Impulse, friction.frictionVector1, friction.inertia1R1CrossT1, friction.inertia2R2CrossT1, manifold, velocities);
 					// --------- Friction 2 --------- //
-					// Compute the impulse P=J^T * lambda
-					const Impulse impulseFriction2 = computeFriction2Impulse(contactPoint.friction2Impulse, contactPoint);
-					// Apply the impulses to the bodies of the constraint
-					applyImpulse(impulseFriction2, contactManifold);
+					applyImpulse(friction.friction2Impulse, friction.frictionvec2, friction.inertia1R1CrossT2, friction.inertia2R2CrossT2, manifold, velocities);
 					// ------ Rolling resistance------ //
-					if (contactManifold.rollingResistanceFactor > 0) {
-						// Compute the impulse P = J^T * lambda
-						const Impulse impulseRollingResistance(vec3(0.0f,0.0f,0.0f), -contactPoint.rollingResistanceImpulse,
-						                                       vec3(0.0f,0.0f,0.0f), contactPoint.rollingResistanceImpulse);
-						// Apply the impulses to the bodies of the constraint
-						applyImpulse(impulseRollingResistance, contactManifold);
+					if (manifold.rollingResistanceFactor > 0) {
+						applyRollingResistanceImpulse(friction.rollingResistanceImpulse, rolling, velocities);
 					}
 				}
 			} else {
 				// If it is a new contact point
 				// Initialize the accumulated impulses to zero
-				contactPoint.penetrationImpulse = 0.0;
-				contactPoint.friction1Impulse = 0.0;
-				contactPoint.friction2Impulse = 0.0;
-				contactPoint.rollingResistanceImpulse = vec3(0.0f,0.0f,0.0f);
+				contactPoint.penetrationImpulse = 0.0f;
+				if (m_isSolveFrictionAtContactManifoldCenterActive == false) {
+					ContactPointFrictionSolver& friction = m_contactPointsFriction[index];
+					friction.friction1Impulse = 0.0f;
+					friction.friction2Impulse = 0.0f;
+					friction.rollingResistanceImpulse = vec3(0.0f, 0.0f, 0.0f);
+				}
 			}
 		}
-		// If we solve the friction constraints at the center of the contact manifold and there is
-		// at least one resting contact point in the contact manifold
-		if (m_isSolveFrictionAtContactManifoldCenterActive && atLeastOneRestingContactPoint) {
-			// Project the old friction impulses (with old friction vectors) int32_to the new friction
-			// vectors to get the new friction impulses
-			vec3 oldFrictionImpulse = contactManifold.friction1Impulse *
-			                          contactManifold.oldFrictionVector1 +
-			                          contactManifold.friction2Impulse *
-			                          contactManifold.oldFrictionvec2;
-			contactManifold.friction1Impulse = oldFrictionImpulse.dot(contactManifold.frictionVector1);
-			contactManifold.friction2Impulse = oldFrictionImpulse.dot(contactManifold.frictionvec2);
-			// ------ First friction constraint at the center of the contact manifold ------ //
-			// Compute the impulse P = J^T * lambda
-			vec3 linearImpulseBody1 = -contactManifold.frictionVector1 * contactManifold.friction1Impulse;
-			vec3 angularImpulseBody1 = -contactManifold.r1CrossT1 * contactManifold.friction1Impulse;
-			vec3 linearImpulseBody2 = contactManifold.frictionVector1 * contactManifold.friction1Impulse;
-			vec3 angularImpulseBody2 = contactManifold.r2CrossT1 * contactManifold.friction1Impulse;
-			const Impulse impulseFriction1(linearImpulseBody1, angularImpulseBody1,
-			                               linearImpulseBody2, angularImpulseBody2);
-			// Apply the impulses to the bodies of the constraint
-			applyImpulse(impulseFriction1, contactManifold);
-			// ------ Second friction constraint at the center of the contact manifold ----- //
-			// Compute the impulse P = J^T * lambda
-			linearImpulseBody1 = -contactManifold.frictionvec2 * contactManifold.friction2Impulse;
-			angularImpulseBody1 = -contactManifold.r1CrossT2 * contactManifold.friction2Impulse;
-			linearImpulseBody2 = contactManifold.frictionvec2 * contactManifold.friction2Impulse;
-			angularImpulseBody2 = contactManifold.r2CrossT2 * contactManifold.friction2Impulse;
-			const Impulse impulseFriction2(linearImpulseBody1, angularImpulseBody1,
-			                               linearImpulseBody2, angularImpulseBody2);
-			// Apply the impulses to the bodies of the constraint
-			applyImpulse(impulseFriction2, contactManifold);
-			// ------ Twist friction constraint at the center of the contact manifold ------ //
-			// Compute the impulse P = J^T * lambda
-			linearImpulseBody1 = vec3(0.0, 0.0, 0.0);
-			angularImpulseBody1 = -contactManifold.normal * contactManifold.frictionTwistImpulse;
-			linearImpulseBody2 = vec3(0.0, 0.0, 0.0);
-			angularImpulseBody2 = contactManifold.normal * contactManifold.frictionTwistImpulse;
-			const Impulse impulseTwistFriction(linearImpulseBody1, angularImpulseBody1,
-			                                   linearImpulseBody2, angularImpulseBody2);
-			// Apply the impulses to the bodies of the constraint
-			applyImpulse(impulseTwistFriction, contactManifold);
-			// ------ Rolling resistance at the center of the contact manifold ------ //
-			// Compute the impulse P = J^T * lambda
-			angularImpulseBody1 = -contactManifold.rollingResistanceImpulse;
-			angularImpulseBody2 = contactManifold.rollingResistanceImpulse;
-			const Impulse impulseRollingResistance(vec3(0.0f,0.0f,0.0f), angularImpulseBody1,
-			                                       vec3(0.0f,0.0f,0.0f), angularImpulseBody2);
-			// Apply the impulses to the bodies of the constraint
-			applyImpulse(impulseRollingResistance, contactManifold);
-		} else {
-			// If it is a new contact manifold
-			// Initialize the accumulated impulses to zero
-			contactManifold.friction1Impulse = 0.0;
-			contactManifold.friction2Impulse = 0.0;
-			contactManifold.frictionTwistImpulse = 0.0;
-			contactManifold.rollingResistanceImpulse = vec3(0.0f,0.0f,0.0f);
+		// If we solve the friction constraints at the center of the contact manifold
+		if (m_isSolveFrictionAtContactManifoldCenterActive == true) {
+			ContactManifoldFrictionSolver& friction = m_contactConstraintsFriction[ccc];
+			// If there is at least one resting contact point in the contact manifold
+			if (atLeastOneRestingContactPoint == true) {
+				// Project the old friction impulses (with old friction vectors) into the new friction
+				// vectors to get the new friction impulses
+				vec3 oldFrictionImpulse =   friction.friction1Impulse * manifoldCold.oldFrictionVector1
+				                          + friction.friction2Impulse * manifoldCold.oldFrictionvec2;
+				friction.friction1Impulse = oldFrictionImpulse.dot(friction.frictionVector1);
+				friction.friction2Impulse = oldFrictionImpulse.dot(friction.frictionvec2);
+				// ------ First friction constraint at the center of the contact manifold ------ //
+				applyImpulse(friction.friction1Impulse, friction.frictionVector1, friction.inertia1R1CrossT1, friction.inertia2R2CrossT1, manifold, velocities);
+				// ------ Second friction constraint at the center of the contact manifold ----- //
+				applyImpulse(friction.friction2Impulse, friction.frictionvec2, friction.inertia1R1CrossT2, friction.inertia2R2CrossT2, manifold, velocities);
+				// ------ Twist friction constraint at the center of the contact manifold ------ //
+				applyImpulse(friction.frictionTwistImpulse, vec3(0.0f, 0.0f, 0.0f), friction.inertia1Normal, friction.inertia2Normal, manifold, velocities);
+				// ------ Rolling resistance at the center of the contact manifold ------ //
+				if (manifold.rollingResistanceFactor > 0) {
+					applyRollingResistanceImpulse(friction.rollingResistanceImpulse, rolling, velocities);
+				}
+			} else {
+				// If it is a new contact manifold
+				// Initialize the accumulated impulses to zero
+				friction.friction1Impulse = 0.0f;
+				friction.friction2Impulse = 0.0f;
+				friction.frictionTwistImpulse = 0.0f;
+				friction.rollingResistanceImpulse = vec3(0.0f, 0.0f, 0.0f);
+			}
 		}
+		scatterVelocities(manifold, velocities, m_linearVelocities, m_angularVelocities);
 	}
 }
 
 void ContactSolver::solve() {
 	PROFILE("ContactSolver::solve()");
-	float deltaLambda;
-	float lambdaTemp;
 	// For each contact manifold
 	for (uint32_t ccc=0; ccc<m_contactConstraints.size(); ++ccc) {
-		ContactManifoldSolver& contactManifold = m_contactConstraints[ccc];
-		float sum_penetrationImpulse = 0.0;
-		// Get the constrained velocities
-		const vec3& v1 = m_linearVelocities[contactManifold.indexBody1];
-		const vec3& w1 = m_angularVelocities[contactManifold.indexBody1];
-		const vec3& v2 = m_linearVelocities[contactManifold.indexBody2];
-		const vec3& w2 = m_angularVelocities[contactManifold.indexBody2];
-		for (uint32_t iii=0; iii<contactManifold.nbContacts; ++iii) {
-			ContactPointSolver& contactPoint = contactManifold.contacts[iii];
+		const ContactManifoldSolver& manifold = m_contactConstraints[ccc];
+		float sumPenetrationImpulse = 0.0f;
+		// Gather the constrained velocities (and the split velocities) of the two bodies
+		ManifoldVelocities velocities;
+		gatherVelocities(manifold, m_linearVelocities, m_angularVelocities, velocities);
+		ManifoldVelocities splitVelocities;
+		if (m_isSplitImpulseActive == true) {
+			gatherVelocities(manifold, m_splitLinearVelocities, m_splitAngularVelocities, splitVelocities);
+		}
+		for (uint32_t iii=0; iii<manifold.nbContacts; ++iii) {
+			uint32_t index = manifold.firstContact + iii;
+			ContactPointSolver& contactPoint = m_contactPoints[index];
 			// --------- Penetration --------- //
 			// Compute J*v
-			vec3 deltaV = v2 + w2.cross(contactPoint.r2) - v1 - w1.cross(contactPoint.r1);
-			float deltaVDotN = deltaV.dot(contactPoint.normal);
-			float Jv = deltaVDotN;
-			// Compute the bias "b" of the constraint
-			float beta = m_isSplitImpulseActive ? BETA_SPLIT_IMPULSE : BETA;
-			float biasPenetrationDepth = 0.0;
-			if (contactPoint.penetrationDepth > SLOP) {
-				biasPenetrationDepth = -(beta/m_timeStep) * etk::max(0.0f, float(contactPoint.penetrationDepth - SLOP));
-			}
-			float b = biasPenetrationDepth + contactPoint.restitutionBias;
+			float Jv = computeJv(contactPoint.normal, contactPoint.r1CrossN, contactPoint.r2CrossN, velocities);
 			// Compute the Lagrange multiplier lambda
-			if (m_isSplitImpulseActive) {
+			float deltaLambda;
+			if (m_isSplitImpulseActive == true) {
 				deltaLambda = - (Jv + contactPoint.restitutionBias) * contactPoint.inversePenetrationMass;
 			} else {
-				deltaLambda = - (Jv + b) * contactPoint.inversePenetrationMass;
+				deltaLambda = - (Jv + contactPoint.penetrationBias + contactPoint.restitutionBias) * contactPoint.inversePenetrationMass;
 			}
-			lambdaTemp = contactPoint.penetrationImpulse;
+			float lambdaTemp = contactPoint.penetrationImpulse;
 			contactPoint.penetrationImpulse = etk::max(contactPoint.penetrationImpulse + deltaLambda, 0.0f);
 			deltaLambda = contactPoint.penetrationImpulse - lambdaTemp;
-			// Compute the impulse P=J^T * lambda
-			const Impulse impulsePenetration = computePenetrationImpulse(deltaLambda, contactPoint);
-			// Apply the impulse to the bodies of the constraint
-			applyImpulse(impulsePenetration, contactManifold);
-			sum_penetrationImpulse += contactPoint.penetrationImpulse;
+			// Apply the impulse P=J^T * lambda to the bodies of the constraint
+			applyImpulse(deltaLambda, contactPoint.normal, contactPoint.inertia1R1CrossN, contactPoint.inertia2R2CrossN, manifold, velocities);
+			sumPenetrationImpulse += contactPoint.penetrationImpulse;
 			// If the split impulse position correction is active
-			if (m_isSplitImpulseActive) {
+			if (m_isSplitImpulseActive == true) {
 				// Split impulse (position correction)
-				const vec3& v1Split = m_splitLinearVelocities[contactManifold.indexBody1];
-				const vec3& w1Split = m_splitAngularVelocities[contactManifold.indexBody1];
-				const vec3& v2Split = m_splitLinearVelocities[contactManifold.indexBody2];
-				const vec3& w2Split = m_splitAngularVelocities[contactManifold.indexBody2];
-				vec3 deltaVSplit = v2Split + w2Split.cross(contactPoint.r2) - v1Split - w1Split.cross(contactPoint.r1);
-				float JvSplit = deltaVSplit.dot(contactPoint.normal);
-				float deltaLambdaSplit = - (JvSplit + biasPenetrationDepth) * contactPoint.inversePenetrationMass;
+				float JvSplit = computeJv(contactPoint.normal, contactPoint.r1CrossN, contactPoint.r2CrossN, splitVelocities);
+				float deltaLambdaSplit = - (JvSplit + contactPoint.penetrationBias) * contactPoint.inversePenetrationMass;
 				float lambdaTempSplit = contactPoint.penetrationSplitImpulse;
 				contactPoint.penetrationSplitImpulse = etk::max(contactPoint.penetrationSplitImpulse + deltaLambdaSplit, 0.0f);
-				deltaLambda = contactPoint.penetrationSplitImpulse - lambdaTempSplit;
-				// Compute the impulse P=J^T * lambda
-				const Impulse splitImpulsePenetration = computePenetrationImpulse(deltaLambdaSplit, contactPoint);
-				applySplitImpulse(splitImpulsePenetration, contactManifold);
+				deltaLambdaSplit = contactPoint.penetrationSplitImpulse - lambdaTempSplit;
+				applyImpulse(deltaLambdaSplit, contactPoint.normal, contactPoint.inertia1R1CrossN, contactPoint.inertia2R2CrossN, manifold, splitVelocities);
 			}
 			// If we do not solve the friction constraints at the center of the contact manifold
-			if (!m_isSolveFrictionAtContactManifoldCenterActive) {
+			if (m_isSolveFrictionAtContactManifoldCenterActive == false) {
+				ContactPointFrictionSolver& friction = m_contactPointsFriction[index];
+				float frictionLimit = manifold.frictionCoefficient * contactPoint.penetrationImpulse;
 				// --------- Friction 1 --------- //
-				// Compute J*v
-				deltaV = v2 + w2.cross(contactPoint.r2) - v1 - w1.cross(contactPoint.r1);
-				Jv = deltaV.dot(contactPoint.frictionVector1);
-				// Compute the Lagrange multiplier lambda
-				deltaLambda = -Jv;
-				deltaLambda *= contactPoint.inverseFriction1Mass;
-				float frictionLimit = contactManifold.frictionCoefficient * contactPoint.penetrationImpulse;
-				lambdaTemp = contactPoint.friction1Impulse;
-				contactPoint.friction1Impulse = etk::max(-frictionLimit,
-				                                         etk::min(contactPoint.friction1Impulse + deltaLambda, frictionLimit));
-				deltaLambda = contactPoint.friction1Impulse - lambdaTemp;
-				// Compute the impulse P=J^T * lambda
-				const Impulse impulseFriction1 = computeFriction1Impulse(deltaLambda, contactPoint);
-				// Apply the impulses to the bodies of the constraint
-				applyImpulse(impulseFriction1, contactManifold);
+				Jv = computeJv(friction.frictionVector1, friction.r1CrossT1, friction.r2CrossT1, velocities);
+				deltaLambda = -Jv * friction.inverseFriction1Mass;
+				lambdaTemp = friction.friction1Impulse;
+				friction.friction1Impulse = etk::max(-frictionLimit, etk::min(friction.friction1Impulse + deltaLambda, frictionLimit));
+				deltaLambda = friction.friction1Impulse - lambdaTemp;
+				applyImpulse(deltaLambda, friction.frictionVector1, friction.inertia1R1CrossT1, friction.inertia2R2CrossT1, manifold, velocities);
 				// --------- Friction 2 --------- //
-				// Compute J*v
-				deltaV = v2 + w2.cross(contactPoint.r2) - v1 - w1.cross(contactPoint.r1);
-				Jv = deltaV.dot(contactPoint.frictionvec2);
-				// Compute the Lagrange multiplier lambda
-				deltaLambda = -Jv;
-				deltaLambda *= contactPoint.inverseFriction2Mass;
-				frictionLimit = contactManifold.frictionCoefficient * contactPoint.penetrationImpulse;
-				lambdaTemp = contactPoint.friction2Impulse;
-				contactPoint.friction2Impulse = etk::max(-frictionLimit, etk::min(contactPoint.friction2Impulse + deltaLambda, frictionLimit));
-				deltaLambda = contactPoint.friction2Impulse - lambdaTemp;
-				// Compute the impulse P=J^T * lambda
-				const Impulse impulseFriction2 = computeFriction2Impulse(deltaLambda, contactPoint);
-				// Apply the impulses to the bodies of the constraint
-				applyImpulse(impulseFriction2, contactManifold);
+				Jv = computeJv(friction.frictionvec2, friction.r1CrossT2, friction.r2CrossT2, velocities);
+				deltaLambda = -Jv * friction.inverseFriction2Mass;
+				lambdaTemp = friction.friction2Impulse;
+				friction.friction2Impulse = etk::max(-frictionLimit, etk::min(friction.friction2Impulse + deltaLambda, frictionLimit));
+				deltaLambda = friction.friction2Impulse - lambdaTemp;
+				applyImpulse(deltaLambda, friction.frictionvec2, friction.inertia1R1CrossT2, friction.inertia2R2CrossT2, manifold, velocities);
 				// --------- Rolling resistance constraint --------- //
-				if (contactManifold.rollingResistanceFactor > 0) {
+				if (manifold.rollingResistanceFactor > 0) {
+					const ContactManifoldRollingSolver& rolling = m_contactConstraintsRolling[ccc];
 					// Compute J*v
-					const vec3 JvRolling = w2 - w1;
+					const vec3 JvRolling = velocities.angular2 - velocities.angular1;
 					// Compute the Lagrange multiplier lambda
-					vec3 deltaLambdaRolling = contactManifold.inverseRollingResistance * (-JvRolling);
-					float rollingLimit = contactManifold.rollingResistanceFactor * contactPoint.penetrationImpulse;
-					vec3 lambdaTempRolling = contactPoint.rollingResistanceImpulse;
-					contactPoint.rollingResistanceImpulse = clamp(contactPoint.rollingResistanceImpulse + deltaLambdaRolling, rollingLimit);
-					deltaLambdaRolling = contactPoint.rollingResistanceImpulse - lambdaTempRolling;
-					// Compute the impulse P=J^T * lambda
-					const Impulse impulseRolling(vec3(0.0f,0.0f,0.0f), -deltaLambdaRolling,
-					                             vec3(0.0f,0.0f,0.0f), deltaLambdaRolling);
-					// Apply the impulses to the bodies of the constraint
-					applyImpulse(impulseRolling, contactManifold);
+					vec3 deltaLambdaRolling = rolling.inverseRollingResistance * (-JvRolling);
+					float rollingLimit = manifold.rollingResistanceFactor * contactPoint.penetrationImpulse;
+					vec3 lambdaTempRolling = friction.rollingResistanceImpulse;
+					friction.rollingResistanceImpulse = clamp(friction.rollingResistanceImpulse + deltaLambdaRolling, rollingLimit);
+					deltaLambdaRolling = friction.rollingResistanceImpulse - lambdaTempRolling;
+					applyRollingResistanceImpulse(deltaLambdaRolling, rolling, velocities);
 				}
 			}
 		}
 		// If we solve the friction constraints at the center of the contact manifold
-		if (m_isSolveFrictionAtContactManifoldCenterActive) {
-			// ------ First friction constraint at the center of the contact manifol ------ //
-			// Compute J*v
-			vec3 deltaV =   v2 + w2.cross(contactManifold.r2Friction)
-			              - v1 - w1.cross(contactManifold.r1Friction);
-			float Jv = deltaV.dot(contactManifold.frictionVector1);
-			// Compute the Lagrange multiplier lambda
-			float deltaLambda = -Jv * contactManifold.inverseFriction1Mass;
-			float frictionLimit = contactManifold.frictionCoefficient * sum_penetrationImpulse;
-			lambdaTemp = contactManifold.friction1Impulse;
-			contactManifold.friction1Impulse = etk::max(-frictionLimit, etk::min(contactManifold.friction1Impulse + deltaLambda, frictionLimit));
-			deltaLambda = contactManifold.friction1Impulse - lambdaTemp;
-			// Compute the impulse P=J^T * lambda
-			vec3 linearImpulseBody1 = -contactManifold.frictionVector1 * deltaLambda;
-			vec3 angularImpulseBody1 = -contactManifold.r1CrossT1 * deltaLambda;
-			vec3 linearImpulseBody2 = contactManifold.frictionVector1 * deltaLambda;
-			vec3 angularImpulseBody2 = contactManifold.r2CrossT1 * deltaLambda;
-			const Impulse impulseFriction1(linearImpulseBody1, angularImpulseBody1,
-			                               linearImpulseBody2, angularImpulseBody2);
-			// Apply the impulses to the bodies of the constraint
-			applyImpulse(impulseFriction1, contactManifold);
-			// ------ Second friction constraint at the center of the contact manifol ----- //
-			// Compute J*v
-			deltaV =   v2 + w2.cross(contactManifold.r2Friction)
-			         - v1 - w1.cross(contactManifold.r1Friction);
-			Jv = deltaV.dot(contactManifold.frictionvec2);
-			// Compute the Lagrange multiplier lambda
-			deltaLambda = -Jv * contactManifold.inverseFriction2Mass;
-			frictionLimit = contactManifold.frictionCoefficient * sum_penetrationImpulse;
-			lambdaTemp = contactManifold.friction2Impulse;
-			contactManifold.friction2Impulse = etk::max(-frictionLimit, etk::min(contactManifold.friction2Impulse + deltaLambda, frictionLimit));
-			deltaLambda = contactManifold.friction2Impulse - lambdaTemp;
-			// Compute the impulse P=J^T * lambda
-			linearImpulseBody1 = -contactManifold.frictionvec2 * deltaLambda;
-			angularImpulseBody1 = -contactManifold.r1CrossT2 * deltaLambda;
-			linearImpulseBody2 = contactManifold.frictionvec2 * deltaLambda;
-			angularImpulseBody2 = contactManifold.r2CrossT2 * deltaLambda;
-			const Impulse impulseFriction2(linearImpulseBody1, angularImpulseBody1,
-			                               linearImpulseBody2, angularImpulseBody2);
-			// Apply the impulses to the bodies of the constraint
-			applyImpulse(impulseFriction2, contactManifold);
-			// ------ Twist friction constraint at the center of the contact manifol ------ //
-			// Compute J*v
-			deltaV = w2 - w1;
-			Jv = deltaV.dot(contactManifold.normal);
-			deltaLambda = -Jv * (contactManifold.inverseTwistFrictionMass);
-			frictionLimit = contactManifold.frictionCoefficient * sum_penetrationImpulse;
-			lambdaTemp = contactManifold.frictionTwistImpulse;
-			contactManifold.frictionTwistImpulse = etk::max(-frictionLimit, etk::min(contactManifold.frictionTwistImpulse + deltaLambda, frictionLimit));
-			deltaLambda = contactManifold.frictionTwistImpulse - lambdaTemp;
-			// Compute the impulse P=J^T * lambda
-			linearImpulseBody1 = vec3(0.0, 0.0, 0.0);
-			angularImpulseBody1 = -contactManifold.normal * deltaLambda;
-			linearImpulseBody2 = vec3(0.0, 0.0, 0.0);;
-			angularImpulseBody2 = contactManifold.normal * deltaLambda;
-			const Impulse impulseTwistFriction(linearImpulseBody1, angularImpulseBody1,
-			                                   linearImpulseBody2, angularImpulseBody2);
-			// Apply the impulses to the bodies of the constraint
-			applyImpulse(impulseTwistFriction, contactManifold);
+		if (m_isSolveFrictionAtContactManifoldCenterActive == true) {
+			ContactManifoldFrictionSolver& friction = m_contactConstraintsFriction[ccc];
+			float frictionLimit = manifold.frictionCoefficient * sumPenetrationImpulse;
+			// ------ First friction constraint at the center of the contact manifold ------ //
+			float Jv = computeJv(friction.frictionVector1, friction.r1CrossT1, friction.r2CrossT1, velocities);
+			float deltaLambda = -Jv * friction.inverseFriction1Mass;
+			float lambdaTemp = friction.friction1Impulse;
+			friction.friction1Impulse = etk::max(-frictionLimit, etk::min(friction.friction1Impulse + deltaLambda, frictionLimit));
+			deltaLambda = friction.friction1Impulse - lambdaTemp;
+			applyImpulse(deltaLambda, friction.frictionVector1, friction.inertia1R1CrossT1, friction.inertia2R2CrossT1, manifold, velocities);
+			// ------ Second friction constraint at the center of the contact manifold ----- //
+			Jv = computeJv(friction.frictionvec2, friction.r1CrossT2, friction.r2CrossT2, velocities);
+			deltaLambda = -Jv * friction.inverseFriction2Mass;
+			lambdaTemp = friction.friction2Impulse;
+			friction.friction2Impulse = etk::max(-frictionLimit, etk::min(friction.friction2Impulse + deltaLambda, frictionLimit));
+			deltaLambda = friction.friction2Impulse - lambdaTemp;
+			applyImpulse(deltaLambda, friction.frictionvec2, friction.inertia1R1CrossT2, friction.inertia2R2CrossT2, manifold, velocities);
+			// ------ Twist friction constraint at the center of the contact manifold ------ //
+			Jv = (velocities.angular2 - velocities.angular1).dot(friction.normal);
+			deltaLambda = -Jv * friction.inverseTwistFrictionMass;
+			lambdaTemp = friction.frictionTwistImpulse;
+			friction.frictionTwistImpulse = etk::max(-frictionLimit, etk::min(friction.frictionTwistImpulse + deltaLambda, frictionLimit));
+			deltaLambda = friction.frictionTwistImpulse - lambdaTemp;
+			applyImpulse(deltaLambda, vec3(0.0f, 0.0f, 0.0f), friction.inertia1Normal, friction.inertia2Normal, manifold, velocities);
 			// --------- Rolling resistance constraint at the center of the contact manifold --------- //
-			if (contactManifold.rollingResistanceFactor > 0) {
+			if (manifold.rollingResistanceFactor > 0) {
+				const ContactManifoldRollingSolver& rolling = m_contactConstraintsRolling[ccc];
 				// Compute J*v
-				const vec3 JvRolling = w2 - w1;
+				const vec3 JvRolling = velocities.angular2 - velocities.angular1;
 				// Compute the Lagrange multiplier lambda
-				vec3 deltaLambdaRolling = contactManifold.inverseRollingResistance * (-JvRolling);
-				float rollingLimit = contactManifold.rollingResistanceFactor * sum_penetrationImpulse;
-				vec3 lambdaTempRolling = contactManifold.rollingResistanceImpulse;
-				contactManifold.rollingResistanceImpulse = clamp(contactManifold.rollingResistanceImpulse + deltaLambdaRolling,
-				                                                 rollingLimit);
-				deltaLambdaRolling = contactManifold.rollingResistanceImpulse - lambdaTempRolling;
-				// Compute the impulse P=J^T * lambda
-				angularImpulseBody1 = -deltaLambdaRolling;
-				angularImpulseBody2 = deltaLambdaRolling;
-				const Impulse impulseRolling(vec3(0.0f,0.0f,0.0f),
-				                             angularImpulseBody1,
-				                             vec3(0.0f,0.0f,0.0f),
-				                             angularImpulseBody2);
-				// Apply the impulses to the bodies of the constraint
-				applyImpulse(impulseRolling, contactManifold);
+				vec3 deltaLambdaRolling = rolling.inverseRollingResistance * (-JvRolling);
+				float rollingLimit = manifold.rollingResistanceFactor * sumPenetrationImpulse;
+				vec3 lambdaTempRolling = friction.rollingResistanceImpulse;
+				friction.rollingResistanceImpulse = clamp(friction.rollingResistanceImpulse + deltaLambdaRolling, rollingLimit);
+				deltaLambdaRolling = friction.rollingResistanceImpulse - lambdaTempRolling;
+				applyRollingResistanceImpulse(deltaLambdaRolling, rolling, velocities);
 			}
 		}
+		// Write back the velocities of the bodies
+		scatterVelocities(manifold, velocities, m_linearVelocities, m_angularVelocities);
+		if (m_isSplitImpulseActive == true) {
+			scatterVelocities(manifold, splitVelocities, m_splitLinearVelocities, m_splitAngularVelocities);
+		}
 	}
 }
 
 void ContactSolver::storeImpulses() {
 	// For each contact manifold
 	for (uint32_t ccc=0; ccc<m_contactConstraints.size(); ++ccc) {
-		ContactManifoldSolver& manifold = m_contactConstraints[ccc];
+		const ContactManifoldSolver& manifold = m_contactConstraints[ccc];
 		for (uint32_t iii=0; iii<manifold.nbContacts; ++iii) {
-			ContactPointSolver& contactPoint = manifold.contacts[iii];
-			contactPoint.externalContact->setPenetrationImpulse(contactPoint.penetrationImpulse);
-			contactPoint.externalContact->setFrictionImpulse1(contactPoint.friction1Impulse);
-			contactPoint.externalContact->setFrictionImpulse2(contactPoint.friction2Impulse);
-			contactPoint.externalContact->setRollingResistanceImpulse(contactPoint.rollingResistanceImpulse);
-			contactPoint.externalContact->setFrictionVector1(contactPoint.frictionVector1);
-			contactPoint.externalContact->setFrictionvec2(contactPoint.frictionvec2);
+			uint32_t index = manifold.firstContact + iii;
+			ContactPoint* externalContact = m_contactPointsCold[index].externalContact;
+			externalContact->setPenetrationImpulse(m_contactPoints[index].penetrationImpulse);
+			if (m_isSolveFrictionAtContactManifoldCenterActive == false) {
+				const ContactPointFrictionSolver& friction = m_contactPointsFriction[index];
+				externalContact->setFrictionImpulse1(friction.friction1Impulse);
+				externalContact->setFrictionImpulse2(friction.friction2Impulse);
+				externalContact->setRollingResistanceImpulse(friction.rollingResistanceImpulse);
+				externalContact->setFrictionVector1(friction.frictionVector1);
+				externalContact->setFrictionvec2(friction.frictionvec2);
+			}
+		}
+		if (m_isSolveFrictionAtContactManifoldCenterActive == true) {
+			const ContactManifoldFrictionSolver& friction = m_contactConstraintsFriction[ccc];
+			ContactManifold* externalManifold = m_contactConstraintsCold[ccc].externalContactManifold;
+			externalManifold->setFrictionImpulse1(friction.friction1Impulse);
+			externalManifold->setFrictionImpulse2(friction.friction2Impulse);
+			externalManifold->setFrictionTwistImpulse(friction.frictionTwistImpulse);
+			externalManifold->setRollingResistanceImpulse(friction.rollingResistanceImpulse);
+			externalManifold->setFrictionVector1(friction.frictionVector1);
+			externalManifold->setFrictionvec2(friction.frictionvec2);
 		}
-		manifold.externalContactManifold->setFrictionImpulse1(manifold.friction1Impulse);
-		manifold.externalContactManifold->setFrictionImpulse2(manifold.friction2Impulse);
-		manifold.externalContactManifold->setFrictionTwistImpulse(manifold.frictionTwistImpulse);
-		manifold.externalContactManifold->setRollingResistanceImpulse(manifold.rollingResistanceImpulse);
-		manifold.externalContactManifold->setFrictionVector1(manifold.frictionVector1);
-		manifold.externalContactManifold->setFrictionvec2(manifold.frictionvec2);
 	}
 }
 
-void ContactSolver::applyImpulse(const Impulse& _impulse, const ContactManifoldSolver& _manifold) {
-	// Update the velocities of the body 1 by applying the impulse P
-	m_linearVelocities[_manifold.indexBody1] += _manifold.massInverseBody1 * _impulse.linearImpulseBody1;
-	m_angularVelocities[_manifold.indexBody1] += _manifold.inverseInertiaTensorBody1 * _impulse.angularImpulseBody1;
-	// Update the velocities of the body 1 by applying the impulse P
-	m_linearVelocities[_manifold.indexBody2] += _manifold.massInverseBody2 * _impulse.linearImpulseBody2;
-	m_angularVelocities[_manifold.indexBody2] += _manifold.inverseInertiaTensorBody2 * _impulse.angularImpulseBody2;
+void ContactSolver::gatherVelocities(const ContactManifoldSolver& _manifold,
+                                     const vec3* _linearVelocities,
+                                     const vec3* _angularVelocities,
+                                     ManifoldVelocities& _velocities) {
+	_velocities.linear1 = _linearVelocities[_manifold.indexBody1];
+	_velocities.angular1 = _angularVelocities[_manifold.indexBody1];
+	_velocities.linear2 = _linearVelocities[_manifold.indexBody2];
+	_velocities.angular2 = _angularVelocities[_manifold.indexBody2];
 }
 
-void ContactSolver::applySplitImpulse(const Impulse& _impulse, const ContactManifoldSolver& _manifold) {
-	// Update the velocities of the body 1 by applying the impulse P
-	m_splitLinearVelocities[_manifold.indexBody1] += _manifold.massInverseBody1 * _impulse.linearImpulseBody1;
-	m_splitAngularVelocities[_manifold.indexBody1] += _manifold.inverseInertiaTensorBody1 * _impulse.angularImpulseBody1;
-	// Update the velocities of the body 1 by applying the impulse P
-	m_splitLinearVelocities[_manifold.indexBody2] += _manifold.massInverseBody2 * _impulse.linearImpulseBody2;
-	m_splitAngularVelocities[_manifold.indexBody2] += _manifold.inverseInertiaTensorBody2 * _impulse.angularImpulseBody2;
+void ContactSolver::scatterVelocities(const ContactManifoldSolver& _manifold,
+                                      const ManifoldVelocities& _velocities,
+                                      vec3* _linearVelocities,
+                                      vec3* _angularVelocities) {
+	// Only the dynamic bodies are updated: the static bodies are shared by the islands solved
+	// in parallel and their velocities are never written
+	if (_manifold.isBody1DynamicType == true) {
+		_linearVelocities[_manifold.indexBody1] = _velocities.linear1;
+		_angularVelocities[_manifold.indexBody1] = _velocities.angular1;
+	}
+	if (_manifold.isBody2DynamicType == true) {
+		_linearVelocities[_manifold.indexBody2] = _velocities.linear2;
+		_angularVelocities[_manifold.indexBody2] = _velocities.angular2;
+	}
 }
 
-void ContactSolver::computeFrictionVectors(const vec3& _deltaVelocity, ContactPointSolver& _contactPoint) const {
-	assert(_contactPoint.normal.length() > 0.0);
-	// Compute the velocity difference vector in the tangential plane
-	vec3 normalVelocity = _deltaVelocity.dot(_contactPoint.normal) * _contactPoint.normal;
-	vec3 tangentVelocity = _deltaVelocity - normalVelocity;
-	// If the velocty difference in the tangential plane is not zero
-	float lengthTangenVelocity = tangentVelocity.length();
-	if (lengthTangenVelocity > FLT_EPSILON) {
-		// Compute the first friction vector in the direction of the tangent
-		// velocity difference
-		_contactPoint.frictionVector1 = tangentVelocity / lengthTangenVelocity;
-	} else {
-		// Get any orthogonal vector to the normal as the first friction vector
-		_contactPoint.frictionVector1 = _contactPoint.normal.getOrthoVector();
-	}
-	// The second friction vector is computed by the cross product of the firs
-	// friction vector and the contact normal
-	_contactPoint.frictionvec2 =_contactPoint.normal.cross(_contactPoint.frictionVector1).safeNormalized();
+float ContactSolver::computeJv(const vec3& _linear,
+                               const vec3& _angular1,
+                               const vec3& _angular2,
+                               const ManifoldVelocities& _velocities) {
+	return   _linear.dot(_velocities.linear2 - _velocities.linear1)
+	       + _angular2.dot(_velocities.angular2)
+	       - _angular1.dot(_velocities.angular1);
 }
 
-void ContactSolver::computeFrictionVectors(const vec3& _deltaVelocity, ContactManifoldSolver& _contactManifold) const {
-	assert(_contactManifold.normal.length() > 0.0);
+void ContactSolver::applyImpulse(float _lambda,
+                                 const vec3& _linear,
+                                 const vec3& _inertiaAngular1,
+                                 const vec3& _inertiaAngular2,
+                                 const ContactManifoldSolver& _manifold,
+                                 ManifoldVelocities& _velocities) {
+	// Update the velocities of the bodies by applying the impulse P = J^T * lambda
+	_velocities.linear1 -= _linear * (_manifold.massInverseBody1 * _lambda);
+	_velocities.angular1 -= _inertiaAngular1 * _lambda;
+	_velocities.linear2 += _linear * (_manifold.massInverseBody2 * _lambda);
+	_velocities.angular2 += _inertiaAngular2 * _lambda;
+}
+
+void ContactSolver::applyRollingResistanceImpulse(const vec3& _impulse,
+                                                  const ContactManifoldRollingSolver& _rolling,
+                                                  ManifoldVelocities& _velocities) {
+	_velocities.angular1 -= _rolling.inverseInertiaTensorBody1 * _impulse;
+	_velocities.angular2 += _rolling.inverseInertiaTensorBody2 * _impulse;
+}
+
+void ContactSolver::computeFrictionVectors(const vec3& _deltaVelocity, const vec3& _normal, vec3& _frictionVector1, vec3& _frictionvec2) const {
+	assert(_normal.length() > 0.0);
 	// Compute the velocity difference vector in the tangential plane
-	vec3 normalVelocity = _deltaVelocity.dot(_contactManifold.normal) * _contactManifold.normal;
+	vec3 normalVelocity = _deltaVelocity.dot(_normal) * _normal;
 	vec3 tangentVelocity = _deltaVelocity - normalVelocity;
 	// If the velocty difference in the tangential plane is not zero
 	float lengthTangenVelocity = tangentVelocity.length();
 	if (lengthTangenVelocity > FLT_EPSILON) {
 		// Compute the first friction vector in the direction of the tangent
 		// velocity difference
-		_contactManifold.frictionVector1 = tangentVelocity / lengthTangenVelocity;
+		_frictionVector1 = tangentVelocity / lengthTangenVelocity;
 	} else {
 		// Get any orthogonal vector to the normal as the first friction vector
-		_contactManifold.frictionVector1 = _contactManifold.normal.getOrthoVector();
+		_frictionVector1 = _normal.getOrthoVector();
 	}
 	// The second friction vector is computed by the cross product of the firs
 	// friction vector and the contact normal
-	_contactManifold.frictionvec2 = _contactManifold.normal.cross(_contactManifold.frictionVector1).safeNormalized();
+	_frictionvec2 = _normal.cross(_frictionVector1).safeNormalized();
 }
 
 void ContactSolver::cleanup() {
 	m_contactConstraints.clear();
+	m_contactConstraintsFriction.clear();
+	m_contactConstraintsCold.clear();
+	m_contactConstraintsRolling.clear();
+	m_contactPoints.clear();
+	m_contactPointsFriction.clear();
+	m_contactPointsCold.clear();
 }
 
 void ContactSolver::setSplitVelocitiesArrays(vec3* _splitLinearVelocities, vec3* _splitAngularVelocities) {
@@ -659,6 +650,11 @@ void ContactSolver::setConstrainedVelocitiesArrays(vec3* _constrainedLinearVeloc
 	m_angularVelocities = _constrainedAngularVelocities;
 }
 
+void ContactSolver::setInverseInertiaTensorsArray(const etk::Matrix3x3* _inverseInertiaTensors) {
+	assert(_inverseInertiaTensors != NULL);
+	m_inverseInertiaTensors = _inverseInertiaTensors;
+}
+
 bool ContactSolver::isSplitImpulseActive() const {
 	return m_isSplitImpulseActive;
 }
@@ -671,6 +667,10 @@ void ContactSolver::setIsSolveFrictionAtContactManifoldCenterActive(bool _isActi
 	m_isSolveFrictionAtContactManifoldCenterActive = _isActive;
 }
 
+bool ContactSolver::isSolveFrictionAtContactManifoldCenterActive() const {
+	return m_isSolveFrictionAtContactManifoldCenterActive;
+}
+
 float ContactSolver::computeMixedRestitutionFactor(RigidBody* _body1, RigidBody* _body2) const {
 	float restitution1 = _body1->getMaterial().getBounciness();
 	float restitution2 = _body2->getMaterial().getBounciness();
@@ -689,24 +689,3 @@ float ContactSolver::computeMixedRollingResistance(RigidBody* _body1, RigidBody*
 	       * (_body1->getMaterial().getRollingResistance()
 	       + _body2->getMaterial().getRollingResistance());
 }
-
-const Impulse ContactSolver::computePenetrationImpulse(float _deltaLambda, const ContactPointSolver& _contactPoint) const {
-	return Impulse(-_contactPoint.normal * _deltaLambda,
-	               -_contactPoint.r1CrossN * _deltaLambda,
-	                _contactPoint.normal * _deltaLambda,
-	                _contactPoint.r2CrossN * _deltaLambda);
-}
-
-const Impulse ContactSolver::computeFriction1Impulse(float _deltaLambda, const ContactPointSolver& _contactPoint) const {
-	return Impulse(-_contactPoint.frictionVector1 * _deltaLambda,
-	               -_contactPoint.r1CrossT1 * _deltaLambda,
-	                _contactPoint.frictionVector1 * _deltaLambda,
-	                _contactPoint.r2CrossT1 * _deltaLambda);
-}
-
-const Impulse ContactSolver::computeFriction2Impulse(float _deltaLambda, const ContactPointSolver& _contactPoint) const {
-	return Impulse(-_contactPoint.frictionvec2 * _deltaLambda,
-	               -_contactPoint.r1CrossT2 * _deltaLambda,
-	                _contactPoint.frictionvec2 * _deltaLambda,
-	                _contactPoint.r2CrossT2 * _deltaLambda);
-}
@@ -13,7 +13,6 @@
 #include <ephysics/constraint/Joint.hpp>
 #include <ephysics/collision/ContactManifold.hpp>
 #include <ephysics/engine/Island.hpp>
-#include <ephysics/engine/Impulse.hpp>
 #include <etk/Map.hpp>
 
 namespace ephysics {
@@ -88,86 +87,144 @@ namespace ephysics {
 	class ContactSolver {
 		private:
 			/**
-			 * Contact solver int32_ternal data structure that to store all the
-			 * information relative to a contact point
+			 * @brief Hot data of a contact point read by each iteration of the solver (penetration
+			 * constraint). The Jacobian is precomputed: its angular parts are also stored multiplied by
+			 * the inverse inertia tensors (velocity change of the bodies for a unit impulse).
 			 */
 			struct ContactPointSolver {
+				vec3 normal; //!< Normal vector of the contact (linear part of the Jacobian)
+				vec3 r1CrossN; //!< Cross product of r1 with the contact normal (angular part of the Jacobian of body 1)
+				vec3 r2CrossN; //!< Cross product of r2 with the contact normal (angular part of the Jacobian of body 2)
+				vec3 inertia1R1CrossN; //!< Inverse inertia tensor of body 1 multiplied by r1CrossN
+				vec3 inertia2R2CrossN; //!< Inverse inertia tensor of body 2 multiplied by r2CrossN
+				float inversePenetrationMass; //!< Inverse of the matrix K for the penenetration
+				float restitutionBias; //!< Velocity restitution bias
+				float penetrationBias; //!< Position correction bias of the penetration depth
 				float penetrationImpulse; //!< Accumulated normal impulse
-				float friction1Impulse; //!< Accumulated impulse in the 1st friction direction
-				float friction2Impulse; //!< Accumulated impulse in the 2nd friction direction
 				float penetrationSplitImpulse; //!< Accumulated split impulse for penetration correction
-				vec3 rollingResistanceImpulse; //!< Accumulated rolling resistance impulse
-				vec3 normal; //!< Normal vector of the contact
+			};
+			/**
+			 * @brief Hot data of the friction constraints of a contact point (only used when the friction
+			 * is not solved at the center of the contact manifolds)
+			 */
+			struct ContactPointFrictionSolver {
 				vec3 frictionVector1; //!< First friction vector in the tangent plane
 				vec3 frictionvec2; //!< Second friction vector in the tangent plane
-				vec3 oldFrictionVector1; //!< Old first friction vector in the tangent plane
-				vec3 oldFrictionvec2; //!< Old second friction vector in the tangent plane
-				vec3 r1; //!< Vector from the body 1 center to the contact point
-				vec3 r2; //!< Vector from the body 2 center to the contact point
 				vec3 r1CrossT1; //!< Cross product of r1 with 1st friction vector
 				vec3 r1CrossT2; //!< Cross product of r1 with 2nd friction vector
 				vec3 r2CrossT1; //!< Cross product of r2 with 1st friction vector
 				vec3 r2CrossT2; //!< Cross product of r2 with 2nd friction vector
-				vec3 r1CrossN; //!< Cross product of r1 with the contact normal
-				vec3 r2CrossN; //!< Cross product of r2 with the contact normal
-				float penetrationDepth; //!< Penetration depth
-				float restitutionBias; //!< Velocity restitution bias
-				float inversePenetrationMass; //!< Inverse of the matrix K for the penenetration
+				vec3 inertia1R1CrossT1; //!< Inverse inertia tensor of body 1 multiplied by r1CrossT1
+				vec3 inertia1R1CrossT2; //!< Inverse inertia tensor of body 1 multiplied by r1CrossT2
+				vec3 inertia2R2CrossT1; //!< Inverse inertia tensor of body 2 multiplied by r2CrossT1
+				vec3 inertia2R2CrossT2; //!< Inverse inertia tensor of body 2 multiplied by r2CrossT2
 				float inverseFriction1Mass; //!< Inverse of the matrix K for the 1st friction
 				float inverseFriction2Mass; //!< Inverse of the matrix K for the 2nd friction
-				bool isRestingContact; //!< True if the contact was existing last time step
+				float friction1Impulse; //!< Accumulated impulse in the 1st friction direction
+				float friction2Impulse; //!< Accumulated impulse in the 2nd friction direction
+				vec3 rollingResistanceImpulse; //!< Accumulated rolling resistance impulse
+			};
+			/**
+			 * @brief Data of a contact point only used by the initialization, the warm start and the storage
+			 * of the impulses (kept out of the solve loop)
+			 */
+			struct ContactPointSolverCold {
 				ContactPoint* externalContact; //!< Pointer to the external contact
+				vec3 r1; //!< Vector from the body 1 center to the contact point
+				vec3 r2; //!< Vector from the body 2 center to the contact point
+				vec3 oldFrictionVector1; //!< Old first friction vector in the tangent plane
+				vec3 oldFrictionvec2; //!< Old second friction vector in the tangent plane
+				float penetrationDepth; //!< Penetration depth
+				bool isRestingContact; //!< True if the contact was existing last time step
 			};
 			/**
-			 * @brief Contact solver int32_ternal data structure to store all the information relative to a contact manifold.
+			 * @brief Hot data of a contact manifold read by each iteration of the solver
 			 */
 			struct ContactManifoldSolver {
 				uint32_t indexBody1; //!< Index of body 1 in the constraint solver
 				uint32_t indexBody2; //!< Index of body 2 in the constraint solver
 				float massInverseBody1; //!< Inverse of the mass of body 1
 				float massInverseBody2; //!< Inverse of the mass of body 2
-				etk::Matrix3x3 inverseInertiaTensorBody1; //!< Inverse inertia tensor of body 1
-				etk::Matrix3x3 inverseInertiaTensorBody2; //!< Inverse inertia tensor of body 2
-				ContactPointSolver contacts[MAX_CONTACT_POINTS_IN_MANIFOLD]; //!< Contact point constraints
+				uint32_t firstContact; //!< Index of the first contact point of the manifold in the contact points arrays
 				uint32_t nbContacts; //!< Number of contact points
-				bool isBody1DynamicType; //!< True if the body 1 is of type dynamic
-				bool isBody2DynamicType; //!< True if the body 2 is of type dynamic
-				float restitutionFactor; //!< Mix of the restitution factor for two bodies
 				float frictionCoefficient; //!< Mix friction coefficient for the two bodies
 				float rollingResistanceFactor; //!< Rolling resistance factor between the two bodies
-				ContactManifold* externalContactManifold; //!< Pointer to the external contact manifold
-				// - Variables used when friction constraints are apply at the center of the manifold-//
+				bool isBody1DynamicType; //!< True if the body 1 is of type dynamic
+				bool isBody2DynamicType; //!< True if the body 2 is of type dynamic
+			};
+			/**
+			 * @brief Hot data of the friction constraints at the center of a contact manifold (only used
+			 * when the friction is solved at the center of the contact manifolds)
+			 */
+			struct ContactManifoldFrictionSolver {
 				vec3 normal; //!< Average normal vector of the contact manifold
-				vec3 frictionPointBody1; //!< Point on body 1 where to apply the friction constraints
-				vec3 frictionPointBody2; //!< Point on body 2 where to apply the friction constraints
-				vec3 r1Friction; //!< R1 vector for the friction constraints
-				vec3 r2Friction; //!< R2 vector for the friction constraints
+				vec3 frictionVector1; //!< First friction direction at contact manifold center
+				vec3 frictionvec2; //!< Second friction direction at contact manifold center
 				vec3 r1CrossT1; //!< Cross product of r1 with 1st friction vector
 				vec3 r1CrossT2; //!< Cross product of r1 with 2nd friction vector
 				vec3 r2CrossT1; //!< Cross product of r2 with 1st friction vector
 				vec3 r2CrossT2; //!< Cross product of r2 with 2nd friction vector
+				vec3 inertia1R1CrossT1; //!< Inverse inertia tensor of body 1 multiplied by r1CrossT1
+				vec3 inertia1R1CrossT2; //!< Inverse inertia tensor of body 1 multiplied by r1CrossT2
+				vec3 inertia2R2CrossT1; //!< Inverse inertia tensor of body 2 multiplied by r2CrossT1
+				vec3 inertia2R2CrossT2; //!< Inverse inertia tensor of body 2 multiplied by r2CrossT2
+				vec3 inertia1Normal; //!< Inverse inertia tensor of body 1 multiplied by the normal (twist friction)
+				vec3 inertia2Normal; //!< Inverse inertia tensor of body 2 multiplied by the normal (twist friction)
 				float inverseFriction1Mass; //!< Matrix K for the first friction constraint
 				float inverseFriction2Mass; //!< Matrix K for the second friction constraint
 				float inverseTwistFrictionMass; //!< Matrix K for the twist friction constraint
-				etk::Matrix3x3 inverseRollingResistance; //!< Matrix K for the rolling resistance constraint
-				vec3 frictionVector1; //!< First friction direction at contact manifold center
-				vec3 frictionvec2; //!< Second friction direction at contact manifold center
-				vec3 oldFrictionVector1; //!< Old 1st friction direction at contact manifold center
-				vec3 oldFrictionvec2; //!< Old 2nd friction direction at contact manifold center
 				float friction1Impulse; //!< First friction direction impulse at manifold center
 				float friction2Impulse; //!< Second friction direction impulse at manifold center
 				float frictionTwistImpulse; //!< Twist friction impulse at contact manifold center
 				vec3 rollingResistanceImpulse; //!< Rolling resistance impulse
 			};
+			/**
+			 * @brief Hot data of the rolling resistance constraint of a contact manifold (its Jacobian is the
+			 * relative angular velocity: the impulse is applied with the full inverse inertia tensors)
+			 */
+			struct ContactManifoldRollingSolver {
+				etk::Matrix3x3 inverseInertiaTensorBody1; //!< Inverse inertia tensor of body 1 (null if the body is not dynamic)
+				etk::Matrix3x3 inverseInertiaTensorBody2; //!< Inverse inertia tensor of body 2 (null if the body is not dynamic)
+				etk::Matrix3x3 inverseRollingResistance; //!< Matrix K for the rolling resistance constraint
+			};
+			/**
+			 * @brief Data of a contact manifold only used by the initialization, the warm start and the storage
+			 * of the impulses
+			 */
+			struct ContactManifoldSolverCold {
+				ContactManifold* externalContactManifold; //!< Pointer to the external contact manifold
+				float restitutionFactor; //!< Mix of the restitution factor for two bodies
+				vec3 r1Friction; //!< R1 vector for the friction constraints at the center of the manifold
+				vec3 r2Friction; //!< R2 vector for the friction constraints at the center of the manifold
+				vec3 oldFrictionVector1; //!< Old 1st friction direction at contact manifold center
+				vec3 oldFrictionvec2; //!< Old 2nd friction direction at contact manifold center
+			};
+			/**
+			 * @brief Velocities of the two bodies of a contact manifold: they are gathered once by manifold,
+			 * updated by the impulses of all its constraints and written back at the end.
+			 */
+			struct ManifoldVelocities {
+				vec3 linear1; //!< Linear velocity of body 1
+				vec3 angular1; //!< Angular velocity of body 1
+				vec3 linear2; //!< Linear velocity of body 2
+				vec3 angular2; //!< Angular velocity of body 2
+			};
 			static const float BETA; //!< Beta value for the penetration depth position correction without split impulses
 			static const float BETA_SPLIT_IMPULSE; //!< Beta value for the penetration depth position correction with split impulses
 			static const float SLOP; //!< Slop distance (allowed penetration distance between bodies)
 			vec3* m_splitLinearVelocities; //!< Split linear velocities for the position contact solver (split impulse)
 			vec3* m_splitAngularVelocities; //!< Split angular velocities for the position contact solver (split impulse)
 			float m_timeStep; //!< Current time step
-			etk::Vector<ContactManifoldSolver> m_contactConstraints; //!< Contact constraints
+			etk::Vector<ContactManifoldSolver> m_contactConstraints; //!< Contact constraints (hot data)
+			etk::Vector<ContactManifoldFrictionSolver> m_contactConstraintsFriction; //!< Friction constraints at the center of the contact manifolds
+			etk::Vector<ContactManifoldRollingSolver> m_contactConstraintsRolling; //!< Rolling resistance constraints (and inverse inertia tensors) of the contact manifolds
+			etk::Vector<ContactManifoldSolverCold> m_contactConstraintsCold; //!< Contact constraints data used out of the solve loop
+			etk::Vector<ContactPointSolver> m_contactPoints; //!< Contact points of all the constraints (hot data)
+			etk::Vector<ContactPointFrictionSolver> m_contactPointsFriction; //!< Friction constraints of the contact points
+			etk::Vector<ContactPointSolverCold> m_contactPointsCold; //!< Contact points data used out of the solve loop
 			vec3* m_linearVelocities; //!< Array of linear velocities
 			vec3* m_angularVelocities; //!< Array of angular velocities
+			const etk::Matrix3x3* m_inverseInertiaTensors; //!< Array of the world inverse inertia tensors of the bodies
 			const etk::Map<RigidBody*, uint32_t>& m_mapBodyToConstrainedVelocityIndex; //!< Reference to the map of rigid body to their index in the constrained velocities array
 			bool m_isWarmStartingActive; //!< True if the warm starting of the solver is active
 			bool m_isSplitImpulseActive; //!< True if the split impulse position correction is active
@@ -177,17 +234,65 @@ namespace ephysics {
 			 */
 			void initializeContactConstraints();
 			/**
-			 * @brief Apply an impulse to the two bodies of a constraint
-			 * @param[in] _impulse Impulse to apply
-			 * @param[in] _manifold Constraint to apply the impulse
+			 * @brief Gather the velocities of the two bodies of a constraint
+			 * @param[in] _manifold Constraint of the bodies
+			 * @param[in] _linearVelocities Linear velocities array (constrained or split velocities)
+			 * @param[in] _angularVelocities Angular velocities array (constrained or split velocities)
+			 * @param[out] _velocities Velocities of the two bodies
 			 */
-			void applyImpulse(const Impulse& _impulse, const ContactManifoldSolver& _manifold);
+			static void gatherVelocities(const ContactManifoldSolver& _manifold,
+			                             const vec3* _linearVelocities,
+			                             const vec3* _angularVelocities,
+			                             ManifoldVelocities& _velocities);
 			/**
-			 * @brief Apply an impulse to the two bodies of a constraint
-			 * @param[in] _impulse Impulse to apply
-			 * @param[in] _manifold Constraint to apply the impulse
+			 * @brief Write back the velocities of the two bodies of a constraint.
+			 * Only the dynamic bodies are written: the static bodies are shared by the islands solved in parallel.
+			 * @param[in] _manifold Constraint of the bodies
+			 * @param[in] _velocities Velocities of the two bodies
+			 * @param[out] _linearVelocities Linear velocities array (constrained or split velocities)
+			 * @param[out] _angularVelocities Angular velocities array (constrained or split velocities)
 			 */
-			void applySplitImpulse(const Impulse& _impulse, const ContactManifoldSolver& _manifold);
+			static void scatterVelocities(const ContactManifoldSolver& _manifold,
+			                              const ManifoldVelocities& _velocities,
+			                              vec3* _linearVelocities,
+			                              vec3* _angularVelocities);
+			/**
+			 * @brief Compute J*v for a precomputed Jacobian
+			 * @param[in] _linear Linear part of the Jacobian (applied on the body 2 and opposite on the body 1)
+			 * @param[in] _angular1 Angular part of the Jacobian of the body 1
+			 * @param[in] _angular2 Angular part of the Jacobian of the body 2
+			 * @param[in] _velocities Velocities of the two bodies
+			 * @return Relative velocity along the constraint
+			 */
+			static float computeJv(const vec3& _linear,
+			                       const vec3& _angular1,
+			                       const vec3& _angular2,
+			                       const ManifoldVelocities& _velocities);
+			/**
+			 * @brief Apply the impulse P = J^T * lambda of a precomputed Jacobian to the two bodies
+			 * (the inverse mass and inertia are null for the non dynamic bodies)
+			 * @param[in] _lambda Lagrange multiplier (impulse magnitude)
+			 * @param[in] _linear Linear part of the Jacobian
+			 * @param[in] _inertiaAngular1 Angular part of the Jacobian of the body 1 multiplied by its inverse inertia tensor
+			 * @param[in] _inertiaAngular2 Angular part of the Jacobian of the body 2 multiplied by its inverse inertia tensor
+			 * @param[in] _manifold Constraint of the bodies
+			 * @param[in,out] _velocities Velocities of the two bodies
+			 */
+			static void applyImpulse(float _lambda,
+			                         const vec3& _linear,
+			                         const vec3& _inertiaAngular1,
+			                         const vec3& _inertiaAngular2,
+			                         const ContactManifoldSolver& _manifold,
+			                         ManifoldVelocities& _velocities);
+			/**
+			 * @brief Apply a rolling resistance impulse to the two bodies of a constraint
+			 * @param[in] _impulse Angular impulse (applied on the body 2 and opposite on the body 1)
+			 * @param[in] _rolling Rolling resistance constraint of the bodies (inverse inertia tensors)
+			 * @param[in,out] _velocities Velocities of the two bodies
+			 */
+			static void applyRollingResistanceImpulse(const vec3& _impulse,
+			                                          const ContactManifoldRollingSolver& _rolling,
+			                                          ManifoldVelocities& _velocities);
 			/**
 			 * @brief Compute the collision restitution factor from the restitution factor of each body
 			 * @param[in] _body1 First body to compute
@@ -211,39 +316,13 @@ namespace ephysics {
 			float computeMixedRollingResistance(RigidBody* _body1, RigidBody* _body2) const;
 			/**
 			 * @brief Compute the two unit orthogonal vectors "t1" and "t2" that span the tangential friction
-			 *        plane for a contact point. The two vectors have to be such that : t1 x t2 = contactNormal.
+			 *        plane for a contact point or a contact manifold. The two vectors have to be such that : t1 x t2 = contactNormal.
 			 * @param[in] _deltaVelocity Velocity ratio (with the delta time step)
-			 * @param[in,out] _contactPoint Contact point property
+			 * @param[in] _normal Normal of the contact
+			 * @param[out] _frictionVector1 First friction vector
+			 * @param[out] _frictionvec2 Second friction vector
 			 */
-			void computeFrictionVectors(const vec3& _deltaVelocity, ContactPointSolver& _contactPoint) const;
-			/**
-			 * @brief Compute the two unit orthogonal vectors "t1" and "t2" that span the tangential friction
-			 *        plane for a contact manifold. The two vectors have to be such that : t1 x t2 = contactNormal.
-			 * @param[in] _deltaVelocity Velocity ratio (with the delta time step)
-			 * @param[in,out] _contactPoint Contact point property
-			 */
-			void computeFrictionVectors(const vec3& _deltaVelocity, ContactManifoldSolver& _contactPoint) const;
-			/**
-			 * @brief Compute a penetration constraint impulse
-			 * @param[in] _deltaLambda Ratio to apply at the calculation.
-			 * @param[in,out] _contactPoint Contact point property
-			 * @return Impulse of the penetration result
-			 */
-			const Impulse computePenetrationImpulse(float _deltaLambda, const ContactPointSolver& _contactPoint) const;
-			/**
-			 * @brief Compute the first friction constraint impulse
-			 * @param[in] _deltaLambda Ratio to apply at the calculation.
-			 * @param[in] _contactPoint Contact point property
-			 * @return Impulse of the friction result
-			 */
-			const Impulse computeFriction1Impulse(float _deltaLambda, const ContactPointSolver& _contactPoint) const;
-			/**
-			 * @brief Compute the second friction constraint impulse
-			 * @param[in] _deltaLambda Ratio to apply at the calculation.
-			 * @param[in] _contactPoint Contact point property
-			 * @return Impulse of the friction result
-			 */
-			const Impulse computeFriction2Impulse(float _deltaLambda, const ContactPointSolver& _contactPoint) const;
+			void computeFrictionVectors(const vec3& _deltaVelocity, const vec3& _normal, vec3& _frictionVector1, vec3& _frictionvec2) const;
 		public:
 			/**
 			 * @brief Constructor
@@ -272,6 +351,11 @@ namespace ephysics {
 			 * @param[in] _constrainedAngularVelocities Constrained angular velocities Table pointer (not free)
 			 */
 			void setConstrainedVelocitiesArrays(vec3* _constrainedLinearVelocities, vec3* _constrainedAngularVelocities);
+			/**
+			 * @brief Set the array of the world inverse inertia tensors of the bodies (indexed like the velocities)
+			 * @param[in] _inverseInertiaTensors Inverse inertia tensors Table pointer (not free)
+			 */
+			void setInverseInertiaTensorsArray(const etk::Matrix3x3* _inverseInertiaTensors);
 			/**
 			 * @brief Warm start the solver.
 			 * For each constraint, we apply the previous impulse (from the previous step)
@@ -303,6 +387,11 @@ namespace ephysics {
 			 * @param[in] _isActive Enable or not the center inertie
 			 */
 			void setIsSolveFrictionAtContactManifoldCenterActive(bool _isActive);
+			/**
+			 * @brief Get if the friction constraints are solved at the center of the contact manifold
+			 * @return true if the friction is solved at the center of the contact manifold
+			 */
+			bool isSolveFrictionAtContactManifoldCenterActive() const;
 			/**
 			 * @brief Clean up the constraint solver
 			 */
@@ -0,0 +1,44 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#include <ephysics/engine/ContactStream.hpp>
+#include <ephysics/collision/ContactManifold.hpp>
+
+using namespace ephysics;
+
+void ContactStream::clear() {
+	m_body1Ids.clear();
+	m_body2Ids.clear();
+	m_shape1UserData.clear();
+	m_shape2UserData.clear();
+	m_worldPoints.clear();
+	m_normals.clear();
+	m_penetrationDepths.clear();
+	m_normalImpulses.clear();
+}
+
+void ContactStream::translate(const vec3& _translation) {
+	for (auto &it: m_worldPoints) {
+		it += _translation;
+	}
+}
+
+void ContactStream::addContactManifold(const ContactManifold& _manifold) {
+	const bodyindex body1Id = _manifold.getBody1()->getID();
+	const bodyindex body2Id = _manifold.getBody2()->getID();
+	void* shape1UserData = _manifold.getShape1()->getUserData();
+	void* shape2UserData = _manifold.getShape2()->getUserData();
+	for (uint32_t iii=0; iii<_manifold.getNbContactPoints(); ++iii) {
+		const ContactPoint* contact = _manifold.getContactPoint(iii);
+		m_body1Ids.pushBack(body1Id);
+		m_body2Ids.pushBack(body2Id);
+		m_shape1UserData.pushBack(shape1UserData);
+		m_shape2UserData.pushBack(shape2UserData);
+		m_worldPoints.pushBack(contact->getWorldPointOnBody1());
+		m_normals.pushBack(contact->getNormal());
+		m_penetrationDepths.pushBack(contact->getPenetrationDepth());
+		m_normalImpulses.pushBack(contact->getPenetrationImpulse());
+	}
+}
@@ -0,0 +1,82 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/Vector.hpp>
+#include <ephysics/configuration.hpp>
+#include <ephysics/mathematics/mathematics.hpp>
+
+namespace ephysics {
+	class ContactManifold;
+	class ContactPoint;
+	/**
+	 * @brief Read-only view on all the contact points of the last simulation step.
+	 * The data is stored as contiguous arrays (one entry per contact point, the same
+	 * index in every array). It is filled by DynamicsWorld::update() and stays valid
+	 * until the next call of update(). No copy is done when it is read.
+	 */
+	class ContactStream {
+		private:
+			etk::Vector<bodyindex> m_body1Ids; //!< ID of the first body of each contact
+			etk::Vector<bodyindex> m_body2Ids; //!< ID of the second body of each contact
+			etk::Vector<void*> m_shape1UserData; //!< User data of the first proxy shape of each contact
+			etk::Vector<void*> m_shape2UserData; //!< User data of the second proxy shape of each contact
+			etk::Vector<vec3> m_worldPoints; //!< Contact point on the first body (in world space)
+			etk::Vector<vec3> m_normals; //!< Contact normal (from body 1 toward body 2) in world space
+			etk::Vector<float> m_penetrationDepths; //!< Penetration depth of each contact
+			etk::Vector<float> m_normalImpulses; //!< Normal impulse applied by the solver on each contact during the step
+			/// Remove all the contacts (keep the allocated memory)
+			void clear();
+			/// Append all the contact points of a manifold
+			void addContactManifold(const ContactManifold& _manifold);
+			/// Translate the world points of the contacts
+			void translate(const vec3& _translation);
+		public:
+			/// Constructor
+			ContactStream() = default;
+			/// DELETE copy-constructor
+			ContactStream(const ContactStream& _stream) = delete;
+			/// DELETE assignment operator
+			ContactStream& operator=(const ContactStream& _stream) = delete;
+			/// Return the number of contact points in the stream
+			size_t getNbContacts() const {
+				return m_body1Ids.size();
+			}
+			/// Return the IDs of the first bodies of the contacts
+			const bodyindex* getBody1Ids() const {
+				return m_body1Ids.dataPointer();
+			}
+			/// Return the IDs of the second bodies of the contacts
+			const bodyindex* getBody2Ids() const {
+				return m_body2Ids.dataPointer();
+			}
+			/// Return the user data of the first proxy shapes of the contacts
+			void* const* getShape1UserData() const {
+				return m_shape1UserData.dataPointer();
+			}
+			/// Return the user data of the second proxy shapes of the contacts
+			void* const* getShape2UserData() const {
+				return m_shape2UserData.dataPointer();
+			}
+			/// Return the contact points (on the first body) in world space
+			const vec3* getWorldPoints() const {
+				return m_worldPoints.dataPointer();
+			}
+			/// Return the contact normals in world space
+			const vec3* getNormals() const {
+				return m_normals.dataPointer();
+			}
+			/// Return the penetration depths of the contacts
+			const float* getPenetrationDepths() const {
+				return m_penetrationDepths.dataPointer();
+			}
+			/// Return the normal impulses applied by the solver on the contacts
+			const float* getNormalImpulses() const {
+				return m_normalImpulses.dataPointer();
+			}
+			friend class DynamicsWorld;
+	};
+}
@@ -11,8 +11,37 @@
 #include <ephysics/constraint/SliderJoint.hpp>
 #include <ephysics/constraint/HingeJoint.hpp>
 #include <ephysics/constraint/FixedJoint.hpp>
+#include <ephysics/engine/StateBuffer.hpp>
+#include <ephysics/engine/WorkStealingTaskScheduler.hpp>
+#include <ephysics/mathematics/simd.hpp>
 #include <ephysics/debug.hpp>
 
+namespace {
+	/// Number of bodies of a range of the parallel loops on the bodies
+	const int32_t BODY_GRAIN_SIZE = 64;
+	/// Number of bodies of which the orientations are converted in rotation matrices at once
+	const int32_t INERTIA_TENSOR_BATCH_SIZE = 16;
+	/**
+	 * @brief Task that calls a range method of the world
+	 */
+	class DynamicsWorldTask : public ephysics::TaskScheduler::Task {
+		public:
+			typedef void (ephysics::DynamicsWorld::*Function)(int32_t _begin, int32_t _end, int32_t _threadIndex);
+		private:
+			ephysics::DynamicsWorld& m_world;
+			Function m_function;
+		public:
+			DynamicsWorldTask(ephysics::DynamicsWorld& _world, Function _function):
+			  m_world(_world),
+			  m_function(_function) {
+				
+			}
+			void execute(int32_t _begin, int32_t _end, int32_t _threadIndex) override {
+				(m_world.*m_function)(_begin, _end, _threadIndex);
+			}
+	};
+}
+
 ephysics::DynamicsWorld::DynamicsWorld(const vec3& _gravity):
   CollisionWorld(),
   m_contactSolver(m_mapBodyToConstrainedVelocityIndex),
@@ -25,11 +54,25 @@ ephysics::DynamicsWorld::DynamicsWorld(const vec3& _gravity):
   m_numberBodiesCapacity(0),
   m_sleepLinearVelocity(DEFAULT_SLEEP_LINEAR_VELOCITY),
   m_sleepAngularVelocity(DEFAULT_SLEEP_ANGULAR_VELOCITY),
-  m_timeBeforeSleep(DEFAULT_TIME_BEFORE_SLEEP) {
+  m_timeBeforeSleep(DEFAULT_TIME_BEFORE_SLEEP),
+  m_isContactStreamEnabled(false),
+  m_updateThread(null),
+  m_taskScheduler(null),
+  m_ownedTaskScheduler(null),
+  m_fixedTimeStep(DEFAULT_FIXED_TIME_STEP),
+  m_maxNbSubSteps(DEFAULT_MAX_NB_SUB_STEPS),
+  m_accumulator(0.0f),
+  m_interpolationFactor(0.0f) {
 	
 }
 
 ephysics::DynamicsWorld::~DynamicsWorld() {
+	// Wait the running step and stop the background thread
+	if (m_updateThread != null) {
+		ETK_DELETE(UpdateThread, m_updateThread);
+		m_updateThread = null;
+	}
+	setTaskScheduler(null);
 	// Destroy all the joints that have not been removed
 	etk::Set<ephysics::Joint*>::Iterator itJoints;
 	for (itJoints = m_joints.begin(); itJoints != m_joints.end();) {
@@ -72,31 +115,53 @@ ephysics::DynamicsWorld::~DynamicsWorld() {
 #endif
 }
 
-void ephysics::DynamicsWorld::update(float timeStep) {
+void ephysics::DynamicsWorld::update(float _timeStep) {
+	m_commandQueue.takeBatch();
+	updateStep(_timeStep);
+}
+
+void ephysics::DynamicsWorld::updateStep(float timeStep) {
 	#ifdef IS_PROFILING_ACTIVE
 		// Increment the frame counter of the profiler
 		Profiler::incrementFrameCounter();
 	#endif
 	PROFILE("ephysics::DynamicsWorld::update()");
 	m_timeStep = timeStep;
+	// Apply the batch of body modifications taken at the start of the step
+	m_commandQueue.apply(*this);
 	// Notify the event listener about the beginning of an int32_ternal tick
 	if (m_eventListener != null) {
 		m_eventListener->beginInternalTick();
 	}
 	// Reset all the contact manifolds lists of each body
 	resetContactManifoldListsOfBodies();
+	m_contactStream.clear();
 	if (m_rigidBodies.size() == 0) {
 		// no rigid body ==> no process to do ...
 		return;
 	}
 	// Compute the collision detection
 	m_collisionDetection.computeCollisionDetection();
+	if (    m_eventListener != null
+	     && m_collisionDetection.m_triggerEvents.size() != 0) {
+		m_eventListener->triggerEvents(m_collisionDetection.m_triggerEvents);
+	}
 	// Compute the islands (separate groups of bodies with constraints between each others)
 	computeIslands();
 	// Integrate the velocities
 	integrateRigidBodiesVelocities();
 	// Solve the contacts and constraints
 	solveContactsAndConstraints();
+	// Export the contacts (with the impulses applied by the solver)
+	if (m_isContactStreamEnabled) {
+		updateContactStream();
+	}
+	// Compute the contact pair events (with the impulses applied by the solver)
+	m_collisionDetection.computeContactPairEvents();
+	if (    m_eventListener != null
+	     && m_collisionDetection.m_contactPairEvents.size() != 0) {
+		m_eventListener->contactPairEvents(m_collisionDetection.m_contactPairEvents);
+	}
 	// Integrate the position and orientation of each body
 	integrateRigidBodiesPositions();
 	// Solve the position correction for constraints
@@ -116,55 +181,170 @@ void ephysics::DynamicsWorld::update(float timeStep) {
 
 void ephysics::DynamicsWorld::integrateRigidBodiesPositions() {
 	PROFILE("ephysics::DynamicsWorld::integrateRigidBodiesPositions()");
-	// For each island of the world
-	for (uint32_t i=0; i < m_islands.size(); i++) {
-		RigidBody** bodies = m_islands[i]->getBodies();
-		// For each body of the island
-		for (uint32_t b=0; b < m_islands[i]->getNbBodies(); b++) {
-			// Get the constrained velocity
-			uint32_t indexArray = m_mapBodyToConstrainedVelocityIndex.find(bodies[b])->second;
-			vec3 newLinVelocity = m_constrainedLinearVelocities[indexArray];
-			vec3 newAngVelocity = m_constrainedAngularVelocities[indexArray];
-			// Add the split impulse velocity from Contact Solver (only used
-			// to update the position)
-			if (m_contactSolver.isSplitImpulseActive()) {
-				newLinVelocity += m_splitLinearVelocities[indexArray];
-				newAngVelocity += m_splitAngularVelocities[indexArray];
-			}
-			// Get current position and orientation of the body
-			const vec3& currentPosition = bodies[b]->m_centerOfMassWorld;
-			const etk::Quaternion& currentOrientation = bodies[b]->getTransform().getOrientation();
-			// Update the new constrained position and orientation of the body
-			m_constrainedPositions[indexArray] = currentPosition + newLinVelocity * m_timeStep;
-			m_constrainedOrientations[indexArray] = currentOrientation;
-			m_constrainedOrientations[indexArray] +=   etk::Quaternion(0, newAngVelocity)
-			                                         * currentOrientation
-			                                         * 0.5f
-			                                         * m_timeStep;
+	DynamicsWorldTask task(*this, &DynamicsWorld::integrateRigidBodiesPositions);
+	parallelFor(task, m_islandBodies.size(), BODY_GRAIN_SIZE);
+}
+
+void ephysics::DynamicsWorld::integrateRigidBodiesPositions(int32_t _begin, int32_t _end, int32_t /*_threadIndex*/) {
+	// For each body of the islands
+	for (int32_t iii=_begin; iii<_end; ++iii) {
+		RigidBody* body = m_islandBodies[iii];
+		// Get the constrained velocity
+		uint32_t indexArray = m_mapBodyToConstrainedVelocityIndex.find(body)->second;
+		vec3 newLinVelocity = m_constrainedLinearVelocities[indexArray];
+		vec3 newAngVelocity = m_constrainedAngularVelocities[indexArray];
+		// Add the split impulse velocity from Contact Solver (only used
+		// to update the position)
+		if (m_contactSolver.isSplitImpulseActive()) {
+			newLinVelocity += m_splitLinearVelocities[indexArray];
+			newAngVelocity += m_splitAngularVelocities[indexArray];
 		}
+		// Get current position and orientation of the body
+		const vec3& currentPosition = body->m_centerOfMassWorld;
+		const etk::Quaternion& currentOrientation = body->getTransform().getOrientation();
+		// Update the new constrained position and orientation of the body
+		m_constrainedPositions[indexArray] = currentPosition + newLinVelocity * m_timeStep;
+		m_constrainedOrientations[indexArray] = currentOrientation;
+		m_constrainedOrientations[indexArray] +=   etk::Quaternion(0, newAngVelocity)
+		                                         * currentOrientation
+		                                         * 0.5f
+		                                         * m_timeStep;
 	}
 }
 
+uint32_t ephysics::DynamicsWorld::advance(float _realTimeStep) {
+	PROFILE("ephysics::DynamicsWorld::advance()");
+	m_accumulator += _realTimeStep;
+	uint32_t nbSubSteps = 0;
+	while (    m_accumulator >= m_fixedTimeStep
+	        && nbSubSteps < m_maxNbSubSteps) {
+		// Keep the transforms at the start of the step for the interpolation
+		for (auto &it: m_rigidBodies) {
+			it->m_previousTransform = it->m_transform;
+		}
+		update(m_fixedTimeStep);
+		m_accumulator -= m_fixedTimeStep;
+		nbSubSteps++;
+	}
+	// The simulation is slower than real time: drop the time that can not be simulated
+	if (m_accumulator >= m_fixedTimeStep) {
+		m_accumulator = fmod(m_accumulator, m_fixedTimeStep);
+	}
+	m_interpolationFactor = m_accumulator / m_fixedTimeStep;
+	// Interpolate the transforms of all the bodies in one pass
+	m_interpolatedBodyStates.resize(m_rigidBodies.size());
+	size_t index = 0;
+	for (auto &it: m_rigidBodies) {
+		BodyState& state = m_interpolatedBodyStates[index];
+		state.body = it;
+		state.transform = etk::Transform3D::interpolateTransforms(it->m_previousTransform, it->m_transform, m_interpolationFactor);
+		state.linearVelocity = it->m_linearVelocity;
+		state.angularVelocity = it->m_angularVelocity;
+		index++;
+	}
+	return nbSubSteps;
+}
+
+void ephysics::DynamicsWorld::setKinematicTargets(ephysics::RigidBody* const* _bodies, const etk::Transform3D* _targets, size_t _nbBodies, float _timeStep) {
+	PROFILE("ephysics::DynamicsWorld::setKinematicTargets()");
+	if (_timeStep <= 0.0f) {
+		EPHY_ERROR("The time step to reach the kinematic targets must be strictly positive: " << _timeStep);
+		return;
+	}
+	float inverseTimeStep = 1.0f / _timeStep;
+	for (size_t iii=0; iii<_nbBodies; ++iii) {
+		ephysics::RigidBody* body = _bodies[iii];
+		if (body->getType() != KINEMATIC) {
+			EPHY_ERROR("Kinematic target set on a body that is not kinematic");
+			continue;
+		}
+		const etk::Transform3D& target = _targets[iii];
+		// The center of mass of a kinematic body is the origin of its transform
+		body->m_linearVelocity = (target.getPosition() - body->m_transform.getPosition()) * inverseTimeStep;
+		// Rotation from the current orientation to the target orientation (shortest path)
+		etk::Quaternion delta = target.getOrientation() * body->m_transform.getOrientation().getInverse();
+		if (delta.w() < 0.0f) {
+			delta = delta * -1.0f;
+		}
+		vec3 axis = delta.getVectorV();
+		float sinHalfAngle = axis.length();
+		if (sinHalfAngle > FLT_EPSILON) {
+			float angle = 2.0f * atan2(sinHalfAngle, delta.w());
+			body->m_angularVelocity = axis * (angle * inverseTimeStep / sinHalfAngle);
+		} else {
+			// Small angle: sin(angle/2) ~ angle/2
+			body->m_angularVelocity = axis * (2.0f * inverseTimeStep);
+		}
+		if (    body->isSleeping() == true
+		     && (    body->m_linearVelocity.length2() > 0.0f
+		          || body->m_angularVelocity.length2() > 0.0f)) {
+			body->setIsSleeping(false);
+		}
+	}
+}
+
+void ephysics::DynamicsWorld::setFixedTimeStep(float _timeStep) {
+	if (_timeStep <= 0.0f) {
+		EPHY_ERROR("The fixed time step must be strictly positive: " << _timeStep);
+		return;
+	}
+	m_fixedTimeStep = _timeStep;
+}
+
+void ephysics::DynamicsWorld::setMaxNbSubSteps(uint32_t _maxNbSubSteps) {
+	m_maxNbSubSteps = etk::max(_maxNbSubSteps, uint32_t(1));
+}
+
+void ephysics::DynamicsWorld::beginUpdate(float _timeStep) {
+	if (m_updateThread == null) {
+		m_updateThread = ETK_NEW(UpdateThread, *this);
+	}
+	// The batch of commands is taken on the calling thread: the commands recorded after this
+	// call are not applied by the background step
+	m_updateThread->wait();
+	m_commandQueue.takeBatch();
+	m_updateThread->start(_timeStep);
+}
+
+void ephysics::DynamicsWorld::waitUpdate() {
+	if (m_updateThread == null) {
+		return;
+	}
+	m_updateThread->wait();
+}
+
+const etk::Vector<ephysics::BodyState>& ephysics::DynamicsWorld::getPublishedBodyStates() const {
+	static const etk::Vector<ephysics::BodyState> emptyStates;
+	if (m_updateThread == null) {
+		return emptyStates;
+	}
+	return m_updateThread->getStates();
+}
+
 void ephysics::DynamicsWorld::updateBodiesState() {
 	PROFILE("ephysics::DynamicsWorld::updateBodiesState()");
-	// For each island of the world
-	for (uint32_t islandIndex = 0; islandIndex < m_islands.size(); islandIndex++) {
-		// For each body of the island
-		RigidBody** bodies = m_islands[islandIndex]->getBodies();
-		for (uint32_t b=0; b < m_islands[islandIndex]->getNbBodies(); b++) {
-			uint32_t index = m_mapBodyToConstrainedVelocityIndex.find(bodies[b])->second;
-			// Update the linear and angular velocity of the body
-			bodies[b]->m_linearVelocity = m_constrainedLinearVelocities[index];
-			bodies[b]->m_angularVelocity = m_constrainedAngularVelocities[index];
-			// Update the position of the center of mass of the body
-			bodies[b]->m_centerOfMassWorld = m_constrainedPositions[index];
-			// Update the orientation of the body
-			bodies[b]->m_transform.setOrientation(m_constrainedOrientations[index].safeNormalized());
-			// Update the transform of the body (using the new center of mass and new orientation)
-			bodies[b]->updateTransformWithCenterOfMass();
-			// Update the broad-phase state of the body
-			bodies[b]->updateBroadPhaseState();
-		}
+	DynamicsWorldTask task(*this, &DynamicsWorld::updateBodiesState);
+	parallelFor(task, m_islandBodies.size(), BODY_GRAIN_SIZE);
+	// Update the broad-phase state of the bodies (the trees are shared)
+	for (auto &it: m_islandBodies) {
+		it->updateBroadPhaseState();
+	}
+}
+
+void ephysics::DynamicsWorld::updateBodiesState(int32_t _begin, int32_t _end, int32_t /*_threadIndex*/) {
+	// For each body of the islands
+	for (int32_t iii=_begin; iii<_end; ++iii) {
+		RigidBody* body = m_islandBodies[iii];
+		uint32_t index = m_mapBodyToConstrainedVelocityIndex.find(body)->second;
+		// Update the linear and angular velocity of the body
+		body->m_linearVelocity = m_constrainedLinearVelocities[index];
+		body->m_angularVelocity = m_constrainedAngularVelocities[index];
+		// Update the position of the center of mass of the body
+		body->m_centerOfMassWorld = m_constrainedPositions[index];
+		// Update the orientation of the body
+		body->m_transform.setOrientation(m_constrainedOrientations[index].safeNormalized());
+		// Update the transform of the body (using the new center of mass and new orientation)
+		body->updateTransformWithCenterOfMass();
 	}
 }
 
@@ -183,12 +363,14 @@ void ephysics::DynamicsWorld::initVelocityArrays() {
 		m_constrainedAngularVelocities.clear();
 		m_constrainedPositions.clear();
 		m_constrainedOrientations.clear();
+		m_inverseInertiaTensorsWorld.clear();
 		m_splitLinearVelocities.resize(m_numberBodiesCapacity, vec3(0,0,0));
 		m_splitAngularVelocities.resize(m_numberBodiesCapacity, vec3(0,0,0));
 		m_constrainedLinearVelocities.resize(m_numberBodiesCapacity, vec3(0,0,0));
 		m_constrainedAngularVelocities.resize(m_numberBodiesCapacity, vec3(0,0,0));
 		m_constrainedPositions.resize(m_numberBodiesCapacity, vec3(0,0,0));
 		m_constrainedOrientations.resize(m_numberBodiesCapacity, etk::Quaternion::identity());
+		m_inverseInertiaTensorsWorld.resize(m_numberBodiesCapacity);
 	}
 	// Reset the velocities arrays
 	for (uint32_t i=0; i<m_numberBodiesCapacity; i++) {
@@ -210,24 +392,58 @@ void ephysics::DynamicsWorld::integrateRigidBodiesVelocities() {
 	PROFILE("ephysics::DynamicsWorld::integrateRigidBodiesVelocities()");
 	// Initialize the bodies velocity arrays
 	initVelocityArrays();
-	// For each island of the world
+	// Flatten the bodies of the islands (a static body can be in several islands: it is only added once)
+	m_islandBodies.clear();
 	for (uint32_t i=0; i < m_islands.size(); i++) {
 		RigidBody** bodies = m_islands[i]->getBodies();
-		// For each body of the island
 		for (uint32_t b=0; b < m_islands[i]->getNbBodies(); b++) {
+			if (bodies[b]->getType() == STATIC) {
+				// The static bodies are not flagged by computeIslands(): flag them while the islands are flattened
+				if (bodies[b]->m_isAlreadyInIsland == true) {
+					continue;
+				}
+				bodies[b]->m_isAlreadyInIsland = true;
+			}
+			m_islandBodies.pushBack(bodies[b]);
+		}
+	}
+	for (auto &it: m_islandBodies) {
+		if (it->getType() == STATIC) {
+			it->m_isAlreadyInIsland = false;
+		}
+	}
+	DynamicsWorldTask task(*this, &DynamicsWorld::integrateRigidBodiesVelocities);
+	parallelFor(task, m_islandBodies.size(), BODY_GRAIN_SIZE);
+}
+
+void ephysics::DynamicsWorld::integrateRigidBodiesVelocities(int32_t _begin, int32_t _end, int32_t /*_threadIndex*/) {
+	etk::Quaternion orientations[INERTIA_TENSOR_BATCH_SIZE];
+	etk::Matrix3x3 rotations[INERTIA_TENSOR_BATCH_SIZE];
+	// For each batch of bodies of the islands
+	for (int32_t first=_begin; first<_end; first+=INERTIA_TENSOR_BATCH_SIZE) {
+		const int32_t nbBodies = etk::min(INERTIA_TENSOR_BATCH_SIZE, _end - first);
+		for (int32_t iii=0; iii<nbBodies; ++iii) {
+			orientations[iii] = m_islandBodies[first + iii]->getTransform().getOrientation();
+		}
+		simd::quaternionsToMatrices(orientations, rotations, nbBodies);
+		for (int32_t iii=0; iii<nbBodies; ++iii) {
+			RigidBody* body = m_islandBodies[first + iii];
 			// Insert the body int32_to the map of constrained velocities
-			uint32_t indexBody = m_mapBodyToConstrainedVelocityIndex.find(bodies[b])->second;
+			uint32_t indexBody = m_mapBodyToConstrainedVelocityIndex.find(body)->second;
+			// The world inverse inertia tensor (R * I^-1 * R^T) is computed once per step: the solvers read it
+			m_inverseInertiaTensorsWorld[indexBody] = simd::multiply(simd::multiply(rotations[iii], body->m_inertiaTensorLocalInverse),
+			                                                         rotations[iii].getTranspose());
 			assert(m_splitLinearVelocities[indexBody] == vec3(0, 0, 0));
 			assert(m_splitAngularVelocities[indexBody] == vec3(0, 0, 0));
 			// Integrate the external force to get the new velocity of the body
-			m_constrainedLinearVelocities[indexBody] = bodies[b]->getLinearVelocity();
-			m_constrainedLinearVelocities[indexBody] += bodies[b]->m_massInverse * bodies[b]->m_externalForce * m_timeStep;
-			m_constrainedAngularVelocities[indexBody] = bodies[b]->getAngularVelocity();
-			m_constrainedAngularVelocities[indexBody] += bodies[b]->getInertiaTensorInverseWorld() * bodies[b]->m_externalTorque * m_timeStep;
+			m_constrainedLinearVelocities[indexBody] = body->getLinearVelocity();
+			m_constrainedLinearVelocities[indexBody] += body->m_massInverse * body->m_externalForce * m_timeStep;
+			m_constrainedAngularVelocities[indexBody] = body->getAngularVelocity();
+			m_constrainedAngularVelocities[indexBody] += m_inverseInertiaTensorsWorld[indexBody] * body->m_externalTorque * m_timeStep;
 			// If the gravity has to be applied to this rigid body
-			if (bodies[b]->isGravityEnabled() && m_isGravityEnabled) {
+			if (body->isGravityEnabled() && m_isGravityEnabled) {
 				// Integrate the gravity force
-				m_constrainedLinearVelocities[indexBody] += m_timeStep * bodies[b]->m_massInverse * bodies[b]->getMass() * m_gravity;
+				m_constrainedLinearVelocities[indexBody] += m_timeStep * body->m_massInverse * body->getMass() * m_gravity;
 			}
 			// Apply the velocity damping
 			// Damping force : F_c = -c' * v (c=damping factor)
@@ -242,13 +458,12 @@ void ephysics::DynamicsWorld::integrateRigidBodiesVelocities() {
 			// Using Taylor Serie for e^(-x) : e^x ~ 1 + x + x^2/2! + ...
 			//							  => e^(-x) ~ 1 - x
 			//				 => v2 = v1 * (1 - c * dt)
-			float linDampingFactor = bodies[b]->getLinearDamping();
-			float angDampingFactor = bodies[b]->getAngularDamping();
+			float linDampingFactor = body->getLinearDamping();
+			float angDampingFactor = body->getAngularDamping();
 			float linearDamping = pow(1.0f - linDampingFactor, m_timeStep);
 			float angularDamping = pow(1.0f - angDampingFactor, m_timeStep);
 			m_constrainedLinearVelocities[indexBody] *= linearDamping;
 			m_constrainedAngularVelocities[indexBody] *= angularDamping;
-			indexBody++;
 		}
 	}
 }
@@ -259,46 +474,60 @@ void ephysics::DynamicsWorld::solveContactsAndConstraints() {
 	m_contactSolver.setSplitVelocitiesArrays(&m_splitLinearVelocities[0], &m_splitAngularVelocities[0]);
 	m_contactSolver.setConstrainedVelocitiesArrays(&m_constrainedLinearVelocities[0],
 	                                               &m_constrainedAngularVelocities[0]);
+	m_contactSolver.setInverseInertiaTensorsArray(&m_inverseInertiaTensorsWorld[0]);
 	m_constraintSolver.setConstrainedVelocitiesArrays(&m_constrainedLinearVelocities[0],
 	                                                  &m_constrainedAngularVelocities[0]);
+	m_constraintSolver.setInverseInertiaTensorsArray(&m_inverseInertiaTensorsWorld[0]);
 	m_constraintSolver.setConstrainedPositionsArrays(&m_constrainedPositions[0],
 	                                                 &m_constrainedOrientations[0]);
+	prepareThreadSolvers();
 	// ---------- Solve velocity constraints for joints and contacts ---------- //
-	// For each island of the world
-	for (uint32_t islandIndex = 0; islandIndex < m_islands.size(); islandIndex++) {
-		// Check if there are contacts and constraints to solve
-		bool isConstraintsToSolve = m_islands[islandIndex]->getNbJoints() > 0;
-		bool isContactsToSolve = m_islands[islandIndex]->getNbContactManifolds() > 0;
-		if (!isConstraintsToSolve && !isContactsToSolve) {
-			continue;
-		}
-		// If there are contacts in the current island
-		if (isContactsToSolve) {
-			// Initialize the solver
-			m_contactSolver.initializeForIsland(m_timeStep, m_islands[islandIndex]);
-			// Warm start the contact solver
-			m_contactSolver.warmStart();
-		}
-		// If there are constraints
+	splitIslands(false);
+	DynamicsWorldTask task(*this, &DynamicsWorld::solveContactsAndConstraints);
+	parallelFor(task, m_parallelIslands.size(), 1);
+	for (auto &it: m_sequentialIslands) {
+		solveIsland(it, 0);
+	}
+}
+
+void ephysics::DynamicsWorld::solveContactsAndConstraints(int32_t _begin, int32_t _end, int32_t _threadIndex) {
+	for (int32_t iii=_begin; iii<_end; ++iii) {
+		solveIsland(m_parallelIslands[iii], _threadIndex);
+	}
+}
+
+void ephysics::DynamicsWorld::solveIsland(Island* _island, int32_t _threadIndex) {
+	ContactSolver& contactSolver = _threadIndex == 0 ? m_contactSolver : *m_threadContactSolvers[_threadIndex - 1];
+	ConstraintSolver& constraintSolver = _threadIndex == 0 ? m_constraintSolver : *m_threadConstraintSolvers[_threadIndex - 1];
+	// Check if there are contacts and constraints to solve
+	bool isConstraintsToSolve = _island->getNbJoints() > 0;
+	bool isContactsToSolve = _island->getNbContactManifolds() > 0;
+	// If there are contacts in the current island
+	if (isContactsToSolve) {
+		// Initialize the solver
+		contactSolver.initializeForIsland(m_timeStep, _island);
+		// Warm start the contact solver
+		contactSolver.warmStart();
+	}
+	// If there are constraints
+	if (isConstraintsToSolve) {
+		// Initialize the constraint solver
+		constraintSolver.initializeForIsland(m_timeStep, _island);
+	}
+	// For each iteration of the velocity solver
+	for (uint32_t i=0; i<m_nbVelocitySolverIterations; i++) {
+		// Solve the constraints
 		if (isConstraintsToSolve) {
-			// Initialize the constraint solver
-			m_constraintSolver.initializeForIsland(m_timeStep, m_islands[islandIndex]);
-		}
-		// For each iteration of the velocity solver
-		for (uint32_t i=0; i<m_nbVelocitySolverIterations; i++) {
-			// Solve the constraints
-			if (isConstraintsToSolve) {
-				m_constraintSolver.solveVelocityConstraints(m_islands[islandIndex]);
-			}
-			// Solve the contacts
-			if (isContactsToSolve) m_contactSolver.solve();
-		}
-		// Cache the lambda values in order to use them in the next
-		// step and cleanup the contact solver
-		if (isContactsToSolve) {
-			m_contactSolver.storeImpulses();
-			m_contactSolver.cleanup();
+			constraintSolver.solveVelocityConstraints(_island);
 		}
+		// Solve the contacts
+		if (isContactsToSolve) contactSolver.solve();
+	}
+	// Cache the lambda values in order to use them in the next
+	// step and cleanup the contact solver
+	if (isContactsToSolve) {
+		contactSolver.storeImpulses();
+		contactSolver.cleanup();
 	}
 }
 
@@ -308,17 +537,121 @@ void ephysics::DynamicsWorld::solvePositionCorrection() {
 	if (m_joints.empty()) {
 		return;
 	}
-	// For each island of the world
-	for (uint32_t islandIndex = 0; islandIndex < m_islands.size(); islandIndex++) {
-		// ---------- Solve the position error correction for the constraints ---------- //
+	// ---------- Solve the position error correction for the constraints ---------- //
+	splitIslands(true);
+	DynamicsWorldTask task(*this, &DynamicsWorld::solvePositionCorrection);
+	parallelFor(task, m_parallelIslands.size(), 1);
+	for (auto &it: m_sequentialIslands) {
+		// For each iteration of the position (error correction) solver
+		for (uint32_t i=0; i<m_nbPositionSolverIterations; i++) {
+			m_constraintSolver.solvePositionConstraints(it);
+		}
+	}
+}
+
+void ephysics::DynamicsWorld::solvePositionCorrection(int32_t _begin, int32_t _end, int32_t _threadIndex) {
+	ConstraintSolver& constraintSolver = _threadIndex == 0 ? m_constraintSolver : *m_threadConstraintSolvers[_threadIndex - 1];
+	for (int32_t iii=_begin; iii<_end; ++iii) {
 		// For each iteration of the position (error correction) solver
 		for (uint32_t i=0; i<m_nbPositionSolverIterations; i++) {
 			// Solve the position constraints
-			m_constraintSolver.solvePositionConstraints(m_islands[islandIndex]);
+			constraintSolver.solvePositionConstraints(m_parallelIslands[iii]);
 		}
 	}
 }
 
+void ephysics::DynamicsWorld::splitIslands(bool _onlyWithJoints) {
+	m_parallelIslands.clear();
+	m_sequentialIslands.clear();
+	for (auto &it: m_islands) {
+		if (    it->getNbJoints() == 0
+		     && (    _onlyWithJoints == true
+		          || it->getNbContactManifolds() == 0)) {
+			continue;
+		}
+		bool isSharingStaticBody = false;
+		Joint** joints = it->getJoints();
+		for (uint32_t iii=0; iii<it->getNbJoints(); ++iii) {
+			if (    static_cast<RigidBody*>(joints[iii]->getBody1())->getType() == STATIC
+			     || static_cast<RigidBody*>(joints[iii]->getBody2())->getType() == STATIC) {
+				isSharingStaticBody = true;
+				break;
+			}
+		}
+		if (    isSharingStaticBody == true
+		     || m_taskScheduler == null) {
+			m_sequentialIslands.pushBack(it);
+		} else {
+			m_parallelIslands.pushBack(it);
+		}
+	}
+}
+
+void ephysics::DynamicsWorld::prepareThreadSolvers() {
+	int32_t nbThreadSolvers = 0;
+	if (m_taskScheduler != null) {
+		nbThreadSolvers = m_taskScheduler->getNbThreads() - 1;
+	}
+	while (int32_t(m_threadContactSolvers.size()) < nbThreadSolvers) {
+		m_threadContactSolvers.pushBack(ETK_NEW(ContactSolver, m_mapBodyToConstrainedVelocityIndex));
+		m_threadConstraintSolvers.pushBack(ETK_NEW(ConstraintSolver, m_mapBodyToConstrainedVelocityIndex));
+	}
+	for (int32_t iii=0; iii<nbThreadSolvers; ++iii) {
+		ContactSolver* contactSolver = m_threadContactSolvers[iii];
+		contactSolver->setIsSplitImpulseActive(m_contactSolver.isSplitImpulseActive());
+		contactSolver->setIsSolveFrictionAtContactManifoldCenterActive(m_contactSolver.isSolveFrictionAtContactManifoldCenterActive());
+		contactSolver->setSplitVelocitiesArrays(&m_splitLinearVelocities[0], &m_splitAngularVelocities[0]);
+		contactSolver->setConstrainedVelocitiesArrays(&m_constrainedLinearVelocities[0],
+		                                              &m_constrainedAngularVelocities[0]);
+		contactSolver->setInverseInertiaTensorsArray(&m_inverseInertiaTensorsWorld[0]);
+		ConstraintSolver* constraintSolver = m_threadConstraintSolvers[iii];
+		constraintSolver->setIsNonLinearGaussSeidelPositionCorrectionActive(m_constraintSolver.getIsNonLinearGaussSeidelPositionCorrectionActive());
+		constraintSolver->setConstrainedVelocitiesArrays(&m_constrainedLinearVelocities[0],
+		                                                 &m_constrainedAngularVelocities[0]);
+		constraintSolver->setInverseInertiaTensorsArray(&m_inverseInertiaTensorsWorld[0]);
+		constraintSolver->setConstrainedPositionsArrays(&m_constrainedPositions[0],
+		                                                &m_constrainedOrientations[0]);
+	}
+}
+
+void ephysics::DynamicsWorld::parallelFor(TaskScheduler::Task& _task, int32_t _nbItems, int32_t _grainSize) {
+	if (m_taskScheduler == null) {
+		_task.execute(0, _nbItems, 0);
+		return;
+	}
+	m_taskScheduler->parallelFor(_task, _nbItems, _grainSize);
+}
+
+void ephysics::DynamicsWorld::setTaskScheduler(TaskScheduler* _scheduler) {
+	m_taskScheduler = _scheduler;
+	// The thread solvers are created again for the new number of threads
+	for (auto &it: m_threadContactSolvers) {
+		ETK_DELETE(ContactSolver, it);
+		it = null;
+	}
+	m_threadContactSolvers.clear();
+	for (auto &it: m_threadConstraintSolvers) {
+		ETK_DELETE(ConstraintSolver, it);
+		it = null;
+	}
+	m_threadConstraintSolvers.clear();
+	if (    m_ownedTaskScheduler != null
+	     && m_ownedTaskScheduler != _scheduler) {
+		ETK_DELETE(TaskScheduler, m_ownedTaskScheduler);
+		m_ownedTaskScheduler = null;
+	}
+}
+
+void ephysics::DynamicsWorld::setNbThreads(int32_t _nbThreads) {
+	if (_nbThreads == 1) {
+		setTaskScheduler(null);
+		return;
+	}
+	TaskScheduler* scheduler = ETK_NEW(WorkStealingTaskScheduler, _nbThreads);
+	setTaskScheduler(scheduler);
+	m_ownedTaskScheduler = scheduler;
+}
+
 ephysics::RigidBody* ephysics::DynamicsWorld::createRigidBody(const etk::Transform3D& _transform) {
 	// Compute the body ID
 	ephysics::bodyindex bodyID = computeNextAvailableBodyID();
@@ -335,6 +668,8 @@ ephysics::RigidBody* ephysics::DynamicsWorld::createRigidBody(const etk::Transfo
 }
 
 void ephysics::DynamicsWorld::destroyRigidBody(RigidBody* _rigidBody) {
+	// Drop the modifications recorded on the body
+	m_commandQueue.removeBody(_rigidBody);
 	// Remove all the collision shapes of the body
 	_rigidBody->removeAllCollisionShapes();
 	// Add the body ID to the list of free IDs
@@ -397,6 +732,8 @@ void ephysics::DynamicsWorld::destroyJoint(Joint* _joint) {
 		EPHY_WARNING("Request destroy null joint");
 		return;
 	}
+	// Drop the operations recorded on the joint
+	m_commandQueue.removeJoint(_joint);
 	// If the collision between the two bodies of the constraint was disabled
 	if (!_joint->isCollisionEnabled()) {
 		// Remove the pair of bodies from the set of body pairs that cannot collide with each other
@@ -657,7 +994,7 @@ etk::Vector<const ephysics::ContactManifold*> ephysics::DynamicsWorld::getContac
 		// For each contact manifold of the pair
 		const ephysics::ContactManifoldSet& manifoldSet = pair->getContactManifoldSet();
 		for (int32_t i=0; i<manifoldSet.getNbContactManifolds(); i++) {
-			ContactManifold* manifold = manifoldSet.getContactManifold(i);
+			const ContactManifold* manifold = manifoldSet.getContactManifold(i);
 			// Get the contact manifold
 			contactManifolds.pushBack(manifold);
 		}
@@ -666,6 +1003,183 @@ etk::Vector<const ephysics::ContactManifold*> ephysics::DynamicsWorld::getContac
 	return contactManifolds;
 }
 
+void ephysics::DynamicsWorld::shiftOrigin(const vec3& _newOrigin) {
+	CollisionWorld::shiftOrigin(_newOrigin);
+	m_contactStream.translate(-_newOrigin);
+	// The interpolated states of the last advance() are rendered until the next one
+	for (auto &it: m_interpolatedBodyStates) {
+		it.transform.setPosition(it.transform.getPosition() - _newOrigin);
+	}
+}
+
+namespace {
+	const uint32_t stateBufferMagic = 0x45505353; //!< Identifier of a world snapshot ("EPSS")
+}
+
+void ephysics::DynamicsWorld::saveState(etk::Vector<uint8_t>& _buffer) const {
+	PROFILE("DynamicsWorld::saveState()");
+	_buffer.clear();
+	ephysics::stateBuffer::write(_buffer, stateBufferMagic);
+	ephysics::stateBuffer::write(_buffer, uint32_t(m_rigidBodies.size()));
+	ephysics::stateBuffer::write(_buffer, uint32_t(m_joints.size()));
+	// Layout of the world: the bodies with their proxy shapes (checked before anything is restored)
+	ephysics::stateBuffer::write(_buffer, uint32_t(m_bodies.size()));
+	for (auto &it: m_bodies) {
+		ephysics::stateBuffer::write(_buffer, it->m_id);
+		ephysics::stateBuffer::write(_buffer, it->m_numberCollisionShapes);
+		for (const ephysics::ProxyShape* shape = it->getProxyShapesList(); shape != null; shape = shape->getNext()) {
+			ephysics::stateBuffer::write(_buffer, shape);
+			ephysics::stateBuffer::write(_buffer, shape->m_collisionShape);
+			ephysics::stateBuffer::write(_buffer, shape->m_broadPhaseID);
+		}
+	}
+	// State of the rigid bodies (the sets are sorted: the order is the same at the restore)
+	for (auto &it: m_rigidBodies) {
+		ephysics::stateBuffer::write(_buffer, it->m_id);
+		ephysics::stateBuffer::write(_buffer, it->m_transform);
+		ephysics::stateBuffer::write(_buffer, it->m_centerOfMassWorld);
+		ephysics::stateBuffer::write(_buffer, it->m_linearVelocity);
+		ephysics::stateBuffer::write(_buffer, it->m_angularVelocity);
+		ephysics::stateBuffer::write(_buffer, it->m_externalForce);
+		ephysics::stateBuffer::write(_buffer, it->m_externalTorque);
+		ephysics::stateBuffer::write(_buffer, it->m_isSleeping);
+		ephysics::stateBuffer::write(_buffer, it->m_sleepTime);
+	}
+	// Accumulated impulses of the joints (warm starting)
+	for (auto &it: m_joints) {
+		it->saveState(_buffer);
+	}
+	// Broad-phase trees, overlapping pairs and contact manifolds
+	m_collisionDetection.saveState(_buffer);
+}
+
+bool ephysics::DynamicsWorld::restoreState(const etk::Vector<uint8_t>& _buffer) {
+	PROFILE("DynamicsWorld::restoreState()");
+	if (_buffer.size() < sizeof(uint32_t) * 3) {
+		EPHY_ERROR("Can not restore the world state: the buffer is too small");
+		return false;
+	}
+	const uint8_t* data = _buffer.dataPointer();
+	uint32_t magic = 0;
+	uint32_t nbRigidBodies = 0;
+	uint32_t nbJoints = 0;
+	ephysics::stateBuffer::read(data, magic);
+	ephysics::stateBuffer::read(data, nbRigidBodies);
+	ephysics::stateBuffer::read(data, nbJoints);
+	if (    magic != stateBufferMagic
+	     || nbRigidBodies != m_rigidBodies.size()
+	     || nbJoints != m_joints.size()
+	     || checkStateLayout(data, _buffer.dataPointer() + _buffer.size()) == false) {
+		EPHY_ERROR("Can not restore the world state: the buffer has not been saved with this world");
+		return false;
+	}
+	for (auto &it: m_rigidBodies) {
+		// The IDs have been checked with the layout of the world
+		bodyindex id = 0;
+		ephysics::stateBuffer::read(data, id);
+		ephysics::stateBuffer::read(data, it->m_transform);
+		it->m_previousTransform = it->m_transform;
+		ephysics::stateBuffer::read(data, it->m_centerOfMassWorld);
+		ephysics::stateBuffer::read(data, it->m_linearVelocity);
+		ephysics::stateBuffer::read(data, it->m_angularVelocity);
+		ephysics::stateBuffer::read(data, it->m_externalForce);
+		ephysics::stateBuffer::read(data, it->m_externalTorque);
+		ephysics::stateBuffer::read(data, it->m_isSleeping);
+		ephysics::stateBuffer::read(data, it->m_sleepTime);
+	}
+	for (auto &it: m_joints) {
+		it->restoreState(data);
+	}
+	m_collisionDetection.restoreState(data);
+	EPHY_ASSERT(data == _buffer.dataPointer() + _buffer.size(), "The world state has not been fully read");
+	// The contact lists of the bodies and the contact stream refer to the previous state
+	resetContactManifoldListsOfBodies();
+	m_contactStream.clear();
+	return true;
+}
+
+bool ephysics::DynamicsWorld::checkStateLayout(const uint8_t*& _data, const uint8_t* _end) const {
+	// Each read is bounded by the end of the snapshot
+	const size_t proxyShapeSize = sizeof(const ephysics::ProxyShape*) + sizeof(const ephysics::CollisionShape*) + sizeof(int32_t);
+	if (size_t(_end - _data) < sizeof(uint32_t)) {
+		return false;
+	}
+	uint32_t nbBodies = 0;
+	ephysics::stateBuffer::read(_data, nbBodies);
+	if (nbBodies != m_bodies.size()) {
+		return false;
+	}
+	for (auto &it: m_bodies) {
+		if (size_t(_end - _data) < sizeof(bodyindex) + sizeof(uint32_t)) {
+			return false;
+		}
+		bodyindex id = 0;
+		uint32_t nbProxyShapes = 0;
+		ephysics::stateBuffer::read(_data, id);
+		ephysics::stateBuffer::read(_data, nbProxyShapes);
+		if (    id != it->m_id
+		     || nbProxyShapes != it->m_numberCollisionShapes
+		     || size_t(_end - _data) < nbProxyShapes * proxyShapeSize) {
+			return false;
+		}
+		for (const ephysics::ProxyShape* shape = it->getProxyShapesList(); shape != null; shape = shape->getNext()) {
+			const ephysics::ProxyShape* savedShape = null;
+			const ephysics::CollisionShape* savedCollisionShape = null;
+			int32_t savedBroadPhaseID = -1;
+			ephysics::stateBuffer::read(_data, savedShape);
+			ephysics::stateBuffer::read(_data, savedCollisionShape);
+			ephysics::stateBuffer::read(_data, savedBroadPhaseID);
+			if (    savedShape != shape
+			     || savedCollisionShape != shape->m_collisionShape
+			     || savedBroadPhaseID != shape->m_broadPhaseID) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void ephysics::DynamicsWorld::enableContactPairEvents(bool _isEnabled) {
+	m_collisionDetection.m_isContactPairEventsEnabled = _isEnabled;
+	if (_isEnabled == false) {
+		// Forget the reported contacts (no END event will be sent for them)
+		etk::Map<ephysics::overlappingpairid, ephysics::OverlappingPair*>::Iterator it;
+		for (it = m_collisionDetection.m_overlappingPairs.begin();
+		     it != m_collisionDetection.m_overlappingPairs.end();
+		     ++it) {
+			it->second->setIsContactReported(false);
+		}
+		m_collisionDetection.m_pendingContactPairEvents.clear();
+		m_collisionDetection.m_contactPairEvents.clear();
+	}
+}
+
+void ephysics::DynamicsWorld::setContactPairEventsImpulseThreshold(float _beginThreshold, float _persistThreshold) {
+	m_collisionDetection.m_contactBeginImpulseThreshold = _beginThreshold;
+	m_collisionDetection.m_contactPersistImpulseThreshold = _persistThreshold;
+}
+
+void ephysics::DynamicsWorld::enableContactStream(bool _isEnabled) {
+	m_isContactStreamEnabled = _isEnabled;
+	if (m_isContactStreamEnabled == false) {
+		m_contactStream.clear();
+	}
+}
+
+void ephysics::DynamicsWorld::updateContactStream() {
+	PROFILE("ephysics::DynamicsWorld::updateContactStream()");
+	// For each pair in contact during the narrow-phase of this step
+	etk::Map<ephysics::overlappingpairid, ephysics::OverlappingPair*>::Iterator it;
+	for (it = m_collisionDetection.m_contactOverlappingPairs.begin();
+	     it != m_collisionDetection.m_contactOverlappingPairs.end();
+	     ++it) {
+		const ephysics::ContactManifoldSet& manifoldSet = it->second->getContactManifoldSet();
+		for (int32_t iii=0; iii<manifoldSet.getNbContactManifolds(); ++iii) {
+			m_contactStream.addContactManifold(*manifoldSet.getContactManifold(iii));
+		}
+	}
+}
+
 void ephysics::DynamicsWorld::resetBodiesForceAndTorque() {
 	// For each body of the world
 	etk::Set<ephysics::RigidBody*>::Iterator it;
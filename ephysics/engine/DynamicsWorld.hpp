@@ -14,6 +14,10 @@
 #include <ephysics/engine/ConstraintSolver.hpp>
 #include <ephysics/body/RigidBody.hpp>
 #include <ephysics/engine/Island.hpp>
+#include <ephysics/engine/ContactStream.hpp>
+#include <ephysics/engine/BodyCommandQueue.hpp>
+#include <ephysics/engine/UpdateThread.hpp>
+#include <ephysics/engine/TaskScheduler.hpp>
 #include <ephysics/configuration.hpp>
 
 namespace ephysics {
@@ -40,12 +44,29 @@ namespace ephysics {
 			etk::Vector<vec3> m_splitAngularVelocities; //!< Split angular velocities for the position contact solver (split impulse)
 			etk::Vector<vec3> m_constrainedPositions; //!< Array of constrained rigid bodies position (for position error correction)
 			etk::Vector<etk::Quaternion> m_constrainedOrientations; //!< Array of constrained rigid bodies orientation (for position error correction)
+			etk::Vector<etk::Matrix3x3> m_inverseInertiaTensorsWorld; //!< Array of the world inverse inertia tensors of the bodies, computed once per step by integrateRigidBodiesVelocities()
 			etk::Map<RigidBody*, uint32_t> m_mapBodyToConstrainedVelocityIndex; //!< Map body to their index in the constrained velocities array
 			etk::Vector<Island*> m_islands; //!< Array with all the islands of awaken bodies
 			uint32_t m_numberBodiesCapacity; //!< Current allocated capacity for the bodies
 			float m_sleepLinearVelocity; //!< Sleep linear velocity threshold
 			float m_sleepAngularVelocity; //!< Sleep angular velocity threshold
 			float m_timeBeforeSleep; //!< Time (in seconds) before a body is put to sleep if its velocity becomes smaller than the sleep velocity.
+			bool m_isContactStreamEnabled; //!< True if the contact stream is filled at each step
+			ContactStream m_contactStream; //!< Contacts of the last simulation step (flat arrays)
+			BodyCommandQueue m_commandQueue; //!< Operations on the bodies and joints applied at the start of the next step
+			UpdateThread* m_updateThread; //!< Background thread of beginUpdate() (created on the first call)
+			TaskScheduler* m_taskScheduler; //!< Scheduler of the parallel phases of the step (null: the step is executed on the calling thread)
+			TaskScheduler* m_ownedTaskScheduler; //!< Scheduler created by setNbThreads()
+			etk::Vector<ContactSolver*> m_threadContactSolvers; //!< Contact solvers of the threads 1 to N-1 of the scheduler
+			etk::Vector<ConstraintSolver*> m_threadConstraintSolvers; //!< Constraint solvers of the threads 1 to N-1 of the scheduler
+			etk::Vector<RigidBody*> m_islandBodies; //!< Bodies of all the islands, each body once (flat array of the parallel loops)
+			etk::Vector<Island*> m_parallelIslands; //!< Islands solved in parallel
+			etk::Vector<Island*> m_sequentialIslands; //!< Islands solved on the calling thread (joint attached to a static body shared with other islands)
+			float m_fixedTimeStep; //!< Time step of the fixed steps of advance() (in seconds)
+			uint32_t m_maxNbSubSteps; //!< Maximum number of fixed steps executed by one call of advance()
+			float m_accumulator; //!< Real time not simulated yet by advance() (in seconds)
+			float m_interpolationFactor; //!< Position of the rendered time between the two last fixed steps [0, 1[
+			etk::Vector<BodyState> m_interpolatedBodyStates; //!< Body states interpolated by the last call of advance()
 			/// Private copy-constructor
 			DynamicsWorld(const DynamicsWorld& world) = delete;
 			/// Private assignment operator
@@ -56,10 +77,24 @@ namespace ephysics {
 			 * the sympletic Euler time stepping scheme.
 			 */
 			void integrateRigidBodiesPositions();
+			/// Integrate the position and orientation of the island bodies [_begin, _end[
+			void integrateRigidBodiesPositions(int32_t _begin, int32_t _end, int32_t _threadIndex);
 			/**
 			 * @brief Reset the external force and torque applied to the bodies
 			 */
 			void resetBodiesForceAndTorque();
+			/**
+			 * @brief Fill the contact stream with the contacts of the current step
+			 */
+			void updateContactStream();
+			/**
+			 * @brief Check that the bodies and the proxy shapes stored in a world snapshot are the
+			 * ones of the world (nothing is modified when they do not match)
+			 * @param[in,out] _data Reading cursor in the snapshot (moved after the layout of the world)
+			 * @param[in] _end End of the snapshot
+			 * @return true if the snapshot has been saved with the current bodies and proxy shapes
+			 */
+			bool checkStateLayout(const uint8_t*& _data, const uint8_t* _end) const;
 			/**
 			 * @brief Initialize the bodies velocities arrays for the next simulation step.
 			 */
@@ -72,14 +107,35 @@ namespace ephysics {
 			 * contact solver.
 			 */
 			void integrateRigidBodiesVelocities();
+			/// Integrate the velocities of the island bodies [_begin, _end[
+			void integrateRigidBodiesVelocities(int32_t _begin, int32_t _end, int32_t _threadIndex);
 			/**
 			 * @brief Solve the contacts and constraints
 			 */
 			void solveContactsAndConstraints();
+			/// Solve the contacts and constraints of the parallel islands [_begin, _end[
+			void solveContactsAndConstraints(int32_t _begin, int32_t _end, int32_t _threadIndex);
+			/// Solve the contacts and constraints of an island with the solvers of a thread
+			void solveIsland(Island* _island, int32_t _threadIndex);
+			/// Execute a step of the simulation: apply the batch of commands taken before (see BodyCommandQueue::takeBatch()) and simulate
+			void updateStep(float _timeStep);
 			/**
 			 * @brief Solve the position error correction of the constraints
 			 */
 			void solvePositionCorrection();
+			/// Solve the position error correction of the parallel islands [_begin, _end[
+			void solvePositionCorrection(int32_t _begin, int32_t _end, int32_t _threadIndex);
+			/**
+			 * @brief Dispatch the islands between m_parallelIslands and m_sequentialIslands. The static
+			 * bodies are shared by the islands: an island with a joint attached to a static body is
+			 * solved sequentially (the joints write the constrained state of both bodies).
+			 * @param[in] _onlyWithJoints Only keep the islands that contain joints
+			 */
+			void splitIslands(bool _onlyWithJoints);
+			/// Create the solvers of the threads of the scheduler and copy the settings of the main solvers
+			void prepareThreadSolvers();
+			/// Execute a task on the scheduler (or on the calling thread if there is no scheduler)
+			void parallelFor(TaskScheduler::Task& _task, int32_t _nbItems, int32_t _grainSize);
 			/**
 			 * @brief Compute the islands of awake bodies.
 			 * An island is an isolated group of rigid bodies that have constraints (joints or contacts)
@@ -94,6 +150,8 @@ namespace ephysics {
 			 * @brief Update the postion/orientation of the bodies
 			 */
 			void updateBodiesState();
+			/// Update the postion/orientation of the island bodies [_begin, _end[ (without the broad-phase)
+			void updateBodiesState(int32_t _begin, int32_t _end, int32_t _threadIndex);
 			/**
 			 * @brief Put bodies to sleep if needed.
 			 * For each island, if all the bodies have been almost still for a long enough period of
@@ -116,10 +174,110 @@ namespace ephysics {
 			 */
 			virtual ~DynamicsWorld();
 			/**
-			 * @brief Update the physics simulation
+			 * @brief Update the physics simulation (the commands recorded in the command queue until now are applied first)
 			 * @param timeStep The amount of time to step the simulation by (in seconds)
 			 */
 			void update(float _timeStep);
+			/**
+			 * @brief Drive a batch of kinematic bodies (animated platforms, bones...) to target transforms.
+			 * The linear and angular velocities that reach the targets in _timeStep are set on the
+			 * bodies: the bodies are moved by the next step (the broad-phase is updated once at the end
+			 * of the step) and they push the dynamic bodies in contact. The velocities are kept after
+			 * the step: give the targets at each frame (a target equal to the current transform stops the body).
+			 * @param[in] _bodies Kinematic bodies to drive (the other types are ignored)
+			 * @param[in] _targets Target transform of each body
+			 * @param[in] _nbBodies Number of bodies
+			 * @param[in] _timeStep Time to reach the targets (in seconds, time step of the next update)
+			 */
+			void setKinematicTargets(RigidBody* const* _bodies, const etk::Transform3D* _targets, size_t _nbBodies, float _timeStep);
+			/**
+			 * @brief Advance the simulation by a real elapsed time with fixed time steps. The elapsed
+			 * time is accumulated and 0 to getMaxNbSubSteps() steps of getFixedTimeStep() are executed
+			 * (the time exceeding the cap is dropped). Then the transform of each body is interpolated
+			 * between the start and the end of the last step (see getInterpolatedBodyStates()).
+			 * @param[in] _realTimeStep Real time elapsed since the previous call (in seconds)
+			 * @return Number of fixed steps executed
+			 */
+			uint32_t advance(float _realTimeStep);
+			/**
+			 * @brief Set the time step of the fixed steps of advance()
+			 * @param[in] _timeStep Time step (in seconds, strictly positive)
+			 */
+			void setFixedTimeStep(float _timeStep);
+			/// Get the time step of the fixed steps of advance() (in seconds)
+			float getFixedTimeStep() const {
+				return m_fixedTimeStep;
+			}
+			/**
+			 * @brief Set the maximum number of fixed steps executed by one call of advance()
+			 * @param[in] _maxNbSubSteps Maximum number of steps (at least 1)
+			 */
+			void setMaxNbSubSteps(uint32_t _maxNbSubSteps);
+			/// Get the maximum number of fixed steps executed by one call of advance()
+			uint32_t getMaxNbSubSteps() const {
+				return m_maxNbSubSteps;
+			}
+			/// Get the interpolation factor computed by the last call of advance() (in [0, 1[)
+			float getInterpolationFactor() const {
+				return m_interpolationFactor;
+			}
+			/**
+			 * @brief Get the states of the rigid bodies for the rendering: the transforms are interpolated
+			 * between the two last fixed steps with the interpolation factor (the velocities are the current ones).
+			 * @return The states computed by the last call of advance()
+			 */
+			const etk::Vector<BodyState>& getInterpolatedBodyStates() const {
+				return m_interpolatedBodyStates;
+			}
+			/**
+			 * @brief Start a step of the simulation on a background thread and return immediately.
+			 * While the step is running, the world must not be modified nor read (except with
+			 * getPublishedBodyStates() and getCommandQueue()) and the event listener is called
+			 * from the background thread. If the previous step is still running, wait its end first.
+			 * The commands recorded in the command queue before this call are applied by the step,
+			 * the ones recorded while it is running are applied by the next step.
+			 * @param[in] _timeStep The amount of time to step the simulation by (in seconds)
+			 */
+			void beginUpdate(float _timeStep);
+			/**
+			 * @brief Wait the end of the step started with beginUpdate() (return immediately if no step is running)
+			 */
+			void waitUpdate();
+			/**
+			 * @brief Get the states of the rigid bodies published at the end of the last step
+			 * started with beginUpdate(). It can be read while the next step is running: the
+			 * returned array stays valid until the next call of beginUpdate().
+			 * @return The published states (empty before the end of the first asynchronous step)
+			 */
+			const etk::Vector<BodyState>& getPublishedBodyStates() const;
+			/**
+			 * @brief Set the scheduler of the parallel phases of the step (integration, solving of the
+			 * islands and update of the bodies). Use it to execute the engine on the job system of the
+			 * application. The profiler (IS_PROFILING_ACTIVE) is not thread-safe: use no scheduler in profiling builds.
+			 * @param[in] _scheduler Scheduler used by the world (not owned, null: the step is executed on the calling thread)
+			 */
+			void setTaskScheduler(TaskScheduler* _scheduler);
+			/**
+			 * @brief Create the engine scheduler (WorkStealingTaskScheduler) with a given number of threads
+			 * @param[in] _nbThreads Number of threads including the thread that calls update() (1: no scheduler, 0: number of hardware threads)
+			 */
+			void setNbThreads(int32_t _nbThreads);
+			/**
+			 * @brief Get the scheduler of the parallel phases of the step
+			 * @return The scheduler (null if the step is executed on the calling thread)
+			 */
+			TaskScheduler* getTaskScheduler() const {
+				return m_taskScheduler;
+			}
+			/**
+			 * @brief Get the queue of the operations on the bodies and the joints (creation, destruction,
+			 * transforms, velocities, forces and torques). The commands can be recorded from any thread,
+			 * even while a step is running, and they are applied in a batch at the start of the next step.
+			 * @return The command queue of the world
+			 */
+			BodyCommandQueue& getCommandQueue() {
+				return m_commandQueue;
+			}
 			/**
 			 * @brief Get the number of iterations for the velocity constraint solver
 			 * @return Number if iteration.
@@ -283,12 +441,79 @@ namespace ephysics {
 			                           CollisionCallback* _callback) override;
 			/// Test and report collisions between all shapes of the world
 			virtual void testCollision(CollisionCallback* _callback) override;
+			/// Move the origin of the world (the contact stream and the interpolated states of the last step are translated too)
+			virtual void shiftOrigin(const vec3& _newOrigin) override;
+			/**
+			 * @brief Save the simulation state of the world in a buffer (rollback, replays...).
+			 * The snapshot contains the state of the rigid bodies (transform, velocities, forces,
+			 * sleeping), the accumulated impulses of the joints, the broad-phase trees and the
+			 * overlapping pairs with their contact manifolds, as raw bytes: restoring it is a set
+			 * of memory copies. The snapshot is only valid for this world: no body, joint or proxy
+			 * shape can be created or destroyed between the save and the restore (the bodies and
+			 * their proxy shapes are stored with the state and checked by restoreState()).
+			 * @param[out] _buffer Buffer where the state is stored (previous content is erased)
+			 */
+			void saveState(etk::Vector<uint8_t>& _buffer) const;
+			/**
+			 * @brief Restore a simulation state saved with saveState(). No event is reported
+			 * for the pairs that are created or destroyed by the restore.
+			 * @param[in] _buffer Buffer filled by saveState()
+			 * @return true if the state has been restored, false if the buffer does not match the world
+			 *         (the world is not modified)
+			 */
+			bool restoreState(const etk::Vector<uint8_t>& _buffer);
 			/**
 			 * @brief Get list of all contacts.
 			 * @return The list of all contacts of the world
 			 */
 			etk::Vector<const ContactManifold*> getContactsList() const;
+			/**
+			 * @brief Enable/Disable the contact pair events (BEGIN/PERSIST/END) computed at each step
+			 * @param[in] _isEnabled True if the contact pair events must be computed
+			 */
+			void enableContactPairEvents(bool _isEnabled);
+			/**
+			 * @brief Set the minimum accumulated normal impulse of a pair to report its contact events
+			 * (to filter the light touches). A pair with a lower impulse does not start a contact
+			 * (no BEGIN event) and does not report PERSIST events. END events are always reported
+			 * for a pair that has reported a BEGIN event.
+			 * @param[in] _beginThreshold Minimum normal impulse to report a BEGIN event (0 by default)
+			 * @param[in] _persistThreshold Minimum normal impulse to report a PERSIST event (0 by default)
+			 */
+			void setContactPairEventsImpulseThreshold(float _beginThreshold, float _persistThreshold);
+			/**
+			 * @brief Get the contact pair events of the last simulation step.
+			 * The list stays valid until the next call of update().
+			 * @return The list of contact pair events
+			 */
+			const etk::Vector<ContactPairEvent>& getContactPairEvents() const {
+				return m_collisionDetection.m_contactPairEvents;
+			}
+			/**
+			 * @brief Get the trigger events (ENTER/EXIT) of the last simulation step.
+			 * The list stays valid until the next call of update().
+			 * @return The list of trigger events
+			 */
+			const etk::Vector<TriggerEvent>& getTriggerEvents() const {
+				return m_collisionDetection.m_triggerEvents;
+			}
+			/**
+			 * @brief Enable/Disable the filling of the contact stream at each step
+			 * @param[in] _isEnabled True if the contacts must be exported in the contact stream
+			 */
+			void enableContactStream(bool _isEnabled);
+			/**
+			 * @brief Get the contacts of the last simulation step as flat arrays (no copy).
+			 * The data stay valid until the next call of update(). The stream is empty when
+			 * it has not been enabled with enableContactStream().
+			 * @return The contact stream of the world
+			 */
+			const ContactStream& getContactStream() const {
+				return m_contactStream;
+			}
 			friend class RigidBody;
+			friend class WorldSerializer;
+			friend class UpdateThread;
 	};
 
 
@@ -11,6 +11,43 @@
 #include <ephysics/constraint/ContactPoint.hpp>
 
 namespace ephysics {
+	/**
+	 * @brief Contact event between two proxy shapes, reported once per simulation step.
+	 * The bodies are given by ID and the shapes by user data because the objects can
+	 * already be destroyed when an END event is reported.
+	 */
+	struct ContactPairEvent {
+		public:
+			/// Type of contact pair event
+			enum Type {
+				BEGIN, //!< The two shapes start touching
+				PERSIST, //!< The two shapes are still touching
+				END //!< The two shapes do not touch anymore
+			};
+			Type type; //!< Type of the event
+			bodyindex body1Id; //!< ID of the first body
+			bodyindex body2Id; //!< ID of the second body
+			void* shape1UserData; //!< User data of the first proxy shape
+			void* shape2UserData; //!< User data of the second proxy shape
+			uint32_t nbContactPoints; //!< Number of contact points between the two shapes (0 for END)
+			float normalImpulse; //!< Sum of the normal impulses applied by the solver on the contact points during the step (0 for END)
+	};
+	/**
+	 * @brief Overlap event between a trigger proxy shape and another proxy shape.
+	 */
+	struct TriggerEvent {
+		public:
+			/// Type of trigger event
+			enum Type {
+				ENTER, //!< The two shapes start overlapping
+				EXIT //!< The two shapes do not overlap anymore
+			};
+			Type type; //!< Type of the event
+			bodyindex body1Id; //!< ID of the first body
+			bodyindex body2Id; //!< ID of the second body
+			void* shape1UserData; //!< User data of the first proxy shape
+			void* shape2UserData; //!< User data of the second proxy shape
+	};
 	/**
 	 * @brief This class can be used to receive event callbacks from the physics engine.
 	 * In order to receive callbacks, you need to create a new class that inherits from
@@ -52,5 +89,17 @@ namespace ephysics {
 			 * called at the end of each int32_ternal simulation step.
 			 */
 			virtual void endInternalTick() {}
+			/**
+			 * @brief Called once per simulation step with all the contact pair events of the step
+			 * (only if the contact pair events are enabled and at least one event occured).
+			 * @param[in] _events List of the events (valid until the next simulation step)
+			 */
+			virtual void contactPairEvents(const etk::Vector<ContactPairEvent>& /*_events*/) {}
+			/**
+			 * @brief Called once per simulation step with all the trigger events of the step
+			 * (only if at least one event occured).
+			 * @param[in] _events List of the events (valid until the next simulation step)
+			 */
+			virtual void triggerEvents(const etk::Vector<TriggerEvent>& /*_events*/) {}
 	};
 }
@@ -7,12 +7,16 @@
  * @license MPL v2.0 (see license file)
  */
 #include <ephysics/engine/OverlappingPair.hpp>
+#include <ephysics/engine/StateBuffer.hpp>
 
 using namespace ephysics;
 
 OverlappingPair::OverlappingPair(ProxyShape* _shape1, ProxyShape* _shape2, int32_t _nbMaxContactManifolds):
   m_contactManifoldSet(_shape1, _shape2, _nbMaxContactManifolds),
-  m_cachedSeparatingAxis(1.0, 1.0, 1.0) {
+  m_cachedSeparatingAxis(1.0, 1.0, 1.0),
+  m_isContactReported(false),
+  m_isTriggerOverlapping(false),
+  m_collisionFilterVersion(0) {
 	
 }
 
@@ -24,8 +28,8 @@ ProxyShape* OverlappingPair::getShape2() const {
 	return m_contactManifoldSet.getShape2();
 }
 
-void OverlappingPair::addContact(ContactPoint* _contact) {
-	m_contactManifoldSet.addContactPoint(_contact);
+void OverlappingPair::addContact(const ContactPointInfo& _contactInfo) {
+	m_contactManifoldSet.addContactPoint(_contactInfo);
 }
 
 void OverlappingPair::update() {
@@ -44,7 +48,7 @@ uint32_t OverlappingPair::getNbContactPoints() const {
 	return m_contactManifoldSet.getTotalNbContactPoints();
 }
 
-const ContactManifoldSet& OverlappingPair::getContactManifoldSet() {
+ContactManifoldSet& OverlappingPair::getContactManifoldSet() {
 	return m_contactManifoldSet;
 }
 
@@ -73,3 +77,18 @@ void OverlappingPair::clearContactPoints() {
 	m_contactManifoldSet.clear();
 }
 
+void OverlappingPair::saveState(etk::Vector<uint8_t>& _buffer) const {
+	stateBuffer::write(_buffer, m_cachedSeparatingAxis);
+	stateBuffer::write(_buffer, m_isContactReported);
+	stateBuffer::write(_buffer, m_isTriggerOverlapping);
+	stateBuffer::write(_buffer, m_collisionFilterVersion);
+	m_contactManifoldSet.saveState(_buffer);
+}
+
+void OverlappingPair::restoreState(const uint8_t*& _data) {
+	stateBuffer::read(_data, m_cachedSeparatingAxis);
+	stateBuffer::read(_data, m_isContactReported);
+	stateBuffer::read(_data, m_isTriggerOverlapping);
+	stateBuffer::read(_data, m_collisionFilterVersion);
+	m_contactManifoldSet.restoreState(_data);
+}
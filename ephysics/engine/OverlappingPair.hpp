@@ -25,6 +25,9 @@ namespace ephysics {
 		private:
 			ContactManifoldSet m_contactManifoldSet; //!< Set of persistent contact manifolds
 			vec3 m_cachedSeparatingAxis; //!< Cached previous separating axis
+			bool m_isContactReported; //!< True if a BEGIN contact pair event has been reported and not yet the END event
+			bool m_isTriggerOverlapping; //!< True if a trigger ENTER event has been reported and not yet the EXIT event
+			uint32_t m_collisionFilterVersion; //!< Version of the collision filters when the pair has been checked last time
 			/// Private copy-constructor
 			OverlappingPair(const OverlappingPair& pair);
 			/// Private assignment operator
@@ -39,7 +42,7 @@ namespace ephysics {
 			/// Return the pointer to second body
 			ProxyShape* getShape2() const;
 			/// Add a contact to the contact cache
-			void addContact(ContactPoint* contact);
+			void addContact(const ContactPointInfo& _contactInfo);
 			/// Update the contact cache
 			void update();
 			/// Return the cached separating axis
@@ -49,9 +52,37 @@ namespace ephysics {
 			/// Return the number of contacts in the cache
 			uint32_t getNbContactPoints() const;
 			/// Return the a reference to the contact manifold set
-			const ContactManifoldSet& getContactManifoldSet();
+			ContactManifoldSet& getContactManifoldSet();
+			/// Return true if a BEGIN contact pair event has been reported (and not yet the END event)
+			bool isContactReported() const {
+				return m_isContactReported;
+			}
+			/// Set whether a BEGIN contact pair event has been reported
+			void setIsContactReported(bool _isReported) {
+				m_isContactReported = _isReported;
+			}
+			/// Return the version of the collision filters when the pair has been checked last time
+			uint32_t getCollisionFilterVersion() const {
+				return m_collisionFilterVersion;
+			}
+			/// Set the version of the collision filters the pair has been checked with
+			void setCollisionFilterVersion(uint32_t _version) {
+				m_collisionFilterVersion = _version;
+			}
+			/// Return true if the shapes of a trigger pair are overlapping (ENTER reported)
+			bool isTriggerOverlapping() const {
+				return m_isTriggerOverlapping;
+			}
+			/// Set whether the shapes of a trigger pair are overlapping
+			void setIsTriggerOverlapping(bool _isOverlapping) {
+				m_isTriggerOverlapping = _isOverlapping;
+			}
 			/// Clear the contact points of the contact manifold
 			void clearContactPoints();
+			/// Save the cached data and the contact manifolds of the pair (see DynamicsWorld::saveState())
+			void saveState(etk::Vector<uint8_t>& _buffer) const;
+			/// Restore the cached data and the contact manifolds saved with saveState()
+			void restoreState(const uint8_t*& _data);
 			/// Return the pair of bodies index
 			static overlappingpairid computeID(ProxyShape* shape1, ProxyShape* shape2);
 			/// Return the pair of bodies index of the pair
@@ -0,0 +1,56 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/Vector.hpp>
+#include <etk/types.hpp>
+
+namespace ephysics {
+	/**
+	 * @brief Helpers to store the raw bytes of the simulation state in a buffer (world
+	 * snapshot). The buffer is only valid for the world (and the process) that saved it:
+	 * it contains raw pointers on the bodies and the proxy shapes.
+	 */
+	namespace stateBuffer {
+		/**
+		 * @brief Append raw bytes at the end of the buffer
+		 * @param[in,out] _buffer Buffer to write in
+		 * @param[in] _data Pointer on the data to copy
+		 * @param[in] _size Number of bytes to copy
+		 */
+		inline void write(etk::Vector<uint8_t>& _buffer, const void* _data, size_t _size) {
+			if (_size == 0) {
+				return;
+			}
+			size_t offset = _buffer.size();
+			_buffer.resize(offset + _size);
+			memcpy(&_buffer[offset], _data, _size);
+		}
+		/// Append the raw bytes of a value at the end of the buffer
+		template<class TYPE>
+		inline void write(etk::Vector<uint8_t>& _buffer, const TYPE& _value) {
+			write(_buffer, &_value, sizeof(TYPE));
+		}
+		/**
+		 * @brief Read raw bytes and move the reading cursor
+		 * @param[in,out] _data Reading cursor in the buffer
+		 * @param[out] _out Pointer on the memory to fill
+		 * @param[in] _size Number of bytes to read
+		 */
+		inline void read(const uint8_t*& _data, void* _out, size_t _size) {
+			if (_size == 0) {
+				return;
+			}
+			memcpy(_out, _data, _size);
+			_data += _size;
+		}
+		/// Read the raw bytes of a value and move the reading cursor
+		template<class TYPE>
+		inline void read(const uint8_t*& _data, TYPE& _value) {
+			read(_data, &_value, sizeof(TYPE));
+		}
+	}
+}
@@ -0,0 +1,48 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/types.hpp>
+
+namespace ephysics {
+	/**
+	 * @brief Interface of the scheduler used by the engine to execute the parallel phases of a
+	 * step. The engine provides its own implementation (WorkStealingTaskScheduler) and the
+	 * host application can implement this interface to plug its own job system.
+	 */
+	class TaskScheduler {
+		public:
+			/**
+			 * @brief Work executed on a range of items
+			 */
+			class Task {
+				public:
+					/// Virtualize the destructor
+					virtual ~Task() = default;
+					/**
+					 * @brief Execute the items of a range (the ranges of a parallelFor() do not overlap)
+					 * @param[in] _begin First item of the range
+					 * @param[in] _end Item after the last item of the range
+					 * @param[in] _threadIndex Index of the executing thread in [0, getNbThreads()[ (two ranges are never executed at the same time with the same index)
+					 */
+					virtual void execute(int32_t _begin, int32_t _end, int32_t _threadIndex) = 0;
+			};
+			/// Virtualize the destructor
+			virtual ~TaskScheduler() = default;
+			/**
+			 * @brief Get the number of threads that can execute the tasks (including the calling thread)
+			 * @return Number of thread indexes used in Task::execute()
+			 */
+			virtual int32_t getNbThreads() const = 0;
+			/**
+			 * @brief Execute a task on the items [0, _nbItems[ and return when all the items are executed
+			 * @param[in] _task Task to execute
+			 * @param[in] _nbItems Number of items
+			 * @param[in] _grainSize Maximum number of items of a range
+			 */
+			virtual void parallelFor(Task& _task, int32_t _nbItems, int32_t _grainSize) = 0;
+	};
+}
@@ -0,0 +1,91 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#include <ephysics/engine/UpdateThread.hpp>
+#include <ephysics/engine/DynamicsWorld.hpp>
+
+using namespace ephysics;
+
+UpdateThread::UpdateThread(DynamicsWorld& _world):
+  m_world(_world),
+  m_isStepRequested(false),
+  m_isStepRunning(false),
+  m_isStopRequested(false),
+  m_timeStep(0.0f),
+  m_frontStates(0) {
+	m_thread = std::thread(&UpdateThread::run, this);
+}
+
+UpdateThread::~UpdateThread() {
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_isStopRequested = true;
+	}
+	m_condition.notify_all();
+	m_thread.join();
+}
+
+void UpdateThread::start(float _timeStep) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (m_isStepRunning == true) {
+		m_condition.wait(lock);
+	}
+	m_timeStep = _timeStep;
+	m_isStepRequested = true;
+	m_isStepRunning = true;
+	lock.unlock();
+	m_condition.notify_all();
+}
+
+void UpdateThread::wait() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (m_isStepRunning == true) {
+		m_condition.wait(lock);
+	}
+}
+
+bool UpdateThread::isRunning() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_isStepRunning;
+}
+
+void UpdateThread::run() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true) {
+		while (    m_isStepRequested == false
+		        && m_isStopRequested == false) {
+			m_condition.wait(lock);
+		}
+		if (m_isStepRequested == false) {
+			// stop requested and no pending step
+			return;
+		}
+		m_isStepRequested = false;
+		float timeStep = m_timeStep;
+		lock.unlock();
+		// The batch of commands has been taken by DynamicsWorld::beginUpdate()
+		m_world.updateStep(timeStep);
+		publish();
+		lock.lock();
+		m_isStepRunning = false;
+		m_condition.notify_all();
+	}
+}
+
+void UpdateThread::publish() {
+	// The back buffer has been published before the current step request: the references returned by getStates() are valid until start()
+	int32_t backStates = 1 - m_frontStates.load();
+	etk::Vector<BodyState>& states = m_states[backStates];
+	states.clear();
+	for (auto &it: m_world.m_rigidBodies) {
+		BodyState state;
+		state.body = it;
+		state.transform = it->getTransform();
+		state.linearVelocity = it->getLinearVelocity();
+		state.angularVelocity = it->getAngularVelocity();
+		states.pushBack(state);
+	}
+	m_frontStates.store(backStates);
+}
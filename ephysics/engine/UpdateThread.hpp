@@ -0,0 +1,73 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/Vector.hpp>
+#include <etk/math/Transform3D.hpp>
+#include <etk/math/Vector3D.hpp>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace ephysics {
+	class DynamicsWorld;
+	class RigidBody;
+	/**
+	 * @brief State of a rigid body published at the end of an asynchronous step
+	 */
+	class BodyState {
+		public:
+			RigidBody* body; //!< Body of the state
+			etk::Transform3D transform; //!< Transform of the body at the end of the step
+			vec3 linearVelocity; //!< Linear velocity of the body at the end of the step
+			vec3 angularVelocity; //!< Angular velocity of the body at the end of the step
+	};
+	/**
+	 * @brief Thread that steps a dynamics world in the background (see DynamicsWorld::beginUpdate()).
+	 * At the end of each step the states of the bodies are written in the back buffer and the
+	 * buffers are swapped: the front buffer is never written while a step is running.
+	 */
+	class UpdateThread {
+		protected:
+			DynamicsWorld& m_world; //!< Stepped world
+			std::thread m_thread; //!< Background thread
+			std::mutex m_mutex; //!< Protect the step request flags
+			std::condition_variable m_condition; //!< Signal a step request, the end of a step or the stop request
+			bool m_isStepRequested; //!< A step is waiting to be processed
+			bool m_isStepRunning; //!< A step has been requested and is not finished
+			bool m_isStopRequested; //!< The thread has to exit
+			float m_timeStep; //!< Time step of the requested step
+			etk::Vector<BodyState> m_states[2]; //!< Double buffer of the published body states
+			std::atomic<int32_t> m_frontStates; //!< Index of the front buffer in m_states
+			/// Main loop of the background thread
+			void run();
+			/// Write the states of the bodies in the back buffer and swap the buffers
+			void publish();
+		public:
+			/// Constructor (start the background thread)
+			UpdateThread(DynamicsWorld& _world);
+			/// Destructor (wait the running step and stop the background thread)
+			~UpdateThread();
+			/// DELETE copy-constructor
+			UpdateThread(const UpdateThread& _obj) = delete;
+			/// DELETE assignment operator
+			UpdateThread& operator=(const UpdateThread& _obj) = delete;
+			/**
+			 * @brief Request a step of the world (wait the previous one if it is still running)
+			 * @param[in] _timeStep Time step of the simulation (in seconds)
+			 */
+			void start(float _timeStep);
+			/// Wait the end of the running step (return immediately if no step is running)
+			void wait();
+			/// Return true if a step is running
+			bool isRunning();
+			/// Return the body states published at the end of the last finished step
+			const etk::Vector<BodyState>& getStates() const {
+				return m_states[m_frontStates.load()];
+			}
+	};
+}
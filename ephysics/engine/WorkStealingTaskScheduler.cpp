@@ -0,0 +1,155 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#include <ephysics/engine/WorkStealingTaskScheduler.hpp>
+#include <ephysics/debug.hpp>
+
+using namespace ephysics;
+
+namespace {
+	/// Index of the thread that is executing a range, -1 otherwise (the nested parallelFor() are executed inline)
+	thread_local int32_t executingThreadIndex = -1;
+}
+
+WorkStealingTaskScheduler::WorkStealingTaskScheduler(int32_t _nbThreads):
+  m_generation(0),
+  m_isStopRequested(false),
+  m_nbRemainingRanges(0) {
+	if (_nbThreads <= 0) {
+		_nbThreads = etk::max(int32_t(std::thread::hardware_concurrency()), 1);
+	}
+	for (int32_t iii=0; iii<_nbThreads; ++iii) {
+		m_queues.pushBack(ETK_NEW(Queue));
+	}
+	for (int32_t iii=1; iii<_nbThreads; ++iii) {
+		m_threads.pushBack(ETK_NEW(std::thread, &WorkStealingTaskScheduler::run, this, iii));
+	}
+}
+
+WorkStealingTaskScheduler::~WorkStealingTaskScheduler() {
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_isStopRequested = true;
+	}
+	m_condition.notify_all();
+	for (auto &it: m_threads) {
+		it->join();
+		ETK_DELETE(std::thread, it);
+		it = null;
+	}
+	m_threads.clear();
+	for (auto &it: m_queues) {
+		ETK_DELETE(Queue, it);
+		it = null;
+	}
+	m_queues.clear();
+}
+
+int32_t WorkStealingTaskScheduler::getNbThreads() const {
+	return m_queues.size();
+}
+
+void WorkStealingTaskScheduler::parallelFor(Task& _task, int32_t _nbItems, int32_t _grainSize) {
+	if (_nbItems <= 0) {
+		return;
+	}
+	_grainSize = etk::max(_grainSize, int32_t(1));
+	// A parallelFor() called from a task is executed inline by the thread of the task
+	if (executingThreadIndex >= 0) {
+		_task.execute(0, _nbItems, executingThreadIndex);
+		return;
+	}
+	// Only one parallelFor() is distributed at a time: the concurrent calls wait
+	std::unique_lock<std::mutex> parallelForLock(m_parallelForMutex);
+	if (    m_threads.size() == 0
+	     || _nbItems <= _grainSize) {
+		_task.execute(0, _nbItems, 0);
+		return;
+	}
+	int32_t nbRanges = (_nbItems + _grainSize - 1) / _grainSize;
+	m_nbRemainingRanges.store(nbRanges);
+	// Distribute the ranges on the queues (the last ranges are pushed first: each thread starts with its first range)
+	int32_t nbQueues = m_queues.size();
+	for (int32_t iii=nbRanges-1; iii>=0; --iii) {
+		Queue& queue = *m_queues[iii % nbQueues];
+		Range range;
+		range.task = &_task;
+		range.begin = iii * _grainSize;
+		range.end = etk::min(range.begin + _grainSize, _nbItems);
+		std::unique_lock<std::mutex> lock(queue.mutex);
+		queue.ranges.pushBack(range);
+	}
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_generation++;
+	}
+	m_condition.notify_all();
+	// The calling thread works on the ranges, then waits the ranges executed by the workers
+	executeRanges(0);
+	while (m_nbRemainingRanges.load() != 0) {
+		std::this_thread::yield();
+	}
+}
+
+bool WorkStealingTaskScheduler::takeRange(int32_t _threadIndex, Range& _range) {
+	// Newest range of the thread queue (best cache locality)
+	{
+		Queue& queue = *m_queues[_threadIndex];
+		std::unique_lock<std::mutex> lock(queue.mutex);
+		if (queue.ranges.size() > queue.first) {
+			_range = queue.ranges.back();
+			queue.ranges.popBack();
+			if (queue.ranges.size() == queue.first) {
+				queue.ranges.clear();
+				queue.first = 0;
+			}
+			return true;
+		}
+	}
+	// Steal the oldest range of another queue
+	int32_t nbQueues = m_queues.size();
+	for (int32_t iii=1; iii<nbQueues; ++iii) {
+		Queue& queue = *m_queues[(_threadIndex + iii) % nbQueues];
+		std::unique_lock<std::mutex> lock(queue.mutex);
+		if (queue.ranges.size() > queue.first) {
+			_range = queue.ranges[queue.first];
+			queue.first++;
+			if (queue.ranges.size() == queue.first) {
+				queue.ranges.clear();
+				queue.first = 0;
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+void WorkStealingTaskScheduler::executeRanges(int32_t _threadIndex) {
+	Range range;
+	while (takeRange(_threadIndex, range) == true) {
+		executingThreadIndex = _threadIndex;
+		range.task->execute(range.begin, range.end, _threadIndex);
+		executingThreadIndex = -1;
+		m_nbRemainingRanges.fetch_sub(1);
+	}
+}
+
+void WorkStealingTaskScheduler::run(int32_t _threadIndex) {
+	uint32_t generation = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			while (    m_generation == generation
+			        && m_isStopRequested == false) {
+				m_condition.wait(lock);
+			}
+			if (m_isStopRequested == true) {
+				return;
+			}
+			generation = m_generation;
+		}
+		executeRanges(_threadIndex);
+	}
+}
@@ -0,0 +1,77 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <ephysics/engine/TaskScheduler.hpp>
+#include <etk/Vector.hpp>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace ephysics {
+	/**
+	 * @brief Task scheduler of the engine: a pool of worker threads with one queue of ranges per
+	 * thread. A parallelFor() distributes its ranges on the queues, each thread executes the
+	 * ranges of its own queue (last in first out) and steals the oldest ranges of the other queues
+	 * when its queue is empty. The calling thread works too (thread index 0).
+	 * The parallelFor() called from different threads are executed one after the other and the
+	 * parallelFor() called from a task is executed inline by the thread of the task.
+	 */
+	class WorkStealingTaskScheduler : public TaskScheduler {
+		protected:
+			/**
+			 * @brief Range of items of a task waiting to be executed
+			 */
+			class Range {
+				public:
+					Task* task; //!< Task to execute
+					int32_t begin; //!< First item
+					int32_t end; //!< Item after the last item
+			};
+			/**
+			 * @brief Queue of ranges of a thread
+			 */
+			class Queue {
+				public:
+					std::mutex mutex; //!< Protect the ranges
+					etk::Vector<Range> ranges; //!< Ranges (the ranges before 'first' have been stolen)
+					size_t first; //!< Index of the oldest range not executed
+					Queue():
+					  first(0) {
+						
+					}
+			};
+			etk::Vector<std::thread*> m_threads; //!< Worker threads (thread index 1 to N-1)
+			etk::Vector<Queue*> m_queues; //!< Queue of each thread (index 0 is the calling thread)
+			std::mutex m_mutex; //!< Protect the generation and the stop request
+			std::condition_variable m_condition; //!< Wake up the workers when new ranges are available
+			uint32_t m_generation; //!< Incremented at each parallelFor()
+			bool m_isStopRequested; //!< The workers have to exit
+			std::atomic<int32_t> m_nbRemainingRanges; //!< Ranges of the current parallelFor() not executed yet
+			std::mutex m_parallelForMutex; //!< Serialize the parallelFor() called from different threads
+			/// Main loop of a worker thread
+			void run(int32_t _threadIndex);
+			/// Take a range in the queue of a thread (newest range) or steal it in another queue (oldest range)
+			bool takeRange(int32_t _threadIndex, Range& _range);
+			/// Execute ranges until all the queues are empty
+			void executeRanges(int32_t _threadIndex);
+		public:
+			/**
+			 * @brief Constructor (start the worker threads)
+			 * @param[in] _nbThreads Number of threads including the calling thread (0: number of hardware threads)
+			 */
+			WorkStealingTaskScheduler(int32_t _nbThreads);
+			/// Destructor (stop the worker threads)
+			virtual ~WorkStealingTaskScheduler();
+			/// DELETE copy-constructor
+			WorkStealingTaskScheduler(const WorkStealingTaskScheduler& _obj) = delete;
+			/// DELETE assignment operator
+			WorkStealingTaskScheduler& operator=(const WorkStealingTaskScheduler& _obj) = delete;
+			int32_t getNbThreads() const override;
+			void parallelFor(Task& _task, int32_t _nbItems, int32_t _grainSize) override;
+	};
+}
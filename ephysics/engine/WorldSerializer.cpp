@@ -0,0 +1,711 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#include <ephysics/engine/WorldSerializer.hpp>
+#include <ephysics/engine/StateBuffer.hpp>
+#include <ephysics/collision/shapes/BoxShape.hpp>
+#include <ephysics/collision/shapes/SphereShape.hpp>
+#include <ephysics/collision/shapes/CapsuleShape.hpp>
+#include <ephysics/collision/shapes/ConeShape.hpp>
+#include <ephysics/collision/shapes/CylinderShape.hpp>
+#include <ephysics/collision/shapes/ConvexMeshShape.hpp>
+#include <ephysics/collision/shapes/CompoundShape.hpp>
+#include <ephysics/constraint/BallAndSocketJoint.hpp>
+#include <ephysics/constraint/SliderJoint.hpp>
+#include <ephysics/constraint/HingeJoint.hpp>
+#include <ephysics/constraint/FixedJoint.hpp>
+#include <ephysics/debug.hpp>
+
+using namespace ephysics;
+
+const uint32_t WorldSerializer::MAGIC = 0x46575045; // "EPWF"
+const uint32_t WorldSerializer::VERSION = 1;
+
+namespace {
+	/**
+	 * @brief Reading cursor that checks the size of the data (the loaded data is not trusted)
+	 */
+	class Reader {
+		private:
+			const uint8_t* m_data; //!< Current position in the data
+			const uint8_t* m_end; //!< End of the data
+			bool m_isValid; //!< False when a read has failed
+		public:
+			Reader(const uint8_t* _data, size_t _size):
+			  m_data(_data),
+			  m_end(_data + _size),
+			  m_isValid(_data != null) {
+
+			}
+			bool isValid() const {
+				return m_isValid;
+			}
+			size_t getRemainingSize() const {
+				return m_end - m_data;
+			}
+			const uint8_t*& getCursor() {
+				return m_data;
+			}
+			bool read(void* _out, size_t _size) {
+				if (    m_isValid == false
+				     || _size > getRemainingSize()) {
+					m_isValid = false;
+					return false;
+				}
+				ephysics::stateBuffer::read(m_data, _out, _size);
+				return true;
+			}
+			template<class TYPE>
+			bool read(TYPE& _value) {
+				return read(&_value, sizeof(TYPE));
+			}
+			/// Check that the data can contain a number of elements (avoid huge allocations on corrupted data)
+			bool checkCount(uint32_t _count, size_t _minElementSize) {
+				if (    m_isValid == false
+				     || _count > getRemainingSize() / _minElementSize) {
+					m_isValid = false;
+				}
+				return m_isValid;
+			}
+	};
+
+	bool isPositive(float _value) {
+		return _value > 0.0f;
+	}
+
+	bool isPositive(const vec3& _value) {
+		return    isPositive(_value.x()) == true
+		       && isPositive(_value.y()) == true
+		       && isPositive(_value.z()) == true;
+	}
+
+	/// Add a shape (and the children of a compound shape before it) in the list of the shapes to save
+	bool collectShape(const CollisionShape* _shape,
+	                  etk::Vector<const CollisionShape*>& _shapes,
+	                  etk::Map<const CollisionShape*, int32_t>& _shapesIndex) {
+		if (_shapesIndex.find(_shape) != _shapesIndex.end()) {
+			return true;
+		}
+		switch (_shape->getType()) {
+			case BOX:
+			case SPHERE:
+			case CAPSULE:
+			case CONE:
+			case CYLINDER:
+			case CONVEX_MESH:
+				break;
+			case COMPOUND: {
+				const CompoundShape* compound = static_cast<const CompoundShape*>(_shape);
+				for (size_t iii=0; iii<compound->getNbChildren(); ++iii) {
+					if (collectShape(compound->getChildShape(iii), _shapes, _shapesIndex) == false) {
+						return false;
+					}
+				}
+				break;
+			}
+			default:
+				EPHY_ERROR("Can not save the collision shape type " << int32_t(_shape->getType()) << " (it references user data)");
+				return false;
+		}
+		_shapesIndex.set(_shape, _shapes.size());
+		_shapes.pushBack(_shape);
+		return true;
+	}
+
+	void writeShape(etk::Vector<uint8_t>& _buffer,
+	                const CollisionShape* _shape,
+	                const etk::Map<const CollisionShape*, int32_t>& _shapesIndex) {
+		stateBuffer::write(_buffer, uint32_t(_shape->getType()));
+		switch (_shape->getType()) {
+			case BOX: {
+				const BoxShape* box = static_cast<const BoxShape*>(_shape);
+				stateBuffer::write(_buffer, box->getExtent());
+				stateBuffer::write(_buffer, box->getMargin());
+				break;
+			}
+			case SPHERE:
+				stateBuffer::write(_buffer, static_cast<const SphereShape*>(_shape)->getRadius());
+				break;
+			case CAPSULE: {
+				const CapsuleShape* capsule = static_cast<const CapsuleShape*>(_shape);
+				stateBuffer::write(_buffer, capsule->getRadius());
+				stateBuffer::write(_buffer, capsule->getHeight());
+				break;
+			}
+			case CONE: {
+				const ConeShape* cone = static_cast<const ConeShape*>(_shape);
+				stateBuffer::write(_buffer, cone->getRadius());
+				stateBuffer::write(_buffer, cone->getHeight());
+				stateBuffer::write(_buffer, cone->getMargin());
+				break;
+			}
+			case CYLINDER: {
+				const CylinderShape* cylinder = static_cast<const CylinderShape*>(_shape);
+				stateBuffer::write(_buffer, cylinder->getRadius());
+				stateBuffer::write(_buffer, cylinder->getHeight());
+				stateBuffer::write(_buffer, cylinder->getMargin());
+				break;
+			}
+			case CONVEX_MESH: {
+				const ConvexMeshShape* mesh = static_cast<const ConvexMeshShape*>(_shape);
+				stateBuffer::write(_buffer, mesh->getMargin());
+				stateBuffer::write(_buffer, mesh->getScaling());
+				stateBuffer::write(_buffer, mesh->getNbVertices());
+				for (uint32_t iii=0; iii<mesh->getNbVertices(); ++iii) {
+					stateBuffer::write(_buffer, mesh->getVertex(iii));
+				}
+				stateBuffer::write(_buffer, mesh->isEdgesInformationUsed());
+				// Each edge is stored once (the adjacency list contains the two directions)
+				etk::Vector<uint32_t> edges;
+				for (auto &it: mesh->getEdgesAdjacencyList()) {
+					for (auto &itVertex: it.second) {
+						if (it.first < itVertex) {
+							edges.pushBack(it.first);
+							edges.pushBack(itVertex);
+						}
+					}
+				}
+				stateBuffer::write(_buffer, uint32_t(edges.size() / 2));
+				stateBuffer::write(_buffer, edges.dataPointer(), edges.size() * sizeof(uint32_t));
+				break;
+			}
+			case COMPOUND: {
+				const CompoundShape* compound = static_cast<const CompoundShape*>(_shape);
+				stateBuffer::write(_buffer, uint32_t(compound->getNbChildren()));
+				for (size_t iii=0; iii<compound->getNbChildren(); ++iii) {
+					stateBuffer::write(_buffer, _shapesIndex.find(compound->getChildShape(iii))->second);
+					stateBuffer::write(_buffer, compound->getChildTransform(iii));
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	/// Proxy shape read from the data (created when all the data has been checked)
+	struct ProxyData {
+		int32_t shapeIndex;
+		etk::Transform3D localTransform;
+		float mass;
+		vec3 localScaling;
+		uint64_t collisionCategoryBits;
+		uint64_t collideWithMaskBits;
+		uint32_t collisionLayer;
+		bool isTrigger;
+	};
+
+	/// Rigid body read from the data (created when all the data has been checked)
+	struct BodyData {
+		uint32_t type;
+		etk::Transform3D transform;
+		vec3 linearVelocity;
+		vec3 angularVelocity;
+		bool isGravityEnabled;
+		float bounciness;
+		float frictionCoefficient;
+		float rollingResistance;
+		float linearDamping;
+		float angularDamping;
+		bool isAllowedToSleep;
+		bool isActive;
+		uint32_t collisionGroup;
+		float mass;
+		vec3 centerOfMassLocal;
+		etk::Matrix3x3 inertiaTensorLocal;
+		uint32_t nbProxies;
+	};
+
+	/// Joint read from the data (created when all the data has been checked)
+	struct JointData {
+		uint32_t type;
+		int32_t body1;
+		int32_t body2;
+		bool isCollisionEnabled;
+		uint32_t positionCorrectionTechnique;
+		const uint8_t* configuration; //!< Configuration of the joint in the data (see Joint::restoreConfiguration())
+	};
+
+	/// Return the size of the configuration of a joint type (written by Joint::saveConfiguration()), 0 for an unknown type
+	uint32_t getJointConfigurationSize(uint32_t _type) {
+		switch (_type) {
+			case BALLSOCKETJOINT:
+				return 2 * sizeof(vec3);
+			case FIXEDJOINT:
+				return 2 * sizeof(vec3) + sizeof(etk::Quaternion);
+			case HINGEJOINT:
+				return 4 * sizeof(vec3) + sizeof(etk::Quaternion) + 2 * sizeof(bool) + 4 * sizeof(float);
+			case SLIDERJOINT:
+				return 3 * sizeof(vec3) + sizeof(etk::Quaternion) + 2 * sizeof(bool) + 4 * sizeof(float);
+			default:
+				return 0;
+		}
+	}
+
+	/// Create a collision shape from the data (return null if the data is not valid)
+	CollisionShape* readShape(Reader& _reader, const etk::Vector<CollisionShape*>& _shapes) {
+		uint32_t type = 0;
+		_reader.read(type);
+		switch (type) {
+			case BOX: {
+				vec3 extent;
+				float margin = 0.0f;
+				_reader.read(extent);
+				_reader.read(margin);
+				if (    _reader.isValid() == false
+				     || margin < 0.0f
+				     || isPositive(extent - vec3(margin, margin, margin)) == false) {
+					return null;
+				}
+				return ETK_NEW(BoxShape, extent, margin);
+			}
+			case SPHERE: {
+				float radius = 0.0f;
+				_reader.read(radius);
+				if (    _reader.isValid() == false
+				     || isPositive(radius) == false) {
+					return null;
+				}
+				return ETK_NEW(SphereShape, radius);
+			}
+			case CAPSULE: {
+				float radius = 0.0f;
+				float height = 0.0f;
+				_reader.read(radius);
+				_reader.read(height);
+				if (    _reader.isValid() == false
+				     || isPositive(radius) == false
+				     || isPositive(height) == false) {
+					return null;
+				}
+				return ETK_NEW(CapsuleShape, radius, height);
+			}
+			case CONE:
+			case CYLINDER: {
+				float radius = 0.0f;
+				float height = 0.0f;
+				float margin = 0.0f;
+				_reader.read(radius);
+				_reader.read(height);
+				_reader.read(margin);
+				if (    _reader.isValid() == false
+				     || isPositive(radius) == false
+				     || isPositive(height) == false
+				     || margin < 0.0f) {
+					return null;
+				}
+				if (type == CONE) {
+					return ETK_NEW(ConeShape, radius, height, margin);
+				}
+				return ETK_NEW(CylinderShape, radius, height, margin);
+			}
+			case CONVEX_MESH: {
+				float margin = 0.0f;
+				vec3 scaling;
+				uint32_t nbVertices = 0;
+				_reader.read(margin);
+				_reader.read(scaling);
+				_reader.read(nbVertices);
+				if (    _reader.checkCount(nbVertices, sizeof(vec3)) == false
+				     || margin < 0.0f
+				     || isPositive(scaling) == false) {
+					return null;
+				}
+				etk::Vector<vec3> vertices;
+				vertices.resize(nbVertices);
+				_reader.read(vertices.dataPointer(), nbVertices * sizeof(vec3));
+				bool isEdgesInformationUsed = false;
+				uint32_t nbEdges = 0;
+				_reader.read(isEdgesInformationUsed);
+				_reader.read(nbEdges);
+				if (_reader.checkCount(nbEdges, 2 * sizeof(uint32_t)) == false) {
+					return null;
+				}
+				etk::Vector<uint32_t> edges;
+				edges.resize(nbEdges * 2);
+				_reader.read(edges.dataPointer(), edges.size() * sizeof(uint32_t));
+				if (_reader.isValid() == false) {
+					return null;
+				}
+				for (auto &it: edges) {
+					if (it >= nbVertices) {
+						return null;
+					}
+				}
+				ConvexMeshShape* mesh = ETK_NEW(ConvexMeshShape, margin);
+				for (auto &it: vertices) {
+					mesh->addVertex(it);
+				}
+				for (size_t iii=0; iii<edges.size(); iii+=2) {
+					mesh->addEdge(edges[iii], edges[iii+1]);
+				}
+				mesh->setIsEdgesInformationUsed(isEdgesInformationUsed);
+				// Always set the scaling: it recomputes the bounds from all the vertices
+				CollisionShape* shape = mesh;
+				shape->setLocalScaling(scaling);
+				return shape;
+			}
+			case COMPOUND: {
+				uint32_t nbChildren = 0;
+				_reader.read(nbChildren);
+				if (_reader.checkCount(nbChildren, sizeof(int32_t) + sizeof(etk::Transform3D)) == false) {
+					return null;
+				}
+				etk::Vector<int32_t> childrenShape;
+				etk::Vector<etk::Transform3D> childrenTransform;
+				childrenShape.resize(nbChildren);
+				childrenTransform.resize(nbChildren);
+				for (uint32_t iii=0; iii<nbChildren; ++iii) {
+					_reader.read(childrenShape[iii]);
+					_reader.read(childrenTransform[iii]);
+					// The children are always stored before the compound shape
+					if (    childrenShape[iii] < 0
+					     || childrenShape[iii] >= int32_t(_shapes.size())) {
+						return null;
+					}
+				}
+				if (_reader.isValid() == false) {
+					return null;
+				}
+				CompoundShape* compound = ETK_NEW(CompoundShape);
+				for (uint32_t iii=0; iii<nbChildren; ++iii) {
+					compound->addChild(_shapes[childrenShape[iii]], childrenTransform[iii]);
+				}
+				return compound;
+			}
+			default:
+				return null;
+		}
+	}
+}
+
+WorldSerializer::WorldSerializer() {
+
+}
+
+WorldSerializer::~WorldSerializer() {
+	for (auto &it: m_shapes) {
+		ETK_DELETE(CollisionShape, it);
+		it = null;
+	}
+	m_shapes.clear();
+}
+
+bool WorldSerializer::save(const DynamicsWorld& _world, etk::Vector<uint8_t>& _buffer) {
+	PROFILE("WorldSerializer::save()");
+	_buffer.clear();
+	// List the shapes used by the bodies (each shared shape is saved once)
+	etk::Vector<const CollisionShape*> shapes;
+	etk::Map<const CollisionShape*, int32_t> shapesIndex;
+	etk::Map<const RigidBody*, int32_t> bodiesIndex;
+	for (auto &it: _world.m_rigidBodies) {
+		for (const ProxyShape* proxy = it->getProxyShapesList(); proxy != null; proxy = proxy->getNext()) {
+			if (collectShape(proxy->getCollisionShape(), shapes, shapesIndex) == false) {
+				return false;
+			}
+		}
+		bodiesIndex.set(it, bodiesIndex.size());
+	}
+	stateBuffer::write(_buffer, MAGIC);
+	stateBuffer::write(_buffer, VERSION);
+	// World settings
+	stateBuffer::write(_buffer, _world.getGravity());
+	for (uint32_t iii=0; iii<NB_COLLISION_LAYERS; ++iii) {
+		uint64_t layerMask = 0;
+		for (uint32_t jjj=0; jjj<NB_COLLISION_LAYERS; ++jjj) {
+			if (_world.canLayersCollide(iii, jjj) == true) {
+				layerMask |= uint64_t(1) << jjj;
+			}
+		}
+		stateBuffer::write(_buffer, layerMask);
+	}
+	// Collision shapes
+	stateBuffer::write(_buffer, uint32_t(shapes.size()));
+	for (auto &it: shapes) {
+		writeShape(_buffer, it, shapesIndex);
+	}
+	// Rigid bodies and their proxy shapes
+	stateBuffer::write(_buffer, uint32_t(_world.m_rigidBodies.size()));
+	for (auto &it: _world.m_rigidBodies) {
+		stateBuffer::write(_buffer, uint32_t(it->getType()));
+		stateBuffer::write(_buffer, it->getTransform());
+		stateBuffer::write(_buffer, it->getLinearVelocity());
+		stateBuffer::write(_buffer, it->getAngularVelocity());
+		stateBuffer::write(_buffer, it->isGravityEnabled());
+		stateBuffer::write(_buffer, it->getMaterial().getBounciness());
+		stateBuffer::write(_buffer, it->getMaterial().getFrictionCoefficient());
+		stateBuffer::write(_buffer, it->getMaterial().getRollingResistance());
+		stateBuffer::write(_buffer, it->getLinearDamping());
+		stateBuffer::write(_buffer, it->getAngularDamping());
+		stateBuffer::write(_buffer, it->isAllowedToSleep());
+		stateBuffer::write(_buffer, it->isActive());
+		stateBuffer::write(_buffer, it->getCollisionGroup());
+		stateBuffer::write(_buffer, it->getMass());
+		stateBuffer::write(_buffer, it->getCenterOfMassLocal());
+		stateBuffer::write(_buffer, it->getInertiaTensorLocal());
+		// The proxy shapes are stored in their creation order (the list of the body is in the reverse order)
+		etk::Vector<const ProxyShape*> proxies;
+		for (const ProxyShape* proxy = it->getProxyShapesList(); proxy != null; proxy = proxy->getNext()) {
+			proxies.pushBack(proxy);
+		}
+		stateBuffer::write(_buffer, uint32_t(proxies.size()));
+		for (int32_t iii=proxies.size()-1; iii>=0; --iii) {
+			const ProxyShape* proxy = proxies[iii];
+			stateBuffer::write(_buffer, shapesIndex.find(proxy->getCollisionShape())->second);
+			stateBuffer::write(_buffer, proxy->getLocalToBodyTransform());
+			stateBuffer::write(_buffer, proxy->getMass());
+			stateBuffer::write(_buffer, proxy->getLocalScaling());
+			stateBuffer::write(_buffer, proxy->getCollisionCategoryBits());
+			stateBuffer::write(_buffer, proxy->getCollideWithMaskBits());
+			stateBuffer::write(_buffer, proxy->getCollisionLayer());
+			stateBuffer::write(_buffer, proxy->isTrigger());
+		}
+	}
+	// Joints (anchors and axes in the local-space of the bodies)
+	stateBuffer::write(_buffer, uint32_t(_world.m_joints.size()));
+	for (auto &it: _world.m_joints) {
+		stateBuffer::write(_buffer, uint32_t(it->getType()));
+		stateBuffer::write(_buffer, bodiesIndex.find(it->getBody1())->second);
+		stateBuffer::write(_buffer, bodiesIndex.find(it->getBody2())->second);
+		stateBuffer::write(_buffer, it->isCollisionEnabled());
+		stateBuffer::write(_buffer, uint32_t(it->getPositionCorrectionTechnique()));
+		etk::Vector<uint8_t> configuration;
+		it->saveConfiguration(configuration);
+		stateBuffer::write(_buffer, uint32_t(configuration.size()));
+		stateBuffer::write(_buffer, configuration.dataPointer(), configuration.size());
+	}
+	return true;
+}
+
+bool WorldSerializer::load(DynamicsWorld& _world, const uint8_t* _data, size_t _size) {
+	PROFILE("WorldSerializer::load()");
+	m_bodies.clear();
+	m_joints.clear();
+	Reader reader(_data, _size);
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	reader.read(magic);
+	reader.read(version);
+	if (    reader.isValid() == false
+	     || magic != MAGIC
+	     || version != VERSION) {
+		EPHY_ERROR("Can not load the world: unknown format or version");
+		return false;
+	}
+	// All the data is read and checked before the world is modified
+	// World settings
+	vec3 gravity;
+	reader.read(gravity);
+	uint64_t layerMasks[NB_COLLISION_LAYERS];
+	reader.read(layerMasks, sizeof(layerMasks));
+	// Collision shapes (owned by the serializer, they are not in the world)
+	size_t firstShape = m_shapes.size();
+	etk::Vector<CollisionShape*> shapes;
+	uint32_t nbShapes = 0;
+	reader.read(nbShapes);
+	if (reader.checkCount(nbShapes, sizeof(uint32_t)) == true) {
+		shapes.reserve(nbShapes);
+		m_shapes.reserve(m_shapes.size() + nbShapes);
+		for (uint32_t iii=0; iii<nbShapes; ++iii) {
+			CollisionShape* shape = readShape(reader, shapes);
+			if (shape == null) {
+				EPHY_ERROR("Can not load the world: wrong collision shape " << iii);
+				break;
+			}
+			shapes.pushBack(shape);
+			m_shapes.pushBack(shape);
+		}
+	}
+	bool isValid = shapes.size() == nbShapes;
+	// Rigid bodies (the proxy shapes of all the bodies are stored in one array)
+	etk::Vector<BodyData> bodies;
+	etk::Vector<ProxyData> proxies;
+	uint32_t nbBodies = 0;
+	reader.read(nbBodies);
+	if (    isValid == true
+	     && reader.checkCount(nbBodies, sizeof(uint32_t)) == false) {
+		isValid = false;
+	}
+	if (isValid == true) {
+		bodies.resize(nbBodies);
+	}
+	for (uint32_t iii=0; iii<nbBodies && isValid == true; ++iii) {
+		BodyData& body = bodies[iii];
+		reader.read(body.type);
+		reader.read(body.transform);
+		reader.read(body.linearVelocity);
+		reader.read(body.angularVelocity);
+		reader.read(body.isGravityEnabled);
+		reader.read(body.bounciness);
+		reader.read(body.frictionCoefficient);
+		reader.read(body.rollingResistance);
+		reader.read(body.linearDamping);
+		reader.read(body.angularDamping);
+		reader.read(body.isAllowedToSleep);
+		reader.read(body.isActive);
+		reader.read(body.collisionGroup);
+		reader.read(body.mass);
+		reader.read(body.centerOfMassLocal);
+		reader.read(body.inertiaTensorLocal);
+		reader.read(body.nbProxies);
+		if (    reader.checkCount(body.nbProxies, sizeof(int32_t)) == false
+		     || body.type > DYNAMIC) {
+			isValid = false;
+			break;
+		}
+		for (uint32_t jjj=0; jjj<body.nbProxies; ++jjj) {
+			ProxyData proxy;
+			reader.read(proxy.shapeIndex);
+			reader.read(proxy.localTransform);
+			reader.read(proxy.mass);
+			reader.read(proxy.localScaling);
+			reader.read(proxy.collisionCategoryBits);
+			reader.read(proxy.collideWithMaskBits);
+			reader.read(proxy.collisionLayer);
+			reader.read(proxy.isTrigger);
+			if (    reader.isValid() == false
+			     || proxy.shapeIndex < 0
+			     || proxy.shapeIndex >= int32_t(shapes.size())
+			     || isPositive(proxy.mass) == false
+			     || isPositive(proxy.localScaling) == false
+			     || proxy.collisionLayer >= NB_COLLISION_LAYERS
+			     || (    shapes[proxy.shapeIndex]->getType() == COMPOUND
+			          && proxy.localScaling != vec3(1.0f, 1.0f, 1.0f))) {
+				isValid = false;
+				break;
+			}
+			proxies.pushBack(proxy);
+		}
+	}
+	// Joints (the configuration is restored from the data when the joint is created)
+	etk::Vector<JointData> joints;
+	uint32_t nbJoints = 0;
+	reader.read(nbJoints);
+	if (    isValid == true
+	     && reader.checkCount(nbJoints, sizeof(uint32_t)) == false) {
+		isValid = false;
+	}
+	if (isValid == true) {
+		joints.resize(nbJoints);
+	}
+	for (uint32_t iii=0; iii<nbJoints && isValid == true; ++iii) {
+		JointData& joint = joints[iii];
+		uint32_t configurationSize = 0;
+		reader.read(joint.type);
+		reader.read(joint.body1);
+		reader.read(joint.body2);
+		reader.read(joint.isCollisionEnabled);
+		reader.read(joint.positionCorrectionTechnique);
+		reader.read(configurationSize);
+		if (    reader.isValid() == false
+		     || joint.body1 < 0
+		     || joint.body1 >= int32_t(nbBodies)
+		     || joint.body2 < 0
+		     || joint.body2 >= int32_t(nbBodies)
+		     || joint.body1 == joint.body2
+		     || joint.positionCorrectionTechnique > NON_LINEAR_GAUSS_SEIDEL
+		     || configurationSize == 0
+		     || configurationSize != getJointConfigurationSize(joint.type)
+		     || configurationSize > reader.getRemainingSize()) {
+			isValid = false;
+			break;
+		}
+		joint.configuration = reader.getCursor();
+		reader.getCursor() += configurationSize;
+	}
+	if (isValid == false) {
+		// Nothing has been added in the world: only remove the loaded shapes
+		EPHY_ERROR("Can not load the world: wrong data");
+		for (size_t iii=firstShape; iii<m_shapes.size(); ++iii) {
+			ETK_DELETE(CollisionShape, m_shapes[iii]);
+		}
+		m_shapes.resize(firstShape);
+		return false;
+	}
+	// The data is valid: modify the world
+	_world.setGravity(gravity);
+	for (uint32_t iii=0; iii<NB_COLLISION_LAYERS; ++iii) {
+		for (uint32_t jjj=iii; jjj<NB_COLLISION_LAYERS; ++jjj) {
+			bool canCollide = (layerMasks[iii] & (uint64_t(1) << jjj)) != 0;
+			// Only the changed layers are set (setting a layer collision tests again all the shapes)
+			if (_world.canLayersCollide(iii, jjj) != canCollide) {
+				_world.setLayersCollision(iii, jjj, canCollide);
+			}
+		}
+	}
+	// Rigid bodies: all the proxy shapes are inserted in the broad-phase at once at the end
+	_world.beginBulkInsertion();
+	m_bodies.reserve(nbBodies);
+	size_t proxyIndex = 0;
+	for (auto &it: bodies) {
+		RigidBody* body = _world.createRigidBody(it.transform);
+		m_bodies.pushBack(body);
+		// The type is set before the proxy shapes are added (no move between the two trees)
+		body->setType(BodyType(it.type));
+		body->enableGravity(it.isGravityEnabled);
+		body->getMaterial().setBounciness(it.bounciness);
+		body->getMaterial().setFrictionCoefficient(it.frictionCoefficient);
+		body->getMaterial().setRollingResistance(it.rollingResistance);
+		body->setLinearDamping(it.linearDamping);
+		body->setAngularDamping(it.angularDamping);
+		body->setIsAllowedToSleep(it.isAllowedToSleep);
+		body->setCollisionGroup(it.collisionGroup);
+		for (uint32_t jjj=0; jjj<it.nbProxies; ++jjj) {
+			const ProxyData& proxyData = proxies[proxyIndex++];
+			ProxyShape* proxy = body->addCollisionShape(shapes[proxyData.shapeIndex], proxyData.localTransform, proxyData.mass);
+			if (proxyData.localScaling != vec3(1.0f, 1.0f, 1.0f)) {
+				proxy->setLocalScaling(proxyData.localScaling);
+			}
+			proxy->setCollisionCategoryBits(proxyData.collisionCategoryBits);
+			proxy->setCollideWithMaskBits(proxyData.collideWithMaskBits);
+			proxy->setCollisionLayer(proxyData.collisionLayer);
+			proxy->setIsTrigger(proxyData.isTrigger);
+		}
+		// The saved mass properties replace the ones computed from the proxy shapes (they may have been set by the user)
+		body->setMass(it.mass);
+		body->setCenterOfMassLocal(it.centerOfMassLocal);
+		body->setInertiaTensorLocal(it.inertiaTensorLocal);
+		body->setLinearVelocity(it.linearVelocity);
+		body->setAngularVelocity(it.angularVelocity);
+		if (it.isActive == false) {
+			body->setIsActive(false);
+		}
+	}
+	_world.endBulkInsertion();
+	// Joints
+	m_joints.reserve(nbJoints);
+	for (auto &it: joints) {
+		// The joint is created with a default configuration replaced by the saved one
+		const vec3 origin(0.0f, 0.0f, 0.0f);
+		const vec3 axis(1.0f, 0.0f, 0.0f);
+		RigidBody* body1 = m_bodies[it.body1];
+		RigidBody* body2 = m_bodies[it.body2];
+		BallAndSocketJointInfo ballAndSocketInfo(body1, body2, origin);
+		FixedJointInfo fixedInfo(body1, body2, origin);
+		HingeJointInfo hingeInfo(body1, body2, origin, axis);
+		SliderJointInfo sliderInfo(body1, body2, origin, axis);
+		JointInfo* jointInfo = &ballAndSocketInfo;
+		switch (it.type) {
+			case FIXEDJOINT:
+				jointInfo = &fixedInfo;
+				break;
+			case HINGEJOINT:
+				jointInfo = &hingeInfo;
+				break;
+			case SLIDERJOINT:
+				jointInfo = &sliderInfo;
+				break;
+			default:
+				break;
+		}
+		jointInfo->isCollisionEnabled = it.isCollisionEnabled;
+		jointInfo->positionCorrectionTechnique = JointsPositionCorrectionTechnique(it.positionCorrectionTechnique);
+		Joint* joint = _world.createJoint(*jointInfo);
+		m_joints.pushBack(joint);
+		const uint8_t* configuration = it.configuration;
+		joint->restoreConfiguration(configuration);
+	}
+	return true;
+}
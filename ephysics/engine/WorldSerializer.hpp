@@ -0,0 +1,72 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/Vector.hpp>
+#include <ephysics/engine/DynamicsWorld.hpp>
+
+namespace ephysics {
+	/**
+	 * @brief Save and load the content of a dynamics world in a versioned binary format (level
+	 * files). The format contains the world settings (gravity, collision layers), the collision
+	 * shapes (each shared shape is stored once), the rigid bodies with their proxy shapes
+	 * (transform, mass, scaling, collision filters) and the joints.
+	 * The loader inserts all the proxy shapes in the broad-phase with a bulk insertion: the
+	 * trees are built in one pass at the end of the load (no incremental rebalancing).
+	 * The concave mesh and height field shapes reference user data and are not supported.
+	 * The collision shapes created by load() are owned by the serializer: it has to be kept
+	 * alive as long as the loaded bodies are used.
+	 */
+	class WorldSerializer {
+		public:
+			static const uint32_t MAGIC; //!< Identifier of the format
+			static const uint32_t VERSION; //!< Current version of the format
+		protected:
+			etk::Vector<CollisionShape*> m_shapes; //!< Collision shapes created by the loads (owned)
+			etk::Vector<RigidBody*> m_bodies; //!< Rigid bodies created by the last load (in the order of the file)
+			etk::Vector<Joint*> m_joints; //!< Joints created by the last load (in the order of the file)
+		public:
+			/// Constructor
+			WorldSerializer();
+			/// Destructor (delete the collision shapes created by the loads)
+			~WorldSerializer();
+			/// DELETE copy-constructor
+			WorldSerializer(const WorldSerializer& _obj) = delete;
+			/// DELETE assignment operator
+			WorldSerializer& operator=(const WorldSerializer& _obj) = delete;
+			/**
+			 * @brief Save the bodies, shapes and joints of a world
+			 * @param[in] _world World to save
+			 * @param[out] _buffer Buffer where the world is stored (previous content is erased)
+			 * @return true if the world has been saved, false if it contains a shape that can not be saved
+			 */
+			static bool save(const DynamicsWorld& _world, etk::Vector<uint8_t>& _buffer);
+			/**
+			 * @brief Load the content of a buffer in a world (the existing bodies of the world are kept)
+			 * @param[in,out] _world World where the bodies and the joints are created
+			 * @param[in] _data Data saved with save()
+			 * @param[in] _size Size of the data in bytes
+			 * @return true if the world has been loaded, false if the data is not valid (the world is not modified)
+			 */
+			bool load(DynamicsWorld& _world, const uint8_t* _data, size_t _size);
+			/// Load the content of a buffer in a world (see load(DynamicsWorld&, const uint8_t*, size_t))
+			bool load(DynamicsWorld& _world, const etk::Vector<uint8_t>& _buffer) {
+				return load(_world, _buffer.dataPointer(), _buffer.size());
+			}
+			/// Return the rigid bodies created by the last load (in the order they have been saved)
+			const etk::Vector<RigidBody*>& getBodies() const {
+				return m_bodies;
+			}
+			/// Return the joints created by the last load (in the order they have been saved)
+			const etk::Vector<Joint*>& getJoints() const {
+				return m_joints;
+			}
+			/// Return the collision shapes created by the loads
+			const etk::Vector<CollisionShape*>& getShapes() const {
+				return m_shapes;
+			}
+	};
+}
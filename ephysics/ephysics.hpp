@@ -17,6 +17,8 @@
 #include <ephysics/engine/CollisionWorld.hpp>
 #include <ephysics/engine/Material.hpp>
 #include <ephysics/engine/EventListener.hpp>
+#include <ephysics/engine/WorldSerializer.hpp>
+#include <ephysics/engine/WorkStealingTaskScheduler.hpp>
 #include <ephysics/collision/shapes/CollisionShape.hpp>
 #include <ephysics/collision/shapes/BoxShape.hpp>
 #include <ephysics/collision/shapes/SphereShape.hpp>
@@ -26,9 +28,11 @@
 #include <ephysics/collision/shapes/ConvexMeshShape.hpp>
 #include <ephysics/collision/shapes/ConcaveMeshShape.hpp>
 #include <ephysics/collision/shapes/HeightFieldShape.hpp>
+#include <ephysics/collision/shapes/CompoundShape.hpp>
 #include <ephysics/collision/shapes/AABB.hpp>
 #include <ephysics/collision/ProxyShape.hpp>
 #include <ephysics/collision/RaycastInfo.hpp>
+#include <ephysics/collision/DistanceInfo.hpp>
 #include <ephysics/collision/TriangleMesh.hpp>
 #include <ephysics/collision/TriangleVertexArray.hpp>
 #include <ephysics/constraint/BallAndSocketJoint.hpp>
@@ -11,6 +11,45 @@
 
 using namespace ephysics;
 
+void ephysics::radixSort(uint64_t* _keys, uint64_t* _buffer, size_t _nbKeys) {
+	if (_nbKeys < 2) {
+		return;
+	}
+	// The histograms of the 8 bytes are computed in a single pass on the keys
+	size_t histogram[8][256];
+	memset(histogram, 0, sizeof(histogram));
+	for (size_t iii=0; iii<_nbKeys; ++iii) {
+		uint64_t key = _keys[iii];
+		for (int32_t jjj=0; jjj<8; ++jjj) {
+			histogram[jjj][(key >> (8 * jjj)) & 0xFF]++;
+		}
+	}
+	uint64_t* source = _keys;
+	uint64_t* destination = _buffer;
+	for (int32_t jjj=0; jjj<8; ++jjj) {
+		size_t* count = histogram[jjj];
+		const int32_t shift = 8 * jjj;
+		// All the keys have the same byte: the pass does not change the order
+		if (count[(source[0] >> shift) & 0xFF] == _nbKeys) {
+			continue;
+		}
+		size_t offset = 0;
+		for (int32_t kkk=0; kkk<256; ++kkk) {
+			size_t nbElements = count[kkk];
+			count[kkk] = offset;
+			offset += nbElements;
+		}
+		for (size_t iii=0; iii<_nbKeys; ++iii) {
+			uint64_t key = source[iii];
+			destination[count[(key >> shift) & 0xFF]++] = key;
+		}
+		etk::swap(source, destination);
+	}
+	if (source != _keys) {
+		memcpy(_keys, source, _nbKeys * sizeof(uint64_t));
+	}
+}
+
 /// Compute the barycentric coordinates u, v, w of a point p inside the triangle (a, b, c)
 /// This method uses the technique described in the book Real-Time collision detection by
 /// Christer Ericson.
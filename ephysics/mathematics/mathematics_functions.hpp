@@ -52,6 +52,15 @@ inline bool sameSign(float a, float b) {
 /// Clamp a vector such that it is no longer than a given maximum length
 vec3 clamp(const vec3& vector, float maxLength);
 
+/**
+ * @brief Sort an array of 64 bits keys in increasing order (LSD radix sort, one pass per byte:
+ * the bytes that are the same for all the keys are skipped)
+ * @param[in,out] _keys Keys to sort
+ * @param[in] _buffer Temporary array of at least _nbKeys elements
+ * @param[in] _nbKeys Number of keys
+ */
+void radixSort(uint64_t* _keys, uint64_t* _buffer, size_t _nbKeys);
+
 /// Compute the barycentric coordinates u, v, w of a point p inside the triangle (a, b, c)
 void computeBarycentricCoordinatesInTriangle(const vec3& a, const vec3& b, const vec3& c,
 											 const vec3& p, float& u, float& v, float& w);
@@ -0,0 +1,59 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#include <ephysics/mathematics/simd.hpp>
+
+using namespace ephysics;
+
+void simd::transformPoints(const Transform& _transform, const vec3* _points, vec3* _out, size_t _nbPoints) {
+	for (size_t iii=0; iii<_nbPoints; ++iii) {
+		_out[iii] = _transform * _points[iii];
+	}
+}
+
+void simd::quaternionsToMatrices(const etk::Quaternion* _quaternions, etk::Matrix3x3* _matrices, size_t _nbQuaternions) {
+	for (size_t iii=0; iii<_nbQuaternions; ++iii) {
+		const etk::Quaternion& quaternion = _quaternions[iii];
+		float norm2 = quaternion.x() * quaternion.x() + quaternion.y() * quaternion.y()
+		            + quaternion.z() * quaternion.z() + quaternion.w() * quaternion.w();
+		float scale = 0.0f;
+		if (norm2 > 0.0f) {
+			scale = 2.0f / norm2;
+		}
+		float xs = quaternion.x() * scale;
+		float ys = quaternion.y() * scale;
+		float zs = quaternion.z() * scale;
+		float wxs = quaternion.w() * xs;
+		float wys = quaternion.w() * ys;
+		float wzs = quaternion.w() * zs;
+		float xxs = quaternion.x() * xs;
+		float xys = quaternion.x() * ys;
+		float xzs = quaternion.x() * zs;
+		float yys = quaternion.y() * ys;
+		float yzs = quaternion.y() * zs;
+		float zzs = quaternion.z() * zs;
+		_matrices[iii].setValue(1.0f - yys - zzs, xys - wzs, xzs + wys,
+		                        xys + wzs, 1.0f - xxs - zzs, yzs - wxs,
+		                        xzs - wys, yzs + wxs, 1.0f - xxs - yys);
+	}
+}
+
+etk::Matrix3x3 simd::multiply(const etk::Matrix3x3& _matrix1, const etk::Matrix3x3& _matrix2) {
+	// Each row of the result is a combination of the rows of the right matrix
+	const Float4 row20 = Float4::load(_matrix2.getRow(0));
+	const Float4 row21 = Float4::load(_matrix2.getRow(1));
+	const Float4 row22 = Float4::load(_matrix2.getRow(2));
+	vec3 out[3];
+	for (int32_t iii=0; iii<3; ++iii) {
+		const vec3 row1 = _matrix1.getRow(iii);
+		Float4 value = row20 * Float4::splat(row1.x());
+		value = Float4::multiplyAdd(row21, Float4::splat(row1.y()), value);
+		value = Float4::multiplyAdd(row22, Float4::splat(row1.z()), value);
+		out[iii] = value.toVec3();
+	}
+	return etk::Matrix3x3(out[0].x(), out[0].y(), out[0].z(),
+	                      out[1].x(), out[1].y(), out[1].z(),
+	                      out[2].x(), out[2].y(), out[2].z());
+}
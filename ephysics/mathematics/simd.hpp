@@ -0,0 +1,282 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/math/Vector3D.hpp>
+#include <etk/math/Matrix3x3.hpp>
+#include <etk/math/Quaternion.hpp>
+#include <etk/math/Transform3D.hpp>
+
+// Select the SIMD instruction set (the engine types stay the etk types: the SIMD registers are only used inside the kernels)
+#if    defined(__SSE__) \
+    || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define EPHY_SIMD_SSE
+	#include <xmmintrin.h>
+#elif    defined(__ARM_NEON) \
+      || defined(__ARM_NEON__)
+	#define EPHY_SIMD_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace ephysics {
+	/**
+	 * @brief Engine internal SIMD math kernels (SSE, NEON or scalar fallback) used by the hot
+	 * loops of the collision detection. The 3D vectors are loaded in 4 floats registers (the 4th
+	 * component is 0): the 3 components are computed with one instruction.
+	 */
+	namespace simd {
+		/**
+		 * @brief Aligned 4 floats vector
+		 */
+		class Float4 {
+			public:
+				#if defined(EPHY_SIMD_SSE)
+					__m128 m_value; //!< x, y, z, w values
+				#elif defined(EPHY_SIMD_NEON)
+					float32x4_t m_value; //!< x, y, z, w values
+				#else
+					alignas(16) float m_value[4]; //!< x, y, z, w values
+				#endif
+				/// Constructor (not initialized)
+				Float4() = default;
+				/// Load a 3D vector (the 4th component is 0)
+				static Float4 load(const vec3& _vector) {
+					Float4 out;
+					#if defined(EPHY_SIMD_SSE)
+						out.m_value = _mm_set_ps(0.0f, _vector.z(), _vector.y(), _vector.x());
+					#elif defined(EPHY_SIMD_NEON)
+						alignas(16) float values[4] = {_vector.x(), _vector.y(), _vector.z(), 0.0f};
+						out.m_value = vld1q_f32(values);
+					#else
+						out.m_value[0] = _vector.x();
+						out.m_value[1] = _vector.y();
+						out.m_value[2] = _vector.z();
+						out.m_value[3] = 0.0f;
+					#endif
+					return out;
+				}
+				/// Load 4 floats (no alignment needed)
+				static Float4 load(const float* _values) {
+					Float4 out;
+					#if defined(EPHY_SIMD_SSE)
+						out.m_value = _mm_loadu_ps(_values);
+					#elif defined(EPHY_SIMD_NEON)
+						out.m_value = vld1q_f32(_values);
+					#else
+						for (int32_t iii=0; iii<4; ++iii) {
+							out.m_value[iii] = _values[iii];
+						}
+					#endif
+					return out;
+				}
+				/// Store the 4 components (no alignment needed)
+				void store(float* _values) const {
+					#if defined(EPHY_SIMD_SSE)
+						_mm_storeu_ps(_values, m_value);
+					#elif defined(EPHY_SIMD_NEON)
+						vst1q_f32(_values, m_value);
+					#else
+						for (int32_t iii=0; iii<4; ++iii) {
+							_values[iii] = m_value[iii];
+						}
+					#endif
+				}
+				/// Set the same value in the 4 components
+				static Float4 splat(float _value) {
+					Float4 out;
+					#if defined(EPHY_SIMD_SSE)
+						out.m_value = _mm_set1_ps(_value);
+					#elif defined(EPHY_SIMD_NEON)
+						out.m_value = vdupq_n_f32(_value);
+					#else
+						out.m_value[0] = _value;
+						out.m_value[1] = _value;
+						out.m_value[2] = _value;
+						out.m_value[3] = _value;
+					#endif
+					return out;
+				}
+				/// Store the 3 first components in a 3D vector
+				vec3 toVec3() const {
+					#if defined(EPHY_SIMD_SSE)
+						alignas(16) float values[4];
+						_mm_store_ps(values, m_value);
+						return vec3(values[0], values[1], values[2]);
+					#elif defined(EPHY_SIMD_NEON)
+						alignas(16) float values[4];
+						vst1q_f32(values, m_value);
+						return vec3(values[0], values[1], values[2]);
+					#else
+						return vec3(m_value[0], m_value[1], m_value[2]);
+					#endif
+				}
+				/// Component-wise addition
+				Float4 operator+(const Float4& _obj) const {
+					Float4 out;
+					#if defined(EPHY_SIMD_SSE)
+						out.m_value = _mm_add_ps(m_value, _obj.m_value);
+					#elif defined(EPHY_SIMD_NEON)
+						out.m_value = vaddq_f32(m_value, _obj.m_value);
+					#else
+						for (int32_t iii=0; iii<4; ++iii) {
+							out.m_value[iii] = m_value[iii] + _obj.m_value[iii];
+						}
+					#endif
+					return out;
+				}
+				/// Component-wise multiplication
+				Float4 operator*(const Float4& _obj) const {
+					Float4 out;
+					#if defined(EPHY_SIMD_SSE)
+						out.m_value = _mm_mul_ps(m_value, _obj.m_value);
+					#elif defined(EPHY_SIMD_NEON)
+						out.m_value = vmulq_f32(m_value, _obj.m_value);
+					#else
+						for (int32_t iii=0; iii<4; ++iii) {
+							out.m_value[iii] = m_value[iii] * _obj.m_value[iii];
+						}
+					#endif
+					return out;
+				}
+				/// Component-wise subtraction
+				Float4 operator-(const Float4& _obj) const {
+					Float4 out;
+					#if defined(EPHY_SIMD_SSE)
+						out.m_value = _mm_sub_ps(m_value, _obj.m_value);
+					#elif defined(EPHY_SIMD_NEON)
+						out.m_value = vsubq_f32(m_value, _obj.m_value);
+					#else
+						for (int32_t iii=0; iii<4; ++iii) {
+							out.m_value[iii] = m_value[iii] - _obj.m_value[iii];
+						}
+					#endif
+					return out;
+				}
+				/// Component-wise minimum
+				static Float4 min(const Float4& _value1, const Float4& _value2) {
+					Float4 out;
+					#if defined(EPHY_SIMD_SSE)
+						out.m_value = _mm_min_ps(_value1.m_value, _value2.m_value);
+					#elif defined(EPHY_SIMD_NEON)
+						out.m_value = vminq_f32(_value1.m_value, _value2.m_value);
+					#else
+						for (int32_t iii=0; iii<4; ++iii) {
+							out.m_value[iii] = etk::min(_value1.m_value[iii], _value2.m_value[iii]);
+						}
+					#endif
+					return out;
+				}
+				/// Component-wise maximum
+				static Float4 max(const Float4& _value1, const Float4& _value2) {
+					Float4 out;
+					#if defined(EPHY_SIMD_SSE)
+						out.m_value = _mm_max_ps(_value1.m_value, _value2.m_value);
+					#elif defined(EPHY_SIMD_NEON)
+						out.m_value = vmaxq_f32(_value1.m_value, _value2.m_value);
+					#else
+						for (int32_t iii=0; iii<4; ++iii) {
+							out.m_value[iii] = etk::max(_value1.m_value[iii], _value2.m_value[iii]);
+						}
+					#endif
+					return out;
+				}
+				/// Return a 4 bits mask where the bit N is set when the component N of _value1 is lower or equal to the one of _value2
+				static int32_t lessEqualMask(const Float4& _value1, const Float4& _value2) {
+					#if defined(EPHY_SIMD_SSE)
+						return _mm_movemask_ps(_mm_cmple_ps(_value1.m_value, _value2.m_value));
+					#elif defined(EPHY_SIMD_NEON)
+						uint32x4_t compare = vcleq_f32(_value1.m_value, _value2.m_value);
+						return   (vgetq_lane_u32(compare, 0) & 1)
+						       | (vgetq_lane_u32(compare, 1) & 2)
+						       | (vgetq_lane_u32(compare, 2) & 4)
+						       | (vgetq_lane_u32(compare, 3) & 8);
+					#else
+						int32_t mask = 0;
+						for (int32_t iii=0; iii<4; ++iii) {
+							if (_value1.m_value[iii] <= _value2.m_value[iii]) {
+								mask |= 1 << iii;
+							}
+						}
+						return mask;
+					#endif
+				}
+				/// Return _value1 * _value2 + _value3
+				static Float4 multiplyAdd(const Float4& _value1, const Float4& _value2, const Float4& _value3) {
+					#if defined(EPHY_SIMD_NEON)
+						Float4 out;
+						out.m_value = vmlaq_f32(_value3.m_value, _value1.m_value, _value2.m_value);
+						return out;
+					#else
+						return _value1 * _value2 + _value3;
+					#endif
+				}
+		};
+		/**
+		 * @brief Rotation matrix (3 columns) and translation of a transform: the orientation
+		 * quaternion is converted once, then each point is transformed with 3 multiply-add
+		 * (fused transform-point) instead of two quaternion products.
+		 */
+		class Transform {
+			protected:
+				Float4 m_column[3]; //!< Columns of the rotation matrix
+				Float4 m_position; //!< Translation
+			public:
+				/// Constructor
+				Transform(const etk::Transform3D& _transform) {
+					etk::Matrix3x3 rotation = _transform.getOrientation().getMatrix();
+					m_column[0] = Float4::load(rotation.getColumn(0));
+					m_column[1] = Float4::load(rotation.getColumn(1));
+					m_column[2] = Float4::load(rotation.getColumn(2));
+					m_position = Float4::load(_transform.getPosition());
+				}
+				/// Constructor from a rotation matrix and a translation
+				Transform(const etk::Matrix3x3& _rotation, const vec3& _position) {
+					m_column[0] = Float4::load(_rotation.getColumn(0));
+					m_column[1] = Float4::load(_rotation.getColumn(1));
+					m_column[2] = Float4::load(_rotation.getColumn(2));
+					m_position = Float4::load(_position);
+				}
+				/// Rotate a vector
+				vec3 rotate(const vec3& _vector) const {
+					return rotateFloat4(_vector).toVec3();
+				}
+				/// Transform a point (rotation then translation)
+				vec3 operator*(const vec3& _point) const {
+					return (rotateFloat4(_point) + m_position).toVec3();
+				}
+			protected:
+				/// Rotate a vector and keep it in a register
+				Float4 rotateFloat4(const vec3& _vector) const {
+					Float4 out = m_column[0] * Float4::splat(_vector.x());
+					out = Float4::multiplyAdd(m_column[1], Float4::splat(_vector.y()), out);
+					return Float4::multiplyAdd(m_column[2], Float4::splat(_vector.z()), out);
+				}
+		};
+		/**
+		 * @brief Transform an array of points
+		 * @param[in] _transform Transform to apply
+		 * @param[in] _points Points to transform
+		 * @param[out] _out Transformed points (can be the input array)
+		 * @param[in] _nbPoints Number of points
+		 */
+		void transformPoints(const Transform& _transform, const vec3* _points, vec3* _out, size_t _nbPoints);
+		/**
+		 * @brief Convert an array of quaternions in rotation matrices
+		 * @param[in] _quaternions Quaternions to convert (they do not need to be normalized)
+		 * @param[out] _matrices Rotation matrices
+		 * @param[in] _nbQuaternions Number of quaternions
+		 */
+		void quaternionsToMatrices(const etk::Quaternion* _quaternions, etk::Matrix3x3* _matrices, size_t _nbQuaternions);
+		/**
+		 * @brief Multiply two 3x3 matrices
+		 * @param[in] _matrix1 Left matrix
+		 * @param[in] _matrix2 Right matrix
+		 * @return _matrix1 * _matrix2
+		 */
+		etk::Matrix3x3 multiply(const etk::Matrix3x3& _matrix1, const etk::Matrix3x3& _matrix2);
+	}
+}
@@ -30,8 +30,11 @@ def configure(target, my_module):
 		'test/testAABB.cpp',
 		'test/testCollisionWorld.cpp',
 		'test/testDynamicAABBTree.cpp',
+		'test/testDynamicsWorld.cpp',
+		'test/testMathematics.cpp',
 		'test/testPointInside.cpp',
 		'test/testRaycast.cpp',
+		'test/testTaskScheduler.cpp',
 		])
 	my_module.add_depend([
 		'ephysics',
@@ -43,6 +43,7 @@ def configure(target, my_module):
 		'ephysics/collision/narrowphase/SphereVsSphereAlgorithm.cpp',
 		'ephysics/collision/narrowphase/NarrowPhaseAlgorithm.cpp',
 		'ephysics/collision/narrowphase/ConcaveVsConvexAlgorithm.cpp',
+		'ephysics/collision/narrowphase/CompoundVsShapeAlgorithm.cpp',
 		'ephysics/collision/narrowphase/EPA/EPAAlgorithm.cpp',
 		'ephysics/collision/narrowphase/EPA/TrianglesStore.cpp',
 		'ephysics/collision/narrowphase/EPA/TriangleEPA.cpp',
@@ -60,6 +61,8 @@ def configure(target, my_module):
 		'ephysics/collision/shapes/ConvexShape.cpp',
 		'ephysics/collision/shapes/ConeShape.cpp',
 		'ephysics/collision/shapes/ConcaveMeshShape.cpp',
+		'ephysics/collision/shapes/CompoundShape.cpp',
+		'ephysics/collision/shapes/ScaledShape.cpp',
 		'ephysics/collision/shapes/AABB.cpp',
 		'ephysics/collision/TriangleMesh.cpp',
 		'ephysics/collision/CollisionDetection.cpp',
@@ -71,6 +74,7 @@ def configure(target, my_module):
 		'ephysics/body/Body.cpp',
 		'ephysics/body/CollisionBody.cpp',
 		'ephysics/mathematics/mathematics_functions.cpp',
+		'ephysics/mathematics/simd.cpp',
 		'ephysics/engine/CollisionWorld.cpp',
 		'ephysics/engine/OverlappingPair.cpp',
 		'ephysics/engine/Material.cpp',
@@ -79,7 +83,12 @@ def configure(target, my_module):
 		'ephysics/engine/ConstraintSolver.cpp',
 		'ephysics/engine/DynamicsWorld.cpp',
 		'ephysics/engine/ContactSolver.cpp',
+		'ephysics/engine/ContactStream.cpp',
 		'ephysics/engine/Timer.cpp',
+		'ephysics/engine/WorldSerializer.cpp',
+		'ephysics/engine/BodyCommandQueue.cpp',
+		'ephysics/engine/UpdateThread.cpp',
+		'ephysics/engine/WorkStealingTaskScheduler.cpp',
 		])
 	
 	my_module.add_header_file([
@@ -98,6 +107,7 @@ def configure(target, my_module):
 		'ephysics/collision/narrowphase/GJK/Simplex.hpp',
 		'ephysics/collision/narrowphase/GJK/GJKAlgorithm.hpp',
 		'ephysics/collision/narrowphase/ConcaveVsConvexAlgorithm.hpp',
+		'ephysics/collision/narrowphase/CompoundVsShapeAlgorithm.hpp',
 		'ephysics/collision/narrowphase/CollisionDispatch.hpp',
 		'ephysics/collision/narrowphase/DefaultCollisionDispatch.hpp',
 		'ephysics/collision/narrowphase/NarrowPhaseAlgorithm.hpp',
@@ -113,6 +123,8 @@ def configure(target, my_module):
 		'ephysics/collision/shapes/CollisionShape.hpp',
 		'ephysics/collision/shapes/BoxShape.hpp',
 		'ephysics/collision/shapes/ConcaveMeshShape.hpp',
+		'ephysics/collision/shapes/CompoundShape.hpp',
+		'ephysics/collision/shapes/ScaledShape.hpp',
 		'ephysics/collision/shapes/ConvexMeshShape.hpp',
 		'ephysics/collision/shapes/HeightFieldShape.hpp',
 		'ephysics/collision/shapes/CylinderShape.hpp',
@@ -122,6 +134,7 @@ def configure(target, my_module):
 		'ephysics/collision/CollisionShapeInfo.hpp',
 		'ephysics/collision/TriangleMesh.hpp',
 		'ephysics/collision/RaycastInfo.hpp',
+		'ephysics/collision/DistanceInfo.hpp',
 		'ephysics/collision/ProxyShape.hpp',
 		'ephysics/collision/broadphase/DynamicAABBTree.hpp',
 		'ephysics/collision/broadphase/BroadPhaseAlgorithm.hpp',
@@ -133,16 +146,24 @@ def configure(target, my_module):
 		'ephysics/mathematics/mathematics.hpp',
 		'ephysics/mathematics/Ray.hpp',
 		'ephysics/mathematics/mathematics_functions.hpp',
+		'ephysics/mathematics/simd.hpp',
 		'ephysics/engine/CollisionWorld.hpp',
 		'ephysics/engine/DynamicsWorld.hpp',
 		'ephysics/engine/ConstraintSolver.hpp',
 		'ephysics/engine/OverlappingPair.hpp',
 		'ephysics/engine/Island.hpp',
 		'ephysics/engine/ContactSolver.hpp',
+		'ephysics/engine/ContactStream.hpp',
 		'ephysics/engine/Material.hpp',
 		'ephysics/engine/Profiler.hpp',
 		'ephysics/engine/Timer.hpp',
 		'ephysics/engine/Impulse.hpp',
+		'ephysics/engine/StateBuffer.hpp',
+		'ephysics/engine/WorldSerializer.hpp',
+		'ephysics/engine/BodyCommandQueue.hpp',
+		'ephysics/engine/UpdateThread.hpp',
+		'ephysics/engine/TaskScheduler.hpp',
+		'ephysics/engine/WorkStealingTaskScheduler.hpp',
 		'ephysics/engine/EventListener.hpp'
 		])
 	
@@ -154,7 +175,8 @@ def configure(target, my_module):
 		'elog',
 		'etk',
 		'ememory',
-		'echrono'
+		'echrono',
+		'pthread'
 		])
 	# TODO: Remove this ...
 	#my_module.add_flag('c++', "-Wno-overloaded-virtual", export=True)
@@ -303,3 +303,193 @@ TEST(TestCollisionWorld, testCollisions_1) {
 	tmp.m_sphere2ProxyShape->setCollideWithMaskBits(0xFFFF);
 	tmp.m_cylinderProxyShape->setCollideWithMaskBits(0xFFFF);
 }
+
+TEST(TestCollisionWorld, testCollisionsLayersAndGroups) {
+	TestCollisionWorld tmp;
+	// --------- Test collision with the layer collision matrix -------- //
+	tmp.m_sphere1ProxyShape->setCollisionLayer(1);
+	tmp.m_world->setLayersCollision(0, 1, false);
+	EXPECT_EQ(tmp.m_world->canLayersCollide(1, 0), false);
+	EXPECT_EQ(tmp.m_world->canLayersCollide(1, 1), true);
+	tmp.m_collisionCallback.reset();
+	tmp.m_world->testCollision(&tmp.m_collisionCallback);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithSphere1, false);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithCylinder, true);
+	tmp.m_world->setLayersCollision(0, 1, true);
+	tmp.m_collisionCallback.reset();
+	tmp.m_world->testCollision(&tmp.m_collisionCallback);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithSphere1, true);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithCylinder, true);
+	// --------- Test collision with the ignore groups -------- //
+	tmp.m_boxBody->setCollisionGroup(1);
+	tmp.m_cylinderBody->setCollisionGroup(1);
+	tmp.m_collisionCallback.reset();
+	tmp.m_world->testCollision(&tmp.m_collisionCallback);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithSphere1, true);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithCylinder, false);
+	tmp.m_cylinderBody->setCollisionGroup(0);
+	tmp.m_collisionCallback.reset();
+	tmp.m_world->testCollision(&tmp.m_collisionCallback);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithSphere1, true);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithCylinder, true);
+}
+
+TEST(TestCollisionWorld, testCollisionsTrigger) {
+	TestCollisionWorld tmp;
+	// A trigger shape does not report contact points to the collision queries
+	tmp.m_sphere1ProxyShape->setIsTrigger(true);
+	tmp.m_collisionCallback.reset();
+	tmp.m_world->testCollision(&tmp.m_collisionCallback);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithSphere1, false);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithCylinder, true);
+	tmp.m_collisionCallback.reset();
+	tmp.m_world->testCollision(tmp.m_boxBody, tmp.m_sphere1Body, &tmp.m_collisionCallback);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithSphere1, false);
+	tmp.m_sphere1ProxyShape->setIsTrigger(false);
+	tmp.m_collisionCallback.reset();
+	tmp.m_world->testCollision(tmp.m_boxBody, tmp.m_sphere1Body, &tmp.m_collisionCallback);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithSphere1, true);
+}
+
+TEST(TestCollisionWorld, testShiftOrigin) {
+	TestCollisionWorld tmp;
+	tmp.m_world->shiftOrigin(vec3(10, 0, 0));
+	EXPECT_EQ(tmp.m_boxBody->getTransform().getPosition().x(), 0);
+	EXPECT_EQ(tmp.m_sphere2Body->getTransform().getPosition().x(), 20);
+	EXPECT_EQ(tmp.m_sphere2Body->getTransform().getPosition().y(), 10);
+	tmp.m_collisionCallback.reset();
+	tmp.m_world->testCollision(&tmp.m_collisionCallback);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithSphere1, true);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithCylinder, true);
+	EXPECT_EQ(tmp.m_collisionCallback.sphere1CollideWithCylinder, false);
+	EXPECT_EQ(tmp.m_collisionCallback.sphere1CollideWithSphere2, false);
+	// The broad-phase AABBs have been translated with the bodies
+	EXPECT_EQ(tmp.m_world->testAABBOverlap(tmp.m_boxProxyShape, tmp.m_sphere1ProxyShape), true);
+	tmp.m_sphere1Body->setTransform(etk::Transform3D(vec3(20, 15, 10), etk::Quaternion::identity()));
+	tmp.m_collisionCallback.reset();
+	tmp.m_world->testCollision(&tmp.m_collisionCallback);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithSphere1, false);
+	EXPECT_EQ(tmp.m_collisionCallback.sphere1CollideWithSphere2, true);
+}
+
+class CompoundCollisionCallback : public ephysics::CollisionCallback {
+	public:
+		int32_t nbContacts;
+		int32_t childIndex;
+		CompoundCollisionCallback():
+		  nbContacts(0),
+		  childIndex(-1) {
+			
+		}
+		virtual void notifyContact(const ephysics::ContactPointInfo& _contactPointInfo) {
+			nbContacts++;
+			if (_contactPointInfo.childIndex1 != -1) {
+				childIndex = _contactPointInfo.childIndex1;
+			} else {
+				childIndex = _contactPointInfo.childIndex2;
+			}
+		}
+};
+
+class CompoundRaycastCallback : public ephysics::RaycastCallback {
+	public:
+		int32_t childIndex;
+		CompoundRaycastCallback():
+		  childIndex(-1) {
+			
+		}
+		virtual float notifyRaycastHit(const ephysics::RaycastInfo& _raycastInfo) {
+			childIndex = _raycastInfo.childIndex;
+			return _raycastInfo.hitFraction;
+		}
+};
+
+TEST(TestCollisionWorld, testCompoundShape) {
+	TestCollisionWorld tmp;
+	int32_t userData0 = 0;
+	int32_t userData1 = 1;
+	ephysics::BoxShape* childShape = ETK_NEW(ephysics::BoxShape, vec3(1,1,1));
+	ephysics::CompoundShape* compoundShape = ETK_NEW(ephysics::CompoundShape);
+	EXPECT_EQ(compoundShape->addChild(childShape, etk::Transform3D(vec3(-3, 0, 0), etk::Quaternion::identity()), &userData0), 0);
+	EXPECT_EQ(compoundShape->addChild(childShape, etk::Transform3D(vec3(3, 0, 0), etk::Quaternion::identity()), &userData1), 1);
+	ephysics::CollisionBody* compoundBody = tmp.m_world->createCollisionBody(etk::Transform3D(vec3(-20, 0, 0), etk::Quaternion::identity()));
+	compoundBody->addCollisionShape(compoundShape, etk::Transform3D::identity());
+	// The sphere only touches the second child
+	tmp.m_sphere1Body->setTransform(etk::Transform3D(vec3(-17, 3.5, 0), etk::Quaternion::identity()));
+	CompoundCollisionCallback collisionCallback;
+	tmp.m_world->testCollision(compoundBody, tmp.m_sphere1Body, &collisionCallback);
+	EXPECT_NE(collisionCallback.nbContacts, 0);
+	EXPECT_EQ(collisionCallback.childIndex, 1);
+	EXPECT_EQ(compoundShape->getChildUserData(collisionCallback.childIndex), &userData1);
+	// The ray hits the first child only
+	CompoundRaycastCallback raycastCallback;
+	tmp.m_world->raycast(ephysics::Ray(vec3(-23, 10, 0), vec3(-23, -10, 0)), &raycastCallback);
+	EXPECT_EQ(raycastCallback.childIndex, 0);
+	EXPECT_EQ(compoundShape->getChildUserData(raycastCallback.childIndex), &userData0);
+	EXPECT_EQ(compoundBody->testPointInside(vec3(-17, 0, 0)), true);
+	EXPECT_EQ(compoundBody->testPointInside(vec3(-20, 0, 0)), false);
+	tmp.m_world->destroyCollisionBody(compoundBody);
+	ETK_DELETE(ephysics::CompoundShape, compoundShape);
+	ETK_DELETE(ephysics::BoxShape, childShape);
+}
+
+TEST(TestCollisionWorld, testProxyShapeScaling) {
+	TestCollisionWorld tmp;
+	tmp.m_sphere1Body->setTransform(etk::Transform3D(vec3(24, 0, 0), etk::Quaternion::identity()));
+	EXPECT_EQ(tmp.m_world->testAABBOverlap(tmp.m_boxProxyShape, tmp.m_sphere1ProxyShape), false);
+	EXPECT_EQ(tmp.m_boxBody->testPointInside(vec3(18, 0, 0)), false);
+	// Scale only the box proxy: the shared box shape is not modified
+	tmp.m_boxProxyShape->setLocalScaling(vec3(4, 1, 1));
+	EXPECT_EQ(tmp.m_boxProxyShape->getLocalScaling(), vec3(4, 1, 1));
+	EXPECT_EQ(tmp.m_boxShape->getExtent(), vec3(3, 3, 3));
+	EXPECT_EQ(tmp.m_boxBody->testPointInside(vec3(18, 0, 0)), true);
+	EXPECT_EQ(tmp.m_boxBody->testPointInside(vec3(10, 5, 0)), false);
+	EXPECT_EQ(tmp.m_world->testAABBOverlap(tmp.m_boxProxyShape, tmp.m_sphere1ProxyShape), true);
+	tmp.m_collisionCallback.reset();
+	tmp.m_world->testCollision(&tmp.m_collisionCallback);
+	EXPECT_EQ(tmp.m_collisionCallback.boxCollideWithSphere1, true);
+	// The ray hits the scaled box on its x face (the raycast of a box ignores its margin)
+	ephysics::RaycastInfo raycastInfo;
+	EXPECT_EQ(tmp.m_boxProxyShape->raycast(ephysics::Ray(vec3(30, 0, 0), vec3(10, 0, 0)), raycastInfo), true);
+	float scaledExtent = 4.0f * (tmp.m_boxShape->getExtent().x() - tmp.m_boxShape->getMargin());
+	EXPECT_FLOAT_EQ_DELTA(raycastInfo.worldPoint.x(), 10.0f + scaledExtent, 0.001f);
+	// The sphere shape is shared by the two spheres: only the scaled proxy grows
+	tmp.m_sphere2ProxyShape->setLocalScaling(vec3(2, 2, 2));
+	EXPECT_EQ(tmp.m_sphereShape->getRadius(), 3.0f);
+	EXPECT_EQ(tmp.m_sphere2Body->testPointInside(vec3(30, 15, 10)), true);
+	EXPECT_EQ(tmp.m_sphere1Body->testPointInside(vec3(24, 5, 0)), false);
+	tmp.m_boxProxyShape->setLocalScaling(vec3(1, 1, 1));
+	EXPECT_EQ(tmp.m_boxBody->testPointInside(vec3(18, 0, 0)), false);
+}
+
+TEST(TestCollisionWorld, testDistanceQueries) {
+	TestCollisionWorld tmp;
+	tmp.m_sphere1Body->setTransform(etk::Transform3D(vec3(10, 10, 0), etk::Quaternion::identity()));
+	// Distance between the top face of the box and the sphere
+	ephysics::DistanceInfo distanceInfo;
+	EXPECT_EQ(tmp.m_world->computeDistance(tmp.m_boxProxyShape, tmp.m_sphere1ProxyShape, distanceInfo), true);
+	EXPECT_FLOAT_EQ_DELTA(distanceInfo.distance, 4.0f, 0.05f);
+	EXPECT_FLOAT_EQ_DELTA(distanceInfo.worldPoint1.y(), 3.0f, 0.05f);
+	EXPECT_FLOAT_EQ_DELTA(distanceInfo.worldPoint2.y(), 7.0f, 0.05f);
+	EXPECT_FLOAT_EQ_DELTA(distanceInfo.worldNormal.y(), 1.0f, 0.01f);
+	// Overlapping shapes have a null distance
+	EXPECT_EQ(tmp.m_world->computeDistance(tmp.m_boxProxyShape, tmp.m_cylinderProxyShape, distanceInfo), true);
+	EXPECT_EQ(distanceInfo.distance, 0.0f);
+	// Nearest shape of a point: the x face of the box
+	EXPECT_EQ(tmp.m_world->findNearest(vec3(20, 0, 0), 10.0f, distanceInfo), true);
+	EXPECT_EQ(distanceInfo.proxyShape, tmp.m_boxProxyShape);
+	EXPECT_FLOAT_EQ_DELTA(distanceInfo.distance, 7.0f, 0.05f);
+	EXPECT_FLOAT_EQ_DELTA(distanceInfo.worldPoint1.x(), 20.0f, 0.01f);
+	EXPECT_FLOAT_EQ_DELTA(distanceInfo.worldPoint2.x(), 13.0f, 0.05f);
+	EXPECT_FLOAT_EQ_DELTA(distanceInfo.worldNormal.x(), -1.0f, 0.01f);
+	EXPECT_EQ(tmp.m_world->findNearest(vec3(20, 0, 0), 5.0f, distanceInfo), false);
+	// The category filter only keeps the second sphere
+	EXPECT_EQ(tmp.m_world->findNearest(vec3(20, 0, 0), 20.0f, distanceInfo, CATEGORY_2), true);
+	EXPECT_EQ(distanceInfo.proxyShape, tmp.m_sphere2ProxyShape);
+	EXPECT_FLOAT_EQ_DELTA(distanceInfo.distance, sqrt(300.0f) - 3.0f, 0.05f);
+	// Nearest shape of a shape (its own body is ignored)
+	EXPECT_EQ(tmp.m_world->findNearest(tmp.m_sphere1ProxyShape, 10.0f, distanceInfo), true);
+	EXPECT_EQ(distanceInfo.proxyShape, tmp.m_boxProxyShape);
+	EXPECT_FLOAT_EQ_DELTA(distanceInfo.distance, 4.0f, 0.05f);
+	EXPECT_FLOAT_EQ_DELTA(distanceInfo.worldNormal.y(), -1.0f, 0.01f);
+}
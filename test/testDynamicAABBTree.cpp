@@ -8,6 +8,9 @@
 #include <ephysics/ephysics.hpp>
 #include <ephysics/collision/broadphase/DynamicAABBTree.hpp>
 #include <etk/Vector.hpp>
+#include <etk/Function.hpp>
+#include <echrono/Clock.hpp>
+#include <test-debug/debug.hpp>
 
 
 class OverlapCallback {
@@ -441,3 +444,197 @@ TEST(TestAABBTree, raycast) {
 	EXPECT_EQ(raycastCallback.isHit(object4Id), true);
 }
 
+
+TEST(TestAABBTree, rebuild) {
+	OverlapCallback overlapCallback;
+	// Dynamic AABB Tree
+	ephysics::DynamicAABBTree tree;
+	int32_t objectData[16];
+	int32_t objectId[16];
+	// Objects on a line (worst case of the incremental insertion)
+	for (int32_t iii=0; iii<16; ++iii) {
+		objectData[iii] = iii;
+		objectId[iii] = tree.addObject(ephysics::AABB(vec3(iii*2, 0, 0), vec3(iii*2+1, 1, 1)), &objectData[iii]);
+	}
+	tree.rebuild();
+
+	// ---------- Tests ---------- //
+
+	// The leaves and their data are kept
+	for (int32_t iii=0; iii<16; ++iii) {
+		EXPECT_EQ(*(int32_t*)(tree.getNodeDataPointer(objectId[iii])), objectData[iii]);
+	}
+	ephysics::AABB rootAABB = tree.getRootAABB();
+	EXPECT_EQ(rootAABB.getMin().x(), 0);
+	EXPECT_EQ(rootAABB.getMax().x(), 31);
+
+	// AABB overlapping objects 2 and 3
+	overlapCallback.reset();
+	tree.reportAllShapesOverlappingWithAABB(ephysics::AABB(vec3(4.5, 0, 0), vec3(6.5, 1, 1)), [&](int32_t _nodeId) mutable { overlapCallback(_nodeId);});
+	EXPECT_EQ(overlapCallback.m_overlapNodes.size(), 2);
+	EXPECT_EQ(overlapCallback.isOverlapping(objectId[2]), true);
+	EXPECT_EQ(overlapCallback.isOverlapping(objectId[3]), true);
+
+	// The tree can still be updated after a rebuild
+	tree.removeObject(objectId[2]);
+	overlapCallback.reset();
+	tree.reportAllShapesOverlappingWithAABB(ephysics::AABB(vec3(4.5, 0, 0), vec3(6.5, 1, 1)), [&](int32_t _nodeId) mutable { overlapCallback(_nodeId);});
+	EXPECT_EQ(overlapCallback.m_overlapNodes.size(), 1);
+	EXPECT_EQ(overlapCallback.isOverlapping(objectId[3]), true);
+}
+
+TEST(TestAABBTree, queryLayout) {
+	// The queries traverse the hierarchy of the tree until the query layout (4 children per node) is built,
+	// then the moved objects are refitted in the query layout
+	ephysics::DynamicAABBTree tree;
+	etk::Vector<ephysics::AABB> aabbs;
+	etk::Vector<int32_t> objectId;
+	etk::Vector<int32_t> objectData;
+	objectData.resize(300);
+	for (int32_t iii=0; iii<300; ++iii) {
+		objectData[iii] = iii;
+		vec3 position((iii * 37) % 41, (iii * 53) % 43, (iii * 71) % 47);
+		aabbs.pushBack(ephysics::AABB(position, position + vec3(1 + iii % 3, 1, 2)));
+		objectId.pushBack(tree.addObject(aabbs[iii], &objectData[iii]));
+	}
+	for (int32_t iii=0; iii<300; iii+=3) {
+		tree.removeObject(objectId[iii]);
+		objectId[iii] = -1;
+	}
+	for (int32_t pass=0; pass<3; ++pass) {
+		if (pass == 1) {
+			tree.updateQueryLayout();
+		}
+		if (pass == 2) {
+			for (int32_t iii=1; iii<300; iii+=3) {
+				vec3 position((iii * 41) % 37, (iii * 59) % 43, (iii * 67) % 47);
+				aabbs[iii] = ephysics::AABB(position, position + vec3(2, 1 + iii % 2, 1));
+				tree.updateObject(objectId[iii], aabbs[iii], vec3(0, 0, 0), true);
+			}
+		}
+		EXPECT_EQ(tree.isQueryLayoutValid(), pass >= 1);
+		for (int32_t iii=0; iii<20; ++iii) {
+			ephysics::AABB query(vec3(iii * 2, iii, 40 - iii * 2), vec3(iii * 2 + 6, iii + 8, 46 - iii * 2));
+			int32_t nbExpected = 0;
+			for (int32_t jjj=0; jjj<300; ++jjj) {
+				if (    objectId[jjj] != -1
+				     && query.testCollision(aabbs[jjj]) == true) {
+					nbExpected++;
+				}
+			}
+			int32_t nbOverlap = 0;
+			tree.reportAllShapesOverlappingWithAABB(query, [&](int32_t _nodeId) mutable {
+			                                               	int32_t index = *(int32_t*)(tree.getNodeDataPointer(_nodeId));
+			                                               	EXPECT_EQ(query.testCollision(aabbs[index]), true);
+			                                               	nbOverlap++;
+			                                               });
+			EXPECT_EQ(nbOverlap, nbExpected);
+			// The nearest hit of a ray along the z axis
+			vec3 point1(iii * 2 + 0.5f, iii + 0.5f, -10);
+			vec3 point2(iii * 2 + 0.5f, iii + 0.5f, 60);
+			float expectedFraction = 2.0f;
+			for (int32_t jjj=0; jjj<300; ++jjj) {
+				if (    objectId[jjj] != -1
+				     && aabbs[jjj].contains(vec3(point1.x(), point1.y(), aabbs[jjj].getMin().z())) == true) {
+					expectedFraction = etk::min(expectedFraction, (aabbs[jjj].getMin().z() + 10.0f) / 70.0f);
+				}
+			}
+			float hitFraction = 2.0f;
+			tree.raycast(ephysics::Ray(point1, point2), [&](int32_t _nodeId, const ephysics::Ray&) mutable {
+			                                            	float fraction = (tree.getFatAABB(_nodeId).getMin().z() + 10.0f) / 70.0f;
+			                                            	hitFraction = etk::min(hitFraction, fraction);
+			                                            	return fraction;
+			                                            });
+			EXPECT_FLOAT_EQ(hitFraction, expectedFraction);
+		}
+	}
+}
+
+TEST(TestAABBTree, traversalBenchmark) {
+	const int32_t nbObjects = 2000;
+	const int32_t nbQueries = 20000;
+	ephysics::DynamicAABBTree tree;
+	etk::Vector<int32_t> objectData;
+	objectData.resize(nbObjects);
+	for (int32_t iii=0; iii<nbObjects; ++iii) {
+		objectData[iii] = iii;
+		vec3 position((iii * 37) % 101, (iii * 53) % 97, (iii * 71) % 89);
+		tree.addObject(ephysics::AABB(position, position + vec3(2, 2, 2)), &objectData[iii]);
+	}
+	tree.updateQueryLayout();
+	// Visitor inlined in the traversal (template parameter)
+	int64_t nbOverlapInlined = 0;
+	echrono::Clock start = echrono::Clock::now();
+	for (int32_t iii=0; iii<nbQueries; ++iii) {
+		vec3 position(iii % 101, (iii * 7) % 97, (iii * 13) % 89);
+		tree.reportAllShapesOverlappingWithAABB(ephysics::AABB(position, position + vec3(5, 5, 5)), [&](int32_t) mutable { nbOverlapInlined++;});
+	}
+	echrono::Clock stop = echrono::Clock::now();
+	int64_t durationInlined = stop.get() - start.get();
+	// Type erased visitor (one indirect call per overlapping leaf)
+	int64_t nbOverlapFunction = 0;
+	etk::Function<void(int32_t)> function = [&](int32_t) mutable { nbOverlapFunction++;};
+	start = echrono::Clock::now();
+	for (int32_t iii=0; iii<nbQueries; ++iii) {
+		vec3 position(iii % 101, (iii * 7) % 97, (iii * 13) % 89);
+		tree.reportAllShapesOverlappingWithAABB(ephysics::AABB(position, position + vec3(5, 5, 5)), function);
+	}
+	stop = echrono::Clock::now();
+	int64_t durationFunction = stop.get() - start.get();
+	EXPECT_EQ(nbOverlapInlined, nbOverlapFunction);
+	EXPECT_EQ(nbOverlapInlined > 0, true);
+	TEST_WARNING("AABB tree " << nbQueries << " queries: inlined visitor=" << durationInlined / 1000 << "us etk::Function=" << durationFunction / 1000 << "us");
+}
+
+TEST(TestAABBTree, queryLayoutBenchmark) {
+	// Broad-phase like steps: a part of the objects moves a little (reinserted in the tree) and each moved
+	// object is queried. The queries traverse the binary hierarchy of a tree without query layout and
+	// the query layout (4 children per node) of the other tree, where the moved objects are refitted.
+	const int32_t nbObjects = 2000;
+	const int32_t nbSteps = 200;
+	const int32_t nbMovedObjects[4] = {1, 20, 100, 500};
+	for (int32_t mmm=0; mmm<4; ++mmm) {
+		int64_t durationUpdate[2] = {0, 0};
+		int64_t durationQuery[2] = {0, 0};
+		int64_t nbOverlap[2] = {0, 0};
+		for (int32_t layout=0; layout<2; ++layout) {
+			ephysics::DynamicAABBTree tree;
+			etk::Vector<int32_t> objectId;
+			etk::Vector<int32_t> objectData;
+			etk::Vector<vec3> objectPosition;
+			objectData.resize(nbObjects);
+			for (int32_t iii=0; iii<nbObjects; ++iii) {
+				objectData[iii] = iii;
+				vec3 position((iii * 37) % 101, (iii * 53) % 97, (iii * 71) % 89);
+				objectPosition.pushBack(position);
+				objectId.pushBack(tree.addObject(ephysics::AABB(position, position + vec3(2, 2, 2)), &objectData[iii]));
+			}
+			if (layout == 1) {
+				tree.updateQueryLayout();
+			}
+			for (int32_t step=0; step<nbSteps; ++step) {
+				echrono::Clock start = echrono::Clock::now();
+				for (int32_t iii=0; iii<nbMovedObjects[mmm]; ++iii) {
+					int32_t index = (step * 7919 + iii * 13) % nbObjects;
+					vec3 displacement(0.1f * (index % 5 - 2), 0.1f * (index % 3 - 1), 0.1f * (index % 7 - 3));
+					objectPosition[index] += displacement;
+					tree.updateObject(objectId[index], ephysics::AABB(objectPosition[index], objectPosition[index] + vec3(2, 2, 2)), displacement, true);
+				}
+				if (layout == 1) {
+					tree.updateQueryLayout();
+				}
+				echrono::Clock startQuery = echrono::Clock::now();
+				for (int32_t iii=0; iii<nbMovedObjects[mmm]; ++iii) {
+					int32_t index = (step * 7919 + iii * 13) % nbObjects;
+					tree.reportAllShapesOverlappingWithAABB(tree.getFatAABB(objectId[index]), [&](int32_t) mutable { nbOverlap[layout]++;});
+				}
+				durationUpdate[layout] += startQuery.get() - start.get();
+				durationQuery[layout] += echrono::Clock::now().get() - startQuery.get();
+			}
+			EXPECT_EQ(tree.isQueryLayoutValid(), layout == 1);
+		}
+		EXPECT_EQ(nbOverlap[0], nbOverlap[1]);
+		TEST_WARNING("AABB tree " << nbObjects << " objects, " << nbMovedObjects[mmm] << " moved per step: hierarchy updates=" << durationUpdate[0] / 1000 << "us queries=" << durationQuery[0] / 1000
+		             << "us, refitted layout updates=" << durationUpdate[1] / 1000 << "us queries=" << durationQuery[1] / 1000 << "us");
+	}
+}
@@ -0,0 +1,705 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etest/etest.hpp>
+#include <ephysics/ephysics.hpp>
+#include <ephysics/engine/ContactSolver.hpp>
+#include <ephysics/engine/Island.hpp>
+#include <test-debug/debug.hpp>
+
+/**
+ * @brief Small dynamics world: a box falling on a static floor and a pendulum
+ */
+class TestDynamicsWorld {
+	public:
+		ephysics::DynamicsWorld* m_world;
+		ephysics::BoxShape* m_floorShape;
+		ephysics::BoxShape* m_boxShape;
+		ephysics::RigidBody* m_floorBody;
+		ephysics::RigidBody* m_boxBody;
+		ephysics::RigidBody* m_pendulumBody;
+		ephysics::BallAndSocketJoint* m_joint;
+	public:
+		TestDynamicsWorld() {
+			m_world = ETK_NEW(ephysics::DynamicsWorld, vec3(0, -9.81f, 0));
+			m_floorShape = ETK_NEW(ephysics::BoxShape, vec3(10, 1, 10));
+			m_boxShape = ETK_NEW(ephysics::BoxShape, vec3(1, 1, 1));
+			m_floorBody = m_world->createRigidBody(etk::Transform3D(vec3(0, -1, 0), etk::Quaternion::identity()));
+			m_floorBody->addCollisionShape(m_floorShape, etk::Transform3D::identity(), 1.0f);
+			m_floorBody->setType(ephysics::STATIC);
+			m_boxBody = m_world->createRigidBody(etk::Transform3D(vec3(0, 2, 0), etk::Quaternion::identity()));
+			m_boxBody->addCollisionShape(m_boxShape, etk::Transform3D::identity(), 1.0f);
+			m_pendulumBody = m_world->createRigidBody(etk::Transform3D(vec3(5, 5, 0), etk::Quaternion::identity()));
+			m_pendulumBody->addCollisionShape(m_boxShape, etk::Transform3D::identity(), 1.0f);
+			ephysics::BallAndSocketJointInfo jointInfo(m_floorBody, m_pendulumBody, vec3(3, 5, 0));
+			m_joint = static_cast<ephysics::BallAndSocketJoint*>(m_world->createJoint(jointInfo));
+		}
+		~TestDynamicsWorld() {
+			ETK_DELETE(ephysics::DynamicsWorld, m_world);
+			ETK_DELETE(ephysics::BoxShape, m_boxShape);
+			ETK_DELETE(ephysics::BoxShape, m_floorShape);
+		}
+		void step(int32_t _nbSteps) {
+			for (int32_t iii=0; iii<_nbSteps; ++iii) {
+				m_world->update(1.0f / 60.0f);
+			}
+		}
+		/// Move the box at rest at a given height (just above the floor, it comes to rest in a few steps)
+		void placeBox(float _height) {
+			m_boxBody->setTransform(etk::Transform3D(vec3(0, _height, 0), etk::Quaternion::identity()));
+			m_boxBody->setLinearVelocity(vec3(0, 0, 0));
+			m_boxBody->setAngularVelocity(vec3(0, 0, 0));
+		}
+		/// Return the number of contact points between the box and the floor
+		uint32_t getNbBoxContactPoints() const {
+			uint32_t nbContactPoints = 0;
+			for (auto &it: m_world->getContactsList()) {
+				if (    it->getBody1() == m_boxBody
+				     || it->getBody2() == m_boxBody) {
+					nbContactPoints += it->getNbContactPoints();
+				}
+			}
+			return nbContactPoints;
+		}
+};
+
+TEST(TestDynamicsWorld, saveRestoreState) {
+	TestDynamicsWorld tmp;
+	// Let the box land on the floor (contacts and joint impulses are cached)
+	tmp.step(60);
+	EXPECT_NE(tmp.m_world->getContactsList().size(), size_t(0));
+	etk::Vector<uint8_t> buffer;
+	tmp.m_world->saveState(buffer);
+	etk::Transform3D boxTransform = tmp.m_boxBody->getTransform();
+	etk::Transform3D pendulumTransform = tmp.m_pendulumBody->getTransform();
+	vec3 pendulumVelocity = tmp.m_pendulumBody->getLinearVelocity();
+	tmp.step(20);
+	etk::Transform3D pendulumTransformAfter = tmp.m_pendulumBody->getTransform();
+	EXPECT_NE(tmp.m_pendulumBody->getTransform().getPosition(), pendulumTransform.getPosition());
+	// Restore and replay the same steps: the simulation is the same
+	EXPECT_EQ(tmp.m_world->restoreState(buffer), true);
+	EXPECT_EQ(tmp.m_boxBody->getTransform().getPosition(), boxTransform.getPosition());
+	EXPECT_EQ(tmp.m_pendulumBody->getTransform().getPosition(), pendulumTransform.getPosition());
+	EXPECT_EQ(tmp.m_pendulumBody->getLinearVelocity(), pendulumVelocity);
+	EXPECT_NE(tmp.m_world->getContactsList().size(), size_t(0));
+	tmp.step(20);
+	EXPECT_EQ(tmp.m_pendulumBody->getTransform().getPosition(), pendulumTransformAfter.getPosition());
+	EXPECT_EQ(tmp.m_pendulumBody->getTransform().getOrientation(), pendulumTransformAfter.getOrientation());
+	// The snapshot can not be restored when the bodies of the world have changed
+	ephysics::RigidBody* newBody = tmp.m_world->createRigidBody(etk::Transform3D::identity());
+	EXPECT_EQ(tmp.m_world->restoreState(buffer), false);
+	tmp.m_world->destroyRigidBody(newBody);
+	// Nor when the proxy shapes have changed (same number of bodies): the world is not modified
+	ephysics::ProxyShape* newShape = tmp.m_boxBody->addCollisionShape(tmp.m_boxShape, etk::Transform3D(vec3(0, 2, 0), etk::Quaternion::identity()), 1.0f);
+	etk::Transform3D boxTransformAfter = tmp.m_boxBody->getTransform();
+	EXPECT_EQ(tmp.m_world->restoreState(buffer), false);
+	EXPECT_EQ(tmp.m_boxBody->getTransform().getPosition(), boxTransformAfter.getPosition());
+	tmp.m_boxBody->removeCollisionShape(newShape);
+	EXPECT_EQ(tmp.m_world->restoreState(buffer), true);
+}
+
+TEST(TestDynamicsWorld, saveLoadWorld) {
+	TestDynamicsWorld tmp;
+	tmp.m_boxBody->getMaterial().setBounciness(0.25f);
+	tmp.placeBox(1.02f);
+	etk::Vector<uint8_t> buffer;
+	EXPECT_EQ(ephysics::WorldSerializer::save(*tmp.m_world, buffer), true);
+	ephysics::DynamicsWorld* world = ETK_NEW(ephysics::DynamicsWorld, vec3(0, 0, 0));
+	ephysics::WorldSerializer serializer;
+	EXPECT_EQ(serializer.load(*world, buffer), true);
+	EXPECT_EQ(world->getGravity(), vec3(0, -9.81f, 0));
+	EXPECT_EQ(world->getNbRigidBodies(), uint32_t(3));
+	EXPECT_EQ(world->getNbJoints(), uint32_t(1));
+	// The box shape is shared by two bodies: it is stored once
+	EXPECT_EQ(serializer.getShapes().size(), size_t(2));
+	ephysics::RigidBody* boxBody = null;
+	for (auto &it: serializer.getBodies()) {
+		if (it->getMaterial().getBounciness() == 0.25f) {
+			boxBody = it;
+		}
+	}
+	EXPECT_NE(boxBody, null);
+	EXPECT_EQ(boxBody->getTransform().getPosition(), vec3(0, 1.02f, 0));
+	EXPECT_EQ(serializer.getJoints()[0]->getType(), ephysics::BALLSOCKETJOINT);
+	// The broad-phase has been built by the bulk loading: the box rests on the floor
+	for (int32_t iii=0; iii<30; ++iii) {
+		world->update(1.0f / 60.0f);
+	}
+	EXPECT_FLOAT_EQ_DELTA(boxBody->getTransform().getPosition().y(), 1.0f, 0.05f);
+	// Corrupted data is rejected and the world is not modified (settings included)
+	ephysics::WorldSerializer serializer2;
+	vec3 gravity(0, -1, 0);
+	world->setGravity(gravity);
+	buffer.resize(buffer.size() - 4);
+	EXPECT_EQ(serializer2.load(*world, buffer), false);
+	EXPECT_EQ(world->getGravity(), gravity);
+	EXPECT_EQ(world->getNbRigidBodies(), uint32_t(3));
+	EXPECT_EQ(world->getNbJoints(), uint32_t(1));
+	ETK_DELETE(ephysics::DynamicsWorld, world);
+}
+
+TEST(TestDynamicsWorld, asynchronousUpdate) {
+	TestDynamicsWorld tmp;
+	EXPECT_EQ(tmp.m_world->getPublishedBodyStates().size(), size_t(0));
+	tmp.m_world->beginUpdate(1.0f / 60.0f);
+	// Commands recorded while the step is running are applied at the start of the next step
+	tmp.m_world->getCommandQueue().setLinearVelocity(tmp.m_boxBody, vec3(0, 10, 0));
+	tmp.m_world->waitUpdate();
+	const etk::Vector<ephysics::BodyState>& states = tmp.m_world->getPublishedBodyStates();
+	EXPECT_EQ(states.size(), size_t(3));
+	for (auto &it: states) {
+		EXPECT_EQ(it.transform.getPosition(), it.body->getTransform().getPosition());
+	}
+	EXPECT_EQ(tmp.m_boxBody->getLinearVelocity().y() < 0.0f, true);
+	tmp.m_world->beginUpdate(1.0f / 60.0f);
+	tmp.m_world->waitUpdate();
+	EXPECT_EQ(tmp.m_boxBody->getLinearVelocity().y() > 9.0f, true);
+	// The synchronous update applies the queued commands too
+	tmp.m_world->getCommandQueue().setTransform(tmp.m_boxBody, etk::Transform3D(vec3(0, 4, 0), etk::Quaternion::identity()));
+	tmp.step(1);
+	EXPECT_EQ(tmp.m_boxBody->getTransform().getPosition().y() > 4.0f, true);
+}
+
+TEST(TestDynamicsWorld, parallelStep) {
+	TestDynamicsWorld sequential;
+	TestDynamicsWorld parallel;
+	parallel.m_world->setNbThreads(4);
+	EXPECT_NE(parallel.m_world->getTaskScheduler(), null);
+	// The islands are independent: the parallel step gives the same result
+	sequential.step(60);
+	parallel.step(60);
+	EXPECT_EQ(parallel.m_boxBody->getTransform().getPosition(), sequential.m_boxBody->getTransform().getPosition());
+	EXPECT_EQ(parallel.m_boxBody->getTransform().getOrientation(), sequential.m_boxBody->getTransform().getOrientation());
+	EXPECT_EQ(parallel.m_pendulumBody->getTransform().getPosition(), sequential.m_pendulumBody->getTransform().getPosition());
+	EXPECT_EQ(parallel.m_pendulumBody->getLinearVelocity(), sequential.m_pendulumBody->getLinearVelocity());
+	parallel.m_world->setNbThreads(1);
+	EXPECT_EQ(parallel.m_world->getTaskScheduler(), null);
+}
+
+TEST(TestDynamicsWorld, commandQueue) {
+	TestDynamicsWorld tmp;
+	ephysics::BodyCommandQueue& queue = tmp.m_world->getCommandQueue();
+	// Record the creation of bodies from several threads
+	etk::Vector<std::thread*> threads;
+	for (int32_t iii=0; iii<4; ++iii) {
+		threads.pushBack(ETK_NEW(std::thread, [&queue, &tmp, iii]() {
+			for (int32_t jjj=0; jjj<25; ++jjj) {
+				queue.createRigidBody(etk::Transform3D(vec3(iii * 3.0f - 6.0f, 10.0f + jjj * 3.0f, -6.0f), etk::Quaternion::identity()),
+				                      [&tmp](ephysics::RigidBody* _body) {
+				                      	_body->addCollisionShape(tmp.m_boxShape, etk::Transform3D::identity(), 1.0f);
+				                      });
+			}
+		}));
+	}
+	for (auto &it: threads) {
+		it->join();
+		ETK_DELETE(std::thread, it);
+	}
+	EXPECT_EQ(tmp.m_world->getNbRigidBodies(), uint32_t(3));
+	tmp.step(1);
+	EXPECT_EQ(tmp.m_world->getNbRigidBodies(), uint32_t(103));
+	// The commands recorded after the destruction of a body are dropped
+	queue.destroyJoint(tmp.m_joint);
+	queue.destroyRigidBody(tmp.m_pendulumBody);
+	queue.setLinearVelocity(tmp.m_pendulumBody, vec3(1, 0, 0));
+	tmp.step(1);
+	EXPECT_EQ(tmp.m_world->getNbRigidBodies(), uint32_t(102));
+	EXPECT_EQ(tmp.m_world->getNbJoints(), uint32_t(0));
+	queue.createJoint(ephysics::BallAndSocketJointInfo(tmp.m_floorBody, tmp.m_boxBody, vec3(0, 0, 0)));
+	tmp.step(1);
+	EXPECT_EQ(tmp.m_world->getNbJoints(), uint32_t(1));
+	// The creation of a joint recorded after the destruction of one of its bodies is dropped
+	ephysics::RigidBody* destroyedBody = tmp.m_world->createRigidBody(etk::Transform3D(vec3(-5, 5, 0), etk::Quaternion::identity()));
+	EXPECT_EQ(tmp.m_world->getNbRigidBodies(), uint32_t(103));
+	queue.destroyRigidBody(destroyedBody);
+	queue.createJoint(ephysics::BallAndSocketJointInfo(tmp.m_floorBody, destroyedBody, vec3(-5, 4, 0)));
+	queue.createJoint(ephysics::BallAndSocketJointInfo(destroyedBody, tmp.m_floorBody, vec3(-5, 4, 0)));
+	tmp.step(1);
+	EXPECT_EQ(tmp.m_world->getNbRigidBodies(), uint32_t(102));
+	EXPECT_EQ(tmp.m_world->getNbJoints(), uint32_t(1));
+	// A joint of unknown type is not recorded
+	ephysics::BallAndSocketJointInfo unknownJointInfo(tmp.m_floorBody, tmp.m_boxBody, vec3(0, 0, 0));
+	unknownJointInfo.type = ephysics::JointType(42);
+	queue.createJoint(unknownJointInfo);
+	tmp.step(1);
+	EXPECT_EQ(tmp.m_world->getNbJoints(), uint32_t(1));
+	// The bulk inserted bodies collide with the floor
+	tmp.step(120);
+	EXPECT_EQ(tmp.m_world->getContactsList().size() > size_t(4), true);
+}
+
+TEST(TestDynamicsWorld, advanceFixedTimeStep) {
+	TestDynamicsWorld tmp;
+	tmp.m_world->setFixedTimeStep(0.01f);
+	tmp.m_world->setMaxNbSubSteps(4);
+	// Less than a step: nothing is simulated, the bodies are rendered at their current position
+	EXPECT_EQ(tmp.m_world->advance(0.005f), uint32_t(0));
+	EXPECT_FLOAT_EQ(tmp.m_world->getInterpolationFactor(), 0.5f);
+	EXPECT_EQ(tmp.m_world->getInterpolatedBodyStates().size(), size_t(3));
+	// Two steps and half a step remaining
+	EXPECT_EQ(tmp.m_world->advance(0.02f), uint32_t(2));
+	EXPECT_FLOAT_EQ_DELTA(tmp.m_world->getInterpolationFactor(), 0.5f, 0.001f);
+	vec3 position = tmp.m_boxBody->getTransform().getPosition();
+	for (auto &it: tmp.m_world->getInterpolatedBodyStates()) {
+		if (it.body == tmp.m_boxBody) {
+			// The box is falling: the rendered position is between the two last steps
+			EXPECT_EQ(it.transform.getPosition().y() > position.y(), true);
+			EXPECT_EQ(it.transform.getPosition().y() < 2.0f, true);
+		}
+	}
+	// The number of steps is capped and the remaining time is dropped
+	EXPECT_EQ(tmp.m_world->advance(1.0f), uint32_t(4));
+	EXPECT_EQ(tmp.m_world->getInterpolationFactor() < 1.0f, true);
+	EXPECT_EQ(tmp.m_world->advance(0.0f), uint32_t(0));
+}
+
+TEST(TestDynamicsWorld, shiftOriginInterpolation) {
+	TestDynamicsWorld tmp;
+	tmp.m_world->setFixedTimeStep(0.01f);
+	// Two steps and half a step remaining: the box is rendered between the two last steps
+	EXPECT_EQ(tmp.m_world->advance(0.025f), uint32_t(2));
+	vec3 position;
+	for (auto &it: tmp.m_world->getInterpolatedBodyStates()) {
+		if (it.body == tmp.m_boxBody) {
+			position = it.transform.getPosition();
+		}
+	}
+	// The interpolated states and the previous transforms are translated with the bodies
+	tmp.m_world->shiftOrigin(vec3(100, 0, 0));
+	for (auto &it: tmp.m_world->getInterpolatedBodyStates()) {
+		if (it.body == tmp.m_boxBody) {
+			EXPECT_FLOAT_EQ_DELTA(it.transform.getPosition().x(), position.x() - 100.0f, 0.0001f);
+			EXPECT_FLOAT_EQ_DELTA(it.transform.getPosition().y(), position.y(), 0.0001f);
+		}
+	}
+	// No step: the box is rendered at the same (translated) position, it does not jump
+	EXPECT_EQ(tmp.m_world->advance(0.0f), uint32_t(0));
+	for (auto &it: tmp.m_world->getInterpolatedBodyStates()) {
+		if (it.body == tmp.m_boxBody) {
+			EXPECT_FLOAT_EQ_DELTA(it.transform.getPosition().x(), position.x() - 100.0f, 0.0001f);
+			EXPECT_FLOAT_EQ_DELTA(it.transform.getPosition().y(), position.y(), 0.0001f);
+		}
+	}
+}
+
+TEST(TestDynamicsWorld, kinematicTargets) {
+	TestDynamicsWorld tmp;
+	ephysics::RigidBody* platforms[2];
+	etk::Transform3D targets[2];
+	for (int32_t iii=0; iii<2; ++iii) {
+		platforms[iii] = tmp.m_world->createRigidBody(etk::Transform3D(vec3(-5, 5 + iii * 3, -5), etk::Quaternion::identity()));
+		platforms[iii]->addCollisionShape(tmp.m_boxShape, etk::Transform3D::identity(), 1.0f);
+		platforms[iii]->setType(ephysics::KINEMATIC);
+	}
+	targets[0] = etk::Transform3D(vec3(-5, 6, -5), etk::Quaternion::identity());
+	targets[1] = etk::Transform3D(vec3(-4, 8, -5), etk::Quaternion(0, 0, sin(0.05f), cos(0.05f)));
+	tmp.m_world->setKinematicTargets(platforms, targets, 2, 1.0f / 60.0f);
+	EXPECT_FLOAT_EQ_DELTA(platforms[0]->getLinearVelocity().y(), 60.0f, 0.001f);
+	EXPECT_FLOAT_EQ_DELTA(platforms[1]->getAngularVelocity().z(), 6.0f, 0.001f);
+	tmp.step(1);
+	// The targets are reached by the step
+	EXPECT_FLOAT_EQ_DELTA(platforms[0]->getTransform().getPosition().y(), 6.0f, 0.001f);
+	EXPECT_FLOAT_EQ_DELTA(platforms[1]->getTransform().getPosition().x(), -4.0f, 0.001f);
+	EXPECT_FLOAT_EQ_DELTA(platforms[1]->getTransform().getOrientation().z(), sin(0.05f), 0.001f);
+	// A target equal to the current transform stops the body
+	targets[0] = platforms[0]->getTransform();
+	tmp.m_world->setKinematicTargets(platforms, targets, 1, 1.0f / 60.0f);
+	EXPECT_EQ(platforms[0]->getLinearVelocity(), vec3(0, 0, 0));
+}
+
+TEST(TestDynamicsWorld, contactFeatureIds) {
+	TestDynamicsWorld tmp;
+	// Let the box rest on the floor
+	tmp.placeBox(1.02f);
+	tmp.step(30);
+	EXPECT_FLOAT_EQ_DELTA(tmp.m_boxBody->getTransform().getPosition().y(), 1.0f, 0.05f);
+	EXPECT_EQ(tmp.m_boxBody->getLinearVelocity().length() < 0.1f, true);
+	EXPECT_NE(tmp.getNbBoxContactPoints(), uint32_t(0));
+	etk::Vector<const ephysics::ContactManifold*> manifolds = tmp.m_world->getContactsList();
+	EXPECT_NE(manifolds.size(), size_t(0));
+	if (manifolds.size() == 0) {
+		return;
+	}
+	int32_t nbWarmStartedContacts = 0;
+	for (auto &it: manifolds) {
+		EXPECT_NE(it->getNbContactPoints(), uint32_t(0));
+		for (uint32_t iii=0; iii<it->getNbContactPoints(); ++iii) {
+			const ephysics::ContactPoint* contact = it->getContactPoint(iii);
+			// Box against floor face contacts: the features are always known
+			EXPECT_NE(contact->getFeatureId(), uint32_t(0));
+			if (    contact->getIsRestingContact() == true
+			     && contact->getPenetrationImpulse() > 0.0f) {
+				nbWarmStartedContacts++;
+			}
+		}
+	}
+	EXPECT_NE(nbWarmStartedContacts, 0);
+	// A contact of the same features reported at another position replaces the previous one and keeps its impulses
+	const ephysics::ContactManifold* manifold = manifolds[0];
+	ephysics::ContactManifold contactManifold(manifold->getShape1(), manifold->getShape2(), 0);
+	ephysics::ContactPointInfo contactInfo(manifold->getShape1(),
+	                                       manifold->getShape2(),
+	                                       manifold->getShape1()->getCollisionShape(),
+	                                       manifold->getShape2()->getCollisionShape(),
+	                                       vec3(0, 1, 0),
+	                                       0.01f,
+	                                       vec3(0, 0, 0),
+	                                       vec3(0, 0, 0));
+	contactInfo.featureId = 42;
+	contactManifold.addContactPoint(contactInfo);
+	contactManifold.getContactPoint(0)->setPenetrationImpulse(3.0f);
+	contactInfo.localPoint1 = vec3(0.5f, 0, 0);
+	contactInfo.localPoint2 = vec3(0.5f, 0, 0);
+	contactManifold.addContactPoint(contactInfo);
+	EXPECT_EQ(contactManifold.getNbContactPoints(), uint32_t(1));
+	EXPECT_EQ(contactManifold.getContactPoint(0)->getLocalPointOnBody1(), vec3(0.5f, 0, 0));
+	EXPECT_FLOAT_EQ(contactManifold.getContactPoint(0)->getPenetrationImpulse(), 3.0f);
+	// Without feature ID, the new contact is a new point
+	contactInfo.featureId = 0;
+	contactInfo.localPoint1 = vec3(-0.5f, 0, 0);
+	contactInfo.localPoint2 = vec3(-0.5f, 0, 0);
+	contactManifold.addContactPoint(contactInfo);
+	EXPECT_EQ(contactManifold.getNbContactPoints(), uint32_t(2));
+	EXPECT_FLOAT_EQ(contactManifold.getContactPoint(1)->getPenetrationImpulse(), 0.0f);
+}
+
+TEST(TestDynamicsWorld, contactSolverFrictionModes) {
+	for (int32_t mode=0; mode<2; ++mode) {
+		TestDynamicsWorld tmp;
+		tmp.m_world->setIsSolveFrictionAtContactManifoldCenterActive(mode == 0);
+		// Let the box rest on the floor: the penetration impulses hold it against the gravity
+		tmp.placeBox(1.02f);
+		tmp.step(30);
+		EXPECT_FLOAT_EQ_DELTA(tmp.m_boxBody->getTransform().getPosition().y(), 1.0f, 0.05f);
+		EXPECT_EQ(tmp.m_boxBody->getLinearVelocity().length() < 0.1f, true);
+		EXPECT_NE(tmp.getNbBoxContactPoints(), uint32_t(0));
+		float sumPenetrationImpulse = 0.0f;
+		etk::Vector<const ephysics::ContactManifold*> manifolds = tmp.m_world->getContactsList();
+		for (auto &it: manifolds) {
+			for (uint32_t iii=0; iii<it->getNbContactPoints(); ++iii) {
+				sumPenetrationImpulse += it->getContactPoint(iii)->getPenetrationImpulse();
+			}
+		}
+		EXPECT_EQ(sumPenetrationImpulse > 0.0f, true);
+	}
+}
+
+/// Add a contact between the floor (body 1) and the box resting on it (body 2) at a position along the x axis
+static void addFloorBoxContact(TestDynamicsWorld& _tmp, ephysics::ContactManifold& _manifold, float _x, float _penetrationDepth, uint32_t _featureId) {
+	ephysics::ProxyShape* floorShape = _tmp.m_floorBody->getProxyShapesList();
+	ephysics::ProxyShape* boxShape = _tmp.m_boxBody->getProxyShapesList();
+	ephysics::ContactPointInfo contactInfo(floorShape,
+	                                       boxShape,
+	                                       floorShape->getCollisionShape(),
+	                                       boxShape->getCollisionShape(),
+	                                       vec3(0, 1, 0),
+	                                       _penetrationDepth,
+	                                       vec3(_x, 1, 0),
+	                                       vec3(_x, -1, 0));
+	contactInfo.featureId = _featureId;
+	_manifold.addContactPoint(contactInfo);
+}
+
+TEST(TestDynamicsWorld, contactSolverSplitImpulse) {
+	TestDynamicsWorld tmp;
+	tmp.placeBox(1.0f);
+	// A deep contact below the center of mass of the box pushes it straight up. The contact beside it
+	// has no penetration: the split impulse must not pull the box back against the floor there.
+	ephysics::ContactManifold manifold(tmp.m_floorBody->getProxyShapesList(), tmp.m_boxBody->getProxyShapesList(), 0);
+	addFloorBoxContact(tmp, manifold, 0.0f, 0.1f, 1);
+	addFloorBoxContact(tmp, manifold, 0.5f, 0.0f, 2);
+	EXPECT_EQ(manifold.getNbContactPoints(), uint32_t(2));
+	ephysics::Island island(2, 1, 0);
+	island.addBody(tmp.m_boxBody);
+	island.addContactManifold(&manifold);
+	etk::Map<ephysics::RigidBody*, uint32_t> mapBodyToVelocityIndex;
+	mapBodyToVelocityIndex.add(tmp.m_floorBody, 0);
+	mapBodyToVelocityIndex.add(tmp.m_boxBody, 1);
+	vec3 linearVelocities[2] = {vec3(0, 0, 0), vec3(0, 0, 0)};
+	vec3 angularVelocities[2] = {vec3(0, 0, 0), vec3(0, 0, 0)};
+	vec3 splitLinearVelocities[2] = {vec3(0, 0, 0), vec3(0, 0, 0)};
+	vec3 splitAngularVelocities[2] = {vec3(0, 0, 0), vec3(0, 0, 0)};
+	etk::Matrix3x3 inverseInertiaTensors[2] = {tmp.m_floorBody->getInertiaTensorInverseWorld(), tmp.m_boxBody->getInertiaTensorInverseWorld()};
+	ephysics::ContactSolver solver(mapBodyToVelocityIndex);
+	solver.setConstrainedVelocitiesArrays(linearVelocities, angularVelocities);
+	solver.setSplitVelocitiesArrays(splitLinearVelocities, splitAngularVelocities);
+	solver.setInverseInertiaTensorsArray(inverseInertiaTensors);
+	solver.initializeForIsland(1.0f / 60.0f, &island);
+	solver.warmStart();
+	for (int32_t iii=0; iii<10; ++iii) {
+		solver.solve();
+	}
+	solver.cleanup();
+	EXPECT_EQ(splitLinearVelocities[1].y() > 0.0f, true);
+	EXPECT_FLOAT_EQ_DELTA(splitAngularVelocities[1].length(), 0.0f, 0.001f);
+	// The static floor is never moved
+	EXPECT_EQ(splitLinearVelocities[0], vec3(0, 0, 0));
+	EXPECT_EQ(splitAngularVelocities[0], vec3(0, 0, 0));
+}
+
+TEST(TestDynamicsWorld, contactSolverRollingResistanceWarmStart) {
+	TestDynamicsWorld tmp;
+	tmp.placeBox(1.0f);
+	tmp.m_boxBody->getMaterial().setRollingResistance(0.5f);
+	ephysics::ContactManifold manifold(tmp.m_floorBody->getProxyShapesList(), tmp.m_boxBody->getProxyShapesList(), 0);
+	addFloorBoxContact(tmp, manifold, -0.5f, 0.0f, 1);
+	addFloorBoxContact(tmp, manifold, 0.5f, 0.0f, 2);
+	// Rolling resistance impulse stored by the previous step of a resting contact
+	for (uint32_t iii=0; iii<manifold.getNbContactPoints(); ++iii) {
+		manifold.getContactPoint(iii)->setIsRestingContact(true);
+	}
+	const vec3 rollingResistanceImpulse(0, 0, 0.3f);
+	manifold.setRollingResistanceImpulse(rollingResistanceImpulse);
+	ephysics::Island island(2, 1, 0);
+	island.addBody(tmp.m_boxBody);
+	island.addContactManifold(&manifold);
+	etk::Map<ephysics::RigidBody*, uint32_t> mapBodyToVelocityIndex;
+	mapBodyToVelocityIndex.add(tmp.m_floorBody, 0);
+	mapBodyToVelocityIndex.add(tmp.m_boxBody, 1);
+	vec3 linearVelocities[2] = {vec3(0, 0, 0), vec3(0, 0, 0)};
+	vec3 angularVelocities[2] = {vec3(0, 0, 0), vec3(0, 0, 0)};
+	vec3 splitLinearVelocities[2] = {vec3(0, 0, 0), vec3(0, 0, 0)};
+	vec3 splitAngularVelocities[2] = {vec3(0, 0, 0), vec3(0, 0, 0)};
+	etk::Matrix3x3 inverseInertiaTensors[2] = {tmp.m_floorBody->getInertiaTensorInverseWorld(), tmp.m_boxBody->getInertiaTensorInverseWorld()};
+	ephysics::ContactSolver solver(mapBodyToVelocityIndex);
+	solver.setIsSolveFrictionAtContactManifoldCenterActive(true);
+	solver.setConstrainedVelocitiesArrays(linearVelocities, angularVelocities);
+	solver.setSplitVelocitiesArrays(splitLinearVelocities, splitAngularVelocities);
+	solver.setInverseInertiaTensorsArray(inverseInertiaTensors);
+	solver.initializeForIsland(1.0f / 60.0f, &island);
+	// The warm start applies the stored impulse to the box (body 2)
+	solver.warmStart();
+	vec3 expectedAngularVelocity = tmp.m_boxBody->getInertiaTensorInverseWorld() * rollingResistanceImpulse;
+	EXPECT_FLOAT_EQ_DELTA(angularVelocities[1].z(), expectedAngularVelocity.z(), 0.0001f);
+	EXPECT_NE(angularVelocities[1].z(), 0.0f);
+	solver.cleanup();
+}
+
+TEST(TestDynamicsWorld, contactManifoldsByValue) {
+	TestDynamicsWorld tmp;
+	tmp.placeBox(1.02f);
+	tmp.step(30);
+	// The box rests on the floor: the manifold of the pair holds the corners of the box face
+	EXPECT_NE(tmp.getNbBoxContactPoints(), uint32_t(0));
+	EXPECT_EQ(tmp.getNbBoxContactPoints() <= uint32_t(4), true);
+	// The manifolds referenced by the body are the ones stored in the pair
+	int32_t nbBodyManifolds = 0;
+	for (const ephysics::ContactManifoldListElement* element = tmp.m_boxBody->getContactManifoldsList();
+	     element != null;
+	     element = element->next) {
+		nbBodyManifolds++;
+		const ephysics::ContactManifold* manifold = element->contactManifold;
+		EXPECT_EQ(    manifold->getBody1() == tmp.m_boxBody
+		           || manifold->getBody2() == tmp.m_boxBody, true);
+		for (uint32_t iii=0; iii<manifold->getNbContactPoints(); ++iii) {
+			const ephysics::ContactPoint* contact = manifold->getContactPoint(iii);
+			EXPECT_FLOAT_EQ_DELTA(etk::abs(contact->getNormal().y()), 1.0f, 0.01f);
+			EXPECT_EQ(contact->getPenetrationDepth() >= 0.0f, true);
+			EXPECT_EQ(contact->getIsRestingContact(), true);
+		}
+	}
+	EXPECT_EQ(nbBodyManifolds, 1);
+	// Lift the box: the contacts are removed
+	tmp.placeBox(5.0f);
+	tmp.step(1);
+	EXPECT_EQ(tmp.getNbBoxContactPoints(), uint32_t(0));
+	EXPECT_EQ(tmp.m_boxBody->getContactManifoldsList(), null);
+	// Drop it again: new contact points are created
+	tmp.placeBox(1.02f);
+	tmp.step(30);
+	EXPECT_NE(tmp.getNbBoxContactPoints(), uint32_t(0));
+	EXPECT_FLOAT_EQ_DELTA(tmp.m_boxBody->getTransform().getPosition().y(), 1.0f, 0.05f);
+}
+
+TEST(TestDynamicsWorld, contactStream) {
+	TestDynamicsWorld tmp;
+	int32_t boxUserData = 1;
+	int32_t floorUserData = 2;
+	tmp.m_boxBody->getProxyShapesList()->setUserData(&boxUserData);
+	tmp.m_floorBody->getProxyShapesList()->setUserData(&floorUserData);
+	tmp.placeBox(1.02f);
+	// The stream is not filled by default
+	tmp.step(30);
+	EXPECT_NE(tmp.getNbBoxContactPoints(), uint32_t(0));
+	EXPECT_EQ(tmp.m_world->getContactStream().getNbContacts(), size_t(0));
+	tmp.m_world->enableContactStream(true);
+	tmp.step(1);
+	// One entry per contact point of the step, with the same index in every array
+	const ephysics::ContactStream& stream = tmp.m_world->getContactStream();
+	EXPECT_EQ(stream.getNbContacts(), size_t(tmp.getNbBoxContactPoints()));
+	float sumNormalImpulses = 0.0f;
+	for (size_t iii=0; iii<stream.getNbContacts(); ++iii) {
+		bool isBoxFirst = stream.getBody1Ids()[iii] == tmp.m_boxBody->getID();
+		if (isBoxFirst == true) {
+			EXPECT_EQ(stream.getBody2Ids()[iii], tmp.m_floorBody->getID());
+			EXPECT_EQ(stream.getShape1UserData()[iii], &boxUserData);
+			EXPECT_EQ(stream.getShape2UserData()[iii], &floorUserData);
+		} else {
+			EXPECT_EQ(stream.getBody1Ids()[iii], tmp.m_floorBody->getID());
+			EXPECT_EQ(stream.getBody2Ids()[iii], tmp.m_boxBody->getID());
+			EXPECT_EQ(stream.getShape1UserData()[iii], &floorUserData);
+			EXPECT_EQ(stream.getShape2UserData()[iii], &boxUserData);
+		}
+		// The normal goes from the first body toward the second one
+		EXPECT_FLOAT_EQ_DELTA(stream.getNormals()[iii].y(), isBoxFirst == true ? -1.0f : 1.0f, 0.01f);
+		// The contact points are on the top face of the floor
+		EXPECT_FLOAT_EQ_DELTA(stream.getWorldPoints()[iii].y(), 0.0f, 0.1f);
+		EXPECT_FLOAT_EQ_DELTA(etk::abs(stream.getWorldPoints()[iii].x()), 1.0f, 0.1f);
+		EXPECT_EQ(stream.getPenetrationDepths()[iii] >= 0.0f, true);
+		EXPECT_EQ(stream.getNormalImpulses()[iii] >= 0.0f, true);
+		sumNormalImpulses += stream.getNormalImpulses()[iii];
+	}
+	// The solver holds the box against the gravity
+	EXPECT_FLOAT_EQ_DELTA(sumNormalImpulses, tmp.m_boxBody->getMass() * 9.81f / 60.0f, 0.02f);
+	// No contact: empty stream
+	tmp.placeBox(5.0f);
+	tmp.step(1);
+	EXPECT_EQ(tmp.m_world->getContactStream().getNbContacts(), size_t(0));
+	tmp.placeBox(1.02f);
+	tmp.step(30);
+	EXPECT_NE(tmp.m_world->getContactStream().getNbContacts(), size_t(0));
+	// Disabling the stream clears it
+	tmp.m_world->enableContactStream(false);
+	EXPECT_EQ(tmp.m_world->getContactStream().getNbContacts(), size_t(0));
+}
+
+/**
+ * @brief Record the contact pair events received by the listener
+ */
+class TestContactPairEventListener : public ephysics::EventListener {
+	public:
+		etk::Vector<ephysics::ContactPairEvent> m_events;
+		void contactPairEvents(const etk::Vector<ephysics::ContactPairEvent>& _events) override {
+			for (auto &it: _events) {
+				m_events.pushBack(it);
+			}
+		}
+};
+
+TEST(TestDynamicsWorld, contactPairEvents) {
+	TestDynamicsWorld tmp;
+	TestContactPairEventListener listener;
+	tmp.m_world->setEventListener(&listener);
+	tmp.m_world->enableContactPairEvents(true);
+	tmp.placeBox(1.02f);
+	tmp.step(20);
+	// One BEGIN event, then a PERSIST event at each step while the box is awake
+	EXPECT_NE(listener.m_events.size(), size_t(0));
+	if (listener.m_events.size() == 0) {
+		return;
+	}
+	EXPECT_EQ(listener.m_events[0].type, ephysics::ContactPairEvent::BEGIN);
+	for (size_t iii=0; iii<listener.m_events.size(); ++iii) {
+		const ephysics::ContactPairEvent& event = listener.m_events[iii];
+		EXPECT_EQ(    event.body1Id == tmp.m_boxBody->getID()
+		           || event.body2Id == tmp.m_boxBody->getID(), true);
+		EXPECT_NE(event.nbContactPoints, uint32_t(0));
+		EXPECT_EQ(event.normalImpulse >= 0.0f, true);
+		if (iii != 0) {
+			EXPECT_EQ(event.type, ephysics::ContactPairEvent::PERSIST);
+		}
+	}
+	// The events of the last step are available from the world too
+	EXPECT_EQ(tmp.m_world->getContactPairEvents().size(), size_t(1));
+	EXPECT_EQ(tmp.m_world->getContactPairEvents()[0].type, ephysics::ContactPairEvent::PERSIST);
+	// Separation: a single END event, then nothing
+	listener.m_events.clear();
+	tmp.placeBox(5.0f);
+	tmp.step(5);
+	EXPECT_EQ(listener.m_events.size(), size_t(1));
+	if (listener.m_events.size() == 0) {
+		return;
+	}
+	EXPECT_EQ(listener.m_events[0].type, ephysics::ContactPairEvent::END);
+	EXPECT_EQ(listener.m_events[0].nbContactPoints, uint32_t(0));
+	// Re-contact: a new BEGIN event
+	listener.m_events.clear();
+	tmp.placeBox(1.02f);
+	tmp.step(20);
+	EXPECT_NE(listener.m_events.size(), size_t(0));
+	if (listener.m_events.size() == 0) {
+		return;
+	}
+	EXPECT_EQ(listener.m_events[0].type, ephysics::ContactPairEvent::BEGIN);
+	size_t nbBeginEvents = 0;
+	for (auto &it: listener.m_events) {
+		if (it.type == ephysics::ContactPairEvent::BEGIN) {
+			nbBeginEvents++;
+		}
+	}
+	EXPECT_EQ(nbBeginEvents, size_t(1));
+	// A contact weaker than the threshold does not start
+	TestDynamicsWorld tmp2;
+	TestContactPairEventListener listener2;
+	tmp2.m_world->setEventListener(&listener2);
+	tmp2.m_world->enableContactPairEvents(true);
+	tmp2.m_world->setContactPairEventsImpulseThreshold(100.0f, 0.0f);
+	tmp2.placeBox(1.02f);
+	tmp2.step(20);
+	EXPECT_EQ(listener2.m_events.size(), size_t(0));
+	tmp.m_world->setEventListener(null);
+	tmp2.m_world->setEventListener(null);
+}
+
+/**
+ * @brief Let the box fall through a trigger shape and return the trigger events of the box
+ */
+static etk::Vector<ephysics::TriggerEvent> dropBoxThroughTrigger(TestDynamicsWorld& _tmp, ephysics::CollisionShape* _triggerShape) {
+	ephysics::RigidBody* triggerBody = _tmp.m_world->createRigidBody(etk::Transform3D(vec3(0, 6, 0), etk::Quaternion::identity()));
+	ephysics::ProxyShape* triggerProxyShape = triggerBody->addCollisionShape(_triggerShape, etk::Transform3D::identity(), 1.0f);
+	triggerBody->setType(ephysics::STATIC);
+	triggerProxyShape->setIsTrigger(true);
+	_tmp.placeBox(9.0f);
+	etk::Vector<ephysics::TriggerEvent> events;
+	float minimumHeight = 9.0f;
+	for (int32_t iii=0; iii<60; ++iii) {
+		_tmp.step(1);
+		for (auto &it: _tmp.m_world->getTriggerEvents()) {
+			EXPECT_EQ(    it.body1Id == triggerBody->getID()
+			           || it.body2Id == triggerBody->getID(), true);
+			EXPECT_EQ(    it.body1Id == _tmp.m_boxBody->getID()
+			           || it.body2Id == _tmp.m_boxBody->getID(), true);
+			events.pushBack(it);
+		}
+		minimumHeight = etk::min(minimumHeight, _tmp.m_boxBody->getTransform().getPosition().y());
+	}
+	// The trigger does not stop the box
+	EXPECT_EQ(minimumHeight < 4.5f, true);
+	_tmp.m_world->destroyRigidBody(triggerBody);
+	return events;
+}
+
+TEST(TestDynamicsWorld, triggerEvents) {
+	// Convex trigger
+	TestDynamicsWorld tmp;
+	ephysics::BoxShape triggerShape(vec3(2, 0.5f, 2));
+	etk::Vector<ephysics::TriggerEvent> events = dropBoxThroughTrigger(tmp, &triggerShape);
+	EXPECT_EQ(events.size(), size_t(2));
+	if (events.size() == 2) {
+		EXPECT_EQ(events[0].type, ephysics::TriggerEvent::ENTER);
+		EXPECT_EQ(events[1].type, ephysics::TriggerEvent::EXIT);
+	}
+	// Concave trigger (a flat square of two triangles)
+	TestDynamicsWorld tmp2;
+	etk::Vector<vec3> vertices;
+	vertices.pushBack(vec3(-3, 0, -3));
+	vertices.pushBack(vec3(3, 0, -3));
+	vertices.pushBack(vec3(3, 0, 3));
+	vertices.pushBack(vec3(-3, 0, 3));
+	etk::Vector<uint32_t> indices;
+	indices.pushBack(0); indices.pushBack(2); indices.pushBack(1);
+	indices.pushBack(0); indices.pushBack(3); indices.pushBack(2);
+	ephysics::TriangleVertexArray vertexArray(vertices, indices);
+	ephysics::TriangleMesh triangleMesh;
+	triangleMesh.addSubpart(&vertexArray);
+	ephysics::ConcaveMeshShape meshShape(&triangleMesh);
+	etk::Vector<ephysics::TriggerEvent> events2 = dropBoxThroughTrigger(tmp2, &meshShape);
+	EXPECT_EQ(events2.size(), size_t(2));
+	if (events2.size() == 2) {
+		EXPECT_EQ(events2[0].type, ephysics::TriggerEvent::ENTER);
+		EXPECT_EQ(events2[1].type, ephysics::TriggerEvent::EXIT);
+	}
+}
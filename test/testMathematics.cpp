@@ -0,0 +1,168 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etest/etest.hpp>
+#include <ephysics/ephysics.hpp>
+#include <ephysics/mathematics/simd.hpp>
+#include <echrono/Clock.hpp>
+#include <test-debug/debug.hpp>
+
+namespace {
+	const int32_t NB_BENCHMARK_POINTS = 1000;
+	const int32_t NB_BENCHMARK_LOOPS = 1000;
+	/// Create a unit quaternion
+	etk::Quaternion createRotation(float _x, float _y, float _z, float _w) {
+		etk::Quaternion quaternion(_x, _y, _z, _w);
+		quaternion.normalize();
+		return quaternion;
+	}
+	/// Return true if two vectors are almost equal
+	bool isNear(const vec3& _vector1, const vec3& _vector2) {
+		return (_vector1 - _vector2).length() < 1.0e-4f;
+	}
+	/// Return true if two matrices are almost equal
+	bool isNear(const etk::Matrix3x3& _matrix1, const etk::Matrix3x3& _matrix2) {
+		return    isNear(_matrix1.getColumn(0), _matrix2.getColumn(0))
+		       && isNear(_matrix1.getColumn(1), _matrix2.getColumn(1))
+		       && isNear(_matrix1.getColumn(2), _matrix2.getColumn(2));
+	}
+}
+
+TEST(TestMathematics, simdTransform) {
+	etk::Transform3D transform(vec3(1, -4, 3), createRotation(3 * M_PI / 6, -M_PI / 8, M_PI / 3, 1));
+	ephysics::simd::Transform transformSimd(transform);
+	ephysics::simd::Transform rotationSimd(transform.getOrientation().getMatrix(), vec3(0, 0, 0));
+	etk::Vector<vec3> points;
+	for (int32_t iii=0; iii<20; ++iii) {
+		points.pushBack(vec3(iii * 0.5f - 3.0f, 7.0f - iii, iii * iii * 0.1f));
+	}
+	etk::Vector<vec3> transformedPoints;
+	transformedPoints.resize(points.size());
+	ephysics::simd::transformPoints(transformSimd, points.dataPointer(), transformedPoints.dataPointer(), points.size());
+	for (size_t iii=0; iii<points.size(); ++iii) {
+		EXPECT_EQ(isNear(transformSimd * points[iii], transform * points[iii]), true);
+		EXPECT_EQ(isNear(rotationSimd.rotate(points[iii]), transform.getOrientation() * points[iii]), true);
+		EXPECT_EQ(isNear(transformSimd.rotate(points[iii]), transform.getOrientation() * points[iii]), true);
+		EXPECT_EQ(isNear(transformedPoints[iii], transform * points[iii]), true);
+	}
+}
+
+TEST(TestMathematics, simdMatrix) {
+	etk::Quaternion quaternions[3] = {etk::Quaternion::identity(),
+	                                  createRotation(M_PI / 5, M_PI / 6, M_PI / 7, 1),
+	                                  createRotation(-3 * M_PI / 8, 1.5 * M_PI / 3, M_PI / 13, 1.0f)};
+	etk::Matrix3x3 matrices[3];
+	ephysics::simd::quaternionsToMatrices(quaternions, matrices, 3);
+	for (int32_t iii=0; iii<3; ++iii) {
+		EXPECT_EQ(isNear(matrices[iii], quaternions[iii].getMatrix()), true);
+	}
+	// A non normalized quaternion gives the same rotation
+	etk::Quaternion scaledQuaternion(quaternions[1].x() * 3.0f, quaternions[1].y() * 3.0f, quaternions[1].z() * 3.0f, quaternions[1].w() * 3.0f);
+	ephysics::simd::quaternionsToMatrices(&scaledQuaternion, matrices, 1);
+	EXPECT_EQ(isNear(matrices[0], quaternions[1].getMatrix()), true);
+	etk::Matrix3x3 matrix1(1, 2, 3, -4, 5, 6, 7, -8, 9);
+	etk::Matrix3x3 matrix2 = quaternions[2].getMatrix();
+	EXPECT_EQ(isNear(ephysics::simd::multiply(matrix1, matrix2), matrix1 * matrix2), true);
+	EXPECT_EQ(isNear(ephysics::simd::multiply(matrix2, matrix1), matrix2 * matrix1), true);
+}
+
+TEST(TestMathematics, simdTransformBenchmark) {
+	etk::Transform3D transform(vec3(1, -4, 3), createRotation(M_PI / 5, M_PI / 6, M_PI / 7, 1));
+	etk::Vector<vec3> points;
+	for (int32_t iii=0; iii<NB_BENCHMARK_POINTS; ++iii) {
+		points.pushBack(vec3(iii * 0.01f, 1.0f - iii * 0.02f, iii * 0.03f));
+	}
+	etk::Vector<vec3> transformedPoints;
+	transformedPoints.resize(points.size());
+	// Transform3D (quaternion rotation for each point)
+	echrono::Clock start = echrono::Clock::now();
+	for (int32_t jjj=0; jjj<NB_BENCHMARK_LOOPS; ++jjj) {
+		for (size_t iii=0; iii<points.size(); ++iii) {
+			transformedPoints[iii] = transform * points[iii];
+		}
+	}
+	echrono::Clock stop = echrono::Clock::now();
+	int64_t durationTransform3D = stop.get() - start.get();
+	vec3 reference = transformedPoints[points.size() - 1];
+	// Fused SIMD transform-point (rotation matrix converted once)
+	start = echrono::Clock::now();
+	for (int32_t jjj=0; jjj<NB_BENCHMARK_LOOPS; ++jjj) {
+		ephysics::simd::Transform transformSimd(transform);
+		ephysics::simd::transformPoints(transformSimd, points.dataPointer(), transformedPoints.dataPointer(), points.size());
+	}
+	stop = echrono::Clock::now();
+	int64_t durationSimd = stop.get() - start.get();
+	EXPECT_EQ(isNear(transformedPoints[points.size() - 1], reference), true);
+	TEST_WARNING("Transform of " << NB_BENCHMARK_POINTS * NB_BENCHMARK_LOOPS << " points: Transform3D=" << durationTransform3D / 1000000 << "ms simd=" << durationSimd / 1000000 << "ms");
+}
+
+TEST(TestMathematics, simdInertiaTensorBenchmark) {
+	// World inverse inertia tensors (R * I^-1 * R^T) of the bodies, as computed once per step by the dynamics world
+	const etk::Matrix3x3 inertiaTensorLocalInverse(0.5f, 0, 0, 0, 0.25f, 0, 0, 0, 0.125f);
+	etk::Vector<etk::Quaternion> orientations;
+	for (int32_t iii=0; iii<NB_BENCHMARK_POINTS; ++iii) {
+		orientations.pushBack(createRotation(iii * 0.01f, 1.0f - iii * 0.02f, iii * 0.03f, 1.0f));
+	}
+	etk::Vector<etk::Matrix3x3> tensors;
+	tensors.resize(orientations.size());
+	// Quaternion to matrix conversion and matrix products of etk for each body
+	echrono::Clock start = echrono::Clock::now();
+	for (int32_t jjj=0; jjj<NB_BENCHMARK_LOOPS; ++jjj) {
+		for (size_t iii=0; iii<orientations.size(); ++iii) {
+			tensors[iii] = orientations[iii].getMatrix() * inertiaTensorLocalInverse * orientations[iii].getMatrix().getTranspose();
+		}
+	}
+	echrono::Clock stop = echrono::Clock::now();
+	int64_t durationEtk = stop.get() - start.get();
+	etk::Matrix3x3 reference = tensors[orientations.size() - 1];
+	// Batched quaternion to matrix conversion and SIMD matrix products
+	etk::Vector<etk::Matrix3x3> rotations;
+	rotations.resize(orientations.size());
+	start = echrono::Clock::now();
+	for (int32_t jjj=0; jjj<NB_BENCHMARK_LOOPS; ++jjj) {
+		ephysics::simd::quaternionsToMatrices(orientations.dataPointer(), rotations.dataPointer(), orientations.size());
+		for (size_t iii=0; iii<orientations.size(); ++iii) {
+			tensors[iii] = ephysics::simd::multiply(ephysics::simd::multiply(rotations[iii], inertiaTensorLocalInverse), rotations[iii].getTranspose());
+		}
+	}
+	stop = echrono::Clock::now();
+	int64_t durationSimd = stop.get() - start.get();
+	EXPECT_EQ(isNear(tensors[orientations.size() - 1], reference), true);
+	TEST_WARNING("Inverse inertia tensor of " << NB_BENCHMARK_POINTS * NB_BENCHMARK_LOOPS << " bodies: etk=" << durationEtk / 1000000 << "ms simd=" << durationSimd / 1000000 << "ms");
+}
+
+TEST(TestMathematics, radixSort) {
+	etk::Vector<uint64_t> keys;
+	for (int32_t iii=0; iii<1000; ++iii) {
+		// Broad-phase like pair keys (with duplicates) and a few large values
+		uint64_t key = (uint64_t((iii * 7919) % 613) << 32) | uint64_t((iii * 104729) % 997);
+		if (iii % 97 == 0) {
+			key |= 0x4000000000000000ULL;
+		}
+		keys.pushBack(key);
+	}
+	etk::Vector<uint64_t> reference = keys;
+	reference.sort(0,
+	               reference.size()-1,
+	               [](const uint64_t& _key1, const uint64_t& _key2) {
+	               	return _key1 < _key2;
+	               });
+	etk::Vector<uint64_t> buffer;
+	buffer.resize(keys.size());
+	ephysics::radixSort(keys.dataPointer(), buffer.dataPointer(), keys.size());
+	for (size_t iii=0; iii<keys.size(); ++iii) {
+		EXPECT_EQ(keys[iii], reference[iii]);
+	}
+	// Keys with the same high bytes (skipped passes)
+	uint64_t smallKeys[5] = {3, 1, 2, 1, 0};
+	uint64_t smallBuffer[5];
+	ephysics::radixSort(smallKeys, smallBuffer, 5);
+	EXPECT_EQ(smallKeys[0], 0);
+	EXPECT_EQ(smallKeys[1], 1);
+	EXPECT_EQ(smallKeys[2], 1);
+	EXPECT_EQ(smallKeys[3], 2);
+	EXPECT_EQ(smallKeys[4], 3);
+}
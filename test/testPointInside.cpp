@@ -677,3 +677,50 @@ TEST(TestPointInside, compound) {
 	EXPECT_EQ(true, tmp.m_compoundBody->testPointInside(tmp.m_localShape2ToWorld * vec3(1, -2, 1.5)));
 }
 
+
+TEST(TestPointInside, batch) {
+	TestPointInside tmp;
+	etk::Vector<ephysics::CollisionBody*> bodies;
+	bodies.pushBack(tmp.m_boxBody);
+	bodies.pushBack(tmp.m_sphereBody);
+	bodies.pushBack(tmp.m_capsuleBody);
+	bodies.pushBack(tmp.m_coneBody);
+	bodies.pushBack(tmp.m_convexMeshBody);
+	bodies.pushBack(tmp.m_convexMeshBodyEdgesInfo);
+	bodies.pushBack(tmp.m_cylinderBody);
+	bodies.pushBack(tmp.m_compoundBody);
+	// Grid of points around the shapes (more points than a group of the batch)
+	etk::Vector<vec3> points;
+	for (int32_t xxx=-8; xxx<=8; ++xxx) {
+		for (int32_t yyy=-8; yyy<=8; ++yyy) {
+			for (int32_t zzz=-8; zzz<=8; ++zzz) {
+				points.pushBack(tmp.m_localShapeToWorld * vec3(xxx * 0.73f, yyy * 0.73f, zzz * 0.73f));
+			}
+		}
+	}
+	etk::Vector<ephysics::CollisionBody*> result;
+	result.resize(points.size(), null);
+	tmp.m_world->testPointsInside(points.dataPointer(), points.size(), result.dataPointer());
+	// The batch gives the same classification as the tests body by body
+	int32_t nbInside = 0;
+	for (size_t iii=0; iii<points.size(); ++iii) {
+		bool isInsideOneBody = false;
+		for (auto &it: bodies) {
+			if (it->testPointInside(points[iii]) == true) {
+				isInsideOneBody = true;
+			}
+		}
+		EXPECT_EQ(result[iii] != null, isInsideOneBody);
+		if (result[iii] != null) {
+			EXPECT_EQ(result[iii]->testPointInside(points[iii]), true);
+			++nbInside;
+		}
+	}
+	EXPECT_EQ(nbInside > 0, true);
+	// Only the box is tested with a category filter
+	tmp.m_boxProxyShape->setCollisionCategoryBits(0x0002);
+	tmp.m_world->testPointsInside(points.dataPointer(), points.size(), result.dataPointer(), 0x0002);
+	for (size_t iii=0; iii<points.size(); ++iii) {
+		EXPECT_EQ(result[iii] != null, tmp.m_boxBody->testPointInside(points[iii]));
+	}
+}
@@ -2517,3 +2517,53 @@ TEST(TestRay, heighField) {
 	EXPECT_EQ(true, tmp.m_callback.isHit);
 }
 
+
+/**
+ * @brief Raycast a stack of parallel square layers (two triangles per layer): the front-to-back
+ * traversal must return the nearest layer, at any scale of the mesh
+ */
+static void testConcaveMeshNearestHit(float _scale) {
+	const int32_t nbLayers = 12;
+	etk::Vector<vec3> vertices;
+	etk::Vector<uint32_t> indices;
+	for (int32_t iii=0; iii<nbLayers; ++iii) {
+		uint32_t first = vertices.size();
+		vertices.pushBack(vec3(-1, -1, iii) * _scale);
+		vertices.pushBack(vec3(1, -1, iii) * _scale);
+		vertices.pushBack(vec3(1, 1, iii) * _scale);
+		vertices.pushBack(vec3(-1, 1, iii) * _scale);
+		// Counter clockwise seen from +Z: front face toward the ray
+		indices.pushBack(first); indices.pushBack(first + 1); indices.pushBack(first + 2);
+		indices.pushBack(first); indices.pushBack(first + 2); indices.pushBack(first + 3);
+	}
+	ephysics::TriangleVertexArray* vertexArray = ETK_NEW(ephysics::TriangleVertexArray, vertices, indices);
+	ephysics::TriangleMesh triangleMesh;
+	triangleMesh.addSubpart(vertexArray);
+	ephysics::ConcaveMeshShape* shape = ETK_NEW(ephysics::ConcaveMeshShape, &triangleMesh);
+	ephysics::CollisionWorld* world = ETK_NEW(ephysics::CollisionWorld);
+	ephysics::CollisionBody* body = world->createCollisionBody(etk::Transform3D::identity());
+	body->addCollisionShape(shape, etk::Transform3D::identity());
+	ephysics::Ray ray(vec3(0.3f, 0.2f, 20.0f) * _scale, vec3(0.3f, 0.2f, -20.0f) * _scale);
+	ephysics::RaycastInfo raycastInfo;
+	EXPECT_EQ(body->raycast(ray, raycastInfo), true);
+	EXPECT_FLOAT_EQ_DELTA(raycastInfo.hitFraction, (20.0f - (nbLayers - 1)) / 40.0f, 0.0001f);
+	EXPECT_FLOAT_EQ_DELTA(raycastInfo.worldPoint.z(), (nbLayers - 1) * _scale, 0.0001f * _scale);
+	EXPECT_EQ(raycastInfo.triangleIndex / 2, nbLayers - 1);
+	// The ray stopped before the first layer hits nothing
+	ephysics::RaycastInfo raycastInfo2;
+	EXPECT_EQ(body->raycast(ephysics::Ray(ray.point1, ray.point2, 0.2f), raycastInfo2), false);
+	// From the back, the layers are not hit (front face raycast)
+	ephysics::RaycastInfo raycastInfo3;
+	EXPECT_EQ(body->raycast(ephysics::Ray(ray.point2, ray.point1), raycastInfo3), false);
+	world->destroyCollisionBody(body);
+	ETK_DELETE(ephysics::CollisionWorld, world);
+	ETK_DELETE(ephysics::ConcaveMeshShape, shape);
+	ETK_DELETE(ephysics::TriangleVertexArray, vertexArray);
+}
+
+TEST(TestRay, concaveMeshNearestHit) {
+	testConcaveMeshNearestHit(1.0f);
+	// Small and large meshes (the parallel test is relative to the size of the triangles)
+	testConcaveMeshNearestHit(0.0001f);
+	testConcaveMeshNearestHit(1000.0f);
+}
@@ -0,0 +1,53 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2017, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etest/etest.hpp>
+#include <ephysics/ephysics.hpp>
+#include <test-debug/debug.hpp>
+
+/**
+ * @brief Count the executions of each item and sum the items per thread
+ */
+class CountTask : public ephysics::TaskScheduler::Task {
+	public:
+		etk::Vector<int32_t> m_nbExecutions;
+		etk::Vector<int64_t> m_threadSums;
+		CountTask(int32_t _nbItems, int32_t _nbThreads) {
+			m_nbExecutions.resize(_nbItems, 0);
+			m_threadSums.resize(_nbThreads, 0);
+		}
+		void execute(int32_t _begin, int32_t _end, int32_t _threadIndex) override {
+			for (int32_t iii=_begin; iii<_end; ++iii) {
+				m_nbExecutions[iii]++;
+				m_threadSums[_threadIndex] += iii;
+			}
+		}
+};
+
+TEST(TestTaskScheduler, parallelFor) {
+	ephysics::WorkStealingTaskScheduler scheduler(4);
+	EXPECT_EQ(scheduler.getNbThreads(), 4);
+	for (int32_t jjj=0; jjj<10; ++jjj) {
+		CountTask task(10000, 4);
+		scheduler.parallelFor(task, 10000, 7);
+		int64_t sum = 0;
+		for (auto &it: task.m_threadSums) {
+			sum += it;
+		}
+		EXPECT_EQ(sum, int64_t(10000) * 9999 / 2);
+		bool isAllExecutedOnce = true;
+		for (auto &it: task.m_nbExecutions) {
+			if (it != 1) {
+				isAllExecutedOnce = false;
+			}
+		}
+		EXPECT_EQ(isAllExecutedOnce, true);
+	}
+	// Less items than the grain size: executed on the calling thread
+	CountTask task(5, 4);
+	scheduler.parallelFor(task, 5, 16);
+	EXPECT_EQ(task.m_threadSums[0], int64_t(10));
+}
@@ -333,7 +333,7 @@ etk::Vector<ContactPoint> SceneDemo::computeContactPointsOfWorld(const ephysics:
 		// For each contact point of the manifold
 		for (uint32_t i=0; i<manifold->getNbContactPoints(); i++) {
 
-			ephysics::ContactPoint* contactPoint = manifold->getContactPoint(i);
+			const ephysics::ContactPoint* contactPoint = manifold->getContactPoint(i);
 			ephysics::vec3 point = contactPoint->getWorldPointOnBody1();
 			ContactPoint contact(openglframework::vec3(point.x(), point.y(), point.z()));
 			contactPoints.pushBack(contact);